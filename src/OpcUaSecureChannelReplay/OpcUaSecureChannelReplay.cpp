@@ -0,0 +1,626 @@
+/*
+   Copyright 2015 Kai Huebl (kai@huebl-sgh.de)
+
+   Lizenziert gemäß Apache Licence Version 2.0 (die „Lizenz“); Nutzung dieser
+   Datei nur in Übereinstimmung mit der Lizenz erlaubt.
+   Eine Kopie der Lizenz erhalten Sie auf http://www.apache.org/licenses/LICENSE-2.0.
+
+   Sofern nicht gemäß geltendem Recht vorgeschrieben oder schriftlich vereinbart,
+   erfolgt die Bereitstellung der im Rahmen der Lizenz verbreiteten Software OHNE
+   GEWÄHR ODER VORBEHALTE – ganz gleich, ob ausdrücklich oder stillschweigend.
+
+   Informationen über die jeweiligen Bedingungen für Genehmigungen und Einschränkungen
+   im Rahmen der Lizenz finden Sie in der Lizenz.
+
+   Autor: Kai Huebl (kai@huebl-sgh.de)
+ */
+
+
+#include <boost/program_options.hpp>
+#include <boost/thread/thread.hpp>
+#include <algorithm>
+#include <fstream>
+#include <iostream>
+#include <iomanip>
+#include <sstream>
+#include "OpcUaStackCore/Base/Log.h"
+#include "OpcUaStackCore/BuildInTypes/OpcUaIdentifier.h"
+#include "OpcUaStackCore/SecureChannel/RequestHeader.h"
+#include "OpcUaStackCore/SecureChannel/ResponseHeader.h"
+#include "OpcUaStackCore/ServiceSet/CreateSessionResponse.h"
+#include "OpcUaSecureChannelReplay/OpcUaSecureChannelReplay.h"
+
+namespace OpcUaSecureChannelReplay
+{
+
+	// ------------------------------------------------------------------------
+	// ------------------------------------------------------------------------
+	//
+	// ServiceStatistic
+	//
+	// ------------------------------------------------------------------------
+	// ------------------------------------------------------------------------
+	ServiceStatistic::ServiceStatistic(void)
+	: latencyVec_()
+	, errorCount_(0)
+	{
+	}
+
+	ServiceStatistic::~ServiceStatistic(void)
+	{
+	}
+
+	// ------------------------------------------------------------------------
+	// ------------------------------------------------------------------------
+	//
+	// ReplayChannel
+	//
+	// ------------------------------------------------------------------------
+	// ------------------------------------------------------------------------
+	ReplayChannel::ReplayChannel(IOThread* ioThread, OpcUaSecureChannelReplay* replay)
+	: replay_(replay)
+	, secureChannelClient_(ioThread)
+	, secureChannel_(nullptr)
+	, connect_()
+	, disconnect_()
+	, session_()
+	, mutex_()
+	, requestId_(0)
+	, sessionPending_(false)
+	, authenticationToken_()
+	, pendingRequestMap_()
+	{
+		secureChannelClient_.secureChannelClientIf(this);
+	}
+
+	ReplayChannel::~ReplayChannel(void)
+	{
+	}
+
+	bool
+	ReplayChannel::connect(
+		const std::string& endpointUrl,
+		ApplicationCertificate::SPtr& applicationCertificate,
+		CryptoManager::SPtr& cryptoManager,
+		uint32_t timeout
+	)
+	{
+		secureChannelClient_.applicationCertificate(applicationCertificate);
+		secureChannelClient_.cryptoManager(cryptoManager);
+
+		SecureChannelClientConfig::SPtr secureChannelClientConfig = constructSPtr<SecureChannelClientConfig>();
+		secureChannelClientConfig->endpointUrl(endpointUrl);
+
+		connect_.condition(1, 0);
+		secureChannel_ = secureChannelClient_.connect(secureChannelClientConfig);
+		if (secureChannel_ == nullptr) {
+			return false;
+		}
+		if (!connect_.waitForCondition(timeout)) {
+			disconnect(timeout);
+			return false;
+		}
+		return true;
+	}
+
+	void
+	ReplayChannel::disconnect(uint32_t timeout)
+	{
+		if (secureChannel_ == nullptr) {
+			return;
+		}
+
+		// wait for the responses of the outstanding requests
+		boost::posix_time::ptime endTime = boost::posix_time::microsec_clock::universal_time()
+			+ boost::posix_time::milliseconds(timeout);
+		while (outstanding() > 0 && boost::posix_time::microsec_clock::universal_time() < endTime) {
+			boost::this_thread::sleep(boost::posix_time::milliseconds(1));
+		}
+
+		// the secure channel is closed in the strand of the connection
+		disconnect_.condition(1, 0);
+		secureChannel_->strand()->post(
+			boost::bind(&SecureChannelClient::disconnect, &secureChannelClient_, secureChannel_)
+		);
+		disconnect_.waitForCondition(timeout);
+		secureChannel_ = nullptr;
+
+		// requests without response are counted as errors
+		boost::mutex::scoped_lock g(mutex_);
+		PendingRequestMap::iterator it;
+		for (it = pendingRequestMap_.begin(); it != pendingRequestMap_.end(); it++) {
+			replay_->addError(it->second.typeId_);
+		}
+		pendingRequestMap_.clear();
+	}
+
+	uint32_t
+	ReplayChannel::outstanding(void)
+	{
+		boost::mutex::scoped_lock g(mutex_);
+		return pendingRequestMap_.size();
+	}
+
+	bool
+	ReplayChannel::sendRequest(SecureChannelCaptureRecord& record, uint32_t timeout)
+	{
+		if (secureChannel_ == nullptr) {
+			return false;
+		}
+
+		// a request of a session must wait for the authentication token of
+		// the session created by the replay
+		bool sessionPending;
+		{
+			boost::mutex::scoped_lock g(mutex_);
+			sessionPending = sessionPending_;
+		}
+		if (sessionPending) {
+			std::stringstream ss(record.data_);
+			RequestHeader requestHeader;
+			requestHeader.opcUaBinaryDecode(ss);
+			if (!isNullToken(requestHeader.sessionAuthenticationToken())) {
+				session_.waitForCondition(timeout);
+			}
+		}
+
+		SecureChannelTransaction::SPtr secureChannelTransaction = constructSPtr<SecureChannelTransaction>();
+		secureChannelTransaction->requestTypeNodeId_.nodeId(record.typeId_);
+		patchRequest(record, secureChannelTransaction);
+
+		{
+			boost::mutex::scoped_lock g(mutex_);
+			secureChannelTransaction->requestId_ = ++requestId_;
+
+			PendingRequest pendingRequest;
+			pendingRequest.typeId_ = record.typeId_;
+			pendingRequest.sendTime_ = boost::posix_time::microsec_clock::universal_time();
+			pendingRequestMap_.insert(std::make_pair(requestId_, pendingRequest));
+
+			if (record.typeId_ == OpcUaId_CreateSessionRequest_Encoding_DefaultBinary) {
+				sessionPending_ = true;
+				session_.condition(1, 0);
+			}
+		}
+
+		secureChannel_->strand()->post(
+			boost::bind(&ReplayChannel::asyncWriteRequest, this, secureChannelTransaction)
+		);
+		return true;
+	}
+
+	void
+	ReplayChannel::asyncWriteRequest(SecureChannelTransaction::SPtr secureChannelTransaction)
+	{
+		secureChannelClient_.asyncWriteMessageRequest(secureChannel_, secureChannelTransaction);
+	}
+
+	void
+	ReplayChannel::patchRequest(SecureChannelCaptureRecord& record, SecureChannelTransaction::SPtr& secureChannelTransaction)
+	{
+		std::iostream os(&secureChannelTransaction->os_);
+
+		// replace the recorded authentication token
+		std::stringstream ss(record.data_);
+		RequestHeader requestHeader;
+		requestHeader.opcUaBinaryDecode(ss);
+		if (!ss.good()) {
+			os.write(record.data_.c_str(), record.data_.size());
+			return;
+		}
+
+		if (!isNullToken(requestHeader.sessionAuthenticationToken())) {
+			boost::mutex::scoped_lock g(mutex_);
+			requestHeader.sessionAuthenticationToken() = authenticationToken_;
+		}
+		requestHeader.opcUaBinaryEncode(os);
+
+		// the body of the request is not changed
+		std::streamoff pos = ss.tellg();
+		os.write(record.data_.c_str() + pos, record.data_.size() - pos);
+	}
+
+	bool
+	ReplayChannel::isNullToken(OpcUaNodeId& token)
+	{
+		OpcUaUInt32 nodeId;
+		OpcUaUInt16 namespaceIndex;
+		if (!token.get(nodeId, namespaceIndex)) {
+			return false;
+		}
+		return nodeId == 0 && namespaceIndex == 0;
+	}
+
+	void
+	ReplayChannel::handleConnect(SecureChannel* secureChannel)
+	{
+		connect_.conditionValueDec();
+	}
+
+	void
+	ReplayChannel::handleDisconnect(SecureChannel* secureChannel)
+	{
+		disconnect_.conditionValueDec();
+	}
+
+	void
+	ReplayChannel::handleMessageResponse(SecureChannel* secureChannel)
+	{
+		boost::posix_time::ptime now = boost::posix_time::microsec_clock::universal_time();
+		SecureChannelTransaction::SPtr secureChannelTransaction = secureChannel->secureChannelTransaction_;
+
+		PendingRequest pendingRequest;
+		{
+			boost::mutex::scoped_lock g(mutex_);
+			PendingRequestMap::iterator it = pendingRequestMap_.find(secureChannelTransaction->requestId_);
+			if (it == pendingRequestMap_.end()) {
+				return;
+			}
+			pendingRequest = it->second;
+			pendingRequestMap_.erase(it);
+		}
+
+		OpcUaUInt32 responseTypeId = 0;
+		OpcUaUInt16 namespaceIndex = 0;
+		secureChannelTransaction->responseTypeNodeId_.get(responseTypeId, namespaceIndex);
+		if (responseTypeId == OpcUaId_ServiceFault_Encoding_DefaultBinary) {
+			replay_->addError(pendingRequest.typeId_);
+		}
+		else {
+			replay_->addLatency(pendingRequest.typeId_, (now - pendingRequest.sendTime_).total_microseconds());
+		}
+
+		// remember the authentication token of the new session
+		if (responseTypeId == OpcUaId_CreateSessionResponse_Encoding_DefaultBinary) {
+			std::iostream ios(&secureChannelTransaction->is_);
+			ResponseHeader responseHeader;
+			responseHeader.opcUaBinaryDecode(ios);
+			CreateSessionResponse createSessionResponse;
+			createSessionResponse.opcUaBinaryDecode(ios);
+
+			boost::mutex::scoped_lock g(mutex_);
+			authenticationToken_ = createSessionResponse.authenticationToken();
+		}
+		if (pendingRequest.typeId_ == OpcUaId_CreateSessionRequest_Encoding_DefaultBinary) {
+			{
+				boost::mutex::scoped_lock g(mutex_);
+				sessionPending_ = false;
+			}
+			session_.conditionValueDec();
+		}
+	}
+
+	// ------------------------------------------------------------------------
+	// ------------------------------------------------------------------------
+	//
+	// OpcUaSecureChannelReplay
+	//
+	// ------------------------------------------------------------------------
+	// ------------------------------------------------------------------------
+	OpcUaSecureChannelReplay::OpcUaSecureChannelReplay(void)
+	: fileName_("")
+	, endpointUrl_("")
+	, pkiDir_("")
+	, speed_(1.0)
+	, timeout_(10000)
+	, ioThread_()
+	, applicationCertificate_()
+	, cryptoManager_()
+	, recordVec_()
+	, replayChannelMap_()
+	, mutex_()
+	, serviceStatisticMap_()
+	, numberRequests_(0)
+	, duration_()
+	{
+	}
+
+	OpcUaSecureChannelReplay::~OpcUaSecureChannelReplay(void)
+	{
+	}
+
+	uint32_t
+	OpcUaSecureChannelReplay::start(int argc, char** argv)
+	{
+		if (!parseCommandLine(argc, argv)) {
+			return 1;
+		}
+
+		if (!readCaptureFile()) {
+			return 1;
+		}
+
+		ioThread_.startup();
+		if (!createApplicationCertificate()) {
+			ioThread_.shutdown();
+			return 1;
+		}
+
+		replay();
+		ioThread_.shutdown();
+
+		report();
+		return 0;
+	}
+
+	bool
+	OpcUaSecureChannelReplay::parseCommandLine(int argc, char** argv)
+	{
+		boost::program_options::options_description desc("Allowed options");
+		desc.add_options()
+			(
+				"help",
+				"produce help message"
+			)
+			(
+				"file",
+				boost::program_options::value<std::string>(),
+				"capture file (OpcUaServer.Logging.SecureChannelCapture)"
+			)
+			(
+				"url",
+				boost::program_options::value<std::string>()->default_value(""),
+				"endpoint url of the server (default: recorded endpoint url)"
+			)
+			(
+				"speed",
+				boost::program_options::value<double>()->default_value(1.0),
+				"replay speed factor (1 = recorded speed, 0 = as fast as possible)"
+			)
+			(
+				"timeout",
+				boost::program_options::value<uint32_t>()->default_value(10000),
+				"timeout in milliseconds for connect, session and outstanding responses"
+			)
+			(
+				"pki",
+				boost::program_options::value<std::string>()->default_value("/tmp/OpcUaSecureChannelReplay/pki"),
+				"directory of the generated client certificate"
+			)
+		;
+
+		boost::program_options::variables_map vm;
+		try {
+			boost::program_options::store(boost::program_options::parse_command_line(argc, argv, desc), vm);
+			boost::program_options::notify(vm);
+		}
+		catch (std::exception& e) {
+			std::cout << e.what() << std::endl << desc << std::endl;
+			return false;
+		}
+
+		if (vm.count("help") || vm.count("file") == 0) {
+		    std::cout << desc << std::endl;
+		    return false;
+		}
+
+		fileName_ = vm["file"].as<std::string>();
+		endpointUrl_ = vm["url"].as<std::string>();
+		speed_ = vm["speed"].as<double>();
+		timeout_ = vm["timeout"].as<uint32_t>();
+		pkiDir_ = vm["pki"].as<std::string>();
+		return true;
+	}
+
+	bool
+	OpcUaSecureChannelReplay::readCaptureFile(void)
+	{
+		std::ifstream ifs(fileName_.c_str(), std::ios::in | std::ios::binary);
+		if (!ifs.is_open()) {
+			std::cout << "open capture file error: " << fileName_ << std::endl;
+			return false;
+		}
+		if (!SecureChannelCapture::readHeader(ifs)) {
+			std::cout << "invalid capture file: " << fileName_ << std::endl;
+			return false;
+		}
+
+		// responses are not replayed
+		SecureChannelCaptureRecord record;
+		while (SecureChannelCapture::readRecord(ifs, record)) {
+			if (record.recordType_ == CRT_Response) continue;
+			recordVec_.push_back(record);
+		}
+
+		std::cout << "read capture file: " << fileName_
+			<< " (" << recordVec_.size() << " records)" << std::endl;
+		return true;
+	}
+
+	bool
+	OpcUaSecureChannelReplay::createApplicationCertificate(void)
+	{
+		applicationCertificate_ = constructSPtr<ApplicationCertificate>();
+		applicationCertificate_->enable(true);
+		applicationCertificate_->certificateTrustListLocation(pkiDir_ + "/trusted/certs/");
+		applicationCertificate_->certificateRejectListLocation(pkiDir_ + "/reject/certs/");
+		applicationCertificate_->certificateRevocationListLocation(pkiDir_ + "/trusted/crl/");
+		applicationCertificate_->issuersCertificatesLocation(pkiDir_ + "/issuers/certs/");
+		applicationCertificate_->issuersRevocationListLocation(pkiDir_ + "/issuers/crl/");
+		applicationCertificate_->serverCertificateFile(pkiDir_ + "/own/certs/OpcUaSecureChannelReplay.der");
+		applicationCertificate_->privateKeyFile(pkiDir_ + "/own/private/OpcUaSecureChannelReplay.pem");
+		applicationCertificate_->generateCertificate(true);
+		applicationCertificate_->uri("urn:asneg.de:ASNeG:OpcUaSecureChannelReplay");
+		applicationCertificate_->commonName("OpcUaSecureChannelReplay");
+		applicationCertificate_->domainComponent("127.0.0.1");
+		applicationCertificate_->organization("ASNeG");
+		applicationCertificate_->organizationUnit("OPC UA Service Department");
+		applicationCertificate_->locality("Neukirchen");
+		applicationCertificate_->state("Hessen");
+		applicationCertificate_->country("DE");
+		applicationCertificate_->yearsValidFor(5);
+		applicationCertificate_->keyLength(2048);
+		applicationCertificate_->certificateType("RsaSha256");
+		if (!applicationCertificate_->init()) {
+			std::cout << "create client certificate error: " << pkiDir_ << std::endl;
+			return false;
+		}
+
+		cryptoManager_ = constructSPtr<CryptoManager>();
+		return true;
+	}
+
+	void
+	OpcUaSecureChannelReplay::replay(void)
+	{
+		if (recordVec_.empty()) {
+			return;
+		}
+
+		uint64_t firstTime = recordVec_.front().time_;
+		boost::posix_time::ptime startTime = boost::posix_time::microsec_clock::universal_time();
+
+		std::vector<SecureChannelCaptureRecord>::iterator it;
+		for (it = recordVec_.begin(); it != recordVec_.end(); it++) {
+			SecureChannelCaptureRecord& record = *it;
+
+			// wait until the scaled time of the record is reached
+			if (speed_ > 0) {
+				int64_t offset = (int64_t)((record.time_ - firstTime) / speed_);
+				boost::posix_time::ptime sendTime = startTime + boost::posix_time::microseconds(offset);
+				boost::posix_time::ptime now = boost::posix_time::microsec_clock::universal_time();
+				if (sendTime > now) {
+					boost::this_thread::sleep(sendTime - now);
+				}
+			}
+
+			ReplayChannel::Map::iterator itc = replayChannelMap_.find(record.channelId_);
+			switch (record.recordType_)
+			{
+				case CRT_Open:
+				{
+					if (itc != replayChannelMap_.end()) break;
+
+					std::string endpointUrl = endpointUrl_.empty() ? record.data_ : endpointUrl_;
+					ReplayChannel::SPtr replayChannel = constructSPtr<ReplayChannel>(&ioThread_, this);
+					if (!replayChannel->connect(endpointUrl, applicationCertificate_, cryptoManager_, timeout_)) {
+						std::cout << "connect error: " << endpointUrl
+							<< " (channel " << record.channelId_ << ")" << std::endl;
+						break;
+					}
+					replayChannelMap_.insert(std::make_pair(record.channelId_, replayChannel));
+					break;
+				}
+				case CRT_Request:
+				{
+					if (itc == replayChannelMap_.end() || !itc->second->sendRequest(record, timeout_)) {
+						addError(record.typeId_);
+						break;
+					}
+
+					boost::mutex::scoped_lock g(mutex_);
+					numberRequests_++;
+					break;
+				}
+				case CRT_Close:
+				{
+					if (itc == replayChannelMap_.end()) break;
+					itc->second->disconnect(timeout_);
+					replayChannelMap_.erase(itc);
+					break;
+				}
+				default:
+				{
+					break;
+				}
+			}
+		}
+
+		// close the channels without a recorded close
+		ReplayChannel::Map::iterator itc;
+		for (itc = replayChannelMap_.begin(); itc != replayChannelMap_.end(); itc++) {
+			itc->second->disconnect(timeout_);
+		}
+		replayChannelMap_.clear();
+
+		duration_ = boost::posix_time::microsec_clock::universal_time() - startTime;
+	}
+
+	void
+	OpcUaSecureChannelReplay::addLatency(uint32_t requestTypeId, uint64_t latency)
+	{
+		boost::mutex::scoped_lock g(mutex_);
+		serviceStatisticMap_[requestTypeId].latencyVec_.push_back(latency);
+	}
+
+	void
+	OpcUaSecureChannelReplay::addError(uint32_t requestTypeId)
+	{
+		boost::mutex::scoped_lock g(mutex_);
+		serviceStatisticMap_[requestTypeId].errorCount_++;
+	}
+
+	void
+	OpcUaSecureChannelReplay::report(void)
+	{
+		boost::mutex::scoped_lock g(mutex_);
+
+		std::cout << std::endl
+			<< "requests: " << numberRequests_
+			<< "  duration: " << duration_.total_milliseconds() << " ms"
+			<< "  requests per second: " << (numberRequests_ * 1000000LL) / (duration_.total_microseconds() + 1)
+			<< std::endl << std::endl;
+
+		std::cout << std::left << std::setw(40) << "service"
+			<< std::right
+			<< std::setw(8) << "count"
+			<< std::setw(8) << "errors"
+			<< std::setw(10) << "min"
+			<< std::setw(10) << "avg"
+			<< std::setw(10) << "p50"
+			<< std::setw(10) << "p90"
+			<< std::setw(10) << "p99"
+			<< std::setw(10) << "max"
+			<< "  (latency in us)" << std::endl;
+
+		std::map<uint32_t, ServiceStatistic>::iterator it;
+		for (it = serviceStatisticMap_.begin(); it != serviceStatisticMap_.end(); it++) {
+			std::string service = OpcUaIdMap::shortString(it->first);
+			if (service.empty()) {
+				std::stringstream ss;
+				ss << it->first;
+				service = ss.str();
+			}
+
+			std::vector<uint64_t>& latencyVec = it->second.latencyVec_;
+			std::sort(latencyVec.begin(), latencyVec.end());
+
+			uint64_t sum = 0;
+			for (size_t idx = 0; idx < latencyVec.size(); idx++) {
+				sum += latencyVec[idx];
+			}
+			size_t count = latencyVec.size();
+
+			std::cout << std::left << std::setw(40) << service
+				<< std::right
+				<< std::setw(8) << count
+				<< std::setw(8) << it->second.errorCount_;
+			if (count == 0) {
+				std::cout << std::endl;
+				continue;
+			}
+			std::cout
+				<< std::setw(10) << latencyVec[0]
+				<< std::setw(10) << sum / count
+				<< std::setw(10) << latencyVec[(count - 1) * 50 / 100]
+				<< std::setw(10) << latencyVec[(count - 1) * 90 / 100]
+				<< std::setw(10) << latencyVec[(count - 1) * 99 / 100]
+				<< std::setw(10) << latencyVec[count - 1]
+				<< std::endl;
+		}
+	}
+
+}
+
+// ----------------------------------------------------------------------------
+// ----------------------------------------------------------------------------
+//
+// main application
+//
+// ----------------------------------------------------------------------------
+// ----------------------------------------------------------------------------
+int main(int argc, char** argv)
+{
+	OpcUaSecureChannelReplay::OpcUaSecureChannelReplay secureChannelReplay;
+	return secureChannelReplay.start(argc, argv);
+}
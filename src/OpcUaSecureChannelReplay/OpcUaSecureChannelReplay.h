@@ -0,0 +1,157 @@
+/*
+   Copyright 2015 Kai Huebl (kai@huebl-sgh.de)
+
+   Lizenziert gemäß Apache Licence Version 2.0 (die „Lizenz“); Nutzung dieser
+   Datei nur in Übereinstimmung mit der Lizenz erlaubt.
+   Eine Kopie der Lizenz erhalten Sie auf http://www.apache.org/licenses/LICENSE-2.0.
+
+   Sofern nicht gemäß geltendem Recht vorgeschrieben oder schriftlich vereinbart,
+   erfolgt die Bereitstellung der im Rahmen der Lizenz verbreiteten Software OHNE
+   GEWÄHR ODER VORBEHALTE – ganz gleich, ob ausdrücklich oder stillschweigend.
+
+   Informationen über die jeweiligen Bedingungen für Genehmigungen und Einschränkungen
+   im Rahmen der Lizenz finden Sie in der Lizenz.
+
+   Autor: Kai Huebl (kai@huebl-sgh.de)
+ */
+
+
+#ifndef __OpcUaSecureChannelReplay_OpcUaSecureChannelReplay_h__
+#define __OpcUaSecureChannelReplay_OpcUaSecureChannelReplay_h__
+
+#include <boost/thread/mutex.hpp>
+#include <boost/date_time/posix_time/posix_time.hpp>
+#include <map>
+#include <vector>
+#include "OpcUaStackCore/Base/Condition.h"
+#include "OpcUaStackCore/Utility/IOThread.h"
+#include "OpcUaStackCore/Certificate/ApplicationCertificate.h"
+#include "OpcUaStackCore/Certificate/CryptoManager.h"
+#include "OpcUaStackCore/SecureChannel/SecureChannelCapture.h"
+#include "OpcUaStackCore/SecureChannel/SecureChannelClient.h"
+
+using namespace OpcUaStackCore;
+
+namespace OpcUaSecureChannelReplay
+{
+
+	//
+	// latency distribution of all responses of one service
+	//
+	class ServiceStatistic
+	{
+	  public:
+		ServiceStatistic(void);
+		~ServiceStatistic(void);
+
+		std::vector<uint64_t> latencyVec_;	// microseconds
+		uint32_t errorCount_;
+	};
+
+	class OpcUaSecureChannelReplay;
+
+	//
+	// A replay channel replaces one recorded secure channel. The recorded
+	// requests are sent with security mode None. The authentication token
+	// of the recorded session is replaced by the token of the session which
+	// is created during the replay.
+	//
+	class ReplayChannel
+	: public SecureChannelClientIf
+	{
+	  public:
+		typedef boost::shared_ptr<ReplayChannel> SPtr;
+		typedef std::map<uint32_t, ReplayChannel::SPtr> Map;
+
+		ReplayChannel(IOThread* ioThread, OpcUaSecureChannelReplay* replay);
+		~ReplayChannel(void);
+
+		bool connect(
+			const std::string& endpointUrl,
+			ApplicationCertificate::SPtr& applicationCertificate,
+			CryptoManager::SPtr& cryptoManager,
+			uint32_t timeout
+		);
+		void disconnect(uint32_t timeout);
+		bool sendRequest(SecureChannelCaptureRecord& record, uint32_t timeout);
+		uint32_t outstanding(void);
+
+		//- SecureChannelClientIf ---------------------------------------------
+		void handleConnect(SecureChannel* secureChannel);
+		void handleDisconnect(SecureChannel* secureChannel);
+		void handleMessageResponse(SecureChannel* secureChannel);
+		//- SecureChannelClientIf ---------------------------------------------
+
+	  private:
+		class PendingRequest
+		{
+		  public:
+			uint32_t typeId_;
+			boost::posix_time::ptime sendTime_;
+		};
+		typedef std::map<uint32_t, PendingRequest> PendingRequestMap;
+
+		void asyncWriteRequest(SecureChannelTransaction::SPtr secureChannelTransaction);
+		void patchRequest(SecureChannelCaptureRecord& record, SecureChannelTransaction::SPtr& secureChannelTransaction);
+		bool isNullToken(OpcUaNodeId& token);
+
+		OpcUaSecureChannelReplay* replay_;
+		SecureChannelClient secureChannelClient_;
+		SecureChannel* secureChannel_;
+		Condition connect_;
+		Condition disconnect_;
+		Condition session_;
+
+		boost::mutex mutex_;
+		uint32_t requestId_;
+		bool sessionPending_;
+		OpcUaNodeId authenticationToken_;
+		PendingRequestMap pendingRequestMap_;
+	};
+
+	//
+	// The secure channel replay reads a capture file written by a server
+	// with the parameter OpcUaServer.Logging.SecureChannelCapture and sends
+	// the recorded requests to a server. The speed factor scales the
+	// recorded time between the requests (0 = as fast as possible). At the
+	// end the latency distribution of each service is reported.
+	//
+	class OpcUaSecureChannelReplay
+	{
+	  public:
+		OpcUaSecureChannelReplay(void);
+		~OpcUaSecureChannelReplay(void);
+
+		uint32_t start(int argc, char** argv);
+
+		void addLatency(uint32_t requestTypeId, uint64_t latency);
+		void addError(uint32_t requestTypeId);
+
+	  private:
+		bool parseCommandLine(int argc, char** argv);
+		bool readCaptureFile(void);
+		bool createApplicationCertificate(void);
+		void replay(void);
+		void report(void);
+
+		std::string fileName_;
+		std::string endpointUrl_;
+		std::string pkiDir_;
+		double speed_;
+		uint32_t timeout_;
+
+		IOThread ioThread_;
+		ApplicationCertificate::SPtr applicationCertificate_;
+		CryptoManager::SPtr cryptoManager_;
+		std::vector<SecureChannelCaptureRecord> recordVec_;
+		ReplayChannel::Map replayChannelMap_;
+
+		boost::mutex mutex_;
+		std::map<uint32_t, ServiceStatistic> serviceStatisticMap_;
+		uint32_t numberRequests_;
+		boost::posix_time::time_duration duration_;
+	};
+
+}
+
+#endif
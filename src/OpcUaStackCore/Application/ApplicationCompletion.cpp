@@ -0,0 +1,64 @@
+/*
+   Copyright 2015 Kai Huebl (kai@huebl-sgh.de)
+
+   Lizenziert gemäß Apache Licence Version 2.0 (die „Lizenz“); Nutzung dieser
+   Datei nur in Übereinstimmung mit der Lizenz erlaubt.
+   Eine Kopie der Lizenz erhalten Sie auf http://www.apache.org/licenses/LICENSE-2.0.
+
+   Sofern nicht gemäß geltendem Recht vorgeschrieben oder schriftlich vereinbart,
+   erfolgt die Bereitstellung der im Rahmen der Lizenz verbreiteten Software OHNE
+   GEWÄHR ODER VORBEHALTE – ganz gleich, ob ausdrücklich oder stillschweigend.
+
+   Informationen über die jeweiligen Bedingungen für Genehmigungen und Einschränkungen
+   im Rahmen der Lizenz finden Sie in der Lizenz.
+
+   Autor: Kai Huebl (kai@huebl-sgh.de)
+ */
+#include "OpcUaStackCore/Application/ApplicationCompletion.h"
+
+namespace OpcUaStackCore
+{
+
+	ApplicationCompletion::ApplicationCompletion(const Callback& callback)
+	: mutex_()
+	, callback_(callback)
+	{
+	}
+
+	ApplicationCompletion::~ApplicationCompletion(void)
+	{
+		if (callback_) {
+			OpcUaDataValue dataValue;
+			callback_(BadInternalError, dataValue);
+		}
+	}
+
+	void
+	ApplicationCompletion::complete(OpcUaStatusCode statusCode)
+	{
+		OpcUaDataValue dataValue;
+		complete(statusCode, dataValue);
+	}
+
+	void
+	ApplicationCompletion::complete(OpcUaStatusCode statusCode, OpcUaDataValue& dataValue)
+	{
+		// the callback is removed from the token, so that a second
+		// completion is ignored
+		Callback callback;
+		{
+			boost::mutex::scoped_lock g(mutex_);
+			callback.swap(callback_);
+		}
+
+		if (callback) callback(statusCode, dataValue);
+	}
+
+	bool
+	ApplicationCompletion::isCompleted(void)
+	{
+		boost::mutex::scoped_lock g(mutex_);
+		return !callback_;
+	}
+
+}
@@ -0,0 +1,58 @@
+/*
+   Copyright 2015 Kai Huebl (kai@huebl-sgh.de)
+
+   Lizenziert gemäß Apache Licence Version 2.0 (die „Lizenz“); Nutzung dieser
+   Datei nur in Übereinstimmung mit der Lizenz erlaubt.
+   Eine Kopie der Lizenz erhalten Sie auf http://www.apache.org/licenses/LICENSE-2.0.
+
+   Sofern nicht gemäß geltendem Recht vorgeschrieben oder schriftlich vereinbart,
+   erfolgt die Bereitstellung der im Rahmen der Lizenz verbreiteten Software OHNE
+   GEWÄHR ODER VORBEHALTE – ganz gleich, ob ausdrücklich oder stillschweigend.
+
+   Informationen über die jeweiligen Bedingungen für Genehmigungen und Einschränkungen
+   im Rahmen der Lizenz finden Sie in der Lizenz.
+
+   Autor: Kai Huebl (kai@huebl-sgh.de)
+ */
+#ifndef __OpcUaStackCore_ApplicationCompletion_h__
+#define __OpcUaStackCore_ApplicationCompletion_h__
+
+#include <boost/shared_ptr.hpp>
+#include <boost/function.hpp>
+#include <boost/thread/mutex.hpp>
+#include "OpcUaStackCore/Base/os.h"
+#include "OpcUaStackCore/BuildInTypes/OpcUaDataValue.h"
+#include "OpcUaStackCore/BuildInTypes/OpcUaStatusCode.h"
+
+namespace OpcUaStackCore
+{
+
+	//
+	// completion token of an asynchronous application operation. The
+	// application takes the token in the forward callback, returns and
+	// completes the operation later from any thread. Only the first
+	// completion is used. A token that is destroyed without completion
+	// completes the operation with BadInternalError.
+	//
+	class DLLEXPORT ApplicationCompletion
+	{
+	  public:
+		typedef boost::shared_ptr<ApplicationCompletion> SPtr;
+		typedef boost::function<void (OpcUaStatusCode, OpcUaDataValue&)> Callback;
+		typedef boost::function<SPtr (void)> Factory;
+
+		ApplicationCompletion(const Callback& callback);
+		~ApplicationCompletion(void);
+
+		void complete(OpcUaStatusCode statusCode);
+		void complete(OpcUaStatusCode statusCode, OpcUaDataValue& dataValue);
+		bool isCompleted(void);
+
+	  private:
+		boost::mutex mutex_;
+		Callback callback_;
+	};
+
+}
+
+#endif
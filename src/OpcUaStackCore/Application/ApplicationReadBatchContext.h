@@ -0,0 +1,49 @@
+/*
+   Copyright 2015 Kai Huebl (kai@huebl-sgh.de)
+
+   Lizenziert gemäß Apache Licence Version 2.0 (die „Lizenz“); Nutzung dieser
+   Datei nur in Übereinstimmung mit der Lizenz erlaubt.
+   Eine Kopie der Lizenz erhalten Sie auf http://www.apache.org/licenses/LICENSE-2.0.
+
+   Sofern nicht gemäß geltendem Recht vorgeschrieben oder schriftlich vereinbart,
+   erfolgt die Bereitstellung der im Rahmen der Lizenz verbreiteten Software OHNE
+   GEWÄHR ODER VORBEHALTE – ganz gleich, ob ausdrücklich oder stillschweigend.
+
+   Informationen über die jeweiligen Bedingungen für Genehmigungen und Einschränkungen
+   im Rahmen der Lizenz finden Sie in der Lizenz.
+
+   Autor: Kai Huebl (kai@huebl-sgh.de)
+ */
+#ifndef __OpcUaStackCore_ApplicationReadBatchContext_h__
+#define __OpcUaStackCore_ApplicationReadBatchContext_h__
+
+#include <vector>
+#include "OpcUaStackCore/Base/os.h"
+#include "OpcUaStackCore/Base/BaseClass.h"
+#include "OpcUaStackCore/Base/UserContext.h"
+#include "OpcUaStackCore/Application/ApplicationReadContext.h"
+
+namespace OpcUaStackCore
+{
+
+	//
+	// all items of a read request that are registered with the same batch
+	// read callback. Each item is read like a single read; an item can be
+	// completed asynchronously with ApplicationReadContext::asyncCompletion().
+	//
+	class DLLEXPORT ApplicationReadBatchContext
+	{
+	  public:
+		typedef std::vector<ApplicationReadContext> ReadContextVec;
+
+		ApplicationReadBatchContext(void);
+		~ApplicationReadBatchContext(void);
+
+		BaseClass::SPtr applicationContext_;	// IN - application context from register call
+		UserContext::SPtr userContext_;			// IN - user context
+		ReadContextVec readContextVec_;			// IN/OUT - read context of each item
+	};
+
+}
+
+#endif
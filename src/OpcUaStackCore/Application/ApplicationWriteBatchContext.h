@@ -0,0 +1,50 @@
+/*
+   Copyright 2015 Kai Huebl (kai@huebl-sgh.de)
+
+   Lizenziert gemäß Apache Licence Version 2.0 (die „Lizenz“); Nutzung dieser
+   Datei nur in Übereinstimmung mit der Lizenz erlaubt.
+   Eine Kopie der Lizenz erhalten Sie auf http://www.apache.org/licenses/LICENSE-2.0.
+
+   Sofern nicht gemäß geltendem Recht vorgeschrieben oder schriftlich vereinbart,
+   erfolgt die Bereitstellung der im Rahmen der Lizenz verbreiteten Software OHNE
+   GEWÄHR ODER VORBEHALTE – ganz gleich, ob ausdrücklich oder stillschweigend.
+
+   Informationen über die jeweiligen Bedingungen für Genehmigungen und Einschränkungen
+   im Rahmen der Lizenz finden Sie in der Lizenz.
+
+   Autor: Kai Huebl (kai@huebl-sgh.de)
+ */
+#ifndef __OpcUaStackCore_ApplicationWriteBatchContext_h__
+#define __OpcUaStackCore_ApplicationWriteBatchContext_h__
+
+#include <vector>
+#include "OpcUaStackCore/Base/os.h"
+#include "OpcUaStackCore/Base/BaseClass.h"
+#include "OpcUaStackCore/Base/UserContext.h"
+#include "OpcUaStackCore/Application/ApplicationWriteContext.h"
+
+namespace OpcUaStackCore
+{
+
+	//
+	// all items of a write request that are registered with the same batch
+	// write callback. The application sets the status code of each item; the
+	// value of an item with status Success is written into the node. An item
+	// can be completed asynchronously with ApplicationWriteContext::asyncCompletion().
+	//
+	class DLLEXPORT ApplicationWriteBatchContext
+	{
+	  public:
+		typedef std::vector<ApplicationWriteContext> WriteContextVec;
+
+		ApplicationWriteBatchContext(void);
+		~ApplicationWriteBatchContext(void);
+
+		BaseClass::SPtr applicationContext_;	// IN - application context from register call
+		UserContext::SPtr userContext_;			// IN - user context
+		WriteContextVec writeContextVec_;		// IN/OUT - write context of each item
+	};
+
+}
+
+#endif
@@ -27,6 +27,8 @@ namespace OpcUaStackCore
 	, userContext_()
 	, dataValue_()
 	, statusCode_(Success)
+	, completionFactory_()
+	, completion_()
 	{
 	}
 
@@ -34,4 +36,16 @@ namespace OpcUaStackCore
 	{
 	}
 
+	ApplicationCompletion::SPtr
+	ApplicationWriteContext::asyncCompletion(void)
+	{
+		if (completionFactory_.empty()) {
+			return ApplicationCompletion::SPtr();
+		}
+		if (completion_.get() == nullptr) {
+			completion_ = completionFactory_();
+		}
+		return completion_;
+	}
+
 }
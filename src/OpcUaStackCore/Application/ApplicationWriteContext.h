@@ -21,6 +21,7 @@
 #include "OpcUaStackCore/Base/os.h"
 #include "OpcUaStackCore/Base/BaseClass.h"
 #include "OpcUaStackCore/Base/UserContext.h"
+#include "OpcUaStackCore/Application/ApplicationCompletion.h"
 #include "OpcUaStackCore/BuildInTypes/OpcUaNodeId.h"
 #include "OpcUaStackCore/BuildInTypes/OpcUaDataValue.h"
 #include "OpcUaStackCore/BuildInTypes/OpcUaStatusCode.h"
@@ -40,6 +41,15 @@ namespace OpcUaStackCore
 		OpcUaDataValue dataValue_;				// IN - variable
 		UserContext::SPtr userContext_;			// IN - user context
 		OpcUaStatusCode statusCode_;			// OUT - result state of the write operation
+
+		// asynchronous write. The application calls asyncCompletion() in the
+		// callback, returns and completes the write later with the token.
+		// statusCode_ is not used in this case.
+		// asyncCompletion() is only valid in the thread of the callback and
+		// before the callback returns. Only the token may be used later.
+		ApplicationCompletion::SPtr asyncCompletion(void);
+		ApplicationCompletion::Factory completionFactory_;	// IN - creates the completion token (empty = not supported)
+		ApplicationCompletion::SPtr completion_;			// OUT - completion token of an asynchronous write
 	};
 
 }
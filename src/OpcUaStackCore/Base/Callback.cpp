@@ -65,6 +65,14 @@ namespace OpcUaStackCore
 		callbackBaseSPtr_.reset();
 	}
 
+	CallbackBase*
+	Callback::callbackBase(void) const
+	{
+		// copies of a callback share the handler, so the pointer identifies
+		// the callback
+		return callbackBaseSPtr_.get();
+	}
+
 	void Callback::operator()(void) const
 	{
 		CallbackParameter0<void> *callbackParameter = static_cast<CallbackParameter0<void>* >(callbackBaseSPtr_.get());
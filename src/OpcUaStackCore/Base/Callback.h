@@ -459,6 +459,7 @@ namespace OpcUaStackCore
 
 		bool exist(void);
 		void reset(void);
+		CallbackBase* callbackBase(void) const;
 		template<typename R, typename F>
 	      void reset(boost::_bi::bind_t<R,boost::_mfi::mf0<R,F>,boost::_bi::list1<boost::_bi::value<F*> > > handler);
 		template<typename R, typename F, typename V1>
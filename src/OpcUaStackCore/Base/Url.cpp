@@ -200,6 +200,46 @@ namespace OpcUaStackCore
 		return !isLocalAddress() && !isIPAddress();
 	}
 
+	bool
+	Url::isUnixSocket(void) const
+	{
+		return protocol_ == "opc.unix";
+	}
+
+	bool
+	Url::isSharedMemory(void) const
+	{
+		return protocol_ == "opc.shm";
+	}
+
+	bool
+	Url::isMemory(void) const
+	{
+		return protocol_ == "opc.mem";
+	}
+
+	std::string
+	Url::unixSocketPath(void)
+	{
+		// opc.unix:///var/run/opcua.sock or opc.unix://localhost/var/run/opcua.sock
+		return "/" + path_;
+	}
+
+	std::string
+	Url::memoryName(void)
+	{
+		// opc.mem://server or opc.mem://server:4841/path
+		std::stringstream ss;
+		ss << host_;
+		if (port_ != -1) {
+			ss << ":" << port_;
+		}
+		if (path_ != "") {
+			ss << "/" << path_;
+		}
+		return ss.str();
+	}
+
 	bool
 	Url::normalizeHost(void)
 	{
@@ -53,6 +53,11 @@ namespace OpcUaStackCore
 		bool isAnyAddress(void);
 		bool isIPAddress(void);
 		bool isHostAddress(void);
+		bool isUnixSocket(void) const;
+		bool isSharedMemory(void) const;
+		bool isMemory(void) const;
+		std::string unixSocketPath(void);
+		std::string memoryName(void);
 	  
 	  private:
 		bool normalizeHost(void);
@@ -0,0 +1,163 @@
+/*
+   Copyright 2015 Kai Huebl (kai@huebl-sgh.de)
+
+   Lizenziert gemäß Apache Licence Version 2.0 (die „Lizenz“); Nutzung dieser
+   Datei nur in Übereinstimmung mit der Lizenz erlaubt.
+   Eine Kopie der Lizenz erhalten Sie auf http://www.apache.org/licenses/LICENSE-2.0.
+
+   Sofern nicht gemäß geltendem Recht vorgeschrieben oder schriftlich vereinbart,
+   erfolgt die Bereitstellung der im Rahmen der Lizenz verbreiteten Software OHNE
+   GEWÄHR ODER VORBEHALTE – ganz gleich, ob ausdrücklich oder stillschweigend.
+
+   Informationen über die jeweiligen Bedingungen für Genehmigungen und Einschränkungen
+   im Rahmen der Lizenz finden Sie in der Lizenz.
+
+   Autor: Kai Huebl (kai@huebl-sgh.de)
+ */
+
+
+#include <boost/bind.hpp>
+#include "OpcUaStackCore/Base/WorkerPool.h"
+#include "OpcUaStackCore/Base/Log.h"
+
+namespace OpcUaStackCore
+{
+
+	static thread_local bool workerPoolThread = false;
+
+	WorkerPool::WorkerPool(const std::string& name)
+	: name_(name)
+	, ioService_()
+	, numberThreads_(0)
+	, mutex_()
+	, queueCondition_()
+	, maxQueueLength_(0)
+	, queueLength_(0)
+	, maxQueueLengthObserved_(0)
+	, rejectCount_(0)
+	{
+	}
+
+	WorkerPool::~WorkerPool(void)
+	{
+		shutdown();
+	}
+
+	void
+	WorkerPool::startup(uint32_t numberThreads, uint32_t maxQueueLength)
+	{
+		if (numberThreads == 0) return;
+		ioService_.start(numberThreads);
+
+		boost::mutex::scoped_lock g(mutex_);
+		maxQueueLength_ = maxQueueLength;
+		numberThreads_ = numberThreads;
+	}
+
+	void
+	WorkerPool::shutdown(void)
+	{
+		{
+			// further tasks are rejected
+			boost::mutex::scoped_lock g(mutex_);
+			if (numberThreads_ == 0) return;
+			numberThreads_ = 0;
+		}
+
+		// the queued tasks are finished before the threads are stopped,
+		// because the owner of a task waits for its completion
+		{
+			boost::mutex::scoped_lock g(mutex_);
+			while (queueLength_ > 0) {
+				queueCondition_.wait(g);
+			}
+		}
+
+		ioService_.stop();
+	}
+
+	bool
+	WorkerPool::post(const Task& task)
+	{
+		{
+			boost::mutex::scoped_lock g(mutex_);
+
+			if (numberThreads_ == 0) return false;
+
+			// the queue length contains the waiting and the running tasks
+			if (maxQueueLength_ != 0 && queueLength_ >= maxQueueLength_) {
+				rejectCount_++;
+				Log(Warning, "worker pool overload; reject task")
+					.parameter("WorkerPool", name_)
+					.parameter("QueueLength", queueLength_)
+					.parameter("RejectCount", rejectCount_);
+				return false;
+			}
+
+			queueLength_++;
+			if (queueLength_ > maxQueueLengthObserved_) {
+				maxQueueLengthObserved_ = queueLength_;
+			}
+		}
+
+		ioService_.run(boost::bind(&WorkerPool::runTask, this, task));
+		return true;
+	}
+
+	void
+	WorkerPool::runTask(const Task& task)
+	{
+		workerPoolThread = true;
+		task();
+
+		boost::mutex::scoped_lock g(mutex_);
+		if (queueLength_ > 0) queueLength_--;
+		if (queueLength_ == 0) queueCondition_.notify_all();
+	}
+
+	bool
+	WorkerPool::runningInWorkerPool(void)
+	{
+		return workerPoolThread;
+	}
+
+	std::string&
+	WorkerPool::name(void)
+	{
+		return name_;
+	}
+
+	uint32_t
+	WorkerPool::numberThreads(void)
+	{
+		return numberThreads_;
+	}
+
+	uint32_t
+	WorkerPool::maxQueueLength(void)
+	{
+		return maxQueueLength_;
+	}
+
+	uint32_t
+	WorkerPool::queueLength(void)
+	{
+		boost::mutex::scoped_lock g(mutex_);
+		return queueLength_;
+	}
+
+	uint32_t
+	WorkerPool::maxQueueLengthObserved(void)
+	{
+		boost::mutex::scoped_lock g(mutex_);
+		return maxQueueLengthObserved_;
+	}
+
+	uint64_t
+	WorkerPool::rejectCount(void)
+	{
+		boost::mutex::scoped_lock g(mutex_);
+		return rejectCount_;
+	}
+
+}
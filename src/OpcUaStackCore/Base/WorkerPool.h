@@ -0,0 +1,79 @@
+/*
+   Copyright 2015 Kai Huebl (kai@huebl-sgh.de)
+
+   Lizenziert gemäß Apache Licence Version 2.0 (die „Lizenz“); Nutzung dieser
+   Datei nur in Übereinstimmung mit der Lizenz erlaubt.
+   Eine Kopie der Lizenz erhalten Sie auf http://www.apache.org/licenses/LICENSE-2.0.
+
+   Sofern nicht gemäß geltendem Recht vorgeschrieben oder schriftlich vereinbart,
+   erfolgt die Bereitstellung der im Rahmen der Lizenz verbreiteten Software OHNE
+   GEWÄHR ODER VORBEHALTE – ganz gleich, ob ausdrücklich oder stillschweigend.
+
+   Informationen über die jeweiligen Bedingungen für Genehmigungen und Einschränkungen
+   im Rahmen der Lizenz finden Sie in der Lizenz.
+
+   Autor: Kai Huebl (kai@huebl-sgh.de)
+ */
+
+#ifndef __OpcUaStackCore_WorkerPool_h__
+#define __OpcUaStackCore_WorkerPool_h__
+
+#include <string>
+#include <boost/shared_ptr.hpp>
+#include <boost/function.hpp>
+#include <boost/thread/mutex.hpp>
+#include <boost/thread/condition.hpp>
+#include "OpcUaStackCore/Base/os.h"
+#include "OpcUaStackCore/Base/IOService.h"
+
+namespace OpcUaStackCore
+{
+
+	//
+	// bounded pool of worker threads. Tasks are executed in the order of
+	// arrival. A task is rejected if the maximum queue length is reached,
+	// so that the caller can reject the work instead of piling it up.
+	//
+	class DLLEXPORT WorkerPool
+	{
+	  public:
+		typedef boost::shared_ptr<WorkerPool> SPtr;
+		typedef boost::function<void (void)> Task;
+
+		WorkerPool(const std::string& name);
+		~WorkerPool(void);
+
+		void startup(uint32_t numberThreads, uint32_t maxQueueLength);
+		// rejects further tasks and waits until the queued tasks are
+		// finished. Must not be called by a thread of the pool
+		void shutdown(void);
+		bool post(const Task& task);
+
+		// true if the calling thread is a thread of a worker pool
+		static bool runningInWorkerPool(void);
+
+		std::string& name(void);
+		uint32_t numberThreads(void);
+		uint32_t maxQueueLength(void);
+		uint32_t queueLength(void);
+		uint32_t maxQueueLengthObserved(void);
+		uint64_t rejectCount(void);
+
+	  private:
+		void runTask(const Task& task);
+
+		std::string name_;
+		IOService ioService_;
+		uint32_t numberThreads_;
+
+		boost::mutex mutex_;
+		boost::condition queueCondition_;
+		uint32_t maxQueueLength_;
+		uint32_t queueLength_;
+		uint32_t maxQueueLengthObserved_;
+		uint64_t rejectCount_;
+	};
+
+}
+
+#endif
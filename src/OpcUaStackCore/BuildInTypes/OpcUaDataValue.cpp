@@ -17,6 +17,7 @@
 
 #include "OpcUaStackCore/BuildInTypes/OpcUaDataValue.h"
 #include "OpcUaStackCore/Base/Utility.h"
+#include "OpcUaStackCore/ServiceSet/TimestampsToReturn.h"
 
 namespace OpcUaStackCore
 {
@@ -170,6 +171,21 @@ namespace OpcUaStackCore
 		serverPicoseconds_ = 0;
 	}
 
+	void
+	OpcUaDataValue::timestampsToReturn(OpcUaInt32 timestampsToReturn)
+	{
+		if (timestampsToReturn == TimestampsToReturn_Server ||
+			timestampsToReturn == TimestampsToReturn_Neither) {
+			sourceTimestamp_ = 0;
+			sourcePicoseconds_ = 0;
+		}
+		if (timestampsToReturn == TimestampsToReturn_Source ||
+			timestampsToReturn == TimestampsToReturn_Neither) {
+			serverTimestamp_ = 0;
+			serverPicoseconds_ = 0;
+		}
+	}
+
 	void 
 	OpcUaDataValue::out(std::ostream& os) const
 	{
@@ -270,6 +286,12 @@ namespace OpcUaStackCore
 
 	void 
 	OpcUaDataValue::opcUaBinaryEncode(std::ostream& os) const
+	{
+		opcUaBinaryEncode(os, TimestampsToReturn_Both);
+	}
+
+	void
+	OpcUaDataValue::opcUaBinaryEncode(std::ostream& os, OpcUaInt32 timestampsToReturn) const
 	{
 		OpcUaByte encodingMask = 0x00;
 
@@ -292,23 +314,32 @@ namespace OpcUaStackCore
 			encodingMask += 0x20;
 		}
 
+		if (timestampsToReturn == TimestampsToReturn_Server ||
+			timestampsToReturn == TimestampsToReturn_Neither) {
+			encodingMask &= ~(0x04 | 0x10);
+		}
+		if (timestampsToReturn == TimestampsToReturn_Source ||
+			timestampsToReturn == TimestampsToReturn_Neither) {
+			encodingMask &= ~(0x08 | 0x20);
+		}
+
 		OpcUaNumber::opcUaBinaryEncode(os,encodingMask);
-		if (opcUaVariantSPtr_.get() != NULL) {
+		if ((encodingMask & 0x01) == 0x01) {
 			opcUaVariantSPtr_->opcUaBinaryEncode(os);
 		}
-		if (opcUaStatusCode_ != 0) {
+		if ((encodingMask & 0x02) == 0x02) {
 			OpcUaNumber::opcUaBinaryEncode(os,opcUaStatusCode_);
 		}
-		if (sourceTimestamp_.exist()) {
+		if ((encodingMask & 0x04) == 0x04) {
 			sourceTimestamp_.opcUaBinaryEncode(os);
 		}
-		if (sourcePicoseconds_ != 0) {
+		if ((encodingMask & 0x10) == 0x10) {
 			OpcUaNumber::opcUaBinaryEncode(os,sourcePicoseconds_);
 		}
-		if (serverTimestamp_.exist()) {
+		if ((encodingMask & 0x08) == 0x08) {
 			serverTimestamp_.opcUaBinaryEncode(os);
 		}
-		if (serverPicoseconds_ != 0) {
+		if ((encodingMask & 0x20) == 0x20) {
 			OpcUaNumber::opcUaBinaryEncode(os,serverPicoseconds_);
 		}
 	}
@@ -56,6 +56,10 @@ namespace OpcUaStackCore
 		OpcUaInt16 serverPicoseconds(void);
 		void reset(void);
 
+		// removes the timestamps which are not requested by the client. Only
+		// used on a copy which is owned by the response.
+		void timestampsToReturn(OpcUaInt32 timestampsToReturn);
+
 		void copyFrom(OpcUaDataValue& dataValue);
 		void copyTo(OpcUaDataValue& dataValue);
 		bool operator!=(const OpcUaDataValue& opcUaDataValue) const;
@@ -70,6 +74,9 @@ namespace OpcUaStackCore
 		}
 
 		void opcUaBinaryEncode(std::ostream& os) const;
+		// the timestamps which are not requested by the client are removed
+		// from the encoding mask. The value is not changed
+		void opcUaBinaryEncode(std::ostream& os, OpcUaInt32 timestampsToReturn) const;
 		void opcUaBinaryDecode(std::istream& is);
 		bool encode(boost::property_tree::ptree& pt) const;
 		bool decode(boost::property_tree::ptree& pt, OpcUaBuildInType type, bool isArray);
@@ -714,6 +714,11 @@ namespace OpcUaStackCore
 	    return true;
 	}
 
+	Certificate::operator X509*(void)
+	{
+		return cert_;
+	}
+
 	PublicKey
 	Certificate::publicKey(void)
 	{
@@ -88,6 +88,8 @@ namespace OpcUaStackCore
 
 		bool isSelfSigned(void) const;
 
+		operator X509*(void);
+
 	  private:
 		X509 *cert_;
 	};
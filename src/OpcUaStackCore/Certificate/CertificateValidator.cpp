@@ -0,0 +1,464 @@
+/*
+   Copyright 2015 Kai Huebl (kai@huebl-sgh.de)
+
+   Lizenziert gemäß Apache Licence Version 2.0 (die „Lizenz“); Nutzung dieser
+   Datei nur in Übereinstimmung mit der Lizenz erlaubt.
+   Eine Kopie der Lizenz erhalten Sie auf http://www.apache.org/licenses/LICENSE-2.0.
+
+   Sofern nicht gemäß geltendem Recht vorgeschrieben oder schriftlich vereinbart,
+   erfolgt die Bereitstellung der im Rahmen der Lizenz verbreiteten Software OHNE
+   GEWÄHR ODER VORBEHALTE – ganz gleich, ob ausdrücklich oder stillschweigend.
+
+   Informationen über die jeweiligen Bedingungen für Genehmigungen und Einschränkungen
+   im Rahmen der Lizenz finden Sie in der Lizenz.
+
+   Autor: Kai Huebl (kai@huebl-sgh.de)
+ */
+
+
+#include <boost/filesystem.hpp>
+#include <boost/functional/hash.hpp>
+#include <openssl/err.h>
+#include "OpcUaStackCore/Base/Log.h"
+#include "OpcUaStackCore/Certificate/CertificateValidator.h"
+
+namespace OpcUaStackCore
+{
+
+	CertificateValidator::CertificateValidator(void)
+	: certificateTrustListLocation_("")
+	, certificateRevocationListLocation_("")
+	, issuersCertificatesLocation_("")
+	, issuersRevocationListLocation_("")
+	, cacheTimeout_(300)
+	, maxCacheEntries_(1000)
+	, mutex_()
+	, store_()
+	, issuers_()
+	, generation_(0)
+	, directoriesHash_(0)
+	, nextDirectoryCheck_()
+	, cacheMap_()
+	, cacheHits_(0)
+	, cacheMisses_(0)
+	{
+	}
+
+	CertificateValidator::~CertificateValidator(void)
+	{
+	}
+
+	void
+	CertificateValidator::certificateTrustListLocation(const std::string& certificateTrustListLocation)
+	{
+		certificateTrustListLocation_ = certificateTrustListLocation;
+	}
+
+	void
+	CertificateValidator::certificateRevocationListLocation(const std::string& certificateRevocationListLocation)
+	{
+		certificateRevocationListLocation_ = certificateRevocationListLocation;
+	}
+
+	void
+	CertificateValidator::issuersCertificatesLocation(const std::string& issuersCertificatesLocation)
+	{
+		issuersCertificatesLocation_ = issuersCertificatesLocation;
+	}
+
+	void
+	CertificateValidator::issuersRevocationListLocation(const std::string& issuersRevocationListLocation)
+	{
+		issuersRevocationListLocation_ = issuersRevocationListLocation;
+	}
+
+	void
+	CertificateValidator::cacheTimeout(uint32_t cacheTimeout)
+	{
+		cacheTimeout_ = cacheTimeout;
+	}
+
+	uint32_t
+	CertificateValidator::cacheTimeout(void)
+	{
+		return cacheTimeout_;
+	}
+
+	void
+	CertificateValidator::maxCacheEntries(uint32_t maxCacheEntries)
+	{
+		maxCacheEntries_ = maxCacheEntries;
+	}
+
+	uint32_t
+	CertificateValidator::maxCacheEntries(void)
+	{
+		return maxCacheEntries_;
+	}
+
+	uint32_t
+	CertificateValidator::generation(void)
+	{
+		boost::mutex::scoped_lock g(mutex_);
+		return generation_;
+	}
+
+	uint32_t
+	CertificateValidator::cacheSize(void)
+	{
+		boost::mutex::scoped_lock g(mutex_);
+		return cacheMap_.size();
+	}
+
+	uint64_t
+	CertificateValidator::cacheHits(void)
+	{
+		boost::mutex::scoped_lock g(mutex_);
+		return cacheHits_;
+	}
+
+	uint64_t
+	CertificateValidator::cacheMisses(void)
+	{
+		boost::mutex::scoped_lock g(mutex_);
+		return cacheMisses_;
+	}
+
+	void
+	CertificateValidator::invalidate(void)
+	{
+		boost::mutex::scoped_lock g(mutex_);
+
+		generation_++;
+		store_.reset();
+		issuers_.reset();
+		cacheMap_.clear();
+		nextDirectoryCheck_ = boost::posix_time::ptime();
+	}
+
+	OpcUaStatusCode
+	CertificateValidator::validate(Certificate& certificate)
+	{
+		// the thumbprint of the certificate is the key of the cache
+		char thumbPrint[20];
+		uint32_t thumbPrintLen = 20;
+		if (!certificate.thumbPrint(thumbPrint, &thumbPrintLen)) {
+			return BadCertificateInvalid;
+		}
+		std::string key(thumbPrint, thumbPrintLen);
+
+		boost::posix_time::ptime now = boost::posix_time::microsec_clock::universal_time();
+		StoreSPtr store;
+		CertificateStackSPtr issuers;
+		uint32_t generation;
+
+		{
+			boost::mutex::scoped_lock g(mutex_);
+			checkDirectories(now);
+
+			// find validation result in cache
+			CacheMap::iterator it = cacheMap_.find(key);
+			if (it != cacheMap_.end()) {
+				if (it->second.generation_ == generation_ && it->second.expireTime_ > now) {
+					cacheHits_++;
+					return it->second.statusCode_;
+				}
+				cacheMap_.erase(it);
+			}
+			cacheMisses_++;
+
+			if (store_.get() == nullptr) {
+				store_ = createStore();
+				issuers_ = createIssuers();
+			}
+			store = store_;
+			issuers = issuers_;
+			generation = generation_;
+		}
+
+		// the verification is done without lock
+		OpcUaStatusCode statusCode = verify(store, issuers, certificate);
+
+		boost::mutex::scoped_lock g(mutex_);
+
+		// the PKI directories have been changed during the verification
+		if (generation != generation_ || cacheTimeout_ == 0) {
+			return statusCode;
+		}
+
+		// remove expired entries if the cache is full
+		if (maxCacheEntries_ != 0 && cacheMap_.size() >= maxCacheEntries_) {
+			CacheMap::iterator it = cacheMap_.begin();
+			while (it != cacheMap_.end()) {
+				if (it->second.expireTime_ <= now) {
+					cacheMap_.erase(it++);
+				}
+				else {
+					it++;
+				}
+			}
+			if (cacheMap_.size() >= maxCacheEntries_) {
+				cacheMap_.clear();
+			}
+		}
+
+		CacheEntry& cacheEntry = cacheMap_[key];
+		cacheEntry.statusCode_ = statusCode;
+		cacheEntry.generation_ = generation;
+		cacheEntry.expireTime_ = expireTime(certificate, now);
+
+		return statusCode;
+	}
+
+	void
+	CertificateValidator::checkDirectories(boost::posix_time::ptime& now)
+	{
+		// the directories are checked at most once per second
+		if (!nextDirectoryCheck_.is_not_a_date_time() && now < nextDirectoryCheck_) {
+			return;
+		}
+		nextDirectoryCheck_ = now + boost::posix_time::seconds(1);
+
+		std::size_t hash = 0;
+		hashDirectory(certificateTrustListLocation_, hash);
+		hashDirectory(certificateRevocationListLocation_, hash);
+		hashDirectory(issuersCertificatesLocation_, hash);
+		hashDirectory(issuersRevocationListLocation_, hash);
+		if (hash == directoriesHash_) {
+			return;
+		}
+
+		Log(Info, "PKI directories changed; invalidate certificate validation cache")
+			.parameter("Generation", generation_ + 1);
+
+		directoriesHash_ = hash;
+		generation_++;
+		store_.reset();
+		issuers_.reset();
+		cacheMap_.clear();
+	}
+
+	void
+	CertificateValidator::hashDirectory(const std::string& directory, std::size_t& hash)
+	{
+		if (directory.empty()) {
+			return;
+		}
+
+		boost::system::error_code ec;
+		boost::filesystem::directory_iterator it(directory, ec);
+		boost::filesystem::directory_iterator end;
+		for (; !ec && it != end; it.increment(ec)) {
+			boost::filesystem::path path = it->path();
+			if (!boost::filesystem::is_regular_file(path, ec)) {
+				continue;
+			}
+
+			// the order of the directory entries is not relevant
+			std::size_t fileHash = 0;
+			boost::hash_combine(fileHash, path.string());
+			boost::hash_combine(fileHash, boost::filesystem::last_write_time(path, ec));
+			boost::hash_combine(fileHash, boost::filesystem::file_size(path, ec));
+			hash += fileHash;
+		}
+	}
+
+	CertificateValidator::StoreSPtr
+	CertificateValidator::createStore(void)
+	{
+		StoreSPtr store(X509_STORE_new(), X509_STORE_free);
+
+		// each certificate in the trust list is a trust anchor. The issuer
+		// certificates are not trusted, they are passed to the verification
+		// as untrusted chain
+		loadCertificates(store.get(), certificateTrustListLocation_);
+
+		uint32_t numberRevocationLists = 0;
+		numberRevocationLists += loadRevocationLists(store.get(), certificateRevocationListLocation_);
+		numberRevocationLists += loadRevocationLists(store.get(), issuersRevocationListLocation_);
+
+		unsigned long flags = X509_V_FLAG_PARTIAL_CHAIN;
+		if (numberRevocationLists > 0) {
+			flags |= X509_V_FLAG_CRL_CHECK;
+		}
+		X509_STORE_set_flags(store.get(), flags);
+
+		return store;
+	}
+
+	void
+	CertificateValidator::loadCertificates(X509_STORE* store, const std::string& directory)
+	{
+		if (directory.empty()) {
+			return;
+		}
+
+		boost::system::error_code ec;
+		boost::filesystem::directory_iterator it(directory, ec);
+		boost::filesystem::directory_iterator end;
+		for (; !ec && it != end; it.increment(ec)) {
+			boost::filesystem::path path = it->path();
+			if (!boost::filesystem::is_regular_file(path, ec)) {
+				continue;
+			}
+
+			Certificate certificate;
+			if (!certificate.fromDERFile(path.string())) {
+				Log(Warning, "read certificate file error")
+					.parameter("FileName", path.string());
+				continue;
+			}
+
+			// an already existing certificate is ignored
+			X509_STORE_add_cert(store, certificate);
+		}
+		ERR_clear_error();
+	}
+
+	static void
+	freeCertificateStack(STACK_OF(X509)* stack)
+	{
+		sk_X509_pop_free(stack, X509_free);
+	}
+
+	CertificateValidator::CertificateStackSPtr
+	CertificateValidator::createIssuers(void)
+	{
+		CertificateStackSPtr issuers(sk_X509_new_null(), freeCertificateStack);
+		loadCertificates(issuers.get(), issuersCertificatesLocation_);
+		return issuers;
+	}
+
+	void
+	CertificateValidator::loadCertificates(STACK_OF(X509)* stack, const std::string& directory)
+	{
+		if (directory.empty()) {
+			return;
+		}
+
+		boost::system::error_code ec;
+		boost::filesystem::directory_iterator it(directory, ec);
+		boost::filesystem::directory_iterator end;
+		for (; !ec && it != end; it.increment(ec)) {
+			boost::filesystem::path path = it->path();
+			if (!boost::filesystem::is_regular_file(path, ec)) {
+				continue;
+			}
+
+			Certificate certificate;
+			if (!certificate.fromDERFile(path.string())) {
+				Log(Warning, "read certificate file error")
+					.parameter("FileName", path.string());
+				continue;
+			}
+
+			// the stack holds its own reference of the certificate
+			X509* cert = certificate;
+			X509_up_ref(cert);
+			if (sk_X509_push(stack, cert) == 0) {
+				X509_free(cert);
+			}
+		}
+		ERR_clear_error();
+	}
+
+	uint32_t
+	CertificateValidator::loadRevocationLists(X509_STORE* store, const std::string& directory)
+	{
+		uint32_t numberRevocationLists = 0;
+		if (directory.empty()) {
+			return numberRevocationLists;
+		}
+
+		boost::system::error_code ec;
+		boost::filesystem::directory_iterator it(directory, ec);
+		boost::filesystem::directory_iterator end;
+		for (; !ec && it != end; it.increment(ec)) {
+			boost::filesystem::path path = it->path();
+			if (!boost::filesystem::is_regular_file(path, ec)) {
+				continue;
+			}
+
+			BIO* bio = BIO_new_file(path.string().c_str(), "rb");
+			if (bio == nullptr) {
+				continue;
+			}
+			X509_CRL* crl = d2i_X509_CRL_bio(bio, nullptr);
+			BIO_free(bio);
+			if (crl == nullptr) {
+				Log(Warning, "read revocation list file error")
+					.parameter("FileName", path.string());
+				continue;
+			}
+
+			X509_STORE_add_crl(store, crl);
+			X509_CRL_free(crl);
+			numberRevocationLists++;
+		}
+		ERR_clear_error();
+
+		return numberRevocationLists;
+	}
+
+	OpcUaStatusCode
+	CertificateValidator::verify(StoreSPtr& store, CertificateStackSPtr& issuers, Certificate& certificate)
+	{
+		X509_STORE_CTX* ctx = X509_STORE_CTX_new();
+		if (ctx == nullptr) {
+			return BadOutOfMemory;
+		}
+		if (X509_STORE_CTX_init(ctx, store.get(), certificate, issuers.get()) != 1) {
+			X509_STORE_CTX_free(ctx);
+			ERR_clear_error();
+			return BadInternalError;
+		}
+
+		int32_t result = X509_verify_cert(ctx);
+		int32_t error = X509_STORE_CTX_get_error(ctx);
+		int32_t depth = X509_STORE_CTX_get_error_depth(ctx);
+		X509_STORE_CTX_free(ctx);
+		ERR_clear_error();
+
+		if (result == 1) {
+			return Success;
+		}
+
+		Log(Info, "certificate validation error")
+			.parameter("Error", X509_verify_cert_error_string(error))
+			.parameter("Depth", depth);
+
+		switch (error)
+		{
+			case X509_V_ERR_CERT_NOT_YET_VALID:
+			case X509_V_ERR_CERT_HAS_EXPIRED:
+				return depth == 0 ? BadCertificateTimeInvalid : BadCertificateIssuerTimeInvalid;
+			case X509_V_ERR_CERT_REVOKED:
+				return depth == 0 ? BadCertificateRevoked : BadCertificateIssuerRevoked;
+			case X509_V_ERR_UNABLE_TO_GET_CRL:
+				return depth == 0 ? BadCertificateRevocationUnknown : BadCertificateIssuerRevocationUnknown;
+			default:
+				return BadCertificateUntrusted;
+		}
+	}
+
+	boost::posix_time::ptime
+	CertificateValidator::expireTime(Certificate& certificate, boost::posix_time::ptime& now)
+	{
+		boost::posix_time::ptime expireTime = now + boost::posix_time::seconds(cacheTimeout_);
+
+		// a result is not cached beyond the end of the validity period
+		struct tm notAfter;
+		const ASN1_TIME* time = X509_get0_notAfter(certificate);
+		if (time == nullptr || ASN1_TIME_to_tm(time, &notAfter) != 1) {
+			ERR_clear_error();
+			return now;
+		}
+
+		boost::posix_time::ptime notAfterTime = boost::posix_time::ptime_from_tm(notAfter);
+		if (notAfterTime < expireTime) {
+			expireTime = notAfterTime;
+		}
+		return expireTime;
+	}
+
+}
@@ -0,0 +1,113 @@
+/*
+   Copyright 2015 Kai Huebl (kai@huebl-sgh.de)
+
+   Lizenziert gemäß Apache Licence Version 2.0 (die „Lizenz“); Nutzung dieser
+   Datei nur in Übereinstimmung mit der Lizenz erlaubt.
+   Eine Kopie der Lizenz erhalten Sie auf http://www.apache.org/licenses/LICENSE-2.0.
+
+   Sofern nicht gemäß geltendem Recht vorgeschrieben oder schriftlich vereinbart,
+   erfolgt die Bereitstellung der im Rahmen der Lizenz verbreiteten Software OHNE
+   GEWÄHR ODER VORBEHALTE – ganz gleich, ob ausdrücklich oder stillschweigend.
+
+   Informationen über die jeweiligen Bedingungen für Genehmigungen und Einschränkungen
+   im Rahmen der Lizenz finden Sie in der Lizenz.
+
+   Autor: Kai Huebl (kai@huebl-sgh.de)
+ */
+
+
+#ifndef __OpcUaStackCore_CertificateValidator_h__
+#define __OpcUaStackCore_CertificateValidator_h__
+
+#include <boost/shared_ptr.hpp>
+#include <boost/thread/mutex.hpp>
+#include <boost/date_time/posix_time/posix_time.hpp>
+#include <map>
+#include <string>
+#include <openssl/x509.h>
+#include "OpcUaStackCore/Base/os.h"
+#include "OpcUaStackCore/BuildInTypes/OpcUaStatusCode.h"
+#include "OpcUaStackCore/Certificate/Certificate.h"
+
+namespace OpcUaStackCore
+{
+
+	//
+	// validates partner certificates against the trust list, the issuer
+	// certificates and the revocation lists of the PKI directories. Only
+	// the certificates of the trust list are trust anchors, the issuer
+	// certificates are used to build the chain. The results are cached by
+	// certificate thumbprint and generation of the PKI directories, but
+	// not beyond the end of the validity period of the certificate. The
+	// generation is incremented if a file in one of the directories is
+	// added, removed or modified.
+	//
+	class DLLEXPORT CertificateValidator
+	{
+	  public:
+		typedef boost::shared_ptr<CertificateValidator> SPtr;
+
+		CertificateValidator(void);
+		~CertificateValidator(void);
+
+		void certificateTrustListLocation(const std::string& certificateTrustListLocation);
+		void certificateRevocationListLocation(const std::string& certificateRevocationListLocation);
+		void issuersCertificatesLocation(const std::string& issuersCertificatesLocation);
+		void issuersRevocationListLocation(const std::string& issuersRevocationListLocation);
+		void cacheTimeout(uint32_t cacheTimeout);
+		uint32_t cacheTimeout(void);
+		void maxCacheEntries(uint32_t maxCacheEntries);
+		uint32_t maxCacheEntries(void);
+
+		OpcUaStatusCode validate(Certificate& certificate);
+		void invalidate(void);
+
+		uint32_t generation(void);
+		uint32_t cacheSize(void);
+		uint64_t cacheHits(void);
+		uint64_t cacheMisses(void);
+
+	  private:
+		typedef boost::shared_ptr<X509_STORE> StoreSPtr;
+		typedef boost::shared_ptr<STACK_OF(X509)> CertificateStackSPtr;
+
+		class CacheEntry
+		{
+		  public:
+			OpcUaStatusCode statusCode_;
+			uint32_t generation_;
+			boost::posix_time::ptime expireTime_;
+		};
+		typedef std::map<std::string, CacheEntry> CacheMap;
+
+		void checkDirectories(boost::posix_time::ptime& now);
+		void hashDirectory(const std::string& directory, std::size_t& hash);
+		StoreSPtr createStore(void);
+		CertificateStackSPtr createIssuers(void);
+		void loadCertificates(X509_STORE* store, const std::string& directory);
+		void loadCertificates(STACK_OF(X509)* stack, const std::string& directory);
+		uint32_t loadRevocationLists(X509_STORE* store, const std::string& directory);
+		OpcUaStatusCode verify(StoreSPtr& store, CertificateStackSPtr& issuers, Certificate& certificate);
+		boost::posix_time::ptime expireTime(Certificate& certificate, boost::posix_time::ptime& now);
+
+		std::string certificateTrustListLocation_;
+		std::string certificateRevocationListLocation_;
+		std::string issuersCertificatesLocation_;
+		std::string issuersRevocationListLocation_;
+		uint32_t cacheTimeout_;
+		uint32_t maxCacheEntries_;
+
+		boost::mutex mutex_;
+		StoreSPtr store_;
+		CertificateStackSPtr issuers_;
+		uint32_t generation_;
+		std::size_t directoriesHash_;
+		boost::posix_time::ptime nextDirectoryCheck_;
+		CacheMap cacheMap_;
+		uint64_t cacheHits_;
+		uint64_t cacheMisses_;
+	};
+
+}
+
+#endif
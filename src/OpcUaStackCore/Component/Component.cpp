@@ -40,12 +40,20 @@ namespace OpcUaStackCore
 	void 
 	Component::removeComponent(Component& component)
 	{
-		removeComponent(component.componentName());
+		// more than one component can use the same name (e.g. sessions).
+		// Only the own entry is removed
+		boost::mutex::scoped_lock g(globalMutex_);
+		ComponentMap::iterator it = componentMap_.find(component.componentName_);
+		if (it == componentMap_.end() || it->second != &component) {
+			return;
+		}
+		componentMap_.erase(it);
 	}
 
 	Component* 
 	Component::getComponent(const std::string& componentName)
 	{
+		boost::mutex::scoped_lock g(globalMutex_);
 		ComponentMap::iterator it;
 		it = componentMap_.find(componentName);
 		if (it == componentMap_.end()) {
@@ -55,14 +63,16 @@ namespace OpcUaStackCore
 	}
 
 	Component::Component(void)
-	: ioThread_(nullptr)
-	, mutex_()
+	: componentName_()
+	, ioThread_(nullptr)
+	, workerPool_()
+	, mailbox_()
 	{
 	}
 
 	Component::~Component(void)
 	{
-		removeComponent(componentName_);
+		removeComponent(*this);
 	}
 
 	void
@@ -102,8 +112,34 @@ namespace OpcUaStackCore
 		return this;
 	}
 
+	void
+	Component::workerPool(WorkerPool::SPtr& workerPool)
+	{
+		workerPool_ = workerPool;
+	}
+
+	WorkerPool::SPtr&
+	Component::workerPool(void)
+	{
+		return workerPool_;
+	}
+
 	void 
 	Component::send(Message::SPtr message)
+	{
+		if (workerPool_.get() == nullptr) {
+			receive(message);
+			return;
+		}
+
+		// the queue of the worker pool is full
+		if (!workerPool_->post(boost::bind(&Component::receive, this, message))) {
+			receiveOverload(message);
+		}
+	}
+
+	void
+	Component::receiveOverload(Message::SPtr message)
 	{
 		receive(message);
 	}
@@ -120,9 +156,34 @@ namespace OpcUaStackCore
 			return;
 		}
 
-		boost::mutex::scoped_lock g(mutex_);
+		// only the first message starts a drain task. The following messages
+		// are received by the running drain task
+		mailbox_.push(message);
+		if (mailbox_.schedule()) {
+			ioThread_->ioService()->io_service().post(
+				boost::bind(&Component::drainMailbox, this)
+			);
+		}
+	}
+
+	void
+	Component::drainMailbox(void)
+	{
+		uint32_t count = 0;
+		while (count < MaxMailboxBatch) {
+			Message::SPtr message;
+			if (!mailbox_.pop(message)) {
+				if (!mailbox_.unschedule()) return;
+				continue;
+			}
+
+			receive(message);
+			count++;
+		}
+
+		// give the other handlers of the io service a chance
 		ioThread_->ioService()->io_service().post(
-			boost::bind(&Component::receive, this, message)
+			boost::bind(&Component::drainMailbox, this)
 		);
 	}
 
@@ -21,9 +21,11 @@
 #include <boost/thread/mutex.hpp>
 #include "OpcUaStackCore/Base/os.h"
 #include "OpcUaStackCore/Base/IOService.h"
+#include "OpcUaStackCore/Base/WorkerPool.h"
 #include "OpcUaStackCore/BuildInTypes/OpcUaNodeId.h"
 #include "OpcUaStackCore/Utility/IOThread.h"
 #include "OpcUaStackCore/Component/Message.h"
+#include "OpcUaStackCore/Component/ComponentMailbox.h"
 
 namespace OpcUaStackCore
 {
@@ -46,7 +48,13 @@ namespace OpcUaStackCore
 		Component* component(const std::string& componentName);
 		Component* component(void);
 
+		// the messages are received in the threads of the worker pool
+		// if a worker pool is set
+		void workerPool(WorkerPool::SPtr& workerPool);
+		WorkerPool::SPtr& workerPool(void);
+
 		virtual void receive(Message::SPtr message) = 0;
+		virtual void receiveOverload(Message::SPtr message);
 		void send(Message::SPtr message);
 		void sendAsync(Message::SPtr message);
 
@@ -56,6 +64,10 @@ namespace OpcUaStackCore
 		void sendAsync(Component& component, Message::SPtr message);
 
 	  private:
+		static const uint32_t MaxMailboxBatch = 100;
+
+		void drainMailbox(void);
+
 		static ComponentMap componentMap_;
 
 		static boost::mutex globalMutex_;
@@ -65,7 +77,8 @@ namespace OpcUaStackCore
 
 		std::string componentName_;
 		IOThread* ioThread_;
-		boost::mutex mutex_;
+		WorkerPool::SPtr workerPool_;
+		ComponentMailbox mailbox_;
 	};
 
 }
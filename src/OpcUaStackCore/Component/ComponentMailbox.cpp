@@ -0,0 +1,84 @@
+/*
+   Copyright 2015 Kai Huebl (kai@huebl-sgh.de)
+
+   Lizenziert gemäß Apache Licence Version 2.0 (die „Lizenz“); Nutzung dieser
+   Datei nur in Übereinstimmung mit der Lizenz erlaubt.
+   Eine Kopie der Lizenz erhalten Sie auf http://www.apache.org/licenses/LICENSE-2.0.
+
+   Sofern nicht gemäß geltendem Recht vorgeschrieben oder schriftlich vereinbart,
+   erfolgt die Bereitstellung der im Rahmen der Lizenz verbreiteten Software OHNE
+   GEWÄHR ODER VORBEHALTE – ganz gleich, ob ausdrücklich oder stillschweigend.
+
+   Informationen über die jeweiligen Bedingungen für Genehmigungen und Einschränkungen
+   im Rahmen der Lizenz finden Sie in der Lizenz.
+
+   Autor: Kai Huebl (kai@huebl-sgh.de)
+ */
+
+#include "OpcUaStackCore/Component/ComponentMailbox.h"
+
+namespace OpcUaStackCore
+{
+
+	ComponentMailbox::ComponentMailbox(void)
+	: head_(nullptr)
+	, scheduled_(false)
+	, consumerHead_(nullptr)
+	{
+	}
+
+	ComponentMailbox::~ComponentMailbox(void)
+	{
+		Message::SPtr message;
+		while (pop(message)) {}
+	}
+
+	void
+	ComponentMailbox::push(Message::SPtr& message)
+	{
+		Node* node = new Node();
+		node->message_ = message;
+		node->next_ = head_.load(std::memory_order_relaxed);
+		while (!head_.compare_exchange_weak(node->next_, node)) {}
+	}
+
+	bool
+	ComponentMailbox::schedule(void)
+	{
+		// returns true if the caller must start the drain task
+		return !scheduled_.exchange(true);
+	}
+
+	bool
+	ComponentMailbox::pop(Message::SPtr& message)
+	{
+		if (consumerHead_ == nullptr) {
+			// take all pushed messages and restore the order of the push
+			Node* node = head_.exchange(nullptr);
+			while (node != nullptr) {
+				Node* next = node->next_;
+				node->next_ = consumerHead_;
+				consumerHead_ = node;
+				node = next;
+			}
+			if (consumerHead_ == nullptr) return false;
+		}
+
+		Node* node = consumerHead_;
+		consumerHead_ = node->next_;
+		message = node->message_;
+		delete node;
+		return true;
+	}
+
+	bool
+	ComponentMailbox::unschedule(void)
+	{
+		// a producer which has seen the scheduled flag has not started a
+		// drain task. Returns true if the caller must continue to drain.
+		scheduled_.store(false);
+		if (consumerHead_ == nullptr && head_.load() == nullptr) return false;
+		return schedule();
+	}
+
+}
@@ -0,0 +1,64 @@
+/*
+   Copyright 2015 Kai Huebl (kai@huebl-sgh.de)
+
+   Lizenziert gemäß Apache Licence Version 2.0 (die „Lizenz“); Nutzung dieser
+   Datei nur in Übereinstimmung mit der Lizenz erlaubt.
+   Eine Kopie der Lizenz erhalten Sie auf http://www.apache.org/licenses/LICENSE-2.0.
+
+   Sofern nicht gemäß geltendem Recht vorgeschrieben oder schriftlich vereinbart,
+   erfolgt die Bereitstellung der im Rahmen der Lizenz verbreiteten Software OHNE
+   GEWÄHR ODER VORBEHALTE – ganz gleich, ob ausdrücklich oder stillschweigend.
+
+   Informationen über die jeweiligen Bedingungen für Genehmigungen und Einschränkungen
+   im Rahmen der Lizenz finden Sie in der Lizenz.
+
+   Autor: Kai Huebl (kai@huebl-sgh.de)
+ */
+
+#ifndef __OpcUaStackCore_ComponentMailbox_h__
+#define __OpcUaStackCore_ComponentMailbox_h__
+
+#include <atomic>
+#include "OpcUaStackCore/Base/os.h"
+#include "OpcUaStackCore/Component/Message.h"
+
+namespace OpcUaStackCore
+{
+
+	//
+	// lock free multi producer single consumer queue of the messages of a
+	// component. The producers push the messages onto a stack with an atomic
+	// compare and swap. The consumer takes the whole stack at once and
+	// reverses it, so the messages are received in the order of the push.
+	// The scheduled flag makes sure that only one drain task is running.
+	//
+	class DLLEXPORT ComponentMailbox
+	{
+	  public:
+		ComponentMailbox(void);
+		~ComponentMailbox(void);
+
+		// producer
+		void push(Message::SPtr& message);
+		bool schedule(void);
+
+		// consumer
+		bool pop(Message::SPtr& message);
+		bool unschedule(void);
+
+	  private:
+		class Node
+		{
+		  public:
+			Message::SPtr message_;
+			Node* next_;
+		};
+
+		std::atomic<Node*> head_;
+		std::atomic<bool> scheduled_;
+		Node* consumerHead_;
+	};
+
+}
+
+#endif
@@ -99,9 +99,7 @@ namespace OpcUaStackCore
 	bool
 	ComponentManager::existComponent(const std::string& componentName)
 	{
-		// FIXME: todo
-
-		return true;
+		return Component::getComponent(componentName) != nullptr;
 	}
 
 	bool
@@ -121,14 +119,20 @@ namespace OpcUaStackCore
 	bool
 	ComponentManager::send(const std::string& componentName, Message::SPtr message)
 	{
-		// FIXME:
+		// the name is searched under the global component lock
+		Component* component = Component::getComponent(componentName);
+		if (component == nullptr) return false;
+		component->send(message);
 		return true;
 	}
 
 	bool
 	ComponentManager::sendAsync(const std::string& componentName, Message::SPtr message)
 	{
-		// FIXME:
+		// the name is searched under the global component lock
+		Component* component = Component::getComponent(componentName);
+		if (component == nullptr) return false;
+		component->sendAsync(message);
 		return true;
 	}
 
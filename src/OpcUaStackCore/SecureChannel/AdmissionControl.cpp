@@ -0,0 +1,297 @@
+/*
+   Copyright 2015 Kai Huebl (kai@huebl-sgh.de)
+
+   Lizenziert gemäß Apache Licence Version 2.0 (die „Lizenz“); Nutzung dieser
+   Datei nur in Übereinstimmung mit der Lizenz erlaubt.
+   Eine Kopie der Lizenz erhalten Sie auf http://www.apache.org/licenses/LICENSE-2.0.
+
+   Sofern nicht gemäß geltendem Recht vorgeschrieben oder schriftlich vereinbart,
+   erfolgt die Bereitstellung der im Rahmen der Lizenz verbreiteten Software OHNE
+   GEWÄHR ODER VORBEHALTE – ganz gleich, ob ausdrücklich oder stillschweigend.
+
+   Informationen über die jeweiligen Bedingungen für Genehmigungen und Einschränkungen
+   im Rahmen der Lizenz finden Sie in der Lizenz.
+
+   Autor: Kai Huebl (kai@huebl-sgh.de)
+ */
+
+
+#include "OpcUaStackCore/SecureChannel/AdmissionControl.h"
+
+namespace OpcUaStackCore
+{
+
+	AdmissionControl::AdmissionControl(void)
+	: maxHandshakes_(0)
+	, acceptRate_(0)
+	, acceptBurst_(0)
+	, maxConnectionsPerAddress_(0)
+	, handshakeTimeout_(0)
+	, mutex_()
+	, tokens_(0)
+	, lastRefill_()
+	, handshakes_(0)
+	, connections_(0)
+	, addressMap_()
+	, acceptCount_(0)
+	, rejectHandshakesCount_(0)
+	, rejectRateCount_(0)
+	, rejectAddressCount_(0)
+	, handshakeExpiredCount_(0)
+	{
+	}
+
+	AdmissionControl::~AdmissionControl(void)
+	{
+	}
+
+	void
+	AdmissionControl::maxHandshakes(uint32_t maxHandshakes)
+	{
+		maxHandshakes_ = maxHandshakes;
+	}
+
+	uint32_t
+	AdmissionControl::maxHandshakes(void)
+	{
+		return maxHandshakes_;
+	}
+
+	void
+	AdmissionControl::acceptRate(uint32_t acceptRate)
+	{
+		acceptRate_ = acceptRate;
+	}
+
+	uint32_t
+	AdmissionControl::acceptRate(void)
+	{
+		return acceptRate_;
+	}
+
+	void
+	AdmissionControl::acceptBurst(uint32_t acceptBurst)
+	{
+		acceptBurst_ = acceptBurst;
+	}
+
+	uint32_t
+	AdmissionControl::acceptBurst(void)
+	{
+		// without burst size the bucket holds the tokens of one second
+		return acceptBurst_ != 0 ? acceptBurst_ : acceptRate_;
+	}
+
+	void
+	AdmissionControl::maxConnectionsPerAddress(uint32_t maxConnectionsPerAddress)
+	{
+		maxConnectionsPerAddress_ = maxConnectionsPerAddress;
+	}
+
+	uint32_t
+	AdmissionControl::maxConnectionsPerAddress(void)
+	{
+		return maxConnectionsPerAddress_;
+	}
+
+	void
+	AdmissionControl::handshakeTimeout(uint32_t handshakeTimeout)
+	{
+		handshakeTimeout_ = handshakeTimeout;
+	}
+
+	uint32_t
+	AdmissionControl::handshakeTimeout(void)
+	{
+		return handshakeTimeout_;
+	}
+
+	bool
+	AdmissionControl::enabled(void)
+	{
+		return maxHandshakes_ != 0 || acceptRate_ != 0 || maxConnectionsPerAddress_ != 0 || handshakeTimeout_ != 0;
+	}
+
+	AdmissionResult
+	AdmissionControl::admit(const std::string& address)
+	{
+		boost::mutex::scoped_lock g(mutex_);
+
+		// check connections from partner address. Connections without
+		// address (unix domain sockets) are not limited
+		AddressMap::iterator it = addressMap_.end();
+		if (!address.empty()) {
+			it = addressMap_.find(address);
+			if (maxConnectionsPerAddress_ != 0 && it != addressMap_.end() && it->second >= maxConnectionsPerAddress_) {
+				rejectAddressCount_++;
+				return AR_RejectAddress;
+			}
+		}
+
+		// check handshakes in progress
+		if (maxHandshakes_ != 0 && handshakes_ >= maxHandshakes_) {
+			rejectHandshakesCount_++;
+			return AR_RejectHandshakes;
+		}
+
+		// check accept rate
+		if (!takeToken()) {
+			rejectRateCount_++;
+			return AR_RejectRate;
+		}
+
+		if (!address.empty()) {
+			if (it == addressMap_.end()) {
+				it = addressMap_.insert(std::make_pair(address, 0)).first;
+			}
+			it->second++;
+		}
+		connections_++;
+		handshakes_++;
+		acceptCount_++;
+		return AR_Accept;
+	}
+
+	bool
+	AdmissionControl::takeToken(void)
+	{
+		if (acceptRate_ == 0) {
+			return true;
+		}
+
+		// refill the bucket with the tokens of the elapsed time
+		boost::posix_time::ptime now = boost::posix_time::microsec_clock::universal_time();
+		double burst = acceptBurst();
+		if (lastRefill_.is_not_a_date_time()) {
+			tokens_ = burst;
+		}
+		else {
+			double elapsed = (now - lastRefill_).total_microseconds() / 1000000.0;
+			tokens_ += elapsed * acceptRate_;
+			if (tokens_ > burst) tokens_ = burst;
+		}
+		lastRefill_ = now;
+
+		if (tokens_ < 1.0) {
+			return false;
+		}
+		tokens_ -= 1.0;
+		return true;
+	}
+
+	void
+	AdmissionControl::handshakeComplete(void)
+	{
+		boost::mutex::scoped_lock g(mutex_);
+		if (handshakes_ > 0) handshakes_--;
+	}
+
+	void
+	AdmissionControl::handshakeExpired(void)
+	{
+		// the connection is released when it is closed
+		boost::mutex::scoped_lock g(mutex_);
+		handshakeExpiredCount_++;
+	}
+
+	void
+	AdmissionControl::release(const std::string& address, bool handshake)
+	{
+		boost::mutex::scoped_lock g(mutex_);
+
+		if (handshake && handshakes_ > 0) handshakes_--;
+		if (connections_ > 0) connections_--;
+
+		if (address.empty()) {
+			return;
+		}
+		AddressMap::iterator it = addressMap_.find(address);
+		if (it == addressMap_.end()) {
+			return;
+		}
+		it->second--;
+		if (it->second == 0) {
+			addressMap_.erase(it);
+		}
+	}
+
+	uint32_t
+	AdmissionControl::handshakes(void)
+	{
+		boost::mutex::scoped_lock g(mutex_);
+		return handshakes_;
+	}
+
+	uint32_t
+	AdmissionControl::connections(void)
+	{
+		boost::mutex::scoped_lock g(mutex_);
+		return connections_;
+	}
+
+	uint64_t
+	AdmissionControl::acceptCount(void)
+	{
+		boost::mutex::scoped_lock g(mutex_);
+		return acceptCount_;
+	}
+
+	uint64_t
+	AdmissionControl::rejectHandshakesCount(void)
+	{
+		boost::mutex::scoped_lock g(mutex_);
+		return rejectHandshakesCount_;
+	}
+
+	uint64_t
+	AdmissionControl::rejectRateCount(void)
+	{
+		boost::mutex::scoped_lock g(mutex_);
+		return rejectRateCount_;
+	}
+
+	uint64_t
+	AdmissionControl::rejectAddressCount(void)
+	{
+		boost::mutex::scoped_lock g(mutex_);
+		return rejectAddressCount_;
+	}
+
+	uint64_t
+	AdmissionControl::handshakeExpiredCount(void)
+	{
+		boost::mutex::scoped_lock g(mutex_);
+		return handshakeExpiredCount_;
+	}
+
+	void
+	AdmissionControl::statistic(
+		uint64_t& acceptCount,
+		uint64_t& rejectHandshakesCount,
+		uint64_t& rejectRateCount,
+		uint64_t& rejectAddressCount,
+		uint64_t& handshakeExpiredCount
+	)
+	{
+		boost::mutex::scoped_lock g(mutex_);
+		acceptCount = acceptCount_;
+		rejectHandshakesCount = rejectHandshakesCount_;
+		rejectRateCount = rejectRateCount_;
+		rejectAddressCount = rejectAddressCount_;
+		handshakeExpiredCount = handshakeExpiredCount_;
+	}
+
+	std::string
+	AdmissionControl::admissionResultToString(AdmissionResult admissionResult)
+	{
+		switch (admissionResult)
+		{
+			case AR_Accept: return "Accept";
+			case AR_RejectHandshakes: return "RejectHandshakes";
+			case AR_RejectRate: return "RejectRate";
+			case AR_RejectAddress: return "RejectAddress";
+		}
+		return "Unknown";
+	}
+
+}
@@ -0,0 +1,118 @@
+/*
+   Copyright 2015 Kai Huebl (kai@huebl-sgh.de)
+
+   Lizenziert gemäß Apache Licence Version 2.0 (die „Lizenz“); Nutzung dieser
+   Datei nur in Übereinstimmung mit der Lizenz erlaubt.
+   Eine Kopie der Lizenz erhalten Sie auf http://www.apache.org/licenses/LICENSE-2.0.
+
+   Sofern nicht gemäß geltendem Recht vorgeschrieben oder schriftlich vereinbart,
+   erfolgt die Bereitstellung der im Rahmen der Lizenz verbreiteten Software OHNE
+   GEWÄHR ODER VORBEHALTE – ganz gleich, ob ausdrücklich oder stillschweigend.
+
+   Informationen über die jeweiligen Bedingungen für Genehmigungen und Einschränkungen
+   im Rahmen der Lizenz finden Sie in der Lizenz.
+
+   Autor: Kai Huebl (kai@huebl-sgh.de)
+ */
+
+
+#ifndef __OpcUaStackCore_AdmissionControl_h__
+#define __OpcUaStackCore_AdmissionControl_h__
+
+#include <boost/shared_ptr.hpp>
+#include <boost/thread/mutex.hpp>
+#include <boost/date_time/posix_time/posix_time.hpp>
+#include <map>
+#include <string>
+#include <stdint.h>
+#include "OpcUaStackCore/Base/os.h"
+
+namespace OpcUaStackCore
+{
+
+	typedef enum
+	{
+		AR_Accept,				// the connection is accepted
+		AR_RejectHandshakes,	// too many handshakes are in progress
+		AR_RejectRate,			// the accept rate is exceeded
+		AR_RejectAddress		// too many connections from the partner address
+	} AdmissionResult;
+
+	//
+	// The admission control decides if a new connection is accepted. A
+	// handshake is in progress from the accept of the connection until
+	// the open secure channel response is sent. A connection is closed if
+	// the handshake is not complete after the handshake timeout. The accept
+	// rate is limited by a token bucket. A limit with the value 0 is
+	// disabled. The admission control is shared by all endpoints of a server.
+	//
+	class DLLEXPORT AdmissionControl
+	{
+	  public:
+		typedef boost::shared_ptr<AdmissionControl> SPtr;
+
+		AdmissionControl(void);
+		~AdmissionControl(void);
+
+		void maxHandshakes(uint32_t maxHandshakes);
+		uint32_t maxHandshakes(void);
+		void acceptRate(uint32_t acceptRate);
+		uint32_t acceptRate(void);
+		void acceptBurst(uint32_t acceptBurst);
+		uint32_t acceptBurst(void);
+		void maxConnectionsPerAddress(uint32_t maxConnectionsPerAddress);
+		uint32_t maxConnectionsPerAddress(void);
+		void handshakeTimeout(uint32_t handshakeTimeout);
+		uint32_t handshakeTimeout(void);
+		bool enabled(void);
+
+		AdmissionResult admit(const std::string& address);
+		void handshakeComplete(void);
+		void handshakeExpired(void);
+		void release(const std::string& address, bool handshake);
+
+		uint32_t handshakes(void);
+		uint32_t connections(void);
+		uint64_t acceptCount(void);
+		uint64_t rejectHandshakesCount(void);
+		uint64_t rejectRateCount(void);
+		uint64_t rejectAddressCount(void);
+		uint64_t handshakeExpiredCount(void);
+		void statistic(
+			uint64_t& acceptCount,
+			uint64_t& rejectHandshakesCount,
+			uint64_t& rejectRateCount,
+			uint64_t& rejectAddressCount,
+			uint64_t& handshakeExpiredCount
+		);
+
+		static std::string admissionResultToString(AdmissionResult admissionResult);
+
+	  private:
+		typedef std::map<std::string, uint32_t> AddressMap;
+
+		bool takeToken(void);
+
+		uint32_t maxHandshakes_;
+		uint32_t acceptRate_;
+		uint32_t acceptBurst_;
+		uint32_t maxConnectionsPerAddress_;
+		uint32_t handshakeTimeout_;
+
+		boost::mutex mutex_;
+		double tokens_;
+		boost::posix_time::ptime lastRefill_;
+		uint32_t handshakes_;
+		uint32_t connections_;
+		AddressMap addressMap_;
+
+		uint64_t acceptCount_;
+		uint64_t rejectHandshakesCount_;
+		uint64_t rejectRateCount_;
+		uint64_t rejectAddressCount_;
+		uint64_t handshakeExpiredCount_;
+	};
+
+}
+
+#endif
@@ -0,0 +1,199 @@
+/*
+   Copyright 2015-2018 Kai Huebl (kai@huebl-sgh.de)
+
+   Lizenziert gemäß Apache Licence Version 2.0 (die „Lizenz“); Nutzung dieser
+   Datei nur in Übereinstimmung mit der Lizenz erlaubt.
+   Eine Kopie der Lizenz erhalten Sie auf http://www.apache.org/licenses/LICENSE-2.0.
+
+   Sofern nicht gemäß geltendem Recht vorgeschrieben oder schriftlich vereinbart,
+   erfolgt die Bereitstellung der im Rahmen der Lizenz verbreiteten Software OHNE
+   GEWÄHR ODER VORBEHALTE – ganz gleich, ob ausdrücklich oder stillschweigend.
+
+   Informationen über die jeweiligen Bedingungen für Genehmigungen und Einschränkungen
+   im Rahmen der Lizenz finden Sie in der Lizenz.
+
+   Autor: Kai Huebl (kai@huebl-sgh.de)
+ */
+
+#include <string.h>
+#include "OpcUaStackCore/SecureChannel/MessageChunkBuffer.h"
+#include "OpcUaStackCore/Base/WorkerPool.h"
+
+namespace OpcUaStackCore
+{
+
+	MessageChunkBuffer::MessageChunkBuffer(uint32_t chunkSize, uint32_t maxChunkCount, uint32_t maxMessageSize)
+	: std::streambuf()
+	, chunkSize_(chunkSize == 0 ? 1 : chunkSize)
+	, maxChunkCount_(maxChunkCount)
+	, maxMessageSize_(maxMessageSize)
+	, chunkCallback_()
+	, maxQueuedChunks_(0)
+	, actChunk_()
+	, mutex_()
+	, chunkCondition_()
+	, chunkList_()
+	, chunkCount_(0)
+	, messageSize_(0)
+	, complete_(false)
+	, aborted_(false)
+	{
+		actChunk_.resize(chunkSize_);
+		setp(&actChunk_[0], &actChunk_[0] + chunkSize_);
+	}
+
+	MessageChunkBuffer::~MessageChunkBuffer(void)
+	{
+	}
+
+	void
+	MessageChunkBuffer::chunkCallback(const ChunkCallback& chunkCallback)
+	{
+		chunkCallback_ = chunkCallback;
+	}
+
+	void
+	MessageChunkBuffer::maxQueuedChunks(uint32_t maxQueuedChunks)
+	{
+		maxQueuedChunks_ = maxQueuedChunks;
+	}
+
+	MessageChunkBuffer::int_type
+	MessageChunkBuffer::overflow(int_type c)
+	{
+		// the actual chunk is full. Pass it to the secure channel and
+		// continue the encoding with a new chunk
+		if (pushChunk()) {
+			callChunkCallback();
+			waitQueuedChunks();
+		}
+
+		if (c != traits_type::eof()) {
+			*pptr() = traits_type::to_char_type(c);
+			pbump(1);
+		}
+		return traits_type::not_eof(c);
+	}
+
+	void
+	MessageChunkBuffer::finish(void)
+	{
+		{
+			boost::mutex::scoped_lock g(mutex_);
+			if (complete_) return;
+		}
+
+		// the last chunk is passed to the secure channel even if it is empty
+		pushChunk();
+		{
+			boost::mutex::scoped_lock g(mutex_);
+			complete_ = true;
+		}
+		callChunkCallback();
+	}
+
+	bool
+	MessageChunkBuffer::pushChunk(void)
+	{
+		uint32_t size = (uint32_t)(pptr() - pbase());
+
+		boost::mutex::scoped_lock g(mutex_);
+
+		// discard the rest of an aborted message
+		if (aborted_) {
+			setp(&actChunk_[0], &actChunk_[0] + chunkSize_);
+			return false;
+		}
+
+		// check chunk limits
+		if ((maxChunkCount_ != 0 && chunkCount_ + 1 > maxChunkCount_) ||
+			(maxMessageSize_ != 0 && messageSize_ + size > maxMessageSize_)) {
+			aborted_ = true;
+			complete_ = true;
+			chunkList_.clear();
+			setp(&actChunk_[0], &actChunk_[0] + chunkSize_);
+			return true;
+		}
+
+		chunkCount_++;
+		messageSize_ += size;
+
+		actChunk_.resize(size);
+		chunkList_.push_back(std::vector<char>());
+		chunkList_.back().swap(actChunk_);
+
+		actChunk_.resize(chunkSize_);
+		setp(&actChunk_[0], &actChunk_[0] + chunkSize_);
+		return true;
+	}
+
+	void
+	MessageChunkBuffer::callChunkCallback(void)
+	{
+		if (chunkCallback_) chunkCallback_();
+	}
+
+	void
+	MessageChunkBuffer::waitQueuedChunks(void)
+	{
+		if (maxQueuedChunks_ == 0 || !WorkerPool::runningInWorkerPool()) return;
+
+		boost::mutex::scoped_lock g(mutex_);
+		while (!aborted_ && chunkList_.size() >= maxQueuedChunks_) {
+			chunkCondition_.wait(g);
+		}
+	}
+
+	void
+	MessageChunkBuffer::cancel(void)
+	{
+		// the secure channel is closed. The rest of the encoding is discarded
+		// and a waiting encoder continues
+		boost::mutex::scoped_lock g(mutex_);
+		aborted_ = true;
+		complete_ = true;
+		chunkList_.clear();
+		chunkCondition_.notify_all();
+	}
+
+	bool
+	MessageChunkBuffer::getChunk(boost::asio::streambuf& chunk, bool& lastChunk)
+	{
+		boost::mutex::scoped_lock g(mutex_);
+		if (chunkList_.empty()) return false;
+
+		std::vector<char>& front = chunkList_.front();
+		if (!front.empty()) {
+			boost::asio::streambuf::mutable_buffers_type buffer = chunk.prepare(front.size());
+			memcpy(boost::asio::buffer_cast<char*>(buffer), &front[0], front.size());
+			chunk.commit(front.size());
+		}
+		chunkList_.pop_front();
+		chunkCondition_.notify_all();
+
+		lastChunk = complete_ && chunkList_.empty();
+		return true;
+	}
+
+	bool
+	MessageChunkBuffer::aborted(void)
+	{
+		boost::mutex::scoped_lock g(mutex_);
+		return aborted_;
+	}
+
+	uint32_t
+	MessageChunkBuffer::chunkCount(void)
+	{
+		boost::mutex::scoped_lock g(mutex_);
+		return chunkCount_;
+	}
+
+	uint32_t
+	MessageChunkBuffer::messageSize(void)
+	{
+		boost::mutex::scoped_lock g(mutex_);
+		return messageSize_;
+	}
+
+}
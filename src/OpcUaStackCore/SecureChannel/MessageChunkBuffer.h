@@ -0,0 +1,93 @@
+/*
+   Copyright 2015-2018 Kai Huebl (kai@huebl-sgh.de)
+
+   Lizenziert gemäß Apache Licence Version 2.0 (die „Lizenz“); Nutzung dieser
+   Datei nur in Übereinstimmung mit der Lizenz erlaubt.
+   Eine Kopie der Lizenz erhalten Sie auf http://www.apache.org/licenses/LICENSE-2.0.
+
+   Sofern nicht gemäß geltendem Recht vorgeschrieben oder schriftlich vereinbart,
+   erfolgt die Bereitstellung der im Rahmen der Lizenz verbreiteten Software OHNE
+   GEWÄHR ODER VORBEHALTE – ganz gleich, ob ausdrücklich oder stillschweigend.
+
+   Informationen über die jeweiligen Bedingungen für Genehmigungen und Einschränkungen
+   im Rahmen der Lizenz finden Sie in der Lizenz.
+
+   Autor: Kai Huebl (kai@huebl-sgh.de)
+ */
+
+#ifndef __OpcUaStackCore_MessageChunkBuffer_h__
+#define __OpcUaStackCore_MessageChunkBuffer_h__
+
+#include <streambuf>
+#include <vector>
+#include <list>
+#include <boost/shared_ptr.hpp>
+#include <boost/function.hpp>
+#include <boost/thread/mutex.hpp>
+#include <boost/thread/condition.hpp>
+#include <boost/asio/streambuf.hpp>
+#include "OpcUaStackCore/Base/os.h"
+
+namespace OpcUaStackCore
+{
+
+	//
+	// The message chunk buffer is an output stream buffer which splits an
+	// encoded response into chunk bodies of a fixed size. Each full chunk is
+	// passed to the secure channel while the encoding continues. The message
+	// is aborted if it exceeds the maximum chunk count or the maximum message
+	// size negotiated with the client (0 = no limit).
+	//
+	// An encoder running in a worker pool thread waits if the maximum number
+	// of queued chunks is reached, until the secure channel has taken a chunk
+	// or the buffer is cancelled. An encoder running in an io thread does not
+	// wait, because the chunks are sent by the io threads.
+	//
+	class DLLEXPORT MessageChunkBuffer
+	: public std::streambuf
+	{
+	  public:
+		typedef boost::shared_ptr<MessageChunkBuffer> SPtr;
+		typedef boost::function<void ()> ChunkCallback;
+
+		MessageChunkBuffer(uint32_t chunkSize, uint32_t maxChunkCount, uint32_t maxMessageSize);
+		~MessageChunkBuffer(void);
+
+		void chunkCallback(const ChunkCallback& chunkCallback);
+		void maxQueuedChunks(uint32_t maxQueuedChunks);
+		void finish(void);
+		void cancel(void);
+
+		bool getChunk(boost::asio::streambuf& chunk, bool& lastChunk);
+		bool aborted(void);
+		uint32_t chunkCount(void);
+		uint32_t messageSize(void);
+
+	  protected:
+		int_type overflow(int_type c);
+
+	  private:
+		bool pushChunk(void);
+		void callChunkCallback(void);
+		void waitQueuedChunks(void);
+
+		uint32_t chunkSize_;
+		uint32_t maxChunkCount_;
+		uint32_t maxMessageSize_;
+		ChunkCallback chunkCallback_;
+		uint32_t maxQueuedChunks_;
+
+		std::vector<char> actChunk_;
+
+		boost::mutex mutex_;
+		boost::condition chunkCondition_;
+		std::list<std::vector<char> > chunkList_;
+		uint32_t chunkCount_;
+		uint32_t messageSize_;
+		bool complete_;
+		bool aborted_;
+	};
+
+}
+
+#endif
@@ -0,0 +1,189 @@
+/*
+   Copyright 2015 Kai Huebl (kai@huebl-sgh.de)
+
+   Lizenziert gemäß Apache Licence Version 2.0 (die „Lizenz“); Nutzung dieser
+   Datei nur in Übereinstimmung mit der Lizenz erlaubt.
+   Eine Kopie der Lizenz erhalten Sie auf http://www.apache.org/licenses/LICENSE-2.0.
+
+   Sofern nicht gemäß geltendem Recht vorgeschrieben oder schriftlich vereinbart,
+   erfolgt die Bereitstellung der im Rahmen der Lizenz verbreiteten Software OHNE
+   GEWÄHR ODER VORBEHALTE – ganz gleich, ob ausdrücklich oder stillschweigend.
+
+   Informationen über die jeweiligen Bedingungen für Genehmigungen und Einschränkungen
+   im Rahmen der Lizenz finden Sie in der Lizenz.
+
+   Autor: Kai Huebl (kai@huebl-sgh.de)
+ */
+
+
+#include <boost/bind.hpp>
+#include "OpcUaStackCore/SecureChannel/RequestWindow.h"
+
+namespace OpcUaStackCore
+{
+
+	// ------------------------------------------------------------------------
+	// ------------------------------------------------------------------------
+	//
+	// RequestWindowSlot
+	//
+	// ------------------------------------------------------------------------
+	// ------------------------------------------------------------------------
+	RequestWindowSlot::RequestWindowSlot(const boost::shared_ptr<RequestWindow>& requestWindow)
+	: requestWindow_(requestWindow)
+	{
+	}
+
+	RequestWindowSlot::~RequestWindowSlot(void)
+	{
+		requestWindow_->leave();
+	}
+
+	// ------------------------------------------------------------------------
+	// ------------------------------------------------------------------------
+	//
+	// RequestWindow
+	//
+	// ------------------------------------------------------------------------
+	// ------------------------------------------------------------------------
+	RequestWindow::RequestWindow(void)
+	: mutex_()
+	, strand_()
+	, resumeCallback_()
+	, closed_(false)
+	, paused_(false)
+	, windowSize_(0)
+	, requestsInFlight_(0)
+	, requestsInFlightMax_(0)
+	, requestCount_(0)
+	, pauseCount_(0)
+	{
+	}
+
+	RequestWindow::~RequestWindow(void)
+	{
+	}
+
+	void
+	RequestWindow::windowSize(uint32_t windowSize)
+	{
+		boost::mutex::scoped_lock g(mutex_);
+		windowSize_ = windowSize;
+	}
+
+	uint32_t
+	RequestWindow::windowSize(void)
+	{
+		boost::mutex::scoped_lock g(mutex_);
+		return windowSize_;
+	}
+
+	void
+	RequestWindow::open(StrandSPtr& strand, const ResumeCallback& resumeCallback)
+	{
+		boost::mutex::scoped_lock g(mutex_);
+		strand_ = strand;
+		resumeCallback_ = resumeCallback;
+		closed_ = false;
+	}
+
+	void
+	RequestWindow::close(void)
+	{
+		// called by the strand of the secure channel before the secure
+		// channel is deleted. A posted resume is not executed anymore.
+		boost::mutex::scoped_lock g(mutex_);
+		closed_ = true;
+		resumeCallback_ = ResumeCallback();
+	}
+
+	void
+	RequestWindow::request(void)
+	{
+		boost::mutex::scoped_lock g(mutex_);
+		requestCount_++;
+	}
+
+	RequestWindowSlot::SPtr
+	RequestWindow::enter(void)
+	{
+		{
+			boost::mutex::scoped_lock g(mutex_);
+			requestsInFlight_++;
+
+			// diagnostic
+			if (requestsInFlight_ > requestsInFlightMax_) {
+				requestsInFlightMax_ = requestsInFlight_;
+			}
+		}
+
+		RequestWindowSlot::SPtr requestWindowSlot(new RequestWindowSlot(shared_from_this()));
+		return requestWindowSlot;
+	}
+
+	bool
+	RequestWindow::full(void)
+	{
+		boost::mutex::scoped_lock g(mutex_);
+		return windowSize_ != 0 && requestsInFlight_ >= windowSize_;
+	}
+
+	bool
+	RequestWindow::pause(void)
+	{
+		boost::mutex::scoped_lock g(mutex_);
+		if (windowSize_ == 0 || requestsInFlight_ < windowSize_) {
+			return false;
+		}
+
+		paused_ = true;
+		pauseCount_++;
+		return true;
+	}
+
+	void
+	RequestWindow::statistic(
+		uint32_t& requestCount,
+		uint32_t& requestsInFlight,
+		uint32_t& requestsInFlightMax,
+		uint32_t& pauseCount
+	)
+	{
+		boost::mutex::scoped_lock g(mutex_);
+		requestCount = requestCount_;
+		requestsInFlight = requestsInFlight_;
+		requestsInFlightMax = requestsInFlightMax_;
+		pauseCount = pauseCount_;
+	}
+
+	void
+	RequestWindow::leave(void)
+	{
+		boost::mutex::scoped_lock g(mutex_);
+		if (requestsInFlight_ > 0) requestsInFlight_--;
+
+		// the secure channel continues reading in its strand
+		if (!paused_ || closed_ || strand_.get() == nullptr) {
+			return;
+		}
+		paused_ = false;
+		strand_->post(boost::bind(&RequestWindow::resume, shared_from_this()));
+	}
+
+	void
+	RequestWindow::resume(void)
+	{
+		ResumeCallback resumeCallback;
+
+		{
+			boost::mutex::scoped_lock g(mutex_);
+			if (closed_) return;
+			resumeCallback = resumeCallback_;
+		}
+
+		if (resumeCallback) {
+			resumeCallback();
+		}
+	}
+
+}
@@ -0,0 +1,109 @@
+/*
+   Copyright 2015 Kai Huebl (kai@huebl-sgh.de)
+
+   Lizenziert gemäß Apache Licence Version 2.0 (die „Lizenz“); Nutzung dieser
+   Datei nur in Übereinstimmung mit der Lizenz erlaubt.
+   Eine Kopie der Lizenz erhalten Sie auf http://www.apache.org/licenses/LICENSE-2.0.
+
+   Sofern nicht gemäß geltendem Recht vorgeschrieben oder schriftlich vereinbart,
+   erfolgt die Bereitstellung der im Rahmen der Lizenz verbreiteten Software OHNE
+   GEWÄHR ODER VORBEHALTE – ganz gleich, ob ausdrücklich oder stillschweigend.
+
+   Informationen über die jeweiligen Bedingungen für Genehmigungen und Einschränkungen
+   im Rahmen der Lizenz finden Sie in der Lizenz.
+
+   Autor: Kai Huebl (kai@huebl-sgh.de)
+ */
+
+
+#ifndef __OpcUaStackCore_RequestWindow_h__
+#define __OpcUaStackCore_RequestWindow_h__
+
+#include <boost/shared_ptr.hpp>
+#include <boost/enable_shared_from_this.hpp>
+#include <boost/function.hpp>
+#include <boost/thread/mutex.hpp>
+#include <boost/asio/io_service.hpp>
+#include <boost/asio/strand.hpp>
+#include <stdint.h>
+#include "OpcUaStackCore/Base/os.h"
+
+namespace OpcUaStackCore
+{
+
+	class RequestWindow;
+
+	//
+	// A place in the request window of a secure channel. The place is
+	// released when the slot is deleted, i.e. when the response is sent or
+	// when the last reference to a request without response is dropped.
+	//
+	class DLLEXPORT RequestWindowSlot
+	{
+	  public:
+		typedef boost::shared_ptr<RequestWindowSlot> SPtr;
+
+		RequestWindowSlot(const boost::shared_ptr<RequestWindow>& requestWindow);
+		~RequestWindowSlot(void);
+
+	  private:
+		boost::shared_ptr<RequestWindow> requestWindow_;
+	};
+
+	//
+	// The request window limits the number of requests of a secure channel
+	// which are processed by the server at the same time (0 = no limit). The
+	// secure channel pauses reading if the window is full. A slot can be
+	// released by any thread. The resume callback is called by the strand
+	// of the secure channel if a paused window has a free place again.
+	//
+	class DLLEXPORT RequestWindow
+	: public boost::enable_shared_from_this<RequestWindow>
+	{
+	  public:
+		typedef boost::shared_ptr<RequestWindow> SPtr;
+		typedef boost::shared_ptr<boost::asio::io_service::strand> StrandSPtr;
+		typedef boost::function<void (void)> ResumeCallback;
+
+		RequestWindow(void);
+		~RequestWindow(void);
+
+		void windowSize(uint32_t windowSize);
+		uint32_t windowSize(void);
+		void open(StrandSPtr& strand, const ResumeCallback& resumeCallback);
+		void close(void);
+
+		void request(void);
+		RequestWindowSlot::SPtr enter(void);
+		bool full(void);
+		bool pause(void);
+
+		void statistic(
+			uint32_t& requestCount,
+			uint32_t& requestsInFlight,
+			uint32_t& requestsInFlightMax,
+			uint32_t& pauseCount
+		);
+
+	  private:
+		friend class RequestWindowSlot;
+
+		void leave(void);
+		void resume(void);
+
+		boost::mutex mutex_;
+		StrandSPtr strand_;
+		ResumeCallback resumeCallback_;
+		bool closed_;
+		bool paused_;
+
+		uint32_t windowSize_;
+		uint32_t requestsInFlight_;
+		uint32_t requestsInFlightMax_;
+		uint32_t requestCount_;
+		uint32_t pauseCount_;
+	};
+
+}
+
+#endif
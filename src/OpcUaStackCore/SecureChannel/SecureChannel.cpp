@@ -18,6 +18,7 @@
 
 #include "OpcUaStackCore/Base/Utility.h"
 #include "OpcUaStackCore/Base/Log.h"
+#include "OpcUaStackCore/BuildInTypes/OpcUaIdentifier.h"
 #include "OpcUaStackCore/SecureChannel/MessageDefaults.h"
 #include "OpcUaStackCore/SecureChannel/SecureChannel.h"
 
@@ -25,6 +26,7 @@ namespace OpcUaStackCore
 {
 
 	OpcUaUInt32 SecureChannel::gChannelId_ = 0;
+	boost::mutex SecureChannel::gChannelIdMutex_;
 
 	SecureChannel::SecureChannel(IOThread* ioThread)
 	// security
@@ -64,6 +66,19 @@ namespace OpcUaStackCore
 
 	, secureChannelTransaction_()
 	, secureChannelTransactionList_()
+	, sendQueueLimit_()
+	, sendQueueBytes_(0)
+	, sendQueueMaxMessages_(0)
+	, sendQueueMaxBytes_(0)
+	, sendQueueDropCount_(0)
+	, sendQueueOverload_(false)
+	, recvPause_(false)
+	, requestWindow_(constructSPtr<RequestWindow>())
+	, admitted_(false)
+	, handshake_(false)
+	, handshakeTimer_(ioThread->ioService()->io_service())
+	, handshakeTimerRunning_(false)
+	, disconnectPending_(false)
 
 	, sendFirstSegment_(true)
 	, recvFirstSegment_(true)
@@ -78,11 +93,14 @@ namespace OpcUaStackCore
 	, handle_()
 
 	, isLogging_(false)
+	, capture_()
 	{
 	}
 
 	SecureChannel::~SecureChannel(void)
 	{
+		// requests which are still processed do not resume the deleted channel
+		requestWindow_->close();
 	}
 
 	// ------------------------------------------------------------------------
@@ -96,6 +114,23 @@ namespace OpcUaStackCore
 		return securitySettings_;
 	}
 
+	uint32_t
+	SecureChannel::sendChunkBodySize(void)
+	{
+		// the chunk body is the send buffer size less the message header (12),
+		// the security header (4) and the sequence header (8)
+		uint32_t overhead = 24;
+
+		// a signed chunk contains padding of up to one block and the signature
+		CryptoBase::SPtr cryptoBase = securitySettings_.cryptoBase();
+		if (securityHeader_.isSignatureEnabled() && cryptoBase.get() != nullptr) {
+			overhead += (uint32_t)cryptoBase->symmetricKeyLen() + cryptoBase->signatureDataLen();
+		}
+
+		if (sendBufferSize_ <= overhead) return 1;
+		return sendBufferSize_ - overhead;
+	}
+
 	void
 	SecureChannel::handle(Object::SPtr& handle)
 	{
@@ -114,6 +149,236 @@ namespace OpcUaStackCore
 		return handle_;
 	}
 
+	// ------------------------------------------------------------------------
+	//
+	// send queue
+	//
+	// ------------------------------------------------------------------------
+	void
+	SecureChannel::sendQueuePush(SecureChannelTransaction::SPtr& secureChannelTransaction)
+	{
+		secureChannelTransaction->sendQueueSize_ = 0;
+		secureChannelTransactionList_.push_back(secureChannelTransaction);
+		if (secureChannelTransaction->chunkBuffer_.get() != nullptr) {
+			sendQueueUpdate();
+			return;
+		}
+
+		secureChannelTransaction->sendQueueSize_ = OpcUaStackCore::count(secureChannelTransaction->os_);
+		sendQueueBytes_ += secureChannelTransaction->sendQueueSize_;
+
+		// diagnostic
+		if (secureChannelTransactionList_.size() > sendQueueMaxMessages_) {
+			sendQueueMaxMessages_ = secureChannelTransactionList_.size();
+		}
+		if (sendQueueBytes_ > sendQueueMaxBytes_) {
+			sendQueueMaxBytes_ = sendQueueBytes_;
+		}
+	}
+
+	void
+	SecureChannel::sendQueueUpdate(void)
+	{
+		// a streamed response is queued before it is encoded. Its size grows
+		// with each encoded chunk until the response leaves the queue
+		SecureChannelTransaction::List::iterator it;
+		for (it = secureChannelTransactionList_.begin(); it != secureChannelTransactionList_.end(); it++) {
+			MessageChunkBuffer::SPtr chunkBuffer = (*it)->chunkBuffer_;
+			if (chunkBuffer.get() == nullptr) continue;
+
+			uint32_t sendQueueSize = chunkBuffer->messageSize();
+			sendQueueBytes_ = sendQueueBytes_ - (*it)->sendQueueSize_ + sendQueueSize;
+			(*it)->sendQueueSize_ = sendQueueSize;
+		}
+
+		// diagnostic
+		if (secureChannelTransactionList_.size() > sendQueueMaxMessages_) {
+			sendQueueMaxMessages_ = secureChannelTransactionList_.size();
+		}
+		if (sendQueueBytes_ > sendQueueMaxBytes_) {
+			sendQueueMaxBytes_ = sendQueueBytes_;
+		}
+	}
+
+	void
+	SecureChannel::sendQueuePop(void)
+	{
+		if (secureChannelTransactionList_.empty()) return;
+		sendQueueBytes_ -= secureChannelTransactionList_.front()->sendQueueSize_;
+		secureChannelTransactionList_.pop_front();
+	}
+
+	void
+	SecureChannel::sendQueueClear(void)
+	{
+		// encoders of streamed responses must not wait for the closed channel
+		SecureChannelTransaction::List::iterator it;
+		for (it = secureChannelTransactionList_.begin(); it != secureChannelTransactionList_.end(); it++) {
+			if ((*it)->chunkBuffer_.get() != nullptr) (*it)->chunkBuffer_->cancel();
+		}
+
+		secureChannelTransactionList_.clear();
+		sendQueueBytes_ = 0;
+	}
+
+	uint32_t
+	SecureChannel::sendQueueDrop(bool coalesce)
+	{
+		uint32_t dropCount = 0;
+		OpcUaNodeId publishResponseTypeId(OpcUaId_PublishResponse_Encoding_DefaultBinary);
+
+		// the first element is in progress if a part of the message
+		// has been already sent
+		SecureChannelTransaction::List::iterator it = secureChannelTransactionList_.begin();
+		if (it != secureChannelTransactionList_.end() && !sendFirstSegment_) it++;
+
+		// only publish responses can be removed from the send queue. All
+		// other responses are expected by the client. The notification
+		// messages of the dropped responses can be fetched by a republish.
+		SecureChannelTransaction::List::iterator itLast = secureChannelTransactionList_.end();
+		if (coalesce) {
+			SecureChannelTransaction::List::iterator itFind;
+			for (itFind = it; itFind != secureChannelTransactionList_.end(); itFind++) {
+				if ((*itFind)->responseTypeNodeId_ == publishResponseTypeId) itLast = itFind;
+			}
+		}
+
+		while (it != secureChannelTransactionList_.end()) {
+			if (!coalesce && !sendQueueAboveHighWaterMark()) break;
+			if (coalesce && it == itLast) break;
+
+			if ((*it)->responseTypeNodeId_ == publishResponseTypeId) {
+				sendQueueBytes_ -= (*it)->sendQueueSize_;
+				it = secureChannelTransactionList_.erase(it);
+				dropCount++;
+			}
+			else {
+				it++;
+			}
+		}
+
+		sendQueueDropCount_ += dropCount;
+		return dropCount;
+	}
+
+	bool
+	SecureChannel::sendQueueAboveHighWaterMark(void)
+	{
+		return sendQueueLimit_.aboveHighWaterMark(secureChannelTransactionList_.size(), sendQueueBytes_);
+	}
+
+	bool
+	SecureChannel::sendQueueBelowLowWaterMark(void)
+	{
+		return sendQueueLimit_.belowLowWaterMark(secureChannelTransactionList_.size(), sendQueueBytes_);
+	}
+
+	bool
+	SecureChannel::sendQueuePauseRead(void)
+	{
+		// reading requests is paused above the high water mark
+		if (!sendQueueAboveHighWaterMark()) return false;
+		recvPause_ = true;
+		return true;
+	}
+
+	bool
+	SecureChannel::sendQueueResumeRead(void)
+	{
+		// reading requests is continued below the low water mark, if the
+		// request window is not full
+		if (!recvPause_) return false;
+		if (!sendQueueBelowLowWaterMark() || requestWindowFull()) return false;
+		recvPause_ = false;
+		return true;
+	}
+
+	uint32_t
+	SecureChannel::sendQueueMessages(void)
+	{
+		return secureChannelTransactionList_.size();
+	}
+
+	uint32_t
+	SecureChannel::sendQueueBytes(void)
+	{
+		return sendQueueBytes_;
+	}
+
+	uint32_t
+	SecureChannel::sendQueueMaxMessages(void)
+	{
+		return sendQueueMaxMessages_;
+	}
+
+	uint32_t
+	SecureChannel::sendQueueMaxBytes(void)
+	{
+		return sendQueueMaxBytes_;
+	}
+
+	uint32_t
+	SecureChannel::sendQueueDropCount(void)
+	{
+		return sendQueueDropCount_;
+	}
+
+	// ------------------------------------------------------------------------
+	//
+	// request window
+	//
+	// ------------------------------------------------------------------------
+	void
+	SecureChannel::requestWindowEnter(SecureChannelTransaction::SPtr& secureChannelTransaction)
+	{
+		requestWindow_->request();
+
+		// publish requests are parked in the server until a notification
+		// is available. They do not use a place in the request window,
+		// otherwise a client with many publish requests would block the
+		// channel.
+		OpcUaNodeId publishRequestTypeId(OpcUaId_PublishRequest_Encoding_DefaultBinary);
+		if (secureChannelTransaction->requestTypeNodeId_ == publishRequestTypeId) {
+			return;
+		}
+
+		// the place is released when the response is sent or when the
+		// request is deleted without a response
+		secureChannelTransaction->requestWindowSlot_ = requestWindow_->enter();
+	}
+
+	void
+	SecureChannel::requestWindowLeave(SecureChannelTransaction::SPtr& secureChannelTransaction)
+	{
+		secureChannelTransaction->requestWindowSlot_.reset();
+	}
+
+	bool
+	SecureChannel::requestWindowFull(void)
+	{
+		return requestWindow_->full();
+	}
+
+	void
+	SecureChannel::requestWindowStatistic(
+		uint32_t& requestCount,
+		uint32_t& requestsInFlight,
+		uint32_t& requestsInFlightMax,
+		uint32_t& pauseCount
+	)
+	{
+		requestWindow_->statistic(requestCount, requestsInFlight, requestsInFlightMax, pauseCount);
+	}
+
+	OpcUaUInt32
+	SecureChannel::nextChannelId(void)
+	{
+		// secure channels are opened by different io threads
+		boost::mutex::scoped_lock g(gChannelIdMutex_);
+		gChannelId_++;
+		return gChannelId_;
+	}
+
 	void
 	SecureChannel::debugRead(const std::string& message)
 	{
@@ -384,6 +649,56 @@ namespace OpcUaStackCore
 			.parameter("RequestId", secureChannelTransaction->requestId_);
 	}
 
-}
+	void
+	SecureChannel::captureOpen(void)
+	{
+		if (capture_.get() == nullptr) return;
+		capture_->writeOpen(channelId_, endpointUrl_);
+	}
+
+	void
+	SecureChannel::captureRecvMessageRequest(SecureChannelTransaction::SPtr& secureChannelTransaction)
+	{
+		if (capture_.get() == nullptr) return;
+
+		OpcUaUInt32 typeId = 0;
+		OpcUaUInt16 namespaceIndex = 0;
+		secureChannelTransaction->requestTypeNodeId_.get(typeId, namespaceIndex);
+		capture_->writeRequest(
+			channelId_,
+			secureChannelTransaction->requestId_,
+			typeId,
+			secureChannelTransaction->is_
+		);
+	}
+
+	void
+	SecureChannel::captureSendMessageResponse(SecureChannelTransaction::SPtr& secureChannelTransaction)
+	{
+		if (capture_.get() == nullptr) return;
+
+		// a streamed response is recorded after its last chunk is encoded
+		uint32_t size = secureChannelTransaction->os_.size();
+		if (secureChannelTransaction->chunkBuffer_.get() != nullptr) {
+			size = secureChannelTransaction->chunkBuffer_->messageSize();
+		}
 
+		OpcUaUInt32 typeId = 0;
+		OpcUaUInt16 namespaceIndex = 0;
+		secureChannelTransaction->responseTypeNodeId_.get(typeId, namespaceIndex);
+		capture_->writeResponse(
+			channelId_,
+			secureChannelTransaction->requestId_,
+			typeId,
+			size
+		);
+	}
 
+	void
+	SecureChannel::captureClose(void)
+	{
+		if (capture_.get() == nullptr || channelId_ == 0) return;
+		capture_->writeClose(channelId_);
+	}
+
+}
@@ -19,6 +19,8 @@
 #ifndef __OpcUaStackCore_SecureChannel_h__
 #define __OpcUaStackCore_SecureChannel_h__
 
+#include <boost/thread/mutex.hpp>
+#include <boost/asio/deadline_timer.hpp>
 #include "OpcUaStackCore/TCPChannel/TCPConnection.h"
 #include "OpcUaStackCore/Utility/IOThread.h"
 #include "OpcUaStackCore/Certificate/CryptoBase.h"
@@ -27,6 +29,9 @@
 #include "OpcUaStackCore/SecureChannel/MessageHeader.h"
 #include "OpcUaStackCore/SecureChannel/SecurityHeader.h"
 #include "OpcUaStackCore/SecureChannel/SecureChannelTransaction.h"
+#include "OpcUaStackCore/SecureChannel/SendQueueLimit.h"
+#include "OpcUaStackCore/SecureChannel/SecureChannelCapture.h"
+#include "OpcUaStackCore/SecureChannel/RequestWindow.h"
 #include "OpcUaStackCore/SecureChannel/HelloMessage.h"
 #include "OpcUaStackCore/SecureChannel/AcknowledgeMessage.h"
 #include "OpcUaStackCore/SecureChannel/OpenSecureChannelRequest.h"
@@ -61,11 +66,50 @@ namespace OpcUaStackCore
 		//
 		// --------------------------------------------------------------------
 		SecureChannelSecuritySettings& securitySettings(void);
+		uint32_t sendChunkBodySize(void);
 
 		void handle(Object::SPtr& handle);
 		void handleReset(void);
 		Object::SPtr handle(void);
 
+		static OpcUaUInt32 nextChannelId(void);
+
+		// --------------------------------------------------------------------
+		//
+		// send queue
+		//
+		// --------------------------------------------------------------------
+		void sendQueuePush(SecureChannelTransaction::SPtr& secureChannelTransaction);
+		void sendQueuePop(void);
+		void sendQueueClear(void);
+		void sendQueueUpdate(void);
+		uint32_t sendQueueDrop(bool coalesce);
+		bool sendQueueAboveHighWaterMark(void);
+		bool sendQueueBelowLowWaterMark(void);
+		bool sendQueuePauseRead(void);
+		bool sendQueueResumeRead(void);
+
+		uint32_t sendQueueMessages(void);
+		uint32_t sendQueueBytes(void);
+		uint32_t sendQueueMaxMessages(void);
+		uint32_t sendQueueMaxBytes(void);
+		uint32_t sendQueueDropCount(void);
+
+		// --------------------------------------------------------------------
+		//
+		// request window
+		//
+		// --------------------------------------------------------------------
+		void requestWindowEnter(SecureChannelTransaction::SPtr& secureChannelTransaction);
+		void requestWindowLeave(SecureChannelTransaction::SPtr& secureChannelTransaction);
+		bool requestWindowFull(void);
+		void requestWindowStatistic(
+			uint32_t& requestCount,
+			uint32_t& requestsInFlight,
+			uint32_t& requestsInFlightMax,
+			uint32_t& pauseCount
+		);
+
 		void debugRecvHeader(MessageHeader& messageHeader);
 		void debugRecvHello(HelloMessage& hello);
 		void debugRecvAcknowledge(AcknowledgeMessage& acknowledge);
@@ -84,6 +128,11 @@ namespace OpcUaStackCore
 		void debugSendMessageRequest(SecureChannelTransaction::SPtr& secureChannelTransaction);
 		void debugSendMessageResponse(SecureChannelTransaction::SPtr& secureChannelTransaction);
 
+		void captureOpen(void);
+		void captureRecvMessageRequest(SecureChannelTransaction::SPtr& secureChannelTransaction);
+		void captureSendMessageResponse(SecureChannelTransaction::SPtr& secureChannelTransaction);
+		void captureClose(void);
+
 		// --------------------------------------------------------------------
 		// --------------------------------------------------------------------
 		//
@@ -127,6 +176,19 @@ namespace OpcUaStackCore
 
 		SecureChannelTransaction::SPtr secureChannelTransaction_;
 		SecureChannelTransaction::List secureChannelTransactionList_;
+		SendQueueLimit sendQueueLimit_;
+		uint32_t sendQueueBytes_;
+		uint32_t sendQueueMaxMessages_;
+		uint32_t sendQueueMaxBytes_;
+		uint32_t sendQueueDropCount_;
+		bool sendQueueOverload_;
+		bool recvPause_;
+		RequestWindow::SPtr requestWindow_;
+		bool admitted_;
+		bool handshake_;
+		boost::asio::deadline_timer handshakeTimer_;
+		bool handshakeTimerRunning_;
+		bool disconnectPending_;
 		OpenSecureChannelResponse::List openSecureChannelResponseList_;
 		bool sendFirstSegment_;
 		bool recvFirstSegment_;
@@ -149,8 +211,10 @@ namespace OpcUaStackCore
 
 		Object::SPtr handle_;
 		static OpcUaUInt32 gChannelId_;
+		static boost::mutex gChannelIdMutex_;
 
 		bool isLogging_;
+		SecureChannelCapture::SPtr capture_;
 
 	  private:
 		void debugRead(const std::string& message);
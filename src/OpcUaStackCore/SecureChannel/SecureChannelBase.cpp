@@ -411,8 +411,6 @@ namespace OpcUaStackCore
 	{
 		bool resultCode;
 
-		SecureChannelSecuritySettings& secureSettings = secureChannel->securitySettings();
-
 		// error accurred
 		if (error) {
 			Log(Error, "opc ua secure channel read OpenSecureChannelRequest message error; close channel")
@@ -450,6 +448,30 @@ namespace OpcUaStackCore
 			return;
 		}
 
+		// the asymmetric decryption and verification is done by the crypto
+		// pool. The receiver remains busy until the request is processed
+		// in the strand of the secure channel
+		if (useCryptoPool(secureChannel)) {
+			secureChannel->asyncRecv_ = true;
+			bool success = cryptoPool()->post(
+				boost::bind(
+					&SecureChannelBase::cryptoReceivedOpenSecureChannelRequest,
+					this,
+					secureChannel
+				)
+			);
+			if (!success) {
+				Log(Warning, "opc ua secure channel crypto pool overload; close channel")
+					.parameter("Local", secureChannel->local_.address().to_string())
+					.parameter("Partner", secureChannel->partner_.address().to_string())
+					.parameter("QueueLength", cryptoPool()->queueLength());
+
+				secureChannel->asyncRecv_ = false;
+				closeChannel(secureChannel, true);
+			}
+			return;
+		}
+
 		// handle security
 		if (secureReceivedOpenSecureChannelRequest(secureChannel) != Success) {
 			Log(Debug, "opc ua secure channel decrypt received message error")
@@ -460,6 +482,59 @@ namespace OpcUaStackCore
 			return;
 		}
 
+		processOpenSecureChannelRequest(secureChannel);
+	}
+
+	void
+	SecureChannelBase::cryptoReceivedOpenSecureChannelRequest(SecureChannel* secureChannel)
+	{
+		// this function is called by a thread of the crypto pool
+		OpcUaStatusCode statusCode = secureReceivedOpenSecureChannelRequest(secureChannel);
+
+		secureChannel->strand()->post(
+			boost::bind(
+				&SecureChannelBase::handleCryptoOpenSecureChannelRequest,
+				this,
+				statusCode,
+				secureChannel
+			)
+		);
+	}
+
+	void
+	SecureChannelBase::handleCryptoOpenSecureChannelRequest(
+		OpcUaStatusCode statusCode,
+		SecureChannel* secureChannel
+	)
+	{
+		// the secure channel is not deleted while the crypto pool is busy,
+		// because the receiver is marked as busy. A disconnect during this
+		// time only changes the state of the secure channel
+		secureChannel->asyncRecv_ = false;
+
+		if (secureChannel->state_ == SecureChannel::S_CloseSecureChannel) {
+			closeChannel(secureChannel, true);
+			return;
+		}
+
+		if (statusCode != Success) {
+			Log(Debug, "opc ua secure channel decrypt received message error")
+				.parameter("Local", secureChannel->local_.address().to_string())
+				.parameter("Partner", secureChannel->partner_.address().to_string());
+
+			closeChannel(secureChannel, true);
+			return;
+		}
+
+		processOpenSecureChannelRequest(secureChannel);
+	}
+
+	void
+	SecureChannelBase::processOpenSecureChannelRequest(SecureChannel* secureChannel)
+	{
+		SecureChannelSecuritySettings& secureSettings = secureChannel->securitySettings();
+		std::iostream is(&secureChannel->recvBuffer_);
+
 		// encode sequence number
 		OpcUaNumber::opcUaBinaryDecode(is, secureChannel->recvSequenceNumber_);
 
@@ -800,18 +875,94 @@ namespace OpcUaStackCore
 		secureChannel->debugSendOpenSecureChannelResponse(*openSecureChannelResponse);
 
 		// handle security
-		MemoryBuffer plainText(sb2, sb1);
-		MemoryBuffer encryptedText;
+		MemoryBuffer::SPtr plainText = constructSPtr<MemoryBuffer>();
+		plainText->set(sb2, sb1);
+		secureChannel->asyncSend_ = true;
+
+		// the asymmetric signature and encryption is done by the crypto pool.
+		// The sender remains busy until the response is written
+		if (useCryptoPool(secureChannel)) {
+			bool success = cryptoPool()->post(
+				boost::bind(
+					&SecureChannelBase::cryptoSendOpenSecureChannelResponse,
+					this,
+					plainText,
+					secureChannel
+				)
+			);
+			if (!success) {
+				Log(Warning, "opc ua secure channel crypto pool overload; close channel")
+					.parameter("Local", secureChannel->local_.address().to_string())
+					.parameter("Partner", secureChannel->partner_.address().to_string())
+					.parameter("QueueLength", cryptoPool()->queueLength());
+
+				secureChannel->asyncSend_ = false;
+				closeChannel(secureChannel, true);
+			}
+			return;
+		}
 
-		if (secureSendOpenSecureChannelResponse(plainText, encryptedText, secureChannel) != Success) {
+		MemoryBuffer::SPtr encryptedText = constructSPtr<MemoryBuffer>();
+		OpcUaStatusCode statusCode = secureSendOpenSecureChannelResponse(*plainText, *encryptedText, secureChannel);
+		writeOpenSecureChannelResponse(statusCode, encryptedText, secureChannel);
+	}
+
+	void
+	SecureChannelBase::cryptoSendOpenSecureChannelResponse(
+		MemoryBuffer::SPtr plainText,
+		SecureChannel* secureChannel
+	)
+	{
+		// this function is called by a thread of the crypto pool
+		MemoryBuffer::SPtr encryptedText = constructSPtr<MemoryBuffer>();
+		OpcUaStatusCode statusCode = secureSendOpenSecureChannelResponse(*plainText, *encryptedText, secureChannel);
+
+		secureChannel->strand()->post(
+			boost::bind(
+				&SecureChannelBase::writeOpenSecureChannelResponse,
+				this,
+				statusCode,
+				encryptedText,
+				secureChannel
+			)
+		);
+	}
+
+	void
+	SecureChannelBase::writeOpenSecureChannelResponse(
+		OpcUaStatusCode statusCode,
+		MemoryBuffer::SPtr encryptedText,
+		SecureChannel* secureChannel
+	)
+	{
+		// the secure channel is closed
+		if (secureChannel->asyncSendStop_) {
+			secureChannel->asyncSend_ = false;
+			closeChannel(secureChannel);
+			return;
+		}
+
+		if (statusCode != Success) {
 			Log(Debug, "opc ua secure channel encrypt send message error")
 				.parameter("Local", secureChannel->local_.address().to_string())
 				.parameter("Partner", secureChannel->partner_.address().to_string());
+
+			// a pending receive is finished by closing the socket and the
+			// receiver closes the secure channel
+			secureChannel->asyncSend_ = false;
+			if (secureChannel->asyncRecv_) {
+				secureChannel->close();
+				return;
+			}
+			closeChannel(secureChannel, true);
 			return;
 		}
 
-		encryptedText.get(secureChannel->sendBuffer_);
-		secureChannel->asyncSend_ = true;
+		// the key set of the new security token can be used as soon as
+		// the partner has received the response
+		secureChannel->securitySettings().nextSecurityKeySetReady();
+
+		encryptedText->get(secureChannel->sendBuffer_);
 		secureChannel->async_write(
 			secureChannel->sendBuffer_,
 			boost::bind(
@@ -966,7 +1117,7 @@ namespace OpcUaStackCore
 	SecureChannelBase::handleWriteCloseSecureChannelRequestComplete(const boost::system::error_code& error, SecureChannel* secureChannel)
 	{
 		// interrupts reading loop -> handleDisconnect
-		secureChannel->socket().cancel();
+		secureChannel->cancelOperations();
 	}
 
 
@@ -1084,9 +1235,37 @@ namespace OpcUaStackCore
 		}
 
 		// message is completed
+		secureChannel->captureRecvMessageRequest(secureChannel->secureChannelTransaction_);
 		secureChannel->secureChannelTransaction_->cryptoBase_ = secureChannel->securitySettings_.cryptoBase();
+		secureChannel->requestWindowEnter(secureChannel->secureChannelTransaction_);
 		handleRecvMessageRequest(secureChannel);
 		secureChannel->secureChannelTransaction_.reset();
+
+		// stop reading new requests until a request of the request window
+		// is finished
+		if (secureChannel->requestWindow_->pause()) {
+			if (secureChannel->isLogging_) {
+				Log(Debug, "opc ua secure channel request window full; pause reading")
+					.parameter("Local", secureChannel->local_.address().to_string())
+					.parameter("Partner", secureChannel->partner_.address().to_string())
+					.parameter("WindowSize", secureChannel->requestWindow_->windowSize());
+			}
+
+			secureChannel->recvPause_ = true;
+			return;
+		}
+
+		// stop reading new requests until the send queue falls below
+		// the low water mark
+		if (secureChannel->sendQueuePauseRead()) {
+			Log(Debug, "opc ua secure channel pause reading")
+				.parameter("Local", secureChannel->local_.address().to_string())
+				.parameter("Partner", secureChannel->partner_.address().to_string())
+				.parameter("QueueMessages", secureChannel->sendQueueMessages())
+				.parameter("QueueBytes", secureChannel->sendQueueBytes());
+			return;
+		}
+
 		asyncRead(secureChannel);
 	}
 
@@ -1104,7 +1283,7 @@ namespace OpcUaStackCore
 		SecureChannelTransaction::SPtr secureChannelTransaction
 	)
 	{
-		secureChannel->secureChannelTransactionList_.push_back(secureChannelTransaction);
+		secureChannel->sendQueuePush(secureChannelTransaction);
 		asyncWriteMessageRequest(secureChannel);
 	}
 
@@ -1185,7 +1364,7 @@ namespace OpcUaStackCore
 			secureChannel->sendFirstSegment_ = false;
 		}
 		else {
-			secureChannel->secureChannelTransactionList_.pop_front();
+			secureChannel->sendQueuePop();
 			secureChannel->sendFirstSegment_ = true;
 
 			secureChannel->async_write(
@@ -1327,7 +1506,13 @@ namespace OpcUaStackCore
 		SecureChannelTransaction::SPtr secureChannelTransaction
 	)
 	{
-		secureChannel->secureChannelTransactionList_.push_back(secureChannelTransaction);
+		secureChannel->sendQueuePush(secureChannelTransaction);
+
+		// check send queue limits
+		if (secureChannel->sendQueueAboveHighWaterMark()) {
+			if (!handleSendQueueOverload(secureChannel)) return;
+		}
+
 		asyncWriteMessageResponse(secureChannel);
 	}
 
@@ -1339,6 +1524,12 @@ namespace OpcUaStackCore
 
 		SecureChannelTransaction::SPtr secureChannelTransaction = secureChannel->secureChannelTransactionList_.front();
 
+		// the response is encoded in chunks while it is sent
+		if (secureChannelTransaction->chunkBuffer_.get() != nullptr) {
+			asyncWriteMessageChunk(secureChannel, secureChannelTransaction);
+			return;
+		}
+
 		boost::asio::streambuf sb1;
 		std::iostream ios1(&sb1);
 		boost::asio::streambuf sb2;
@@ -1348,7 +1539,7 @@ namespace OpcUaStackCore
 		OpcUaNumber::opcUaBinaryEncode(ios1, secureChannel->channelId_);
 
 		// encode token id
-		OpcUaNumber::opcUaBinaryEncode(ios1, secureChannelTransaction->securityTokenId_);
+		OpcUaNumber::opcUaBinaryEncode(ios1, sendSecurityTokenId(secureChannel, secureChannelTransaction->securityTokenId_));
 
 		// encode sequence number
 		secureChannel->sendSequenceNumber_++;
@@ -1422,7 +1613,7 @@ namespace OpcUaStackCore
 			secureChannel->sendFirstSegment_ = false;
 		}
 		else {
-			secureChannel->secureChannelTransactionList_.pop_front();
+			secureChannel->sendQueuePop();
 			secureChannel->sendFirstSegment_ = true;
 
 			// handle security
@@ -1451,6 +1642,103 @@ namespace OpcUaStackCore
 		}
 	}
 
+	void
+	SecureChannelBase::asyncWriteMessageChunk(
+		SecureChannel* secureChannel,
+		SecureChannelTransaction::SPtr& secureChannelTransaction
+	)
+	{
+		MessageChunkBuffer::SPtr chunkBuffer = secureChannelTransaction->chunkBuffer_;
+
+		boost::asio::streambuf sb;
+		std::iostream ios(&sb);
+
+		// get next chunk body. The body of the first chunk already contains
+		// the message type id
+		bool lastChunk = false;
+		if (chunkBuffer->aborted()) {
+			// the response exceeds the limits of the client. Abort the message
+			// with an error code and a reason
+			secureChannel->actSegmentFlag_ = 'A';
+			OpcUaNumber::opcUaBinaryEncode(ios, (OpcUaUInt32)BadResponseTooLarge);
+			OpcUaString reason;
+			reason.value("response exceeds MaxChunkCount or MaxMessageSize");
+			reason.opcUaBinaryEncode(ios);
+
+			Log(Error, "opc ua secure channel abort response")
+				.parameter("Local", secureChannel->local_.address().to_string())
+				.parameter("Partner", secureChannel->partner_.address().to_string())
+				.parameter("RequestId", secureChannelTransaction->requestId_)
+				.parameter("MaxChunkCount", secureChannel->maxChunkCount_)
+				.parameter("MaxMessageSize", secureChannel->maxMessageSize_);
+		}
+		else if (chunkBuffer->getChunk(sb, lastChunk)) {
+			secureChannel->actSegmentFlag_ = lastChunk ? 'F' : 'C';
+		}
+		else {
+			// the encoder has not finished the next chunk yet
+			return;
+		}
+
+		boost::asio::streambuf sb1;
+		std::iostream ios1(&sb1);
+		boost::asio::streambuf sb2;
+		std::iostream ios2(&sb2);
+
+		// encode channel id, token id, sequence number and request id
+		OpcUaNumber::opcUaBinaryEncode(ios1, secureChannel->channelId_);
+		OpcUaNumber::opcUaBinaryEncode(ios1, sendSecurityTokenId(secureChannel, secureChannelTransaction->securityTokenId_));
+		secureChannel->sendSequenceNumber_++;
+		OpcUaNumber::opcUaBinaryEncode(ios1, secureChannel->sendSequenceNumber_);
+		OpcUaNumber::opcUaBinaryEncode(ios1, secureChannelTransaction->requestId_);
+
+		// encode MessageHeader
+		uint32_t packetSize = OpcUaStackCore::count(sb1) + 8 + OpcUaStackCore::count(sb);
+		MessageHeader::SPtr messageHeaderSPtr = constructSPtr<MessageHeader>();
+		messageHeaderSPtr->messageType(MessageType_Message);
+		messageHeaderSPtr->segmentFlag(secureChannel->actSegmentFlag_);
+		messageHeaderSPtr->messageSize(packetSize);
+		messageHeaderSPtr->opcUaBinaryEncode(ios2);
+
+		// debug output
+		secureChannel->debugSendHeader(secureChannel->messageHeader_);
+		secureChannel->debugSendMessageResponse(secureChannelTransaction);
+
+		if (secureChannel->actSegmentFlag_ == 'C') {
+			secureChannel->sendFirstSegment_ = false;
+		}
+		else {
+			secureChannel->captureSendMessageResponse(secureChannelTransaction);
+			secureChannel->sendQueuePop();
+			secureChannel->sendFirstSegment_ = true;
+		}
+
+		// handle security
+		MemoryBuffer plainText(sb2, sb1, sb);
+		MemoryBuffer encryptedText;
+
+		if (secureSendMessageResponse(plainText, encryptedText, secureChannel) != Success) {
+			Log(Debug, "opc ua secure channel encrypt send message error")
+				.parameter("Local", secureChannel->local_.address().to_string())
+				.parameter("Partner", secureChannel->partner_.address().to_string());
+			return;
+		}
+
+		encryptedText.get(secureChannel->sendBuffer_);
+
+		// send chunk
+		secureChannel->asyncSend_ = true;
+		secureChannel->async_write(
+			secureChannel->sendBuffer_,
+			boost::bind(
+				&SecureChannelBase::handleWriteMessageResponseComplete,
+				this,
+				boost::asio::placeholders::error,
+				secureChannel
+			)
+		);
+	}
+
 	void
 	SecureChannelBase::handleWriteMessageResponseComplete(
 		const boost::system::error_code& error,
@@ -1490,7 +1778,23 @@ namespace OpcUaStackCore
 			Log(Debug, "handle write complete");
 		}
 
-		if (secureChannel->actSegmentFlag_ == 'F') {
+		// continue reading requests
+		if (secureChannel->sendQueueBelowLowWaterMark()) {
+			if (secureChannel->sendQueueOverload_) {
+				Log(Info, "opc ua secure channel send queue below low water mark")
+					.parameter("Local", secureChannel->local_.address().to_string())
+					.parameter("Partner", secureChannel->partner_.address().to_string())
+					.parameter("QueueMessages", secureChannel->secureChannelTransactionList_.size())
+					.parameter("QueueBytes", secureChannel->sendQueueBytes_);
+				secureChannel->sendQueueOverload_ = false;
+			}
+
+			if (secureChannel->sendQueueResumeRead()) {
+				asyncRead(secureChannel);
+			}
+		}
+
+		if (secureChannel->actSegmentFlag_ != 'C') {
 			asyncWriteOpenSecureChannelResponse(secureChannel);
 			if (secureChannel->asyncSend_) return;
 		}
@@ -1565,6 +1869,61 @@ namespace OpcUaStackCore
 	//
 	// ------------------------------------------------------------------------
 	// ------------------------------------------------------------------------
+	bool
+	SecureChannelBase::handleSendQueueOverload(SecureChannel* secureChannel)
+	{
+		SlowConsumerPolicy slowConsumerPolicy = secureChannel->sendQueueLimit_.slowConsumerPolicy();
+
+		if (!secureChannel->sendQueueOverload_) {
+			Log(Warning, "opc ua secure channel send queue above high water mark")
+				.parameter("Local", secureChannel->local_.address().to_string())
+				.parameter("Partner", secureChannel->partner_.address().to_string())
+				.parameter("QueueMessages", secureChannel->secureChannelTransactionList_.size())
+				.parameter("QueueBytes", secureChannel->sendQueueBytes_)
+				.parameter("Policy", SendQueueLimit::slowConsumerPolicyToString(slowConsumerPolicy));
+			secureChannel->sendQueueOverload_ = true;
+		}
+
+		switch (slowConsumerPolicy)
+		{
+			case SCP_DropOldest:
+			{
+				secureChannel->sendQueueDrop(false);
+				break;
+			}
+			case SCP_Coalesce:
+			{
+				secureChannel->sendQueueDrop(true);
+				break;
+			}
+			case SCP_Close:
+			{
+				// close the socket. Pending read and write operations are
+				// finished with an error and close the secure channel.
+				secureChannel->close();
+				secureChannel->state_ = SecureChannel::S_CloseSecureChannel;
+				if (!secureChannel->asyncRecv_ && !secureChannel->asyncSend_) {
+					closeChannel(secureChannel);
+				}
+				return false;
+			}
+		}
+
+		return true;
+	}
+
+	bool
+	SecureChannelBase::useCryptoPool(SecureChannel* secureChannel)
+	{
+		if (cryptoPool().get() == nullptr) {
+			return false;
+		}
+
+		// only asymmetric operations are passed to the crypto pool
+		SecurityHeader& securityHeader = secureChannel->securityHeader_;
+		return securityHeader.isEncryptionEnabled() || securityHeader.isSignatureEnabled();
+	}
+
 	void
 	SecureChannelBase::closeChannel(SecureChannel* secureChannel, bool close)
 	{
@@ -1578,7 +1937,7 @@ namespace OpcUaStackCore
 		secureChannel->asyncSendStop_ = false;
 
 		// cleanup send queue
-		secureChannel->secureChannelTransactionList_.clear();
+		secureChannel->sendQueueClear();
 
 		// signal disconnect to session
 		handleDisconnect(secureChannel);
@@ -80,6 +80,10 @@ namespace OpcUaStackCore
 			SecureChannelTransaction::SPtr secureChannelTransaction
 		);
 		void asyncWriteMessageResponse(SecureChannel* secureChannel);
+		void asyncWriteMessageChunk(
+			SecureChannel* secureChannel,
+			SecureChannelTransaction::SPtr& secureChannelTransaction
+		);
 
 
 		//
@@ -137,6 +141,13 @@ namespace OpcUaStackCore
 		void asyncReadErrorComplete(const boost::system::error_code& error, std::size_t bytes_transfered, SecureChannel* secureChannel);
 
 
+		void cryptoReceivedOpenSecureChannelRequest(SecureChannel* secureChannel);
+		void handleCryptoOpenSecureChannelRequest(OpcUaStatusCode statusCode, SecureChannel* secureChannel);
+		void processOpenSecureChannelRequest(SecureChannel* secureChannel);
+		void cryptoSendOpenSecureChannelResponse(MemoryBuffer::SPtr plainText, SecureChannel* secureChannel);
+		void writeOpenSecureChannelResponse(OpcUaStatusCode statusCode, MemoryBuffer::SPtr encryptedText, SecureChannel* secureChannel);
+
+
 		void handleWriteAcknowledgeComplete(const boost::system::error_code& error, SecureChannel* secureChannel);
 		void handleWriteHelloComplete(const boost::system::error_code& error, SecureChannel* secureChannel);
 		void handleWriteOpenSecureChannelRequestComplete(const boost::system::error_code& error, SecureChannel* secureChannel);
@@ -146,7 +157,11 @@ namespace OpcUaStackCore
 		void handleWriteMessageResponseComplete(const boost::system::error_code& error, SecureChannel* secureChannel);
 		void handleWriteComplete(SecureChannel* secureChannel);
 
+	  protected:
+		bool handleSendQueueOverload(SecureChannel* secureChannel);
 
+	  private:
+		bool useCryptoPool(SecureChannel* secureChannel);
 		void closeChannel(SecureChannel* secureChannel, bool close = false);
 		void consumeAll(boost::asio::streambuf& streambuf);
 
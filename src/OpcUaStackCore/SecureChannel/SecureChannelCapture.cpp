@@ -0,0 +1,379 @@
+/*
+   Copyright 2015 Kai Huebl (kai@huebl-sgh.de)
+
+   Lizenziert gemäß Apache Licence Version 2.0 (die „Lizenz“); Nutzung dieser
+   Datei nur in Übereinstimmung mit der Lizenz erlaubt.
+   Eine Kopie der Lizenz erhalten Sie auf http://www.apache.org/licenses/LICENSE-2.0.
+
+   Sofern nicht gemäß geltendem Recht vorgeschrieben oder schriftlich vereinbart,
+   erfolgt die Bereitstellung der im Rahmen der Lizenz verbreiteten Software OHNE
+   GEWÄHR ODER VORBEHALTE – ganz gleich, ob ausdrücklich oder stillschweigend.
+
+   Informationen über die jeweiligen Bedingungen für Genehmigungen und Einschränkungen
+   im Rahmen der Lizenz finden Sie in der Lizenz.
+
+   Autor: Kai Huebl (kai@huebl-sgh.de)
+ */
+
+
+#include <boost/bind.hpp>
+#include <boost/date_time/posix_time/posix_time.hpp>
+#include <sstream>
+#include <string.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/stat.h>
+#include "OpcUaStackCore/Base/Log.h"
+#include "OpcUaStackCore/BuildInTypes/OpcUaNumber.h"
+#include "OpcUaStackCore/SecureChannel/SecureChannelCapture.h"
+
+namespace OpcUaStackCore
+{
+
+	// ------------------------------------------------------------------------
+	// ------------------------------------------------------------------------
+	//
+	// SecureChannelCaptureRecord
+	//
+	// ------------------------------------------------------------------------
+	// ------------------------------------------------------------------------
+	SecureChannelCaptureRecord::SecureChannelCaptureRecord(void)
+	: recordType_(CRT_Open)
+	, channelId_(0)
+	, time_(0)
+	, requestId_(0)
+	, typeId_(0)
+	, size_(0)
+	, data_()
+	{
+	}
+
+	SecureChannelCaptureRecord::~SecureChannelCaptureRecord(void)
+	{
+	}
+
+	// ------------------------------------------------------------------------
+	// ------------------------------------------------------------------------
+	//
+	// SecureChannelCapture
+	//
+	// ------------------------------------------------------------------------
+	// ------------------------------------------------------------------------
+	SecureChannelCapture::SecureChannelCapture(void)
+	: fileName_()
+	, maxFileSize_(0)
+	, mutex_()
+	, writerCondition_()
+	, writerThread_(nullptr)
+	, stop_(false)
+	, fd_(-1)
+	, fileSize_(0)
+	, pendingSize_(0)
+	, pendingVec_()
+	, numberRecords_(0)
+	, droppedRecords_(0)
+	{
+	}
+
+	SecureChannelCapture::~SecureChannelCapture(void)
+	{
+		close();
+	}
+
+	void
+	SecureChannelCapture::maxFileSize(uint64_t maxFileSize)
+	{
+		boost::mutex::scoped_lock g(mutex_);
+		maxFileSize_ = maxFileSize;
+	}
+
+	uint64_t
+	SecureChannelCapture::maxFileSize(void)
+	{
+		boost::mutex::scoped_lock g(mutex_);
+		return maxFileSize_;
+	}
+
+	bool
+	SecureChannelCapture::open(const std::string& fileName)
+	{
+		boost::mutex::scoped_lock g(mutex_);
+		if (fd_ >= 0) {
+			Log(Error, "secure channel capture file already open")
+				.parameter("FileName", fileName_);
+			return false;
+		}
+
+		// the capture file contains the decrypted requests. An existing file
+		// keeps its access mode and is changed to owner access only.
+		fd_ = ::open(fileName.c_str(), O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, S_IRUSR | S_IWUSR);
+		if (fd_ < 0) {
+			Log(Error, "open secure channel capture file error")
+				.parameter("FileName", fileName)
+				.parameter("Message", strerror(errno));
+			return false;
+		}
+		if (::fchmod(fd_, S_IRUSR | S_IWUSR) != 0) {
+			Log(Error, "set access mode of secure channel capture file error")
+				.parameter("FileName", fileName)
+				.parameter("Message", strerror(errno));
+			::close(fd_);
+			fd_ = -1;
+			return false;
+		}
+
+		fileName_ = fileName;
+		std::stringstream ss;
+		OpcUaNumber::opcUaBinaryEncode(ss, (OpcUaUInt32)Magic);
+		OpcUaNumber::opcUaBinaryEncode(ss, (OpcUaUInt32)Version);
+		std::string header = ss.str();
+		if (!writeFile(header.c_str(), header.size())) {
+			::close(fd_);
+			fd_ = -1;
+			return false;
+		}
+
+		fileSize_ = header.size();
+		pendingSize_ = 0;
+		numberRecords_ = 0;
+		droppedRecords_ = 0;
+		stop_ = false;
+		writerThread_ = new boost::thread(boost::bind(&SecureChannelCapture::writerLoop, this));
+		return true;
+	}
+
+	void
+	SecureChannelCapture::close(void)
+	{
+		boost::thread* writerThread = nullptr;
+
+		{
+			boost::mutex::scoped_lock g(mutex_);
+			if (fd_ < 0 || stop_) return;
+
+			stop_ = true;
+			writerThread = writerThread_;
+			writerThread_ = nullptr;
+			writerCondition_.notify_all();
+		}
+
+		// the writer thread writes all pending records before it stops
+		writerThread->join();
+		delete writerThread;
+
+		boost::mutex::scoped_lock g(mutex_);
+		::close(fd_);
+		fd_ = -1;
+		stop_ = false;
+	}
+
+	bool
+	SecureChannelCapture::isOpen(void)
+	{
+		boost::mutex::scoped_lock g(mutex_);
+		return fd_ >= 0 && !stop_;
+	}
+
+	uint32_t
+	SecureChannelCapture::numberRecords(void)
+	{
+		boost::mutex::scoped_lock g(mutex_);
+		return numberRecords_;
+	}
+
+	uint32_t
+	SecureChannelCapture::droppedRecords(void)
+	{
+		boost::mutex::scoped_lock g(mutex_);
+		return droppedRecords_;
+	}
+
+	void
+	SecureChannelCapture::writeOpen(uint32_t channelId, const std::string& endpointUrl)
+	{
+		writeRecord(CRT_Open, channelId, 0, 0, 0, endpointUrl.c_str(), endpointUrl.size());
+	}
+
+	void
+	SecureChannelCapture::writeRequest(uint32_t channelId, uint32_t requestId, uint32_t typeId, boost::asio::streambuf& sb)
+	{
+		// the request is copied without consuming the stream buffer
+		std::string data;
+		data.reserve(sb.size());
+		boost::asio::streambuf::const_buffers_type buffers = sb.data();
+		for (auto it = boost::asio::buffer_sequence_begin(buffers); it != boost::asio::buffer_sequence_end(buffers); it++) {
+			boost::asio::const_buffer buffer(*it);
+			data.append((const char*)buffer.data(), buffer.size());
+		}
+
+		writeRecord(CRT_Request, channelId, requestId, typeId, data.size(), data.c_str(), data.size());
+	}
+
+	void
+	SecureChannelCapture::writeResponse(uint32_t channelId, uint32_t requestId, uint32_t typeId, uint32_t size)
+	{
+		writeRecord(CRT_Response, channelId, requestId, typeId, size, nullptr, 0);
+	}
+
+	void
+	SecureChannelCapture::writeClose(uint32_t channelId)
+	{
+		writeRecord(CRT_Close, channelId, 0, 0, 0, nullptr, 0);
+	}
+
+	void
+	SecureChannelCapture::writeRecord(
+		CaptureRecordType recordType,
+		uint32_t channelId,
+		uint32_t requestId,
+		uint32_t typeId,
+		uint32_t size,
+		const char* data,
+		uint32_t dataLength
+	)
+	{
+		// the record is encoded by the calling thread. The lock is only held
+		// to pass it to the writer thread.
+		std::stringstream ss;
+		OpcUaNumber::opcUaBinaryEncode(ss, (OpcUaByte)recordType);
+		OpcUaNumber::opcUaBinaryEncode(ss, (OpcUaUInt32)channelId);
+		OpcUaNumber::opcUaBinaryEncode(ss, (OpcUaUInt64)now());
+		OpcUaNumber::opcUaBinaryEncode(ss, (OpcUaUInt32)requestId);
+		OpcUaNumber::opcUaBinaryEncode(ss, (OpcUaUInt32)typeId);
+		OpcUaNumber::opcUaBinaryEncode(ss, (OpcUaUInt32)size);
+		OpcUaNumber::opcUaBinaryEncode(ss, (OpcUaUInt32)dataLength);
+		std::string record = ss.str();
+		if (dataLength > 0) {
+			record.append(data, dataLength);
+		}
+
+		boost::mutex::scoped_lock g(mutex_);
+		if (fd_ < 0 || stop_) return;
+
+		if ((maxFileSize_ != 0 && fileSize_ + record.size() > maxFileSize_) ||
+			pendingSize_ + record.size() > MaxPendingSize) {
+			if (droppedRecords_ == 0) {
+				Log(Warning, "secure channel capture limit reached; drop records")
+					.parameter("FileName", fileName_)
+					.parameter("FileSize", fileSize_)
+					.parameter("MaxFileSize", maxFileSize_)
+					.parameter("PendingSize", pendingSize_);
+			}
+			droppedRecords_++;
+			return;
+		}
+
+		fileSize_ += record.size();
+		pendingSize_ += record.size();
+		pendingVec_.push_back(std::string());
+		pendingVec_.back().swap(record);
+		numberRecords_++;
+		writerCondition_.notify_one();
+	}
+
+	void
+	SecureChannelCapture::writerLoop(void)
+	{
+		std::vector<std::string> recordVec;
+
+		boost::mutex::scoped_lock g(mutex_);
+		while (true) {
+			while (pendingVec_.empty() && !stop_) {
+				writerCondition_.wait(g);
+			}
+			if (pendingVec_.empty()) {
+				return;
+			}
+
+			// the file descriptor is not changed while the writer thread runs
+			recordVec.swap(pendingVec_);
+			pendingSize_ = 0;
+			g.unlock();
+
+			std::vector<std::string>::iterator it;
+			for (it = recordVec.begin(); it != recordVec.end(); it++) {
+				if (!writeFile(it->c_str(), it->size())) break;
+			}
+			recordVec.clear();
+
+			g.lock();
+		}
+	}
+
+	bool
+	SecureChannelCapture::writeFile(const char* data, size_t dataLength)
+	{
+		while (dataLength > 0) {
+			ssize_t result = ::write(fd_, data, dataLength);
+			if (result < 0) {
+				if (errno == EINTR) continue;
+
+				Log(Error, "write secure channel capture file error")
+					.parameter("FileName", fileName_)
+					.parameter("Message", strerror(errno));
+				return false;
+			}
+			data += result;
+			dataLength -= result;
+		}
+		return true;
+	}
+
+	uint64_t
+	SecureChannelCapture::now(void)
+	{
+		static const boost::posix_time::ptime epoch(boost::gregorian::date(1970, 1, 1));
+		boost::posix_time::time_duration duration = boost::posix_time::microsec_clock::universal_time() - epoch;
+		return duration.total_microseconds();
+	}
+
+	bool
+	SecureChannelCapture::readHeader(std::istream& is)
+	{
+		OpcUaUInt32 magic = 0;
+		OpcUaUInt32 version = 0;
+		OpcUaNumber::opcUaBinaryDecode(is, magic);
+		OpcUaNumber::opcUaBinaryDecode(is, version);
+		return is.good() && magic == Magic && version == Version;
+	}
+
+	bool
+	SecureChannelCapture::readRecord(std::istream& is, SecureChannelCaptureRecord& record)
+	{
+		OpcUaByte recordType = 0;
+		OpcUaUInt32 channelId = 0;
+		OpcUaUInt64 time = 0;
+		OpcUaUInt32 requestId = 0;
+		OpcUaUInt32 typeId = 0;
+		OpcUaUInt32 size = 0;
+		OpcUaUInt32 dataLength = 0;
+
+		OpcUaNumber::opcUaBinaryDecode(is, recordType);
+		OpcUaNumber::opcUaBinaryDecode(is, channelId);
+		OpcUaNumber::opcUaBinaryDecode(is, time);
+		OpcUaNumber::opcUaBinaryDecode(is, requestId);
+		OpcUaNumber::opcUaBinaryDecode(is, typeId);
+		OpcUaNumber::opcUaBinaryDecode(is, size);
+		OpcUaNumber::opcUaBinaryDecode(is, dataLength);
+		if (!is.good() || recordType < CRT_Open || recordType > CRT_Close) {
+			return false;
+		}
+
+		record.recordType_ = (CaptureRecordType)recordType;
+		record.channelId_ = channelId;
+		record.time_ = time;
+		record.requestId_ = requestId;
+		record.typeId_ = typeId;
+		record.size_ = size;
+		record.data_.resize(dataLength);
+		if (dataLength > 0) {
+			is.read(&record.data_[0], dataLength);
+			if ((uint32_t)is.gcount() != dataLength) {
+				return false;
+			}
+		}
+		return true;
+	}
+
+}
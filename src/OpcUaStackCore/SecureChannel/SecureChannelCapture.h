@@ -0,0 +1,133 @@
+/*
+   Copyright 2015 Kai Huebl (kai@huebl-sgh.de)
+
+   Lizenziert gemäß Apache Licence Version 2.0 (die „Lizenz“); Nutzung dieser
+   Datei nur in Übereinstimmung mit der Lizenz erlaubt.
+   Eine Kopie der Lizenz erhalten Sie auf http://www.apache.org/licenses/LICENSE-2.0.
+
+   Sofern nicht gemäß geltendem Recht vorgeschrieben oder schriftlich vereinbart,
+   erfolgt die Bereitstellung der im Rahmen der Lizenz verbreiteten Software OHNE
+   GEWÄHR ODER VORBEHALTE – ganz gleich, ob ausdrücklich oder stillschweigend.
+
+   Informationen über die jeweiligen Bedingungen für Genehmigungen und Einschränkungen
+   im Rahmen der Lizenz finden Sie in der Lizenz.
+
+   Autor: Kai Huebl (kai@huebl-sgh.de)
+ */
+
+
+#ifndef __OpcUaStackCore_SecureChannelCapture_h__
+#define __OpcUaStackCore_SecureChannelCapture_h__
+
+#include <boost/shared_ptr.hpp>
+#include <boost/thread/mutex.hpp>
+#include <boost/thread/condition.hpp>
+#include <boost/thread/thread.hpp>
+#include <boost/asio/streambuf.hpp>
+#include <string>
+#include <vector>
+#include <stdint.h>
+#include "OpcUaStackCore/Base/os.h"
+
+namespace OpcUaStackCore
+{
+
+	typedef enum
+	{
+		CRT_Open = 1,		// secure channel opened, data contains the endpoint url
+		CRT_Request,		// complete (decrypted) service request
+		CRT_Response,		// service response queued, data contains no body
+		CRT_Close			// secure channel closed
+	} CaptureRecordType;
+
+	class DLLEXPORT SecureChannelCaptureRecord
+	{
+	  public:
+		SecureChannelCaptureRecord(void);
+		~SecureChannelCaptureRecord(void);
+
+		CaptureRecordType recordType_;
+		uint32_t channelId_;
+		uint64_t time_;				// microseconds since 1970-01-01
+		uint32_t requestId_;
+		uint32_t typeId_;			// numeric encoding id of the message
+		uint32_t size_;				// size of the message body
+		std::string data_;
+	};
+
+	//
+	// The secure channel capture writes the traffic of the secure channels
+	// of a server into a binary file. Requests are recorded after they are
+	// decrypted and reassembled. Responses are only recorded with their
+	// size and time. The file is read by the secure channel replay tool.
+	//
+	// The records are encoded by the io threads and are written to the file
+	// by a writer thread. The file is created with access for the owner
+	// only, because it contains the decrypted requests. Records which exceed
+	// the maximum file size or the maximum size of the records waiting for
+	// the writer thread are dropped.
+	//
+	// file:   magic (uint32) version (uint32) record*
+	// record: type (byte) channelId (uint32) time (uint64) requestId (uint32)
+	//         typeId (uint32) size (uint32) dataLength (uint32) data
+	//
+	class DLLEXPORT SecureChannelCapture
+	{
+	  public:
+		typedef boost::shared_ptr<SecureChannelCapture> SPtr;
+
+		static const uint32_t Magic = 0x50414355;	// "UCAP"
+		static const uint32_t Version = 1;
+		static const uint32_t MaxPendingSize = 16 * 1024 * 1024;
+
+		SecureChannelCapture(void);
+		~SecureChannelCapture(void);
+
+		void maxFileSize(uint64_t maxFileSize);
+		uint64_t maxFileSize(void);
+		bool open(const std::string& fileName);
+		void close(void);
+		bool isOpen(void);
+		uint32_t numberRecords(void);
+		uint32_t droppedRecords(void);
+
+		void writeOpen(uint32_t channelId, const std::string& endpointUrl);
+		void writeRequest(uint32_t channelId, uint32_t requestId, uint32_t typeId, boost::asio::streambuf& sb);
+		void writeResponse(uint32_t channelId, uint32_t requestId, uint32_t typeId, uint32_t size);
+		void writeClose(uint32_t channelId);
+
+		static bool readHeader(std::istream& is);
+		static bool readRecord(std::istream& is, SecureChannelCaptureRecord& record);
+
+	  private:
+		void writeRecord(
+			CaptureRecordType recordType,
+			uint32_t channelId,
+			uint32_t requestId,
+			uint32_t typeId,
+			uint32_t size,
+			const char* data,
+			uint32_t dataLength
+		);
+		bool writeFile(const char* data, size_t dataLength);
+		void writerLoop(void);
+		uint64_t now(void);
+
+		std::string fileName_;
+		uint64_t maxFileSize_;
+
+		boost::mutex mutex_;
+		boost::condition writerCondition_;
+		boost::thread* writerThread_;
+		bool stop_;
+		int fd_;
+		uint64_t fileSize_;
+		uint32_t pendingSize_;
+		std::vector<std::string> pendingVec_;
+		uint32_t numberRecords_;
+		uint32_t droppedRecords_;
+	};
+
+}
+
+#endif
@@ -18,6 +18,7 @@
 #include "OpcUaStackCore/Base/Log.h"
 #include "OpcUaStackCore/Base/Url.h"
 #include "OpcUaStackCore/SecureChannel/SecureChannelClient.h"
+#include "OpcUaStackCore/TCPChannel/MemAcceptor.h"
 
 namespace OpcUaStackCore
 {
@@ -69,6 +70,15 @@ namespace OpcUaStackCore
 			return nullptr;
 		}
 
+		// the shared memory transport only supports the security modes
+		// None and Sign
+		Url url(secureChannelClientConfig->endpointUrl());
+		if (url.isSharedMemory() && secureChannelClientConfig->securityMode() == SM_SignAndEncrypt) {
+			Log(Error, "security mode not supported by shared memory transport")
+				.parameter("EndpointUrl", secureChannelClientConfig->endpointUrl());
+			return nullptr;
+		}
+
 		// set base configuration
 		renewTimeout_ = secureChannelClientConfig->renewTimeout();
 		reconnectTimeout_ = secureChannelClientConfig->reconnectTimeout();
@@ -83,7 +93,7 @@ namespace OpcUaStackCore
 	void SecureChannelClient::disconnect(SecureChannel* secureChannel)
 	{
 		if (secureChannel->state_ != SecureChannel::S_Established) {
-			secureChannel->socket().cancel();
+			secureChannel->cancelOperations();
 			secureChannel->state_ = SecureChannel::S_CloseSecureChannel;
 			return;
 		}
@@ -110,8 +120,48 @@ namespace OpcUaStackCore
 		secureChannel->securityPolicy_ = config->securityPolicy();
 		secureChannel->endpointUrl_ = config->endpointUrl();
 
-		// get ip address from hostname
+		// in process endpoints are connected directly by name
 		Url url(config->endpointUrl());
+		if (url.isMemory()) {
+			Log(Info, "connect secure channel to server")
+				.parameter("Name", url.memoryName());
+			secureChannel->memory(true);
+			secureChannel->state_ = SecureChannel::S_Connecting;
+
+			boost::system::error_code ec;
+			if (!MemAcceptor::connect(url.memoryName(), secureChannel->memStream())) {
+				ec = boost::asio::error::connection_refused;
+			}
+			secureChannel->io_service().post(
+				boost::bind(&SecureChannelClient::connectComplete, this, ec, secureChannel)
+			);
+			return;
+		}
+
+		// unix domain socket and shared memory endpoints need no address resolution
+		secureChannel->unixSocket(url.isUnixSocket() || url.isSharedMemory());
+		if (secureChannel->unixSocket()) {
+#if defined(BOOST_ASIO_HAS_LOCAL_SOCKETS)
+			Log(Info, "connect secure channel to server")
+				.parameter("Path", url.unixSocketPath());
+			secureChannel->state_ = SecureChannel::S_Connecting;
+			secureChannel->localSocket().async_connect(
+				boost::asio::local::stream_protocol::endpoint(url.unixSocketPath()),
+				boost::bind(
+					&SecureChannelClient::connectComplete,
+					this,
+					boost::asio::placeholders::error,
+					secureChannel
+				)
+			);
+#else
+			Log(Error, "unix domain sockets not supported")
+				.parameter("EndpointUrl", secureChannel->endpointUrl_);
+#endif
+			return;
+		}
+
+		// get ip address from hostname
 		secureChannel->partner_.port(url.port());
 		boost::asio::ip::tcp::resolver::query query(url.host(), url.portToString());
 		resolver_.async_resolve(
@@ -179,8 +229,52 @@ namespace OpcUaStackCore
 			return;
 		}
 
+#if defined(BOOST_ASIO_HAS_LOCAL_SOCKETS)
+		// the server passes the shared memory region over the unix domain
+		// socket before the hello message can be sent
+		if (secureChannel->unixSocket() && Url(secureChannel->endpointUrl_).isSharedMemory()) {
+			secureChannel->localSocket().async_wait(
+				boost::asio::local::stream_protocol::socket::wait_read,
+				boost::bind(
+					&SecureChannelClient::attachSharedMemoryComplete,
+					this,
+					boost::asio::placeholders::error,
+					secureChannel
+				)
+			);
+			return;
+		}
+#endif
+
+		sendHello(secureChannel);
+	}
+
+	void
+	SecureChannelClient::attachSharedMemoryComplete(
+		const boost::system::error_code& error,
+		SecureChannel* secureChannel
+	)
+	{
+		if (error || !secureChannel->attachSharedMemory()) {
+			Log(Info, "cannot attach shared memory of secure channel")
+				.parameter("EndpointUrl", secureChannel->endpointUrl_)
+				.parameter("Message", error.message());
+
+			secureChannel->close();
+			reconnect(secureChannel);
+			return;
+		}
+
+		sendHello(secureChannel);
+	}
+
+	void
+	SecureChannelClient::sendHello(SecureChannel* secureChannel)
+	{
 		asyncRead(secureChannel);
-		secureChannel->local_ = secureChannel->socket().local_endpoint();
+		if (!secureChannel->unixSocket() && !secureChannel->memory()) {
+			secureChannel->local_ = secureChannel->socket().local_endpoint();
+		}
 
 		Log(Info, "secure channel to server connected")
 			.parameter("Address", secureChannel->partner_.address().to_string())
@@ -60,6 +60,11 @@ namespace OpcUaStackCore
 			const boost::system::error_code& error,
 			SecureChannel* secureChannel
 		);
+		void attachSharedMemoryComplete(
+			const boost::system::error_code& error,
+			SecureChannel* secureChannel
+		);
+		void sendHello(SecureChannel* secureChannel);
 		void reconnect(SecureChannel* secureChannel);
 		void handleReconnect(SecureChannel* secureChannel);
 
@@ -24,6 +24,8 @@ namespace OpcUaStackCore
 	SecureChannelCrypto::SecureChannelCrypto(void)
 	: cryptoManager_()
 	, applicationCertificate_()
+	, cryptoPool_()
+	, certificateValidator_()
 	{
 	}
 
@@ -55,6 +57,30 @@ namespace OpcUaStackCore
 		return applicationCertificate_;
 	}
 
+	void
+	SecureChannelCrypto::cryptoPool(WorkerPool::SPtr& cryptoPool)
+	{
+		cryptoPool_ = cryptoPool;
+	}
+
+	WorkerPool::SPtr&
+	SecureChannelCrypto::cryptoPool(void)
+	{
+		return cryptoPool_;
+	}
+
+	void
+	SecureChannelCrypto::certificateValidator(CertificateValidator::SPtr& certificateValidator)
+	{
+		certificateValidator_ = certificateValidator;
+	}
+
+	CertificateValidator::SPtr&
+	SecureChannelCrypto::certificateValidator(void)
+	{
+		return certificateValidator_;
+	}
+
 	// ------------------------------------------------------------------------
 	// ------------------------------------------------------------------------
 	//
@@ -99,6 +125,20 @@ namespace OpcUaStackCore
 		if (securityHeader->isSignatureEnabled()) {
 			Certificate::SPtr partnerCertificate = securityHeader->certificateChain().getCertificate();
 			securitySettings.partnerCertificate(partnerCertificate);
+
+			// check if the partner certificate is trusted
+			if (certificateValidator_.get() != nullptr) {
+				if (partnerCertificate.get() == nullptr) {
+					return BadCertificateInvalid;
+				}
+				statusCode = certificateValidator_->validate(*partnerCertificate);
+				if (statusCode != Success) {
+					Log(Error, "partner certificate validation error")
+						.parameter("StatusCode", OpcUaStatusCodeMap::shortString(statusCode));
+					return statusCode;
+				}
+			}
+
 			statusCode = verifyReceivedOpenSecureChannelRequest(secureChannel);
 			if (statusCode != Success) {
 				return statusCode;
@@ -749,12 +789,13 @@ namespace OpcUaStackCore
 		CryptoBase::SPtr cryptoBase = securitySettings.cryptoBase();
 		PublicKey publicKey = securitySettings.partnerCertificate()->publicKey();
 
-		// create symmetric key set
+		// create symmetric key set of the new security token. The current
+		// key set remains in use until the partner uses the new token
 		statusCode = cryptoBase->deriveChannelKeyset(
 			securitySettings.clientNonce(),
 			securitySettings.serverNonce(),
-			securitySettings.securityKeySetClient(),
-			securitySettings.securityKeySetServer()
+			securitySettings.nextSecurityKeySetClient(),
+			securitySettings.nextSecurityKeySetServer()
 		);
 		if (statusCode != Success) {
 			return statusCode;
@@ -858,6 +899,14 @@ namespace OpcUaStackCore
 			return Success;
 		}
 
+		// select the key set of the security token used by the partner
+		if (!securitySettings.selectSecurityToken(secureChannel->secureChannelTransaction_->securityTokenId_)) {
+			Log(Error, "receive message with unknown security token")
+				.parameter("ChannelId", secureChannel->channelId_)
+				.parameter("TokenId", secureChannel->secureChannelTransaction_->securityTokenId_);
+			return BadSecureChannelTokenUnknown;
+		}
+
 		// decrypt received message request
 		if (securityHeader->isEncryptionEnabled()) {
 			statusCode = decryptReceivedMessage(secureChannel);
@@ -1172,6 +1221,14 @@ namespace OpcUaStackCore
 			return Success;
 		}
 
+		// select the key set of the security token used by the partner
+		if (!securitySettings.selectSecurityToken(secureChannel->secureChannelTransaction_->securityTokenId_)) {
+			Log(Error, "receive message with unknown security token")
+				.parameter("ChannelId", secureChannel->channelId_)
+				.parameter("TokenId", secureChannel->secureChannelTransaction_->securityTokenId_);
+			return BadSecureChannelTokenUnknown;
+		}
+
 		// decrypt received message request
 		if (securityHeader->isEncryptionEnabled()) {
 			statusCode = decryptReceivedMessageResponse(secureChannel);
@@ -1274,6 +1331,23 @@ namespace OpcUaStackCore
 	//
 	// ------------------------------------------------------------------------
 	// ------------------------------------------------------------------------
+	OpcUaUInt32
+	SecureChannelCrypto::sendSecurityTokenId(
+		SecureChannel* secureChannel,
+		OpcUaUInt32 securityTokenId
+	)
+	{
+		SecurityHeader* securityHeader = &secureChannel->securityHeader_;
+
+		// without security the token id of the request is returned
+		if (!securityHeader->isEncryptionEnabled() && !securityHeader->isSignatureEnabled()) {
+			return securityTokenId;
+		}
+
+		// the response is secured with the current security token
+		return secureChannel->securitySettings().tokenId();
+	}
+
 	OpcUaStatusCode
 	SecureChannelCrypto::secureSendMessageResponse(
 		MemoryBuffer& plainText,
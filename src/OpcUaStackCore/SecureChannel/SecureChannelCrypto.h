@@ -20,8 +20,10 @@
 #define __OpcUaStackCore_SecureChannelCrypto_h__
 
 #include "OpcUaStackCore/Base/os.h"
+#include "OpcUaStackCore/Base/WorkerPool.h"
 #include "OpcUaStackCore/Certificate/CryptoManager.h"
 #include "OpcUaStackCore/Certificate/ApplicationCertificate.h"
+#include "OpcUaStackCore/Certificate/CertificateValidator.h"
 #include "OpcUaStackCore/SecureChannel/SecureChannel.h"
 
 namespace OpcUaStackCore
@@ -37,6 +39,10 @@ namespace OpcUaStackCore
 		CryptoManager::SPtr& cryptoManager(void);
 		void applicationCertificate(ApplicationCertificate::SPtr& applicationCertificate);
 		ApplicationCertificate::SPtr& applicationCertificate(void);
+		void cryptoPool(WorkerPool::SPtr& cryptoPool);
+		WorkerPool::SPtr& cryptoPool(void);
+		void certificateValidator(CertificateValidator::SPtr& certificateValidator);
+		CertificateValidator::SPtr& certificateValidator(void);
 
 		//
 		// receive open secure channel request
@@ -147,6 +153,10 @@ namespace OpcUaStackCore
 		//
 		// send message response
 		//
+		OpcUaUInt32 sendSecurityTokenId(
+			SecureChannel* secureChannel,
+			OpcUaUInt32 securityTokenId
+		);
 		OpcUaStatusCode secureSendMessageResponse(
 			MemoryBuffer& plainText,
 			MemoryBuffer& encryptedText,
@@ -180,6 +190,8 @@ namespace OpcUaStackCore
 	  private:
 		CryptoManager::SPtr cryptoManager_;
 		ApplicationCertificate::SPtr applicationCertificate_;
+		WorkerPool::SPtr cryptoPool_;
+		CertificateValidator::SPtr certificateValidator_;
 
 	};
 
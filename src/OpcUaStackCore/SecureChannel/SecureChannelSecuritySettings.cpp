@@ -26,9 +26,13 @@ namespace OpcUaStackCore
 	, partnerCertificate_()
 	, clientNonce_()
 	, serverNonce_()
-	, securityKeySetClient_()
-	, securityKeySetServer_()
+	, receiveKeySet_(0)
 	{
+		for (uint32_t idx = 0; idx < KS_Max; idx++) {
+			tokenId_[idx] = 0;
+			valid_[idx] = false;
+			keySet_[idx] = idx;
+		}
 	}
 
 	SecureChannelSecuritySettings::~SecureChannelSecuritySettings(void)
@@ -74,13 +78,80 @@ namespace OpcUaStackCore
 	SecurityKeySet&
 	SecureChannelSecuritySettings::securityKeySetClient(void)
 	{
-		return securityKeySetClient_;
+		return securityKeySetClient_[receiveKeySet_];
 	}
 
 	SecurityKeySet&
 	SecureChannelSecuritySettings::securityKeySetServer(void)
 	{
-		return securityKeySetServer_;
+		return securityKeySetServer_[keySet_[KS_Current]];
+	}
+
+	SecurityKeySet&
+	SecureChannelSecuritySettings::nextSecurityKeySetClient(void)
+	{
+		return securityKeySetClient_[keySet_[KS_Next]];
+	}
+
+	SecurityKeySet&
+	SecureChannelSecuritySettings::nextSecurityKeySetServer(void)
+	{
+		return securityKeySetServer_[keySet_[KS_Next]];
+	}
+
+	void
+	SecureChannelSecuritySettings::nextSecurityToken(OpcUaUInt32 tokenId, OpcUaUInt32 lifetime)
+	{
+		uint32_t keySet = keySet_[KS_Next];
+		tokenId_[keySet] = tokenId;
+		expireTime_[keySet] = boost::posix_time::microsec_clock::universal_time() +
+			boost::posix_time::millisec(lifetime);
+		valid_[keySet] = false;
+	}
+
+	void
+	SecureChannelSecuritySettings::nextSecurityKeySetReady(void)
+	{
+		valid_[keySet_[KS_Next]] = true;
+	}
+
+	bool
+	SecureChannelSecuritySettings::selectSecurityToken(OpcUaUInt32 tokenId)
+	{
+		// the partner uses the new token for the first time. From now on
+		// the new keys are used to send messages.
+		uint32_t next = keySet_[KS_Next];
+		if (valid_[next] && tokenId_[next] == tokenId) {
+			keySet_[KS_Next] = keySet_[KS_Previous];
+			keySet_[KS_Previous] = keySet_[KS_Current];
+			keySet_[KS_Current] = next;
+			valid_[keySet_[KS_Next]] = false;
+		}
+
+		uint32_t current = keySet_[KS_Current];
+		if (valid_[current] && tokenId_[current] == tokenId) {
+			receiveKeySet_ = current;
+			return true;
+		}
+
+		// messages secured with the old token are accepted until the
+		// old token expires
+		uint32_t previous = keySet_[KS_Previous];
+		if (valid_[previous] && tokenId_[previous] == tokenId) {
+			if (boost::posix_time::microsec_clock::universal_time() < expireTime_[previous]) {
+				receiveKeySet_ = previous;
+				return true;
+			}
+			valid_[previous] = false;
+		}
+
+		return false;
+	}
+
+	OpcUaUInt32
+	SecureChannelSecuritySettings::tokenId(void)
+	{
+		return tokenId_[keySet_[KS_Current]];
 	}
 
 }
@@ -19,6 +19,8 @@
 #ifndef __OpcUaStackCore_SecureChannelSecuritySettings_h__
 #define __OpcUaStackCore_SecureChannelSecuritySettings_h__
 
+#include <boost/date_time/posix_time/posix_time.hpp>
+#include "OpcUaStackCore/BuildInTypes/OpcUaType.h"
 #include "OpcUaStackCore/Certificate/CryptoBase.h"
 #include "OpcUaStackCore/Certificate/SecurityKeySet.h"
 #include "OpcUaStackCore/Certificate/Certificate.h"
@@ -42,14 +44,40 @@ namespace OpcUaStackCore
 		SecurityKeySet& securityKeySetClient(void);
 		SecurityKeySet& securityKeySetServer(void);
 
+		//
+		// the key sets of a renewed security token are derived into the next
+		// key set while the current key set remains in use. The next key set
+		// becomes the current key set when the partner uses the new token for
+		// the first time. The previous key set is accepted for received
+		// messages until the lifetime of its token expires.
+		//
+		SecurityKeySet& nextSecurityKeySetClient(void);
+		SecurityKeySet& nextSecurityKeySetServer(void);
+		void nextSecurityToken(OpcUaUInt32 tokenId, OpcUaUInt32 lifetime);
+		void nextSecurityKeySetReady(void);
+		bool selectSecurityToken(OpcUaUInt32 tokenId);
+		OpcUaUInt32 tokenId(void);
+
 	  private:
+		typedef enum {
+			KS_Current = 0,
+			KS_Previous,
+			KS_Next,
+			KS_Max
+		} KeySetType;
+
 		CryptoBase::SPtr cryptoBase_;
 		Certificate::SPtr partnerCertificate_;
 		MemoryBuffer clientNonce_;
 		MemoryBuffer serverNonce_;
 
-		SecurityKeySet securityKeySetClient_;
-		SecurityKeySet securityKeySetServer_;
+		SecurityKeySet securityKeySetClient_[KS_Max];
+		SecurityKeySet securityKeySetServer_[KS_Max];
+		OpcUaUInt32 tokenId_[KS_Max];
+		boost::posix_time::ptime expireTime_[KS_Max];
+		bool valid_[KS_Max];
+		uint32_t keySet_[KS_Max];
+		uint32_t receiveKeySet_;
 	};
 
 }
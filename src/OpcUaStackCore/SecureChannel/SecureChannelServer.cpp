@@ -24,11 +24,20 @@ namespace OpcUaStackCore
 
 	SecureChannelServer::SecureChannelServer(IOThread* ioThread)
 	: SecureChannelBase(SecureChannelBase::SCT_Server)
-	, secureChannelServerIf_(nullptr)
+	, endpointUrl_("")
 	, ioThread_(ioThread)
 	, resolver_(ioThread->ioService()->io_service())
-	, tcpAcceptor_(nullptr)
-	, endpointUrl_("")
+	, secureChannelServerIf_(nullptr)
+	, localEndpoint_()
+	, acceptorMutex_()
+	, tcpAcceptorVec_()
+	, numberOpenAcceptors_(0)
+	, unixSocket_(false)
+	, sharedMemory_(false)
+	, memory_(false)
+	, admissionControl_()
+	, secureChannelCapture_()
+	, handle_()
 	{
 	}
 
@@ -48,6 +57,30 @@ namespace OpcUaStackCore
 		return secureChannelServerIf_;
 	}
 
+	void
+	SecureChannelServer::admissionControl(AdmissionControl::SPtr& admissionControl)
+	{
+		admissionControl_ = admissionControl;
+	}
+
+	AdmissionControl::SPtr&
+	SecureChannelServer::admissionControl(void)
+	{
+		return admissionControl_;
+	}
+
+	void
+	SecureChannelServer::secureChannelCapture(SecureChannelCapture::SPtr& secureChannelCapture)
+	{
+		secureChannelCapture_ = secureChannelCapture;
+	}
+
+	SecureChannelCapture::SPtr&
+	SecureChannelServer::secureChannelCapture(void)
+	{
+		return secureChannelCapture_;
+	}
+
 	bool
 	SecureChannelServer::accept(SecureChannelServerConfig::SPtr secureChannelServerConfig)
 	{
@@ -68,12 +101,18 @@ namespace OpcUaStackCore
 	void
 	SecureChannelServer::disconnect(void)
 	{
-		if (tcpAcceptor_ != nullptr) {
-			// close acceptor socket. The acceptComplete function will be called
-			// with an error
-			tcpAcceptor_->cancel();
+		boost::mutex::scoped_lock g(acceptorMutex_);
+
+		if (!tcpAcceptorVec_.empty()) {
+			// close acceptor sockets. The acceptComplete function will be called
+			// with an error for each acceptor
+			std::vector<TCPAcceptor*>::iterator it;
+			for (it = tcpAcceptorVec_.begin(); it != tcpAcceptorVec_.end(); it++) {
+				if (*it != nullptr) (*it)->cancel();
+			}
 		}
 		else {
+			g.unlock();
 			secureChannelServerIf_->handleEndpointClose(endpointUrl_);
 		}
 	}
@@ -82,35 +121,65 @@ namespace OpcUaStackCore
 	SecureChannelServer::disconnect(SecureChannel* secureChannel)
 	{
 		// close secure channel socket. The handleDisconnect function will be
-		// clalled with an error
-		secureChannel->socket().cancel();
+		// clalled with an error. The function must be called in the strand
+		// of the secure channel
+		secureChannel->cancelOperations();
 		secureChannel->state_ = SecureChannel::S_CloseSecureChannel;
 	}
 
 	void
 	SecureChannelServer::sendResponse(SecureChannel* secureChannel, SecureChannelTransaction::SPtr& secureChannelTransaction)
 	{
-		// send open secure channel response
+		// send message response. The responses are sent in the order in which
+		// they are completed, the client assigns them by the request id. The
+		// request leaves the request window now and reading is continued
+		// after the response is written.
+		secureChannel->requestWindowLeave(secureChannelTransaction);
+		if (secureChannelTransaction->chunkBuffer_.get() == nullptr) {
+			secureChannel->captureSendMessageResponse(secureChannelTransaction);
+		}
 		asyncWriteMessageResponse(secureChannel, secureChannelTransaction);
 	}
 
+	void
+	SecureChannelServer::sendResponseChunk(SecureChannel* secureChannel)
+	{
+		// the queued size of the streamed response has grown
+		secureChannel->sendQueueUpdate();
+		if (secureChannel->sendQueueAboveHighWaterMark()) {
+			if (!handleSendQueueOverload(secureChannel)) return;
+		}
+
+		// send the next chunk of a streamed response
+		asyncWriteMessageResponse(secureChannel);
+	}
+
 	void
 	SecureChannelServer::accept(SecureChannel* secureChannel)
 	{
 		SecureChannelServerConfig::SPtr config;
 		config = boost::static_pointer_cast<SecureChannelServerConfig>(secureChannel->config_);
 
+		Url url(config->endpointUrl());
 		endpointUrl_ = config->endpointUrl();
+		sharedMemory_ = url.isSharedMemory();
+		unixSocket_ = url.isUnixSocket() || sharedMemory_;
+		memory_ = url.isMemory();
+		initSecureChannel(secureChannel);
+
+		// in process endpoints are registered by name
+		if (memory_) {
+			openMemory(secureChannel, url.memoryName());
+			return;
+		}
 
-		secureChannel->isLogging_ = config->secureChannelLog();
-		secureChannel->receivedBufferSize_ = config->receivedBufferSize();
-		secureChannel->sendBufferSize_ = config->sendBufferSize();
-		secureChannel->maxMessageSize_ = config->maxMessageSize();
-		secureChannel->maxChunkCount_ = config->maxChunkCount();
-		secureChannel->endpointUrl_ = config->endpointUrl();
+		// unix domain socket and shared memory endpoints need no address resolution
+		if (unixSocket_) {
+			openUnixSocket(secureChannel, url.unixSocketPath(), config->unixSocketMode());
+			return;
+		}
 
 		// get ip address from endpoint hostname
-		Url url(config->endpointUrl());
 		secureChannel->partner_.port(url.port());
 		boost::asio::ip::tcp::resolver::query query(url.host(), url.portToString());
 		resolver_.async_resolve(
@@ -125,6 +194,112 @@ namespace OpcUaStackCore
 		);
 	}
 
+	void
+	SecureChannelServer::initSecureChannel(SecureChannel* secureChannel)
+	{
+		SecureChannelServerConfig::SPtr config;
+		config = boost::static_pointer_cast<SecureChannelServerConfig>(secureChannel->config_);
+
+		secureChannel->isLogging_ = config->secureChannelLog();
+		secureChannel->capture_ = secureChannelCapture_;
+		secureChannel->receivedBufferSize_ = config->receivedBufferSize();
+		secureChannel->sendBufferSize_ = config->sendBufferSize();
+		secureChannel->maxMessageSize_ = config->maxMessageSize();
+		secureChannel->maxChunkCount_ = config->maxChunkCount();
+		secureChannel->endpointUrl_ = config->endpointUrl();
+		secureChannel->sendQueueLimit_ = config->sendQueueLimit();
+		secureChannel->requestWindow_->windowSize(config->maxRequestsInFlight());
+		secureChannel->requestWindow_->open(
+			secureChannel->strand(),
+			boost::bind(&SecureChannelServer::requestWindowResume, this, secureChannel)
+		);
+		secureChannel->unixSocket(unixSocket_);
+		secureChannel->memory(memory_);
+	}
+
+	void
+	SecureChannelServer::openUnixSocket(SecureChannel* secureChannel, const std::string& unixSocketPath, uint32_t unixSocketMode)
+	{
+		if (!TCPAcceptor::unixSocketSupported()) {
+			Log(Error, "unix domain sockets not supported")
+				.parameter("EndpointUrl", secureChannel->endpointUrl_);
+
+			std::string endpointUrl = secureChannel->endpointUrl_;
+			delete secureChannel;
+
+			secureChannelServerIf_->handleEndpointClose(endpointUrl);
+			return;
+		}
+
+		TCPAcceptor* tcpAcceptor = nullptr;
+		try {
+			tcpAcceptor = new TCPAcceptor(ioThread_->ioService()->io_service(), unixSocketPath);
+			tcpAcceptor->unixSocketMode(unixSocketMode);
+			tcpAcceptor->listen();
+		}
+		catch (boost::system::system_error& e) {
+			Log(Error, "cannot open unix domain socket")
+				.parameter("EndpointUrl", secureChannel->endpointUrl_)
+				.parameter("Path", unixSocketPath)
+				.parameter("Message", e.what());
+
+			if (tcpAcceptor != nullptr) delete tcpAcceptor;
+			std::string endpointUrl = secureChannel->endpointUrl_;
+			delete secureChannel;
+
+			secureChannelServerIf_->handleEndpointClose(endpointUrl);
+			return;
+		}
+
+		Log(Info, "secure channel endpoint open")
+			.parameter("Path", unixSocketPath);
+
+		{
+			// sharding with SO_REUSEPORT is not used for unix domain sockets
+			boost::mutex::scoped_lock g(acceptorMutex_);
+			tcpAcceptorVec_.push_back(tcpAcceptor);
+			numberOpenAcceptors_ = 1;
+		}
+
+		secureChannelServerIf_->handleEndpointOpen(secureChannel->endpointUrl_);
+		asyncAccept(0, secureChannel);
+	}
+
+	void
+	SecureChannelServer::openMemory(SecureChannel* secureChannel, const std::string& memoryName)
+	{
+		MemAcceptor::SPtr memAcceptor(new MemAcceptor(ioThread_->ioService()->io_service(), memoryName));
+		TCPAcceptor* tcpAcceptor = new TCPAcceptor(ioThread_->ioService()->io_service(), memAcceptor);
+		try {
+			tcpAcceptor->listen();
+		}
+		catch (boost::system::system_error& e) {
+			Log(Error, "cannot open memory endpoint")
+				.parameter("EndpointUrl", secureChannel->endpointUrl_)
+				.parameter("Name", memoryName)
+				.parameter("Message", e.what());
+
+			delete tcpAcceptor;
+			std::string endpointUrl = secureChannel->endpointUrl_;
+			delete secureChannel;
+
+			secureChannelServerIf_->handleEndpointClose(endpointUrl);
+			return;
+		}
+
+		Log(Info, "secure channel endpoint open")
+			.parameter("Name", memoryName);
+
+		{
+			boost::mutex::scoped_lock g(acceptorMutex_);
+			tcpAcceptorVec_.push_back(tcpAcceptor);
+			numberOpenAcceptors_ = 1;
+		}
+
+		secureChannelServerIf_->handleEndpointOpen(secureChannel->endpointUrl_);
+		asyncAccept(0, secureChannel);
+	}
+
 	void
 	SecureChannelServer::resolveComplete(
 		const boost::system::error_code& error,
@@ -141,38 +316,139 @@ namespace OpcUaStackCore
 			std::string endpointUrl = secureChannel->endpointUrl_;
 			delete secureChannel;
 
-			// handle acceptor socket error
-			if (tcpAcceptor_ != nullptr) {
-				tcpAcceptor_->close();
-				delete tcpAcceptor_;
-				tcpAcceptor_ = nullptr;
-			}
 			secureChannelServerIf_->handleEndpointClose(endpointUrl);
-
 			return;
 		}
 		secureChannel->local_ = ((*endpointIterator).endpoint());
+		localEndpoint_ = secureChannel->local_;
+
+		// get number of acceptors. More than one acceptor can only be bound
+		// to the same endpoint if SO_REUSEPORT is available
+		SecureChannelServerConfig::SPtr config;
+		config = boost::static_pointer_cast<SecureChannelServerConfig>(secureChannel->config_);
+		uint32_t numberAcceptors = config->numberAcceptors();
+		if (numberAcceptors > 1 && !TCPAcceptor::reusePortSupported()) {
+			Log(Warning, "SO_REUSEPORT not supported - use single acceptor")
+				.parameter("EndpointUrl", secureChannel->endpointUrl_);
+			numberAcceptors = 1;
+		}
 
 		// open connection from client to server
-		if (tcpAcceptor_ == nullptr) {
-			Log(Info, "secure channel endpoint open")
+		Log(Info, "secure channel endpoint open")
+			.parameter("Address", secureChannel->local_.address().to_string())
+			.parameter("Port", secureChannel->local_.port())
+			.parameter("Acceptors", numberAcceptors);
+
+		// all acceptors of a sharded endpoint run on the io thread pool of
+		// the server. The kernel distributes the connections over the
+		// acceptors, so the accept handlers of the acceptors are executed
+		// in parallel by the threads of the pool. Each acceptor has at most
+		// one pending accept, which serializes its own handlers
+		std::vector<TCPAcceptor*> tcpAcceptorVec;
+		try {
+			for (uint32_t idx = 0; idx < numberAcceptors; idx++) {
+				TCPAcceptor* tcpAcceptor = new TCPAcceptor(
+					ioThread_->ioService()->io_service(),
+					localEndpoint_,
+					numberAcceptors > 1
+				);
+				tcpAcceptorVec.push_back(tcpAcceptor);
+				tcpAcceptor->listen();
+			}
+		}
+		catch (boost::system::system_error& e) {
+			Log(Error, "secure channel endpoint open error")
+				.parameter("EndpointUrl", secureChannel->endpointUrl_)
 				.parameter("Address", secureChannel->local_.address().to_string())
-				.parameter("Port", secureChannel->local_.port());
+				.parameter("Port", secureChannel->local_.port())
+				.parameter("Message", e.what());
+
+			std::vector<TCPAcceptor*>::iterator it1;
+			for (it1 = tcpAcceptorVec.begin(); it1 != tcpAcceptorVec.end(); it1++) {
+				delete *it1;
+			}
+
+			// we do not need the secure channel anymore.
+			std::string endpointUrl = secureChannel->endpointUrl_;
+			delete secureChannel;
+
+			secureChannelServerIf_->handleEndpointClose(endpointUrl);
+			return;
+		}
+
+		{
+			boost::mutex::scoped_lock g(acceptorMutex_);
+			tcpAcceptorVec_ = tcpAcceptorVec;
+			numberOpenAcceptors_ = numberAcceptors;
+		}
 
-			tcpAcceptor_ = new TCPAcceptor(ioThread_->ioService()->io_service(), secureChannel->local_);
-			tcpAcceptor_->listen();
+		secureChannelServerIf_->handleEndpointOpen(secureChannel->endpointUrl_);
 
-			secureChannelServerIf_->handleEndpointOpen(secureChannel->endpointUrl_);
+		if (numberAcceptors == 1) {
+			asyncAccept(0, secureChannel);
+			return;
+		}
+
+		// each acceptor waits for new connections with its own secure channel
+		delete secureChannel;
+		for (uint32_t idx = 0; idx < numberAcceptors; idx++) {
+			SecureChannel* acceptorSecureChannel = new SecureChannel(ioThread_);
+			acceptorSecureChannel->config_ = config;
+			initSecureChannel(acceptorSecureChannel);
+			asyncAccept(idx, acceptorSecureChannel);
 		}
+	}
 
+	void
+	SecureChannelServer::asyncAccept(uint32_t acceptorIndex, SecureChannel* secureChannel)
+	{
+		secureChannel->local_ = localEndpoint_;
 		secureChannel->state_ = SecureChannel::S_Accepting;
-		tcpAcceptor_->async_accept(
+
+		// the acceptor can be closed concurrently by another io thread
+		boost::mutex::scoped_lock g(acceptorMutex_);
+		if (acceptorIndex >= tcpAcceptorVec_.size() || tcpAcceptorVec_[acceptorIndex] == nullptr) {
+			g.unlock();
+			delete secureChannel;
+			return;
+		}
+
+		if (secureChannel->memory()) {
+			tcpAcceptorVec_[acceptorIndex]->async_accept(
+				secureChannel->memStream(),
+				boost::bind(
+					&SecureChannelServer::acceptComplete,
+					this,
+					boost::asio::placeholders::error,
+					secureChannel,
+					acceptorIndex
+				)
+			);
+			return;
+		}
+#if defined(BOOST_ASIO_HAS_LOCAL_SOCKETS)
+		if (secureChannel->unixSocket()) {
+			tcpAcceptorVec_[acceptorIndex]->async_accept(
+				secureChannel->localSocket(),
+				boost::bind(
+					&SecureChannelServer::acceptComplete,
+					this,
+					boost::asio::placeholders::error,
+					secureChannel,
+					acceptorIndex
+				)
+			);
+			return;
+		}
+#endif
+		tcpAcceptorVec_[acceptorIndex]->async_accept(
 			secureChannel->socket(),
 			boost::bind(
 				&SecureChannelServer::acceptComplete,
 				this,
 				boost::asio::placeholders::error,
-				secureChannel
+				secureChannel,
+				acceptorIndex
 			)
 		);
 	}
@@ -180,7 +456,8 @@ namespace OpcUaStackCore
 	void
 	SecureChannelServer::acceptComplete(
 		const boost::system::error_code& error,
-		SecureChannel* secureChannel
+		SecureChannel* secureChannel,
+		uint32_t acceptorIndex
 	)
 	{
 		if (error) {
@@ -194,39 +471,254 @@ namespace OpcUaStackCore
 			delete secureChannel;
 
 			// handle acceptor socket error
-			if (tcpAcceptor_ != nullptr) {
-				tcpAcceptor_->close();
-				delete tcpAcceptor_;
-				tcpAcceptor_ = nullptr;
-			}
-			secureChannelServerIf_->handleEndpointClose(endpointUrl);
+			closeAcceptor(acceptorIndex, endpointUrl);
+			return;
+		}
 
+		// a rejected connection is closed immediately without handshake. The
+		// secure channel is used for the next connection
+		if (!admitConnection(secureChannel)) {
+			secureChannel->close();
+			asyncAccept(acceptorIndex, secureChannel);
 			return;
 		}
 
-		secureChannel->partner_ = secureChannel->socket().remote_endpoint();
+		if (sharedMemory_) {
+			Log(Info, "accepted new secure channel from client")
+				.parameter("EndpointUrl", secureChannel->endpointUrl_);
+
+			// pass the shared memory region to the client. The messages of
+			// the secure channel are exchanged over the shared memory
+			SecureChannelServerConfig::SPtr config;
+			config = boost::static_pointer_cast<SecureChannelServerConfig>(secureChannel->config_);
+			if (!secureChannel->openSharedMemory(config->sharedMemoryBufferSize())) {
+				Log(Error, "cannot open shared memory for secure channel")
+					.parameter("EndpointUrl", secureChannel->endpointUrl_);
+
+				// the closed secure channel is not used again. A new secure
+				// channel waits for the next connection
+				releaseConnection(secureChannel);
+				secureChannel->close();
+
+				SecureChannel* nextSecureChannel = new SecureChannel(ioThread_);
+				nextSecureChannel->config_ = secureChannel->config_;
+				initSecureChannel(nextSecureChannel);
+				delete secureChannel;
+
+				asyncAccept(acceptorIndex, nextSecureChannel);
+				return;
+			}
+		}
+		else if (secureChannel->unixSocket() || secureChannel->memory()) {
+			Log(Info, "accepted new secure channel from client")
+				.parameter("EndpointUrl", secureChannel->endpointUrl_);
+		}
+		else {
+			secureChannel->partner_ = secureChannel->socket().remote_endpoint();
 
-		Log(Info, "accepted new secure channel from client")
-			.parameter("Address", secureChannel->partner_.address().to_string())
-			.parameter("Port", secureChannel->partner_.port());
+			Log(Info, "accepted new secure channel from client")
+				.parameter("Address", secureChannel->partner_.address().to_string())
+				.parameter("Port", secureChannel->partner_.port());
+
+			// the reactor is used if io_uring is not available
+			SecureChannelServerConfig::SPtr config;
+			config = boost::static_pointer_cast<SecureChannelServerConfig>(secureChannel->config_);
+			if (config->ioUring() && !secureChannel->openIoUring()) {
+				Log(Debug, "io_uring not available for secure channel")
+					.parameter("Address", secureChannel->partner_.address().to_string())
+					.parameter("Port", secureChannel->partner_.port());
+			}
+		}
+
+		// wait for the next connection on the same acceptor. The endpoint
+		// address was already resolved.
+		SecureChannel* nextSecureChannel = new SecureChannel(ioThread_);
+		nextSecureChannel->config_ = secureChannel->config_;
+		initSecureChannel(nextSecureChannel);
 
 		secureChannel->state_ = SecureChannel::S_Connected;
+		startHandshakeTimer(secureChannel);
 		asyncRead(secureChannel);
 
-		SecureChannelServerConfig::SPtr config;
-		config = boost::static_pointer_cast<SecureChannelServerConfig>(secureChannel->config_);
-		accept(config);
+		asyncAccept(acceptorIndex, nextSecureChannel);
+	}
+
+	void
+	SecureChannelServer::closeAcceptor(uint32_t acceptorIndex, const std::string& endpointUrl)
+	{
+		bool endpointClosed = false;
+
+		{
+			boost::mutex::scoped_lock g(acceptorMutex_);
+
+			TCPAcceptor* tcpAcceptor = tcpAcceptorVec_[acceptorIndex];
+			if (tcpAcceptor == nullptr) {
+				return;
+			}
+
+			tcpAcceptor->close();
+			delete tcpAcceptor;
+			tcpAcceptorVec_[acceptorIndex] = nullptr;
+
+			numberOpenAcceptors_--;
+			if (numberOpenAcceptors_ == 0) {
+				tcpAcceptorVec_.clear();
+				endpointClosed = true;
+			}
+		}
+
+		// the endpoint is closed when the last acceptor is closed
+		if (endpointClosed) {
+			secureChannelServerIf_->handleEndpointClose(endpointUrl);
+		}
+	}
+
+	bool
+	SecureChannelServer::admitConnection(SecureChannel* secureChannel)
+	{
+		if (admissionControl_.get() == nullptr) {
+			return true;
+		}
+
+		// connections over unix domain sockets and in process connections
+		// have no partner address
+		std::string address;
+		if (!secureChannel->unixSocket() && !secureChannel->memory()) {
+			boost::system::error_code ec;
+			secureChannel->partner_ = secureChannel->socket().remote_endpoint(ec);
+			if (ec) {
+				return false;
+			}
+			address = secureChannel->partner_.address().to_string();
+		}
+
+		AdmissionResult admissionResult = admissionControl_->admit(address);
+		if (admissionResult != AR_Accept) {
+			Log(Debug, "reject secure channel from client")
+				.parameter("Address", address)
+				.parameter("EndpointUrl", secureChannel->endpointUrl_)
+				.parameter("Reason", AdmissionControl::admissionResultToString(admissionResult))
+				.parameter("Handshakes", admissionControl_->handshakes())
+				.parameter("Connections", admissionControl_->connections());
+			return false;
+		}
+
+		secureChannel->admitted_ = true;
+		secureChannel->handshake_ = true;
+		return true;
+	}
+
+	void
+	SecureChannelServer::releaseConnection(SecureChannel* secureChannel)
+	{
+		if (!secureChannel->admitted_) {
+			return;
+		}
+
+		std::string address;
+		if (!secureChannel->unixSocket() && !secureChannel->memory()) {
+			address = secureChannel->partner_.address().to_string();
+		}
+		admissionControl_->release(address, secureChannel->handshake_);
+
+		secureChannel->admitted_ = false;
+		secureChannel->handshake_ = false;
+	}
+
+	void
+	SecureChannelServer::requestWindowResume(SecureChannel* secureChannel)
+	{
+		// a request of the full request window is finished. The request can
+		// also be deleted without a response by the server.
+		if (secureChannel->state_ == SecureChannel::S_CloseSecureChannel) {
+			return;
+		}
+
+		if (secureChannel->sendQueueResumeRead()) {
+			asyncRead(secureChannel);
+		}
+	}
+
+	void
+	SecureChannelServer::startHandshakeTimer(SecureChannel* secureChannel)
+	{
+		if (!secureChannel->handshake_ || admissionControl_->handshakeTimeout() == 0) {
+			return;
+		}
+
+		// the connection is closed if the open secure channel request is not
+		// answered before the handshake timeout
+		secureChannel->handshakeTimerRunning_ = true;
+		secureChannel->handshakeTimer_.expires_from_now(
+			boost::posix_time::milliseconds(admissionControl_->handshakeTimeout())
+		);
+		secureChannel->handshakeTimer_.async_wait(
+			secureChannel->strand()->wrap(
+				boost::bind(
+					&SecureChannelServer::handleHandshakeTimeout,
+					this,
+					boost::asio::placeholders::error,
+					secureChannel
+				)
+			)
+		);
+	}
+
+	void
+	SecureChannelServer::handleHandshakeTimeout(const boost::system::error_code& error, SecureChannel* secureChannel)
+	{
+		secureChannel->handshakeTimerRunning_ = false;
+
+		// the secure channel was closed while the timer was running
+		if (secureChannel->disconnectPending_) {
+			handleDisconnect(secureChannel);
+			return;
+		}
+
+		// the timer is cancelled or the handshake is complete
+		if (error || !secureChannel->handshake_) {
+			return;
+		}
+
+		Log(Info, "secure channel handshake timeout; close secure channel")
+			.parameter("Partner-Address", secureChannel->partner_.address().to_string())
+			.parameter("Partner-Port", secureChannel->partner_.port())
+			.parameter("HandshakeTimeout", admissionControl_->handshakeTimeout());
+
+		admissionControl_->handshakeExpired();
+		disconnect(secureChannel);
 	}
 
 	void
 	SecureChannelServer::handleDisconnect(SecureChannel* secureChannel)
 	{
+		// the secure channel is deleted by the handler of the handshake timer
+		if (secureChannel->handshakeTimerRunning_) {
+			secureChannel->disconnectPending_ = true;
+			secureChannel->handshakeTimer_.cancel();
+			return;
+		}
+
+		uint32_t requestCount;
+		uint32_t requestsInFlight;
+		uint32_t requestsInFlightMax;
+		uint32_t requestWindowPauseCount;
+		secureChannel->requestWindowStatistic(requestCount, requestsInFlight, requestsInFlightMax, requestWindowPauseCount);
+
 		Log(Info, "secure channel closed")
 			.parameter("Local-Address", secureChannel->local_.address().to_string())
 			.parameter("Local-Port", secureChannel->local_.port())
 			.parameter("Partner-Address", secureChannel->partner_.address().to_string())
-			.parameter("Partner-Port", secureChannel->partner_.port());
-
+			.parameter("Partner-Port", secureChannel->partner_.port())
+			.parameter("MaxQueueMessages", secureChannel->sendQueueMaxMessages_)
+			.parameter("MaxQueueBytes", secureChannel->sendQueueMaxBytes_)
+			.parameter("QueueDropCount", secureChannel->sendQueueDropCount_)
+			.parameter("Requests", requestCount)
+			.parameter("MaxRequestsInFlight", requestsInFlightMax)
+			.parameter("RequestWindowPauses", requestWindowPauseCount);
+
+		releaseConnection(secureChannel);
+		secureChannel->captureClose();
 		secureChannelServerIf_->handleDisconnect(secureChannel);
 		delete secureChannel;
 	}
@@ -239,7 +731,7 @@ namespace OpcUaStackCore
 		// check protocol version
 		if (hello.protocolVersion() != 0) {
 			Log(Error, "receive invalid protocol version in hello request");
-			secureChannel->socket().cancel();
+			secureChannel->cancelOperations();
 			secureChannel->state_ = SecureChannel::S_CloseSecureChannel;
 			return;
 		}
@@ -302,7 +794,17 @@ namespace OpcUaStackCore
 
 		// check parameter
 		bool success = true;
-		if (openSecureChannelRequest.requestType() == RT_ISSUE) {
+		if (secureChannel->sharedMemory() && openSecureChannelRequest.securityMode() == SM_SignAndEncrypt) {
+
+			// the shared memory transport only supports the security modes
+			// None and Sign
+
+			success = false;
+			Log(Error, "security mode not supported by shared memory transport")
+				.parameter("EndpointUrl", secureChannel->endpointUrl_)
+				.parameter("SecurityMode", openSecureChannelRequest.securityMode());
+		}
+		else if (openSecureChannelRequest.requestType() == RT_ISSUE) {
 
 			// create a new security token for a new security channel
 
@@ -315,8 +817,7 @@ namespace OpcUaStackCore
 					.parameter("Partner-Port", secureChannel->partner_.port())
 					.parameter("RequestedType", openSecureChannelRequest.requestType());
 			}
-			secureChannel->gChannelId_++;
-			secureChannel->channelId_ = secureChannel->gChannelId_;
+			secureChannel->channelId_ = SecureChannel::nextChannelId();
 		}
 		else if (openSecureChannelRequest.requestType() ==  RT_RENEW) {
 
@@ -342,7 +843,7 @@ namespace OpcUaStackCore
 				.parameter("ChannelId", channelId);
 		}
 		if (!success) {
-			secureChannel->socket().cancel();
+			secureChannel->cancelOperations();
 			secureChannel->state_ = SecureChannel::S_CloseSecureChannel;
 			return;
 		}
@@ -362,10 +863,26 @@ namespace OpcUaStackCore
 		openSecureChannelResponse->responseHeader()->time().dateTime(boost::posix_time::microsec_clock::local_time());
 		openSecureChannelResponse->serverNonce(serverNonce, 1);
 
+		// the keys of the new token are derived when the response is secured
+		secureChannel->securitySettings().nextSecurityToken(
+			openSecureChannelResponse->securityToken()->tokenId(),
+			openSecureChannelResponse->securityToken()->revisedLifetime()
+		);
+
 		// send open secure channel response
 		asyncWriteOpenSecureChannelResponse(secureChannel, openSecureChannelResponse);
 
+		// the handshake of an admitted connection is complete
+		if (secureChannel->handshake_) {
+			secureChannel->handshake_ = false;
+			admissionControl_->handshakeComplete();
+			if (secureChannel->handshakeTimerRunning_) {
+				secureChannel->handshakeTimer_.cancel();
+			}
+		}
+
 		if (openSecureChannelRequest.requestType() ==  RT_ISSUE) {
+			secureChannel->captureOpen();
 			secureChannelServerIf_->handleConnect(secureChannel);
 		}
 	}
@@ -379,7 +896,7 @@ namespace OpcUaStackCore
 			.parameter("Partner-Address", secureChannel->partner_.address().to_string())
 			.parameter("Partner-Port", secureChannel->partner_.port());
 
-		secureChannel->socket().cancel();
+		secureChannel->cancelOperations();
 		secureChannel->state_ = SecureChannel::S_CloseSecureChannel;
 	}
 
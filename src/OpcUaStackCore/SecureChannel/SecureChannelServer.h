@@ -22,10 +22,14 @@
 #include <boost/asio.hpp>
 #include <boost/bind.hpp>
 #include <map>
+#include <vector>
+#include <boost/thread/mutex.hpp>
 #include "OpcUaStackCore/Base/os.h"
 #include "OpcUaStackCore/SecureChannel/SecureChannelServerConfig.h"
 #include "OpcUaStackCore/SecureChannel/SecureChannelServerIf.h"
 #include "OpcUaStackCore/SecureChannel/SecureChannelBase.h"
+#include "OpcUaStackCore/SecureChannel/AdmissionControl.h"
+#include "OpcUaStackCore/SecureChannel/SecureChannelCapture.h"
 #include "OpcUaStackCore/TCPChannel/TCPAcceptor.h"
 
 namespace OpcUaStackCore
@@ -43,11 +47,16 @@ namespace OpcUaStackCore
 
 		void secureChannelServerIf(SecureChannelServerIf* secureChannelServerIf);
 		SecureChannelServerIf* secureChannelServerIf(void);
+		void admissionControl(AdmissionControl::SPtr& admissionControl);
+		AdmissionControl::SPtr& admissionControl(void);
+		void secureChannelCapture(SecureChannelCapture::SPtr& secureChannelCapture);
+		SecureChannelCapture::SPtr& secureChannelCapture(void);
 
 		bool accept(SecureChannelServerConfig::SPtr secureChannelServerConfig);
 		void disconnect(void);
 		void disconnect(SecureChannel* secureChannel);
 		void sendResponse(SecureChannel* secureChannel, SecureChannelTransaction::SPtr& secureChannelTransaction);
+		void sendResponseChunk(SecureChannel* secureChannel);
 
 		//- SecureChannelBase -------------------------------------------------
 		void handleDisconnect(SecureChannel* secureChannel);
@@ -59,21 +68,42 @@ namespace OpcUaStackCore
 
 	  private:
 		void accept(SecureChannel* secureChannel);
+		void initSecureChannel(SecureChannel* secureChannel);
 		void resolveComplete(
 			const boost::system::error_code& error,
 			boost::asio::ip::tcp::resolver::iterator endpointIterator,
 			SecureChannel* secureChannel
 		);
+		void openUnixSocket(SecureChannel* secureChannel, const std::string& unixSocketPath, uint32_t unixSocketMode);
+		void openMemory(SecureChannel* secureChannel, const std::string& memoryName);
+		void asyncAccept(uint32_t acceptorIndex, SecureChannel* secureChannel);
 		void acceptComplete(
 			const boost::system::error_code& error,
-			SecureChannel* secureChannel
+			SecureChannel* secureChannel,
+			uint32_t acceptorIndex
 		);
+		void closeAcceptor(uint32_t acceptorIndex, const std::string& endpointUrl);
+		bool admitConnection(SecureChannel* secureChannel);
+		void releaseConnection(SecureChannel* secureChannel);
+		void requestWindowResume(SecureChannel* secureChannel);
+		void startHandshakeTimer(SecureChannel* secureChannel);
+		void handleHandshakeTimeout(const boost::system::error_code& error, SecureChannel* secureChannel);
 
 		std::string endpointUrl_;
 		IOThread* ioThread_;
 		boost::asio::ip::tcp::resolver resolver_;
 		SecureChannelServerIf* secureChannelServerIf_;
-		TCPAcceptor* tcpAcceptor_;
+
+		// one or more acceptors bound to the same local endpoint
+		boost::asio::ip::tcp::endpoint localEndpoint_;
+		boost::mutex acceptorMutex_;
+		std::vector<TCPAcceptor*> tcpAcceptorVec_;
+		uint32_t numberOpenAcceptors_;
+		bool unixSocket_;
+		bool sharedMemory_;
+		bool memory_;
+		AdmissionControl::SPtr admissionControl_;
+		SecureChannelCapture::SPtr secureChannelCapture_;
 
 		Object::SPtr handle_;
 	};
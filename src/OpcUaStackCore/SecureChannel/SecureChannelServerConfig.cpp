@@ -35,6 +35,12 @@ namespace OpcUaStackCore
 	, endpointUrl_("")
 
 	, secureChannelLog_(false)
+	, numberAcceptors_(1)
+	, sendQueueLimit_()
+	, sharedMemoryBufferSize_(1048576)
+	, unixSocketMode_(0600)
+	, ioUring_(false)
+	, maxRequestsInFlight_(0)
 	{
 	}
 
@@ -90,4 +96,71 @@ namespace OpcUaStackCore
 		return secureChannelLog_;
 	}
 
+	void
+	SecureChannelServerConfig::numberAcceptors(uint32_t numberAcceptors)
+	{
+		if (numberAcceptors == 0) return;
+		numberAcceptors_ = numberAcceptors;
+	}
+
+	uint32_t
+	SecureChannelServerConfig::numberAcceptors(void)
+	{
+		return numberAcceptors_;
+	}
+
+	SendQueueLimit&
+	SecureChannelServerConfig::sendQueueLimit(void)
+	{
+		return sendQueueLimit_;
+	}
+
+	void
+	SecureChannelServerConfig::sharedMemoryBufferSize(uint32_t sharedMemoryBufferSize)
+	{
+		sharedMemoryBufferSize_ = sharedMemoryBufferSize;
+	}
+
+	uint32_t
+	SecureChannelServerConfig::sharedMemoryBufferSize(void)
+	{
+		return sharedMemoryBufferSize_;
+	}
+
+	void
+	SecureChannelServerConfig::unixSocketMode(uint32_t unixSocketMode)
+	{
+		unixSocketMode_ = unixSocketMode & 0777;
+	}
+
+	uint32_t
+	SecureChannelServerConfig::unixSocketMode(void)
+	{
+		return unixSocketMode_;
+	}
+
+	void
+	SecureChannelServerConfig::ioUring(bool ioUring)
+	{
+		ioUring_ = ioUring;
+	}
+
+	bool
+	SecureChannelServerConfig::ioUring(void)
+	{
+		return ioUring_;
+	}
+
+	void
+	SecureChannelServerConfig::maxRequestsInFlight(uint32_t maxRequestsInFlight)
+	{
+		maxRequestsInFlight_ = maxRequestsInFlight;
+	}
+
+	uint32_t
+	SecureChannelServerConfig::maxRequestsInFlight(void)
+	{
+		return maxRequestsInFlight_;
+	}
+
 }
@@ -20,6 +20,7 @@
 #define __OpUaStackCore_SecureChannelServerConfig_h__
 
 #include "OpcUaStackCore/SecureChannel/SecureChannelConfig.h"
+#include "OpcUaStackCore/SecureChannel/SendQueueLimit.h"
 #include "OpcUaStackCore/ServiceSet/EndpointDescription.h"
 #include "OpcUaStackCore/Certificate/ApplicationCertificate.h"
 #include "OpcUaStackCore/Certificate/CryptoManager.h"
@@ -46,6 +47,17 @@ namespace OpcUaStackCore
 
 		void secureChannelLog(bool secureChannelLog);
 		bool secureChannelLog(void);
+		void numberAcceptors(uint32_t numberAcceptors);
+		uint32_t numberAcceptors(void);
+		SendQueueLimit& sendQueueLimit(void);
+		void sharedMemoryBufferSize(uint32_t sharedMemoryBufferSize);
+		uint32_t sharedMemoryBufferSize(void);
+		void unixSocketMode(uint32_t unixSocketMode);
+		uint32_t unixSocketMode(void);
+		void ioUring(bool ioUring);
+		bool ioUring(void);
+		void maxRequestsInFlight(uint32_t maxRequestsInFlight);
+		uint32_t maxRequestsInFlight(void);
 
 	  private:
 		EndpointDescriptionArray::SPtr endpointDescriptionArray_;
@@ -53,6 +65,12 @@ namespace OpcUaStackCore
 		std::string endpointUrl_;
 
 		bool secureChannelLog_;
+		uint32_t numberAcceptors_;
+		SendQueueLimit sendQueueLimit_;
+		uint32_t sharedMemoryBufferSize_;
+		uint32_t unixSocketMode_;
+		bool ioUring_;
+		uint32_t maxRequestsInFlight_;
 	};
 
 }
@@ -27,7 +27,11 @@ namespace OpcUaStackCore
 	, responseTypeNodeId_()
 	, securityTokenId_()
 	, requestId_(0)
+	, sendQueueSize_(0)
+	, requestWindowSlot_()
+	, sessionHandle_()
 	, cryptoBase_()
+	, chunkBuffer_()
 	{
 	}
 
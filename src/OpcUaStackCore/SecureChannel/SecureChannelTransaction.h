@@ -25,6 +25,8 @@
 #include "OpcUaStackCore/Certificate/CryptoBase.h"
 #include "OpcUaStackCore/BuildInTypes/OpcUaNumber.h"
 #include "OpcUaStackCore/BuildInTypes/OpcUaNodeId.h"
+#include "OpcUaStackCore/SecureChannel/MessageChunkBuffer.h"
+#include "OpcUaStackCore/SecureChannel/RequestWindow.h"
 #include <stdint.h>
 #include <list>
 
@@ -48,11 +50,18 @@ namespace OpcUaStackCore
 		OpcUaNodeId responseTypeNodeId_;
 		OpcUaUInt32 securityTokenId_;
 		OpcUaUInt32 requestId_;
+		OpcUaUInt32 sendQueueSize_;
+		RequestWindowSlot::SPtr requestWindowSlot_;
 		Object::SPtr handle_;
+		Object::SPtr sessionHandle_;
 		CryptoBase::SPtr cryptoBase_;
 
 		boost::asio::streambuf is_;
 		boost::asio::streambuf os_;
+
+		// streaming mode: the response is encoded into the chunk buffer
+		// instead of os_ and is sent chunk by chunk
+		MessageChunkBuffer::SPtr chunkBuffer_;
 	};
 
 }
@@ -0,0 +1,146 @@
+/*
+   Copyright 2015-2018 Kai Huebl (kai@huebl-sgh.de)
+
+   Lizenziert gemäß Apache Licence Version 2.0 (die „Lizenz“); Nutzung dieser
+   Datei nur in Übereinstimmung mit der Lizenz erlaubt.
+   Eine Kopie der Lizenz erhalten Sie auf http://www.apache.org/licenses/LICENSE-2.0.
+
+   Sofern nicht gemäß geltendem Recht vorgeschrieben oder schriftlich vereinbart,
+   erfolgt die Bereitstellung der im Rahmen der Lizenz verbreiteten Software OHNE
+   GEWÄHR ODER VORBEHALTE – ganz gleich, ob ausdrücklich oder stillschweigend.
+
+   Informationen über die jeweiligen Bedingungen für Genehmigungen und Einschränkungen
+   im Rahmen der Lizenz finden Sie in der Lizenz.
+
+   Autor: Kai Huebl (kai@huebl-sgh.de)
+ */
+
+#include "OpcUaStackCore/SecureChannel/SendQueueLimit.h"
+
+namespace OpcUaStackCore
+{
+
+	SendQueueLimit::SendQueueLimit(void)
+	: highWaterMarkBytes_(0)
+	, lowWaterMarkBytes_(0)
+	, highWaterMarkMessages_(0)
+	, lowWaterMarkMessages_(0)
+	, slowConsumerPolicy_(SCP_DropOldest)
+	{
+	}
+
+	SendQueueLimit::~SendQueueLimit(void)
+	{
+	}
+
+	void
+	SendQueueLimit::highWaterMarkBytes(uint32_t highWaterMarkBytes)
+	{
+		highWaterMarkBytes_ = highWaterMarkBytes;
+	}
+
+	uint32_t
+	SendQueueLimit::highWaterMarkBytes(void)
+	{
+		return highWaterMarkBytes_;
+	}
+
+	void
+	SendQueueLimit::lowWaterMarkBytes(uint32_t lowWaterMarkBytes)
+	{
+		lowWaterMarkBytes_ = lowWaterMarkBytes;
+	}
+
+	uint32_t
+	SendQueueLimit::lowWaterMarkBytes(void)
+	{
+		if (lowWaterMarkBytes_ == 0 || lowWaterMarkBytes_ > highWaterMarkBytes_) {
+			return highWaterMarkBytes_ / 2;
+		}
+		return lowWaterMarkBytes_;
+	}
+
+	void
+	SendQueueLimit::highWaterMarkMessages(uint32_t highWaterMarkMessages)
+	{
+		highWaterMarkMessages_ = highWaterMarkMessages;
+	}
+
+	uint32_t
+	SendQueueLimit::highWaterMarkMessages(void)
+	{
+		return highWaterMarkMessages_;
+	}
+
+	void
+	SendQueueLimit::lowWaterMarkMessages(uint32_t lowWaterMarkMessages)
+	{
+		lowWaterMarkMessages_ = lowWaterMarkMessages;
+	}
+
+	uint32_t
+	SendQueueLimit::lowWaterMarkMessages(void)
+	{
+		if (lowWaterMarkMessages_ == 0 || lowWaterMarkMessages_ > highWaterMarkMessages_) {
+			return highWaterMarkMessages_ / 2;
+		}
+		return lowWaterMarkMessages_;
+	}
+
+	void
+	SendQueueLimit::slowConsumerPolicy(SlowConsumerPolicy slowConsumerPolicy)
+	{
+		slowConsumerPolicy_ = slowConsumerPolicy;
+	}
+
+	SlowConsumerPolicy
+	SendQueueLimit::slowConsumerPolicy(void)
+	{
+		return slowConsumerPolicy_;
+	}
+
+	bool
+	SendQueueLimit::enabled(void)
+	{
+		return highWaterMarkBytes_ != 0 || highWaterMarkMessages_ != 0;
+	}
+
+	bool
+	SendQueueLimit::aboveHighWaterMark(uint32_t messages, uint32_t bytes)
+	{
+		if (highWaterMarkBytes_ != 0 && bytes > highWaterMarkBytes_) return true;
+		if (highWaterMarkMessages_ != 0 && messages > highWaterMarkMessages_) return true;
+		return false;
+	}
+
+	bool
+	SendQueueLimit::belowLowWaterMark(uint32_t messages, uint32_t bytes)
+	{
+		if (highWaterMarkBytes_ != 0 && bytes > lowWaterMarkBytes()) return false;
+		if (highWaterMarkMessages_ != 0 && messages > lowWaterMarkMessages()) return false;
+		return true;
+	}
+
+	bool
+	SendQueueLimit::slowConsumerPolicy(const std::string& policyString, SlowConsumerPolicy& slowConsumerPolicy)
+	{
+		if (policyString == "DropOldest") slowConsumerPolicy = SCP_DropOldest;
+		else if (policyString == "Coalesce") slowConsumerPolicy = SCP_Coalesce;
+		else if (policyString == "Close") slowConsumerPolicy = SCP_Close;
+		else return false;
+		return true;
+	}
+
+	std::string
+	SendQueueLimit::slowConsumerPolicyToString(SlowConsumerPolicy slowConsumerPolicy)
+	{
+		switch (slowConsumerPolicy)
+		{
+			case SCP_DropOldest: return "DropOldest";
+			case SCP_Coalesce: return "Coalesce";
+			case SCP_Close: return "Close";
+		}
+		return "Unknown";
+	}
+
+}
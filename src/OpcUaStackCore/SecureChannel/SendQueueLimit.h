@@ -0,0 +1,84 @@
+/*
+   Copyright 2015-2018 Kai Huebl (kai@huebl-sgh.de)
+
+   Lizenziert gemäß Apache Licence Version 2.0 (die „Lizenz“); Nutzung dieser
+   Datei nur in Übereinstimmung mit der Lizenz erlaubt.
+   Eine Kopie der Lizenz erhalten Sie auf http://www.apache.org/licenses/LICENSE-2.0.
+
+   Sofern nicht gemäß geltendem Recht vorgeschrieben oder schriftlich vereinbart,
+   erfolgt die Bereitstellung der im Rahmen der Lizenz verbreiteten Software OHNE
+   GEWÄHR ODER VORBEHALTE – ganz gleich, ob ausdrücklich oder stillschweigend.
+
+   Informationen über die jeweiligen Bedingungen für Genehmigungen und Einschränkungen
+   im Rahmen der Lizenz finden Sie in der Lizenz.
+
+   Autor: Kai Huebl (kai@huebl-sgh.de)
+ */
+
+#ifndef __OpcUaStackCore_SendQueueLimit_h__
+#define __OpcUaStackCore_SendQueueLimit_h__
+
+#include <string>
+#include <stdint.h>
+#include "OpcUaStackCore/Base/os.h"
+
+namespace OpcUaStackCore
+{
+
+	//
+	// A publish response which is dropped from the send queue is not lost.
+	// Its notification message remains in the retransmission queue of the
+	// subscription until the client acknowledges it (the last 20 messages
+	// of each subscription). The client finds the missing sequence number
+	// in the available sequence numbers of the next publish response and
+	// gets the message with a republish request. The publish request of a
+	// dropped response is not answered and times out at the client.
+	//
+	typedef enum
+	{
+		SCP_DropOldest,		// drop the oldest queued publish responses
+		SCP_Coalesce,		// keep only the latest queued publish response
+		SCP_Close			// close the secure channel
+	} SlowConsumerPolicy;
+
+	//
+	// The send queue limit contains the high and low water marks of the
+	// send queue of a secure channel. A water mark with the value 0 is
+	// disabled. If the low water mark is not set half of the high water
+	// mark is used.
+	//
+	class DLLEXPORT SendQueueLimit
+	{
+	  public:
+		SendQueueLimit(void);
+		~SendQueueLimit(void);
+
+		void highWaterMarkBytes(uint32_t highWaterMarkBytes);
+		uint32_t highWaterMarkBytes(void);
+		void lowWaterMarkBytes(uint32_t lowWaterMarkBytes);
+		uint32_t lowWaterMarkBytes(void);
+		void highWaterMarkMessages(uint32_t highWaterMarkMessages);
+		uint32_t highWaterMarkMessages(void);
+		void lowWaterMarkMessages(uint32_t lowWaterMarkMessages);
+		uint32_t lowWaterMarkMessages(void);
+		void slowConsumerPolicy(SlowConsumerPolicy slowConsumerPolicy);
+		SlowConsumerPolicy slowConsumerPolicy(void);
+
+		bool enabled(void);
+		bool aboveHighWaterMark(uint32_t messages, uint32_t bytes);
+		bool belowLowWaterMark(uint32_t messages, uint32_t bytes);
+
+		static bool slowConsumerPolicy(const std::string& policyString, SlowConsumerPolicy& slowConsumerPolicy);
+		static std::string slowConsumerPolicyToString(SlowConsumerPolicy slowConsumerPolicy);
+
+	  private:
+		uint32_t highWaterMarkBytes_;
+		uint32_t lowWaterMarkBytes_;
+		uint32_t highWaterMarkMessages_;
+		uint32_t lowWaterMarkMessages_;
+		SlowConsumerPolicy slowConsumerPolicy_;
+	};
+
+}
+
+#endif
@@ -16,6 +16,7 @@
  */
 
 #include "OpcUaStackCore/ServiceSet/HistoryData.h"
+#include "OpcUaStackCore/ServiceSet/TimestampsToReturn.h"
 
 namespace OpcUaStackCore
 {
@@ -31,6 +32,7 @@ namespace OpcUaStackCore
 	HistoryData::HistoryData(void)
 	: Object()
 	, dataValueArraySPtr_(constructSPtr<OpcUaDataValueArray>())
+	, timestampsToReturn_(TimestampsToReturn_Both)
 	{
 	}
 
@@ -50,6 +52,18 @@ namespace OpcUaStackCore
 		return dataValueArraySPtr_;
 	}
 
+	void
+	HistoryData::timestampsToReturn(OpcUaInt32 timestampsToReturn)
+	{
+		timestampsToReturn_ = timestampsToReturn;
+	}
+
+	OpcUaInt32
+	HistoryData::timestampsToReturn(void) const
+	{
+		return timestampsToReturn_;
+	}
+
 	ExtensibleParameterBase::SPtr
 	HistoryData::factory(void)
 	{
@@ -59,7 +73,21 @@ namespace OpcUaStackCore
 	void 
 	HistoryData::opcUaBinaryEncode(std::ostream& os) const
 	{
-		dataValueArraySPtr_->opcUaBinaryEncode(os);
+		// the data values can be shared with the application. Only the
+		// timestamps requested by the client are encoded, the values are not
+		// changed. A missing value is encoded as an empty data value, so the
+		// positions of the other values remain
+		OpcUaUInt32 size = dataValueArraySPtr_->size();
+		OpcUaNumber::opcUaBinaryEncode(os, size);
+		for (uint32_t pos = 0; pos < size; pos++) {
+			OpcUaDataValue::SPtr dataValue;
+			dataValueArraySPtr_->get(pos, dataValue);
+			if (dataValue.get() == nullptr) {
+				OpcUaDataValue().opcUaBinaryEncode(os);
+				continue;
+			}
+			dataValue->opcUaBinaryEncode(os, timestampsToReturn_);
+		}
 	}
 	
 	void 
@@ -39,6 +39,8 @@ namespace OpcUaStackCore
 
 		void dataValues(const OpcUaDataValueArray::SPtr dataValues);
 		OpcUaDataValueArray::SPtr dataValues(void) const;
+		void timestampsToReturn(OpcUaInt32 timestampsToReturn);
+		OpcUaInt32 timestampsToReturn(void) const;
 
 		void opcUaBinaryEncode(std::ostream& os) const;
 		void opcUaBinaryDecode(std::istream& is);
@@ -49,6 +51,7 @@ namespace OpcUaStackCore
 
 	  private:
 		OpcUaDataValueArray::SPtr dataValueArraySPtr_;
+		OpcUaInt32 timestampsToReturn_;
 	};
 
 }
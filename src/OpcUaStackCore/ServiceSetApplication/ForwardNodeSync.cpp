@@ -22,9 +22,11 @@ namespace OpcUaStackCore
 
 	ForwardNodeSync::ForwardNodeSync(void)
 	: readService_()
+	, readBatchService_()
 	, readHService_()
 	, readHEService_()
 	, writeService_()
+	, writeBatchService_()
 	, writeHService_()
 	, methodService_()
 	, monitoredItemStartService_()
@@ -42,6 +44,12 @@ namespace OpcUaStackCore
 		return readService_;
 	}
 
+	ForwardCallback&
+	ForwardNodeSync::readBatchService(void)
+	{
+		return readBatchService_;
+	}
+
 	ForwardCallback&
 	ForwardNodeSync::readHService(void)
 	{
@@ -60,6 +68,12 @@ namespace OpcUaStackCore
 		return writeService_;
 	}
 
+	ForwardCallback&
+	ForwardNodeSync::writeBatchService(void)
+	{
+		return writeBatchService_;
+	}
+
 	ForwardCallback&
 	ForwardNodeSync::writeHService(void)
 	{
@@ -88,9 +102,11 @@ namespace OpcUaStackCore
 	ForwardNodeSync::updateFrom(ForwardNodeSync& forwardCallbackSync)
 	{
 		readService_.updateFrom(forwardCallbackSync.readService());
+		readBatchService_.updateFrom(forwardCallbackSync.readBatchService());
 		readHService_.updateFrom(forwardCallbackSync.readHService());
 		readHEService_.updateFrom(forwardCallbackSync.readHEService());
 		writeService_.updateFrom(forwardCallbackSync.writeService());
+		writeBatchService_.updateFrom(forwardCallbackSync.writeBatchService());
 		writeHService_.updateFrom(forwardCallbackSync.writeHService());
 		methodService_.updateFrom(forwardCallbackSync.methodService());
 		monitoredItemStartService_.updateFrom(forwardCallbackSync.monitoredItemStartService());
@@ -37,9 +37,11 @@ namespace OpcUaStackCore
 		virtual ~ForwardNodeSync(void);
 
 		ForwardCallback& readService(void);
+		ForwardCallback& readBatchService(void);
 		ForwardCallback& readHService(void);
 		ForwardCallback& readHEService(void);
 		ForwardCallback& writeService(void);
+		ForwardCallback& writeBatchService(void);
 		ForwardCallback& writeHService(void);
 		ForwardCallback& methodService(void);
 		ForwardCallback& monitoredItemStartService(void);
@@ -50,9 +52,11 @@ namespace OpcUaStackCore
 	  private:
 		// attribute service
 		ForwardCallback readService_;
+		ForwardCallback readBatchService_;
 		ForwardCallback readHService_;
 		ForwardCallback readHEService_;
 		ForwardCallback writeService_;
+		ForwardCallback writeBatchService_;
 		ForwardCallback writeHService_;
 		ForwardCallback monitoredItemStartService_;
 		ForwardCallback monitoredItemStopService_;
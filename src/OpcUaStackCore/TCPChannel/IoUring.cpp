@@ -0,0 +1,556 @@
+/*
+   Copyright 2015 Kai Huebl (kai@huebl-sgh.de)
+
+   Lizenziert gemäß Apache Licence Version 2.0 (die „Lizenz“); Nutzung dieser
+   Datei nur in Übereinstimmung mit der Lizenz erlaubt.
+   Eine Kopie der Lizenz erhalten Sie auf http://www.apache.org/licenses/LICENSE-2.0.
+
+   Sofern nicht gemäß geltendem Recht vorgeschrieben oder schriftlich vereinbart,
+   erfolgt die Bereitstellung der im Rahmen der Lizenz verbreiteten Software OHNE
+   GEWÄHR ODER VORBEHALTE – ganz gleich, ob ausdrücklich oder stillschweigend.
+
+   Informationen über die jeweiligen Bedingungen für Genehmigungen und Einschränkungen
+   im Rahmen der Lizenz finden Sie in der Lizenz.
+
+   Autor: Kai Huebl (kai@huebl-sgh.de)
+ */
+
+
+#include "OpcUaStackCore/TCPChannel/IoUring.h"
+
+#if defined(OPCUASTACK_HAS_IO_URING)
+
+#include <boost/bind.hpp>
+#include <map>
+#include <vector>
+#include <string.h>
+#include <errno.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <sys/eventfd.h>
+#include <linux/io_uring.h>
+#include "OpcUaStackCore/Base/Log.h"
+#include "OpcUaStackCore/Base/ObjectPool.h"
+
+namespace OpcUaStackCore
+{
+
+	// ------------------------------------------------------------------------
+	// ------------------------------------------------------------------------
+	//
+	// Operation
+	//
+	// ------------------------------------------------------------------------
+	// ------------------------------------------------------------------------
+	IoUring::Operation::Operation(int fd, StrandSPtr& strand)
+	: fd_(fd)
+	, recv_(false)
+	, strand_(strand)
+	, handler_()
+	, ec_()
+	, bytes_(0)
+	{
+		memset(&msg_, 0x00, sizeof(msg_));
+		msg_.msg_iov = iov_;
+		msg_.msg_iovlen = 0;
+	}
+
+	IoUring::Operation::~Operation(void)
+	{
+	}
+
+	// ------------------------------------------------------------------------
+	// ------------------------------------------------------------------------
+	//
+	// Completions
+	//
+	// ------------------------------------------------------------------------
+	// ------------------------------------------------------------------------
+	IoUring::Completions::Completions(void)
+	: operationVec_()
+	{
+	}
+
+	IoUring::Completions::~Completions(void)
+	{
+		// the operations are deleted even if the handler is not invoked
+		// because the io service is shut down
+		OperationVec::iterator it;
+		for (it = operationVec_.begin(); it != operationVec_.end(); it++) {
+			delete *it;
+		}
+	}
+
+	// ------------------------------------------------------------------------
+	// ------------------------------------------------------------------------
+	//
+	// IoUring
+	//
+	// ------------------------------------------------------------------------
+	// ------------------------------------------------------------------------
+	boost::asio::io_service::id IoUring::id;
+
+	IoUring::IoUring(boost::asio::io_service& io_service)
+	: boost::asio::io_service::service(io_service)
+	, io_service_(io_service)
+	, mutex_()
+	, openFailed_(false)
+	, flushPosted_(false)
+	, unsubmitted_(0)
+	, operationSet_()
+	, ringFd_(-1)
+	, sqRing_(MAP_FAILED)
+	, sqRingSize_(0)
+	, cqRing_(MAP_FAILED)
+	, cqRingSize_(0)
+	, sqes_((struct io_uring_sqe*)MAP_FAILED)
+	, sqesSize_(0)
+	, sqHead_(nullptr)
+	, sqTail_(nullptr)
+	, sqMask_(nullptr)
+	, sqEntries_(nullptr)
+	, sqFlags_(nullptr)
+	, sqArray_(nullptr)
+	, cqHead_(nullptr)
+	, cqTail_(nullptr)
+	, cqMask_(nullptr)
+	, cqes_(nullptr)
+	, eventValue_(0)
+	, eventWait_(io_service)
+	{
+	}
+
+	IoUring::~IoUring(void)
+	{
+		close();
+	}
+
+	void
+	IoUring::shutdown(void)
+	{
+		boost::mutex::scoped_lock g(mutex_);
+
+		boost::system::error_code ec;
+		eventWait_.close(ec);
+
+		if (ringFd_ < 0 || operationSet_.empty()) {
+			return;
+		}
+
+		// the kernel uses the message header and the buffers of submitted
+		// operations until their completion entries are posted. All pending
+		// operations are cancelled and the handlers are destroyed without
+		// invocation after the completions are reaped.
+		std::set<Operation*>::iterator it;
+		for (it = operationSet_.begin(); it != operationSet_.end(); it++) {
+			prepare(*it, IORING_OP_ASYNC_CANCEL, 0);
+		}
+
+		while (!operationSet_.empty()) {
+			int result = syscall(__NR_io_uring_enter, ringFd_, unsubmitted_, 1, IORING_ENTER_GETEVENTS, nullptr, 0);
+			if (result < 0) {
+				if (errno == EINTR) continue;
+				if (errno != EBUSY && errno != EAGAIN) {
+					break;
+				}
+			}
+			else {
+				unsubmitted_ -= result;
+			}
+
+			OperationVec operationVec;
+			reapLocked(operationVec);
+			OperationVec::iterator itVec;
+			for (itVec = operationVec.begin(); itVec != operationVec.end(); itVec++) {
+				delete *itVec;
+			}
+		}
+
+		// operations which are not finished by the kernel are not deleted
+		if (!operationSet_.empty()) {
+			Log(Error, "io_uring operations not finished on shutdown")
+				.parameter("Operations", operationSet_.size())
+				.parameter("Message", strerror(errno));
+			operationSet_.clear();
+		}
+	}
+
+	bool
+	IoUring::open(void)
+	{
+		boost::mutex::scoped_lock g(mutex_);
+		if (ringFd_ >= 0) return true;
+		if (openFailed_) return false;
+
+		// completions are processed when the io thread enters the kernel
+		// anyway. Older kernels do not know this flag.
+		struct io_uring_params params;
+		memset(&params, 0x00, sizeof(params));
+#if defined(IORING_SETUP_COOP_TASKRUN)
+		params.flags = IORING_SETUP_COOP_TASKRUN;
+		ringFd_ = syscall(__NR_io_uring_setup, Entries, &params);
+		if (ringFd_ < 0 && errno == EINVAL) {
+			memset(&params, 0x00, sizeof(params));
+			ringFd_ = syscall(__NR_io_uring_setup, Entries, &params);
+		}
+#else
+		ringFd_ = syscall(__NR_io_uring_setup, Entries, &params);
+#endif
+		if (ringFd_ < 0) {
+			Log(Warning, "io_uring setup error")
+				.parameter("Message", strerror(errno));
+			openFailed_ = true;
+			return false;
+		}
+
+		// completions must not be lost if the completion queue is full
+		if ((params.features & IORING_FEAT_NODROP) == 0) {
+			Log(Warning, "io_uring is not supported by the kernel");
+			close();
+			openFailed_ = true;
+			return false;
+		}
+
+		// map submission queue, completion queue and submission entries
+		sqRingSize_ = params.sq_off.array + params.sq_entries * sizeof(unsigned);
+		cqRingSize_ = params.cq_off.cqes + params.cq_entries * sizeof(struct io_uring_cqe);
+		if ((params.features & IORING_FEAT_SINGLE_MMAP) != 0) {
+			if (cqRingSize_ > sqRingSize_) sqRingSize_ = cqRingSize_;
+			cqRingSize_ = 0;
+		}
+
+		sqRing_ = mmap(nullptr, sqRingSize_, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, ringFd_, IORING_OFF_SQ_RING);
+		if (sqRing_ == MAP_FAILED) {
+			Log(Warning, "io_uring submission queue map error")
+				.parameter("Message", strerror(errno));
+			close();
+			openFailed_ = true;
+			return false;
+		}
+
+		if (cqRingSize_ == 0) {
+			cqRing_ = sqRing_;
+		}
+		else {
+			cqRing_ = mmap(nullptr, cqRingSize_, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, ringFd_, IORING_OFF_CQ_RING);
+			if (cqRing_ == MAP_FAILED) {
+				Log(Warning, "io_uring completion queue map error")
+					.parameter("Message", strerror(errno));
+				close();
+				openFailed_ = true;
+				return false;
+			}
+		}
+
+		sqesSize_ = params.sq_entries * sizeof(struct io_uring_sqe);
+		sqes_ = (struct io_uring_sqe*)mmap(nullptr, sqesSize_, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, ringFd_, IORING_OFF_SQES);
+		if (sqes_ == MAP_FAILED) {
+			Log(Warning, "io_uring submission entries map error")
+				.parameter("Message", strerror(errno));
+			close();
+			openFailed_ = true;
+			return false;
+		}
+
+		char* sqRing = (char*)sqRing_;
+		sqHead_ = (unsigned*)(sqRing + params.sq_off.head);
+		sqTail_ = (unsigned*)(sqRing + params.sq_off.tail);
+		sqMask_ = (unsigned*)(sqRing + params.sq_off.ring_mask);
+		sqEntries_ = (unsigned*)(sqRing + params.sq_off.ring_entries);
+		sqFlags_ = (unsigned*)(sqRing + params.sq_off.flags);
+		sqArray_ = (unsigned*)(sqRing + params.sq_off.array);
+
+		char* cqRing = (char*)cqRing_;
+		cqHead_ = (unsigned*)(cqRing + params.cq_off.head);
+		cqTail_ = (unsigned*)(cqRing + params.cq_off.tail);
+		cqMask_ = (unsigned*)(cqRing + params.cq_off.ring_mask);
+		cqes_ = (struct io_uring_cqe*)(cqRing + params.cq_off.cqes);
+
+		// the eventfd is signaled when a completion entry is posted
+		int eventFd = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+		if (eventFd < 0) {
+			Log(Warning, "io_uring eventfd create error")
+				.parameter("Message", strerror(errno));
+			close();
+			openFailed_ = true;
+			return false;
+		}
+		if (syscall(__NR_io_uring_register, ringFd_, IORING_REGISTER_EVENTFD, &eventFd, 1) < 0) {
+			Log(Warning, "io_uring eventfd register error")
+				.parameter("Message", strerror(errno));
+			::close(eventFd);
+			close();
+			openFailed_ = true;
+			return false;
+		}
+		eventWait_.assign(eventFd);
+		waitCompletion();
+
+		Log(Info, "io_uring open")
+			.parameter("SubmissionEntries", params.sq_entries)
+			.parameter("CompletionEntries", params.cq_entries);
+		return true;
+	}
+
+	void
+	IoUring::close(void)
+	{
+		boost::system::error_code ec;
+		eventWait_.close(ec);
+
+		if (sqes_ != MAP_FAILED) {
+			munmap(sqes_, sqesSize_);
+			sqes_ = (struct io_uring_sqe*)MAP_FAILED;
+		}
+		if (cqRing_ != MAP_FAILED && cqRing_ != sqRing_) {
+			munmap(cqRing_, cqRingSize_);
+		}
+		cqRing_ = MAP_FAILED;
+		if (sqRing_ != MAP_FAILED) {
+			munmap(sqRing_, sqRingSize_);
+			sqRing_ = MAP_FAILED;
+		}
+		if (ringFd_ >= 0) {
+			::close(ringFd_);
+			ringFd_ = -1;
+		}
+	}
+
+	bool
+	IoUring::asyncRecv(Operation* operation)
+	{
+		boost::mutex::scoped_lock g(mutex_);
+		operation->recv_ = true;
+		return submit(operation, IORING_OP_RECVMSG, (uint64_t)operation);
+	}
+
+	bool
+	IoUring::asyncSend(Operation* operation)
+	{
+		boost::mutex::scoped_lock g(mutex_);
+		operation->recv_ = false;
+		return submit(operation, IORING_OP_SENDMSG, (uint64_t)operation);
+	}
+
+	void
+	IoUring::cancel(int fd)
+	{
+		boost::mutex::scoped_lock g(mutex_);
+		if (ringFd_ < 0) return;
+
+		// the pending operations hold a reference to the socket. They are
+		// not finished when the socket is closed and must be cancelled.
+		std::set<Operation*>::iterator it;
+		for (it = operationSet_.begin(); it != operationSet_.end(); it++) {
+			if ((*it)->fd_ != fd) continue;
+			submit(*it, IORING_OP_ASYNC_CANCEL, 0);
+		}
+		flushLocked();
+	}
+
+	bool
+	IoUring::submit(Operation* operation, uint8_t opcode, uint64_t userData)
+	{
+		if (!prepare(operation, opcode, userData)) {
+			return false;
+		}
+
+		// all entries prepared until the next handler of the io service
+		// are submitted with one system call
+		if (!flushPosted_) {
+			flushPosted_ = true;
+			io_service_.post(boost::bind(&IoUring::flush, this));
+		}
+		return true;
+	}
+
+	bool
+	IoUring::prepare(Operation* operation, uint8_t opcode, uint64_t userData)
+	{
+		if (ringFd_ < 0) return false;
+
+		// submit the collected entries if the submission queue is full
+		unsigned tail = *sqTail_;
+		if (tail - __atomic_load_n(sqHead_, __ATOMIC_ACQUIRE) == *sqEntries_) {
+			flushLocked();
+			if (tail - __atomic_load_n(sqHead_, __ATOMIC_ACQUIRE) == *sqEntries_) {
+				Log(Warning, "io_uring submission queue overflow");
+				return false;
+			}
+		}
+
+		unsigned index = tail & *sqMask_;
+		struct io_uring_sqe* sqe = &sqes_[index];
+		memset(sqe, 0x00, sizeof(*sqe));
+		sqe->opcode = opcode;
+		sqe->user_data = userData;
+		if (opcode == IORING_OP_ASYNC_CANCEL) {
+			sqe->fd = -1;
+			sqe->addr = (uint64_t)operation;
+		}
+		else {
+			sqe->fd = operation->fd_;
+			sqe->addr = (uint64_t)&operation->msg_;
+			sqe->len = 1;
+			sqe->msg_flags = MSG_NOSIGNAL;
+			operationSet_.insert(operation);
+		}
+		sqArray_[index] = index;
+		__atomic_store_n(sqTail_, tail + 1, __ATOMIC_RELEASE);
+		unsubmitted_++;
+		return true;
+	}
+
+	void
+	IoUring::flush(void)
+	{
+		OperationVec operationVec;
+
+		{
+			boost::mutex::scoped_lock g(mutex_);
+			flushPosted_ = false;
+			if (ringFd_ < 0) return;
+
+			// the completions of earlier submissions are reaped in the same
+			// pass. Their eventfd signal finds an empty completion queue.
+			flushLocked();
+			reapLocked(operationVec);
+		}
+
+		dispatch(operationVec);
+	}
+
+	void
+	IoUring::flushLocked(void)
+	{
+		while (unsubmitted_ > 0) {
+			int result = syscall(__NR_io_uring_enter, ringFd_, unsubmitted_, 0, 0, nullptr, 0);
+			if (result < 0) {
+				if (errno == EINTR) continue;
+
+				// the completion queue is full. The entries are submitted
+				// after the next completions are reaped
+				if (errno == EBUSY || errno == EAGAIN) return;
+
+				Log(Error, "io_uring submit error")
+					.parameter("Message", strerror(errno));
+				return;
+			}
+			unsubmitted_ -= result;
+		}
+	}
+
+	void
+	IoUring::reapLocked(OperationVec& operationVec)
+	{
+		// move overflowed completions into the completion queue
+		if ((__atomic_load_n(sqFlags_, __ATOMIC_RELAXED) & IORING_SQ_CQ_OVERFLOW) != 0) {
+			syscall(__NR_io_uring_enter, ringFd_, 0, 0, IORING_ENTER_GETEVENTS, nullptr, 0);
+		}
+
+		unsigned head = *cqHead_;
+		unsigned tail = __atomic_load_n(cqTail_, __ATOMIC_ACQUIRE);
+		while (head != tail) {
+			struct io_uring_cqe* cqe = &cqes_[head & *cqMask_];
+			head++;
+
+			// cancel entries have no operation
+			Operation* operation = (Operation*)cqe->user_data;
+			if (operation == nullptr) {
+				continue;
+			}
+			operationSet_.erase(operation);
+
+			int32_t result = cqe->res;
+			operation->bytes_ = 0;
+			if (result == -ECANCELED) {
+				operation->ec_ = boost::asio::error::operation_aborted;
+			}
+			else if (result < 0) {
+				operation->ec_ = boost::system::error_code(-result, boost::asio::error::get_system_category());
+			}
+			else if (result == 0 && operation->recv_) {
+				operation->ec_ = boost::asio::error::eof;
+			}
+			else {
+				operation->ec_ = boost::system::error_code();
+				operation->bytes_ = result;
+			}
+			operationVec.push_back(operation);
+		}
+		__atomic_store_n(cqHead_, head, __ATOMIC_RELEASE);
+	}
+
+	void
+	IoUring::dispatch(OperationVec& operationVec)
+	{
+		if (operationVec.empty()) {
+			return;
+		}
+
+		// the completions of a strand are invoked by one handler in the
+		// order of the completion queue
+		typedef std::map<boost::asio::io_service::strand*, Completions::SPtr> CompletionsMap;
+		CompletionsMap completionsMap;
+
+		OperationVec::iterator it;
+		for (it = operationVec.begin(); it != operationVec.end(); it++) {
+			Completions::SPtr& completions = completionsMap[(*it)->strand_.get()];
+			if (completions.get() == nullptr) {
+				completions = constructSPtr<Completions>();
+			}
+			completions->operationVec_.push_back(*it);
+		}
+
+		CompletionsMap::iterator itMap;
+		for (itMap = completionsMap.begin(); itMap != completionsMap.end(); itMap++) {
+			itMap->second->operationVec_.front()->strand_->post(boost::bind(&IoUring::invoke, itMap->second));
+		}
+	}
+
+	void
+	IoUring::invoke(Completions::SPtr& completions)
+	{
+		OperationVec::iterator it;
+		for (it = completions->operationVec_.begin(); it != completions->operationVec_.end(); it++) {
+			Operation* operation = *it;
+			operation->handler_(operation->ec_, operation->bytes_);
+		}
+	}
+
+	void
+	IoUring::waitCompletion(void)
+	{
+		eventWait_.async_read_some(
+			boost::asio::buffer(&eventValue_, sizeof(eventValue_)),
+			boost::bind(&IoUring::completion, this, boost::asio::placeholders::error)
+		);
+	}
+
+	void
+	IoUring::completion(const boost::system::error_code& error)
+	{
+		if (error == boost::asio::error::operation_aborted) {
+			return;
+		}
+
+		OperationVec operationVec;
+
+		{
+			boost::mutex::scoped_lock g(mutex_);
+			if (ringFd_ < 0) return;
+
+			reapLocked(operationVec);
+
+			// submit entries which were rejected because of a full completion queue
+			flushLocked();
+		}
+
+		dispatch(operationVec);
+		waitCompletion();
+	}
+
+}
+
+#endif
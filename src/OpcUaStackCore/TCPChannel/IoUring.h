@@ -0,0 +1,168 @@
+/*
+   Copyright 2015 Kai Huebl (kai@huebl-sgh.de)
+
+   Lizenziert gemäß Apache Licence Version 2.0 (die „Lizenz“); Nutzung dieser
+   Datei nur in Übereinstimmung mit der Lizenz erlaubt.
+   Eine Kopie der Lizenz erhalten Sie auf http://www.apache.org/licenses/LICENSE-2.0.
+
+   Sofern nicht gemäß geltendem Recht vorgeschrieben oder schriftlich vereinbart,
+   erfolgt die Bereitstellung der im Rahmen der Lizenz verbreiteten Software OHNE
+   GEWÄHR ODER VORBEHALTE – ganz gleich, ob ausdrücklich oder stillschweigend.
+
+   Informationen über die jeweiligen Bedingungen für Genehmigungen und Einschränkungen
+   im Rahmen der Lizenz finden Sie in der Lizenz.
+
+   Autor: Kai Huebl (kai@huebl-sgh.de)
+ */
+
+
+#ifndef __OpcUaStackCore_IoUring_h__
+#define __OpcUaStackCore_IoUring_h__
+
+#include <set>
+#include <vector>
+#include <boost/shared_ptr.hpp>
+#include <boost/function.hpp>
+#include <boost/asio.hpp>
+#include <boost/thread/mutex.hpp>
+#include "OpcUaStackCore/Base/os.h"
+
+#if defined(__linux__) && defined(OPCUASTACK_IO_URING) && defined(BOOST_ASIO_HAS_POSIX_STREAM_DESCRIPTOR)
+	#define OPCUASTACK_HAS_IO_URING
+#endif
+
+#if defined(OPCUASTACK_HAS_IO_URING)
+
+#include <sys/uio.h>
+#include <sys/socket.h>
+
+struct io_uring_sqe;
+struct io_uring_cqe;
+
+namespace OpcUaStackCore
+{
+
+	//
+	// io_uring instance of an io service. Receive and send operations of
+	// all connections of the io service are collected in the submission
+	// queue and are submitted to the kernel with one system call when the
+	// io service runs the next handler. The same pass reaps the completion
+	// entries which are already available, the remaining ones are reaped
+	// when the eventfd of the ring signals new completion entries. The
+	// completions of a connection are passed to its strand with one handler.
+	//
+	class DLLEXPORT IoUring
+	: public boost::asio::io_service::service
+	{
+	  public:
+		typedef boost::shared_ptr<boost::asio::io_service::strand> StrandSPtr;
+		typedef boost::function<void (const boost::system::error_code&, std::size_t)> Handler;
+
+		static boost::asio::io_service::id id;
+		static const uint32_t MaxBuffers = 16;
+		static const uint32_t Entries = 256;
+
+		class Operation
+		{
+		  public:
+			Operation(int fd, StrandSPtr& strand);
+			~Operation(void);
+
+			template<typename BUFFERS>
+			  std::size_t buffers(const BUFFERS& buffers)
+			  {
+				  std::size_t size = 0;
+				  for (auto it = boost::asio::buffer_sequence_begin(buffers); it != boost::asio::buffer_sequence_end(buffers); it++) {
+					  if (msg_.msg_iovlen == MaxBuffers) break;
+					  boost::asio::const_buffer buffer(*it);
+					  if (buffer.size() == 0) continue;
+					  iov_[msg_.msg_iovlen].iov_base = (void*)buffer.data();
+					  iov_[msg_.msg_iovlen].iov_len = buffer.size();
+					  msg_.msg_iovlen++;
+					  size += buffer.size();
+				  }
+				  return size;
+			  }
+
+			int fd_;
+			bool recv_;
+			StrandSPtr strand_;
+			Handler handler_;
+			boost::system::error_code ec_;
+			std::size_t bytes_;
+			struct msghdr msg_;
+			struct iovec iov_[MaxBuffers];
+		};
+
+		explicit IoUring(boost::asio::io_service& io_service);
+		~IoUring(void);
+
+		bool open(void);
+		bool asyncRecv(Operation* operation);
+		bool asyncSend(Operation* operation);
+		void cancel(int fd);
+
+		//- boost::asio::io_service::service ----------------------------------
+		void shutdown(void);
+		//- boost::asio::io_service::service ----------------------------------
+
+	  private:
+		typedef std::vector<Operation*> OperationVec;
+
+		class Completions
+		{
+		  public:
+			typedef boost::shared_ptr<Completions> SPtr;
+
+			Completions(void);
+			~Completions(void);
+
+			OperationVec operationVec_;
+		};
+
+		bool prepare(Operation* operation, uint8_t opcode, uint64_t userData);
+		bool submit(Operation* operation, uint8_t opcode, uint64_t userData);
+		void flush(void);
+		void flushLocked(void);
+		void reapLocked(OperationVec& operationVec);
+		void dispatch(OperationVec& operationVec);
+		static void invoke(Completions::SPtr& completions);
+		void waitCompletion(void);
+		void completion(const boost::system::error_code& error);
+		void close(void);
+
+		boost::asio::io_service& io_service_;
+		boost::mutex mutex_;
+		bool openFailed_;
+		bool flushPosted_;
+		uint32_t unsubmitted_;
+		std::set<Operation*> operationSet_;
+
+		int ringFd_;
+		void* sqRing_;
+		size_t sqRingSize_;
+		void* cqRing_;
+		size_t cqRingSize_;
+		struct io_uring_sqe* sqes_;
+		size_t sqesSize_;
+
+		unsigned* sqHead_;
+		unsigned* sqTail_;
+		unsigned* sqMask_;
+		unsigned* sqEntries_;
+		unsigned* sqFlags_;
+		unsigned* sqArray_;
+		unsigned* cqHead_;
+		unsigned* cqTail_;
+		unsigned* cqMask_;
+		struct io_uring_cqe* cqes_;
+
+		uint64_t eventValue_;
+		boost::asio::posix::stream_descriptor eventWait_;
+	};
+
+}
+
+#endif
+
+#endif
@@ -0,0 +1,161 @@
+/*
+   Copyright 2015 Kai Huebl (kai@huebl-sgh.de)
+
+   Lizenziert gemäß Apache Licence Version 2.0 (die „Lizenz“); Nutzung dieser
+   Datei nur in Übereinstimmung mit der Lizenz erlaubt.
+   Eine Kopie der Lizenz erhalten Sie auf http://www.apache.org/licenses/LICENSE-2.0.
+
+   Sofern nicht gemäß geltendem Recht vorgeschrieben oder schriftlich vereinbart,
+   erfolgt die Bereitstellung der im Rahmen der Lizenz verbreiteten Software OHNE
+   GEWÄHR ODER VORBEHALTE – ganz gleich, ob ausdrücklich oder stillschweigend.
+
+   Informationen über die jeweiligen Bedingungen für Genehmigungen und Einschränkungen
+   im Rahmen der Lizenz finden Sie in der Lizenz.
+
+   Autor: Kai Huebl (kai@huebl-sgh.de)
+ */
+
+
+#include <boost/bind.hpp>
+#include "OpcUaStackCore/TCPChannel/MemAcceptor.h"
+
+namespace OpcUaStackCore
+{
+
+	boost::mutex MemAcceptor::registryMutex_;
+	MemAcceptor::Registry MemAcceptor::registry_;
+
+	MemAcceptor::MemAcceptor(boost::asio::io_service& io_service, const std::string& name)
+	: io_service_(io_service)
+	, name_(name)
+	, listen_(false)
+	, mutex_()
+	, backlog_()
+	, acceptStream_(nullptr)
+	, acceptHandler_()
+	{
+	}
+
+	MemAcceptor::~MemAcceptor(void)
+	{
+		close();
+	}
+
+	bool
+	MemAcceptor::connect(const std::string& name, MemStream& memStream)
+	{
+		// the registry lock keeps the acceptor alive during the connect
+		boost::mutex::scoped_lock g(registryMutex_);
+		Registry::iterator it = registry_.find(name);
+		if (it == registry_.end()) {
+			return false;
+		}
+		it->second->connect(memStream);
+		return true;
+	}
+
+	void
+	MemAcceptor::connect(MemStream& memStream)
+	{
+		MemStream::Queue::SPtr clientServer;
+		MemStream::Queue::SPtr serverClient;
+		MemStream::createQueues(clientServer, serverClient);
+		memStream.attach(serverClient, clientServer);
+
+		AcceptHandler acceptHandler;
+		{
+			boost::mutex::scoped_lock g(mutex_);
+			if (acceptStream_ == nullptr) {
+				backlog_.push_back(Connection(clientServer, serverClient));
+				return;
+			}
+			acceptStream_->attach(clientServer, serverClient);
+			acceptStream_ = nullptr;
+			acceptHandler.swap(acceptHandler_);
+		}
+
+		io_service_.post(boost::bind(acceptHandler, boost::system::error_code()));
+	}
+
+	void
+	MemAcceptor::listen(void)
+	{
+		boost::mutex::scoped_lock g(registryMutex_);
+		boost::mutex::scoped_lock a(mutex_);
+		if (listen_) return;
+
+		// the name of an acceptor is unique in the process
+		if (registry_.find(name_) != registry_.end()) {
+			throw boost::system::system_error(boost::asio::error::address_in_use);
+		}
+		registry_.insert(std::make_pair(name_, this));
+		listen_ = true;
+	}
+
+	void
+	MemAcceptor::asyncAccept(MemStream& memStream, const AcceptHandler& acceptHandler)
+	{
+		boost::system::error_code ec;
+		{
+			boost::mutex::scoped_lock g(mutex_);
+			if (!listen_) {
+				ec = boost::asio::error::bad_descriptor;
+			}
+			else if (acceptStream_ != nullptr) {
+				ec = boost::asio::error::already_started;
+			}
+			else if (backlog_.empty()) {
+				acceptStream_ = &memStream;
+				acceptHandler_ = acceptHandler;
+				return;
+			}
+			else {
+				memStream.attach(backlog_.front().first, backlog_.front().second);
+				backlog_.pop_front();
+			}
+		}
+
+		io_service_.post(boost::bind(acceptHandler, ec));
+	}
+
+	void
+	MemAcceptor::cancel(void)
+	{
+		AcceptHandler acceptHandler;
+		{
+			boost::mutex::scoped_lock g(mutex_);
+			acceptStream_ = nullptr;
+			acceptHandler.swap(acceptHandler_);
+		}
+
+		if (acceptHandler) {
+			io_service_.post(boost::bind(acceptHandler, boost::asio::error::operation_aborted));
+		}
+	}
+
+	void
+	MemAcceptor::close(void)
+	{
+		std::deque<Connection> backlog;
+		{
+			boost::mutex::scoped_lock g(registryMutex_);
+			boost::mutex::scoped_lock a(mutex_);
+			if (listen_) {
+				registry_.erase(name_);
+				listen_ = false;
+			}
+			backlog.swap(backlog_);
+		}
+
+		cancel();
+
+		// connections in the backlog are closed. The clients read the
+		// end of the stream
+		std::deque<Connection>::iterator it;
+		for (it = backlog.begin(); it != backlog.end(); it++) {
+			MemStream::closeQueue(it->first, boost::system::error_code());
+			MemStream::closeQueue(it->second, boost::system::error_code());
+		}
+	}
+
+}
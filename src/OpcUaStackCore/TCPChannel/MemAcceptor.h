@@ -0,0 +1,85 @@
+/*
+   Copyright 2015 Kai Huebl (kai@huebl-sgh.de)
+
+   Lizenziert gemäß Apache Licence Version 2.0 (die „Lizenz“); Nutzung dieser
+   Datei nur in Übereinstimmung mit der Lizenz erlaubt.
+   Eine Kopie der Lizenz erhalten Sie auf http://www.apache.org/licenses/LICENSE-2.0.
+
+   Sofern nicht gemäß geltendem Recht vorgeschrieben oder schriftlich vereinbart,
+   erfolgt die Bereitstellung der im Rahmen der Lizenz verbreiteten Software OHNE
+   GEWÄHR ODER VORBEHALTE – ganz gleich, ob ausdrücklich oder stillschweigend.
+
+   Informationen über die jeweiligen Bedingungen für Genehmigungen und Einschränkungen
+   im Rahmen der Lizenz finden Sie in der Lizenz.
+
+   Autor: Kai Huebl (kai@huebl-sgh.de)
+ */
+
+
+#ifndef __OpcUaStackCore_MemAcceptor_h__
+#define __OpcUaStackCore_MemAcceptor_h__
+
+#include <boost/shared_ptr.hpp>
+#include <boost/function.hpp>
+#include <boost/thread/mutex.hpp>
+#include <boost/asio.hpp>
+#include <deque>
+#include <map>
+#include <string>
+#include "OpcUaStackCore/Base/os.h"
+#include "OpcUaStackCore/TCPChannel/MemStream.h"
+
+namespace OpcUaStackCore
+{
+
+	//
+	// acceptor of in process connections (opc.mem). A listening acceptor
+	// is registered by its name in a process wide registry. A client
+	// connects its memory stream by the name of the acceptor. Connections
+	// which arrive while no accept operation is pending are kept in the
+	// backlog of the acceptor.
+	//
+	class DLLEXPORT MemAcceptor
+	{
+	  public:
+		typedef boost::shared_ptr<MemAcceptor> SPtr;
+		typedef boost::function<void (const boost::system::error_code&)> AcceptHandler;
+
+		MemAcceptor(boost::asio::io_service& io_service, const std::string& name);
+		~MemAcceptor(void);
+
+		static bool connect(const std::string& name, MemStream& memStream);
+
+		void listen(void);
+		void cancel(void);
+		void close(void);
+
+		template<typename HANDLER>
+		  void async_accept(MemStream& memStream, HANDLER handler)
+		  {
+			  asyncAccept(memStream, AcceptHandler(handler));
+		  }
+
+	  private:
+		typedef std::pair<MemStream::Queue::SPtr, MemStream::Queue::SPtr> Connection;
+		typedef std::map<std::string, MemAcceptor*> Registry;
+
+		static boost::mutex registryMutex_;
+		static Registry registry_;
+
+		void asyncAccept(MemStream& memStream, const AcceptHandler& acceptHandler);
+		void connect(MemStream& memStream);
+
+		boost::asio::io_service& io_service_;
+		std::string name_;
+		bool listen_;
+
+		boost::mutex mutex_;
+		std::deque<Connection> backlog_;
+		MemStream* acceptStream_;
+		AcceptHandler acceptHandler_;
+	};
+
+}
+
+#endif
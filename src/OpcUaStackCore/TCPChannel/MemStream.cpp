@@ -0,0 +1,129 @@
+/*
+   Copyright 2015 Kai Huebl (kai@huebl-sgh.de)
+
+   Lizenziert gemäß Apache Licence Version 2.0 (die „Lizenz“); Nutzung dieser
+   Datei nur in Übereinstimmung mit der Lizenz erlaubt.
+   Eine Kopie der Lizenz erhalten Sie auf http://www.apache.org/licenses/LICENSE-2.0.
+
+   Sofern nicht gemäß geltendem Recht vorgeschrieben oder schriftlich vereinbart,
+   erfolgt die Bereitstellung der im Rahmen der Lizenz verbreiteten Software OHNE
+   GEWÄHR ODER VORBEHALTE – ganz gleich, ob ausdrücklich oder stillschweigend.
+
+   Informationen über die jeweiligen Bedingungen für Genehmigungen und Einschränkungen
+   im Rahmen der Lizenz finden Sie in der Lizenz.
+
+   Autor: Kai Huebl (kai@huebl-sgh.de)
+ */
+
+
+#include "OpcUaStackCore/TCPChannel/MemStream.h"
+
+namespace OpcUaStackCore
+{
+
+	// ------------------------------------------------------------------------
+	// ------------------------------------------------------------------------
+	//
+	// MemStream::Queue
+	//
+	// ------------------------------------------------------------------------
+	// ------------------------------------------------------------------------
+	MemStream::Queue::Queue(void)
+	: mutex_()
+	, data_()
+	, readPos_(0)
+	, closed_(false)
+	, waitStrand_()
+	, waitHandler_()
+	{
+	}
+
+	MemStream::Queue::~Queue(void)
+	{
+	}
+
+	// ------------------------------------------------------------------------
+	// ------------------------------------------------------------------------
+	//
+	// MemStream
+	//
+	// ------------------------------------------------------------------------
+	// ------------------------------------------------------------------------
+	MemStream::MemStream(boost::asio::io_service& io_service, StrandSPtr& strand)
+	: io_service_(io_service)
+	, strand_(strand)
+	, closed_(false)
+	, rxQueue_()
+	, txQueue_()
+	{
+	}
+
+	MemStream::~MemStream(void)
+	{
+		close();
+	}
+
+	MemStream::executor_type
+	MemStream::get_executor(void)
+	{
+		return io_service_.get_executor();
+	}
+
+	void
+	MemStream::createQueues(Queue::SPtr& queue1, Queue::SPtr& queue2)
+	{
+		queue1.reset(new Queue());
+		queue2.reset(new Queue());
+	}
+
+	void
+	MemStream::attach(Queue::SPtr& rxQueue, Queue::SPtr& txQueue)
+	{
+		// a closed stream can be attached again to a new pair of queues
+		rxQueue_ = rxQueue;
+		txQueue_ = txQueue;
+		closed_ = false;
+	}
+
+	bool
+	MemStream::isOpen(void)
+	{
+		return rxQueue_.get() != nullptr && !closed_;
+	}
+
+	void
+	MemStream::close(void)
+	{
+		if (closed_) return;
+		closed_ = true;
+
+		// the own pending read is aborted and the pending read of the peer
+		// is woken up to read the end of the stream
+		if (rxQueue_.get() != nullptr) {
+			closeQueue(rxQueue_, boost::asio::error::operation_aborted);
+		}
+		if (txQueue_.get() != nullptr) {
+			closeQueue(txQueue_, boost::system::error_code());
+		}
+		rxQueue_.reset();
+		txQueue_.reset();
+	}
+
+	void
+	MemStream::closeQueue(Queue::SPtr& queue, const boost::system::error_code& error)
+	{
+		StrandSPtr waitStrand;
+		WaitHandler waitHandler;
+		{
+			boost::mutex::scoped_lock g(queue->mutex_);
+			queue->closed_ = true;
+			waitStrand.swap(queue->waitStrand_);
+			waitHandler.swap(queue->waitHandler_);
+		}
+
+		if (waitHandler) {
+			waitStrand->post(boost::bind(waitHandler, error));
+		}
+	}
+
+}
@@ -0,0 +1,178 @@
+/*
+   Copyright 2015 Kai Huebl (kai@huebl-sgh.de)
+
+   Lizenziert gemäß Apache Licence Version 2.0 (die „Lizenz“); Nutzung dieser
+   Datei nur in Übereinstimmung mit der Lizenz erlaubt.
+   Eine Kopie der Lizenz erhalten Sie auf http://www.apache.org/licenses/LICENSE-2.0.
+
+   Sofern nicht gemäß geltendem Recht vorgeschrieben oder schriftlich vereinbart,
+   erfolgt die Bereitstellung der im Rahmen der Lizenz verbreiteten Software OHNE
+   GEWÄHR ODER VORBEHALTE – ganz gleich, ob ausdrücklich oder stillschweigend.
+
+   Informationen über die jeweiligen Bedingungen für Genehmigungen und Einschränkungen
+   im Rahmen der Lizenz finden Sie in der Lizenz.
+
+   Autor: Kai Huebl (kai@huebl-sgh.de)
+ */
+
+
+#ifndef __OpcUaStackCore_MemStream_h__
+#define __OpcUaStackCore_MemStream_h__
+
+#include <boost/shared_ptr.hpp>
+#include <boost/function.hpp>
+#include <boost/bind.hpp>
+#include <boost/thread/mutex.hpp>
+#include <boost/asio.hpp>
+#include <string.h>
+#include <string>
+#include "OpcUaStackCore/Base/os.h"
+
+namespace OpcUaStackCore
+{
+
+	//
+	// asynchronous stream over two buffer queues in the memory of the
+	// process. A pair of streams is connected by crossing the queues, which
+	// allows a client and a server in the same process to exchange messages
+	// without sockets. Writing appends the data to the queue of the peer and
+	// never blocks. A waiting reader is woken up on the strand of its
+	// connection.
+	//
+	class DLLEXPORT MemStream
+	{
+	  public:
+		typedef boost::shared_ptr<MemStream> SPtr;
+		typedef boost::shared_ptr<boost::asio::io_service::strand> StrandSPtr;
+		typedef boost::asio::io_service::executor_type executor_type;
+		typedef boost::function<void (const boost::system::error_code&)> WaitHandler;
+
+		class Queue
+		{
+		  public:
+			typedef boost::shared_ptr<Queue> SPtr;
+
+			Queue(void);
+			~Queue(void);
+
+			boost::mutex mutex_;
+			std::string data_;
+			size_t readPos_;
+			bool closed_;
+			StrandSPtr waitStrand_;
+			WaitHandler waitHandler_;
+		};
+
+		MemStream(boost::asio::io_service& io_service, StrandSPtr& strand);
+		~MemStream(void);
+
+		static void createQueues(Queue::SPtr& queue1, Queue::SPtr& queue2);
+		static void closeQueue(Queue::SPtr& queue, const boost::system::error_code& error);
+		void attach(Queue::SPtr& rxQueue, Queue::SPtr& txQueue);
+		bool isOpen(void);
+		void close(void);
+
+		executor_type get_executor(void);
+
+		template<typename MUTABLE_BUFFER, typename HANDLER>
+		  void async_read_some(const MUTABLE_BUFFER& buffers, HANDLER&& handler)
+		  {
+			  boost::system::error_code ec;
+			  std::size_t bytes = 0;
+			  if (rxQueue_.get() == nullptr || closed_) {
+				  ec = boost::asio::error::bad_descriptor;
+			  }
+			  else if (boost::asio::buffer_size(buffers) != 0) {
+				  boost::mutex::scoped_lock g(rxQueue_->mutex_);
+				  bytes = readSome(buffers);
+				  if (bytes == 0) {
+					  if (!rxQueue_->closed_) {
+						  // wait for the next write of the peer
+						  rxQueue_->waitStrand_ = strand_;
+						  rxQueue_->waitHandler_ = [this, buffers, handler](const boost::system::error_code& error) mutable {
+							  if (error) {
+								  handler(error, 0);
+								  return;
+							  }
+							  async_read_some(buffers, handler);
+						  };
+						  return;
+					  }
+					  ec = boost::asio::error::eof;
+				  }
+			  }
+			  strand_->post(boost::asio::detail::bind_handler(handler, ec, bytes));
+		  }
+
+		template<typename CONST_BUFFER, typename HANDLER>
+		  void async_write_some(const CONST_BUFFER& buffers, HANDLER&& handler)
+		  {
+			  boost::system::error_code ec;
+			  std::size_t bytes = 0;
+			  StrandSPtr waitStrand;
+			  WaitHandler waitHandler;
+			  if (txQueue_.get() == nullptr || closed_) {
+				  ec = boost::asio::error::bad_descriptor;
+			  }
+			  else {
+				  {
+					  boost::mutex::scoped_lock g(txQueue_->mutex_);
+					  if (txQueue_->closed_) {
+						  ec = boost::asio::error::broken_pipe;
+					  }
+					  else {
+						  for (auto it = boost::asio::buffer_sequence_begin(buffers); it != boost::asio::buffer_sequence_end(buffers); it++) {
+							  boost::asio::const_buffer buffer(*it);
+							  txQueue_->data_.append((const char*)buffer.data(), buffer.size());
+							  bytes += buffer.size();
+						  }
+						  if (bytes > 0) {
+							  waitStrand.swap(txQueue_->waitStrand_);
+							  waitHandler.swap(txQueue_->waitHandler_);
+						  }
+					  }
+				  }
+			  }
+			  strand_->post(boost::asio::detail::bind_handler(handler, ec, bytes));
+
+			  // wakeup the reader of the peer. The own completion is queued
+			  // first, because the reaction of the peer (e.g. closing the
+			  // connection) can destroy this stream.
+			  if (waitHandler) {
+				  waitStrand->post(boost::bind(waitHandler, boost::system::error_code()));
+			  }
+		  }
+
+	  private:
+		template<typename MUTABLE_BUFFER>
+		  std::size_t readSome(const MUTABLE_BUFFER& buffers)
+		  {
+			  std::size_t bytes = 0;
+			  for (auto it = boost::asio::buffer_sequence_begin(buffers); it != boost::asio::buffer_sequence_end(buffers); it++) {
+				  boost::asio::mutable_buffer buffer(*it);
+				  size_t available = rxQueue_->data_.size() - rxQueue_->readPos_;
+				  size_t len = buffer.size() < available ? buffer.size() : available;
+				  memcpy(buffer.data(), rxQueue_->data_.data() + rxQueue_->readPos_, len);
+				  rxQueue_->readPos_ += len;
+				  bytes += len;
+				  if (len < buffer.size()) break;
+			  }
+
+			  // the queue is empty. The memory is reused by the next write
+			  if (rxQueue_->readPos_ == rxQueue_->data_.size()) {
+				  rxQueue_->data_.clear();
+				  rxQueue_->readPos_ = 0;
+			  }
+			  return bytes;
+		  }
+
+		boost::asio::io_service& io_service_;
+		StrandSPtr strand_;
+		bool closed_;
+		Queue::SPtr rxQueue_;
+		Queue::SPtr txQueue_;
+	};
+
+}
+
+#endif
@@ -0,0 +1,230 @@
+/*
+   Copyright 2015 Kai Huebl (kai@huebl-sgh.de)
+
+   Lizenziert gemäß Apache Licence Version 2.0 (die „Lizenz“); Nutzung dieser
+   Datei nur in Übereinstimmung mit der Lizenz erlaubt.
+   Eine Kopie der Lizenz erhalten Sie auf http://www.apache.org/licenses/LICENSE-2.0.
+
+   Sofern nicht gemäß geltendem Recht vorgeschrieben oder schriftlich vereinbart,
+   erfolgt die Bereitstellung der im Rahmen der Lizenz verbreiteten Software OHNE
+   GEWÄHR ODER VORBEHALTE – ganz gleich, ob ausdrücklich oder stillschweigend.
+
+   Informationen über die jeweiligen Bedingungen für Genehmigungen und Einschränkungen
+   im Rahmen der Lizenz finden Sie in der Lizenz.
+
+   Autor: Kai Huebl (kai@huebl-sgh.de)
+ */
+
+#include <string.h>
+#include <new>
+#include "OpcUaStackCore/TCPChannel/ShmRingBuffer.h"
+
+namespace OpcUaStackCore
+{
+
+	ShmRingBuffer::ShmRingBuffer(void)
+	: header_(nullptr)
+	, data_(nullptr)
+	, capacity_(0)
+	, mask_(0)
+	, error_(false)
+	{
+	}
+
+	ShmRingBuffer::~ShmRingBuffer(void)
+	{
+	}
+
+	uint32_t
+	ShmRingBuffer::memorySize(uint32_t capacity)
+	{
+		return sizeof(Header) + capacity;
+	}
+
+	bool
+	ShmRingBuffer::init(char* memory, uint32_t capacity)
+	{
+		// the capacity must be a power of two
+		if (capacity == 0 || (capacity & (capacity - 1)) != 0) {
+			return false;
+		}
+
+		header_ = new (memory) Header();
+		header_->head_.store(0);
+		header_->tail_.store(0);
+		header_->readerWaiting_.store(0);
+		header_->writerWaiting_.store(0);
+		header_->closed_.store(0);
+		header_->capacity_ = capacity;
+
+		data_ = memory + sizeof(Header);
+		capacity_ = capacity;
+		mask_ = capacity - 1;
+		error_ = false;
+		return true;
+	}
+
+	bool
+	ShmRingBuffer::attach(char* memory)
+	{
+		Header* header = reinterpret_cast<Header*>(memory);
+		uint32_t capacity = header->capacity_;
+		if (capacity == 0 || (capacity & (capacity - 1)) != 0) {
+			return false;
+		}
+
+		header_ = header;
+		data_ = memory + sizeof(Header);
+		capacity_ = capacity;
+		mask_ = capacity - 1;
+		error_ = false;
+		return true;
+	}
+
+	void
+	ShmRingBuffer::detach(void)
+	{
+		header_ = nullptr;
+		data_ = nullptr;
+		capacity_ = 0;
+		mask_ = 0;
+	}
+
+	bool
+	ShmRingBuffer::attached(void)
+	{
+		return header_ != nullptr;
+	}
+
+	uint32_t
+	ShmRingBuffer::capacity(void)
+	{
+		return capacity_;
+	}
+
+	bool
+	ShmRingBuffer::used(uint64_t head, uint64_t tail, uint32_t& used)
+	{
+		// the peer has written an invalid position
+		if (head - tail > capacity_) {
+			error_ = true;
+			close();
+			return false;
+		}
+		used = (uint32_t)(head - tail);
+		return true;
+	}
+
+	uint32_t
+	ShmRingBuffer::write(const char* buf, uint32_t bufLen)
+	{
+		uint64_t head = header_->head_.load(std::memory_order_relaxed);
+		uint64_t tail = header_->tail_.load(std::memory_order_acquire);
+
+		uint32_t used;
+		if (!this->used(head, tail, used)) return 0;
+		uint32_t free = capacity_ - used;
+		uint32_t len = bufLen < free ? bufLen : free;
+		if (len == 0) return 0;
+
+		// copy data in at most two parts
+		uint32_t pos = (uint32_t)(head & mask_);
+		uint32_t part = capacity_ - pos;
+		if (part > len) part = len;
+		memcpy(data_ + pos, buf, part);
+		memcpy(data_, buf + part, len - part);
+
+		// the consumer reads the head after checking its waiting flag
+		header_->head_.store(head + len, std::memory_order_seq_cst);
+		return len;
+	}
+
+	uint32_t
+	ShmRingBuffer::read(char* buf, uint32_t bufLen)
+	{
+		uint64_t tail = header_->tail_.load(std::memory_order_relaxed);
+		uint64_t head = header_->head_.load(std::memory_order_acquire);
+
+		uint32_t used;
+		if (!this->used(head, tail, used)) return 0;
+		uint32_t len = bufLen < used ? bufLen : used;
+		if (len == 0) return 0;
+
+		// copy data out in at most two parts
+		uint32_t pos = (uint32_t)(tail & mask_);
+		uint32_t part = capacity_ - pos;
+		if (part > len) part = len;
+		memcpy(buf, data_ + pos, part);
+		memcpy(buf + part, data_, len - part);
+
+		header_->tail_.store(tail + len, std::memory_order_seq_cst);
+		return len;
+	}
+
+	uint32_t
+	ShmRingBuffer::readAvailable(void)
+	{
+		uint64_t tail = header_->tail_.load(std::memory_order_seq_cst);
+		uint64_t head = header_->head_.load(std::memory_order_seq_cst);
+
+		// an invalid position is reported by the next read
+		uint64_t used = head - tail;
+		return used > capacity_ ? capacity_ : (uint32_t)used;
+	}
+
+	uint32_t
+	ShmRingBuffer::writeAvailable(void)
+	{
+		uint64_t tail = header_->tail_.load(std::memory_order_seq_cst);
+		uint64_t head = header_->head_.load(std::memory_order_seq_cst);
+
+		// an invalid position is reported by the next write
+		uint64_t used = head - tail;
+		return used > capacity_ ? capacity_ : capacity_ - (uint32_t)used;
+	}
+
+	void
+	ShmRingBuffer::readerWaiting(bool readerWaiting)
+	{
+		header_->readerWaiting_.store(readerWaiting ? 1 : 0, std::memory_order_seq_cst);
+	}
+
+	bool
+	ShmRingBuffer::clearReaderWaiting(void)
+	{
+		if (header_->readerWaiting_.load(std::memory_order_seq_cst) == 0) return false;
+		return header_->readerWaiting_.exchange(0) != 0;
+	}
+
+	void
+	ShmRingBuffer::writerWaiting(bool writerWaiting)
+	{
+		header_->writerWaiting_.store(writerWaiting ? 1 : 0, std::memory_order_seq_cst);
+	}
+
+	bool
+	ShmRingBuffer::clearWriterWaiting(void)
+	{
+		if (header_->writerWaiting_.load(std::memory_order_seq_cst) == 0) return false;
+		return header_->writerWaiting_.exchange(0) != 0;
+	}
+
+	void
+	ShmRingBuffer::close(void)
+	{
+		header_->closed_.store(1, std::memory_order_seq_cst);
+	}
+
+	bool
+	ShmRingBuffer::closed(void)
+	{
+		return header_->closed_.load(std::memory_order_seq_cst) != 0;
+	}
+
+	bool
+	ShmRingBuffer::error(void)
+	{
+		return error_;
+	}
+
+}
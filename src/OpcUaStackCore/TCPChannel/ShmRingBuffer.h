@@ -0,0 +1,92 @@
+/*
+   Copyright 2015 Kai Huebl (kai@huebl-sgh.de)
+
+   Lizenziert gemäß Apache Licence Version 2.0 (die „Lizenz“); Nutzung dieser
+   Datei nur in Übereinstimmung mit der Lizenz erlaubt.
+   Eine Kopie der Lizenz erhalten Sie auf http://www.apache.org/licenses/LICENSE-2.0.
+
+   Sofern nicht gemäß geltendem Recht vorgeschrieben oder schriftlich vereinbart,
+   erfolgt die Bereitstellung der im Rahmen der Lizenz verbreiteten Software OHNE
+   GEWÄHR ODER VORBEHALTE – ganz gleich, ob ausdrücklich oder stillschweigend.
+
+   Informationen über die jeweiligen Bedingungen für Genehmigungen und Einschränkungen
+   im Rahmen der Lizenz finden Sie in der Lizenz.
+
+   Autor: Kai Huebl (kai@huebl-sgh.de)
+ */
+
+#ifndef __OpcUaStackCore_ShmRingBuffer_h__
+#define __OpcUaStackCore_ShmRingBuffer_h__
+
+#include <atomic>
+#include <stdint.h>
+#include "OpcUaStackCore/Base/os.h"
+
+namespace OpcUaStackCore
+{
+
+	//
+	// single producer single consumer ring buffer in a memory region which
+	// can be shared between two processes. The producer and the consumer
+	// only use atomic operations on the fast path. The waiting flags tell
+	// the other side that a wakeup notification is necessary.
+	//
+	// The header is writable by the peer process. The capacity is read once
+	// and the positions are checked on each access. An invalid position is
+	// a protocol error which closes the ring buffer.
+	//
+	class DLLEXPORT ShmRingBuffer
+	{
+	  public:
+		class Header
+		{
+		  public:
+			std::atomic<uint64_t> head_;
+			char pad1_[56];
+			std::atomic<uint64_t> tail_;
+			char pad2_[56];
+			std::atomic<uint32_t> readerWaiting_;
+			std::atomic<uint32_t> writerWaiting_;
+			std::atomic<uint32_t> closed_;
+			uint32_t capacity_;
+			char pad3_[48];
+		};
+
+		ShmRingBuffer(void);
+		~ShmRingBuffer(void);
+
+		static uint32_t memorySize(uint32_t capacity);
+
+		bool init(char* memory, uint32_t capacity);
+		bool attach(char* memory);
+		void detach(void);
+		bool attached(void);
+		uint32_t capacity(void);
+
+		uint32_t write(const char* buf, uint32_t bufLen);
+		uint32_t read(char* buf, uint32_t bufLen);
+		uint32_t readAvailable(void);
+		uint32_t writeAvailable(void);
+
+		void readerWaiting(bool readerWaiting);
+		bool clearReaderWaiting(void);
+		void writerWaiting(bool writerWaiting);
+		bool clearWriterWaiting(void);
+
+		void close(void);
+		bool closed(void);
+		bool error(void);
+
+	  private:
+		bool used(uint64_t head, uint64_t tail, uint32_t& used);
+
+		Header* header_;
+		char* data_;
+		uint32_t capacity_;
+		uint64_t mask_;
+		bool error_;
+	};
+
+}
+
+#endif
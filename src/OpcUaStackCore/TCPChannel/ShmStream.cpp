@@ -0,0 +1,339 @@
+/*
+   Copyright 2015 Kai Huebl (kai@huebl-sgh.de)
+
+   Lizenziert gemäß Apache Licence Version 2.0 (die „Lizenz“); Nutzung dieser
+   Datei nur in Übereinstimmung mit der Lizenz erlaubt.
+   Eine Kopie der Lizenz erhalten Sie auf http://www.apache.org/licenses/LICENSE-2.0.
+
+   Sofern nicht gemäß geltendem Recht vorgeschrieben oder schriftlich vereinbart,
+   erfolgt die Bereitstellung der im Rahmen der Lizenz verbreiteten Software OHNE
+   GEWÄHR ODER VORBEHALTE – ganz gleich, ob ausdrücklich oder stillschweigend.
+
+   Informationen über die jeweiligen Bedingungen für Genehmigungen und Einschränkungen
+   im Rahmen der Lizenz finden Sie in der Lizenz.
+
+   Autor: Kai Huebl (kai@huebl-sgh.de)
+ */
+
+#include "OpcUaStackCore/TCPChannel/ShmStream.h"
+
+#if defined(OPCUASTACK_HAS_SHM)
+
+#include <boost/bind.hpp>
+#include <string.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/socket.h>
+#include <sys/eventfd.h>
+#include "OpcUaStackCore/Base/Log.h"
+
+namespace OpcUaStackCore
+{
+
+	ShmStream::ShmStream(boost::asio::io_service& io_service, StrandSPtr& strand)
+	: io_service_(io_service)
+	, strand_(strand)
+	, server_(false)
+	, closed_(false)
+	, peerClosed_(false)
+	, memFd_(-1)
+	, memory_(nullptr)
+	, memorySize_(0)
+	, rxRing_()
+	, txRing_()
+	, rxSpaceNotifyFd_(-1)
+	, txDataNotifyFd_(-1)
+	, rxEventValue_(0)
+	, txEventValue_(0)
+	, rxDataWait_(io_service)
+	, txSpaceWait_(io_service)
+	, peerByte_(0)
+	, peerWatch_(io_service)
+	{
+		for (uint32_t idx = 0; idx < E_Max; idx++) {
+			eventFd_[idx] = -1;
+		}
+	}
+
+	ShmStream::~ShmStream(void)
+	{
+		close();
+	}
+
+	ShmStream::executor_type
+	ShmStream::get_executor(void)
+	{
+		return io_service_.get_executor();
+	}
+
+	bool
+	ShmStream::create(uint32_t capacity)
+	{
+		// the ring buffer size must be a power of two
+		if (capacity == 0 || (capacity & (capacity - 1)) != 0) {
+			Log(Error, "shared memory buffer size must be a power of two")
+				.parameter("BufferSize", capacity);
+			return false;
+		}
+
+		// create shared memory region with one ring buffer for each direction
+		size_t memorySize = 2 * ShmRingBuffer::memorySize(capacity);
+		int memFd = memfd_create("OpcUaShmStream", MFD_CLOEXEC);
+		if (memFd < 0) {
+			Log(Error, "shared memory create error")
+				.parameter("Message", strerror(errno));
+			return false;
+		}
+		if (ftruncate(memFd, memorySize) < 0) {
+			Log(Error, "shared memory truncate error")
+				.parameter("Message", strerror(errno));
+			::close(memFd);
+			return false;
+		}
+
+		// create wakeup descriptors
+		for (uint32_t idx = 0; idx < E_Max; idx++) {
+			eventFd_[idx] = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+			if (eventFd_[idx] < 0) {
+				Log(Error, "eventfd create error")
+					.parameter("Message", strerror(errno));
+				::close(memFd);
+				close();
+				return false;
+			}
+		}
+
+		return map(memFd, memorySize, true, capacity);
+	}
+
+	bool
+	ShmStream::sendDescriptors(int socket)
+	{
+		int fds[E_Max + 1];
+		fds[0] = memFd_;
+		for (uint32_t idx = 0; idx < E_Max; idx++) {
+			fds[idx+1] = eventFd_[idx];
+		}
+
+		char data = 'S';
+		struct iovec iov;
+		iov.iov_base = &data;
+		iov.iov_len = 1;
+
+		char control[CMSG_SPACE(sizeof(fds))];
+		memset(control, 0x00, sizeof(control));
+
+		struct msghdr msg;
+		memset(&msg, 0x00, sizeof(msg));
+		msg.msg_iov = &iov;
+		msg.msg_iovlen = 1;
+		msg.msg_control = control;
+		msg.msg_controllen = sizeof(control);
+
+		struct cmsghdr* cmsg = CMSG_FIRSTHDR(&msg);
+		cmsg->cmsg_level = SOL_SOCKET;
+		cmsg->cmsg_type = SCM_RIGHTS;
+		cmsg->cmsg_len = CMSG_LEN(sizeof(fds));
+		memcpy(CMSG_DATA(cmsg), fds, sizeof(fds));
+
+		if (sendmsg(socket, &msg, MSG_NOSIGNAL) != 1) {
+			Log(Error, "shared memory descriptor send error")
+				.parameter("Message", strerror(errno));
+			return false;
+		}
+		return true;
+	}
+
+	bool
+	ShmStream::receiveDescriptors(int socket)
+	{
+		int fds[E_Max + 1];
+
+		char data = 0;
+		struct iovec iov;
+		iov.iov_base = &data;
+		iov.iov_len = 1;
+
+		char control[CMSG_SPACE(sizeof(fds))];
+		memset(control, 0x00, sizeof(control));
+
+		struct msghdr msg;
+		memset(&msg, 0x00, sizeof(msg));
+		msg.msg_iov = &iov;
+		msg.msg_iovlen = 1;
+		msg.msg_control = control;
+		msg.msg_controllen = sizeof(control);
+
+		if (recvmsg(socket, &msg, MSG_CMSG_CLOEXEC) != 1) {
+			Log(Error, "shared memory descriptor receive error")
+				.parameter("Message", strerror(errno));
+			return false;
+		}
+
+		struct cmsghdr* cmsg = CMSG_FIRSTHDR(&msg);
+		if (cmsg == nullptr ||
+			cmsg->cmsg_level != SOL_SOCKET ||
+			cmsg->cmsg_type != SCM_RIGHTS ||
+			cmsg->cmsg_len != CMSG_LEN(sizeof(fds))
+		) {
+			Log(Error, "shared memory descriptor message invalid");
+			return false;
+		}
+		memcpy(fds, CMSG_DATA(cmsg), sizeof(fds));
+
+		for (uint32_t idx = 0; idx < E_Max; idx++) {
+			eventFd_[idx] = fds[idx+1];
+		}
+
+		struct stat memStat;
+		if (fstat(fds[0], &memStat) < 0) {
+			Log(Error, "shared memory stat error")
+				.parameter("Message", strerror(errno));
+			::close(fds[0]);
+			close();
+			return false;
+		}
+
+		return map(fds[0], memStat.st_size, false, 0);
+	}
+
+	bool
+	ShmStream::map(int memFd, size_t memorySize, bool server, uint32_t capacity)
+	{
+		void* memory = mmap(nullptr, memorySize, PROT_READ | PROT_WRITE, MAP_SHARED, memFd, 0);
+		if (memory == MAP_FAILED) {
+			Log(Error, "shared memory map error")
+				.parameter("Message", strerror(errno));
+			::close(memFd);
+			close();
+			return false;
+		}
+		memFd_ = memFd;
+		memory_ = (char*)memory;
+		memorySize_ = memorySize;
+		server_ = server;
+
+		// the first ring buffer transports data from the client to the server
+		// and the second ring buffer from the server to the client
+		char* clientServer = memory_;
+		char* serverClient = memory_ + memorySize_ / 2;
+		bool success;
+		if (server_) {
+			success = rxRing_.init(clientServer, capacity) && txRing_.init(serverClient, capacity);
+		}
+		else {
+			success = rxRing_.attach(serverClient) && txRing_.attach(clientServer);
+			if (success && ShmRingBuffer::memorySize(rxRing_.capacity()) * 2 != memorySize_) {
+				success = false;
+			}
+		}
+		if (!success) {
+			Log(Error, "shared memory ring buffer invalid")
+				.parameter("MemorySize", memorySize_);
+			close();
+			return false;
+		}
+
+		rxSpaceNotifyFd_ = eventFd_[server_ ? E_SpaceClientServer : E_SpaceServerClient];
+		txDataNotifyFd_ = eventFd_[server_ ? E_DataServerClient : E_DataClientServer];
+		rxDataWait_.assign(dup(eventFd_[server_ ? E_DataClientServer : E_DataServerClient]));
+		txSpaceWait_.assign(dup(eventFd_[server_ ? E_SpaceServerClient : E_SpaceClientServer]));
+		return true;
+	}
+
+	void
+	ShmStream::watchPeer(int socket)
+	{
+		// the peer never writes to the unix domain socket after the descriptors
+		// are exchanged. A completion of the read means the peer has gone.
+		peerWatch_.assign(dup(socket));
+		peerWatch_.async_read_some(
+			boost::asio::buffer(&peerByte_, 1),
+			strand_->wrap(boost::bind(&ShmStream::peerWatchComplete, this, boost::asio::placeholders::error))
+		);
+	}
+
+	void
+	ShmStream::peerWatchComplete(const boost::system::error_code& error)
+	{
+		if (error == boost::asio::error::operation_aborted || closed_) {
+			return;
+		}
+		peerClosed_ = true;
+
+		// wakeup own waiting operations
+		notify(eventFd_[server_ ? E_DataClientServer : E_DataServerClient]);
+		notify(eventFd_[server_ ? E_SpaceServerClient : E_SpaceClientServer]);
+	}
+
+	void
+	ShmStream::notify(int eventFd)
+	{
+		uint64_t value = 1;
+		if (::write(eventFd, &value, sizeof(value)) != sizeof(value)) {
+			// the eventfd counter is already set or the descriptor is closed
+		}
+	}
+
+	bool
+	ShmStream::closed(void)
+	{
+		return closed_ || peerClosed_ || rxRing_.closed() || txRing_.closed();
+	}
+
+	bool
+	ShmStream::protocolError(void)
+	{
+		// the peer has corrupted the positions of a ring buffer
+		return rxRing_.error() || txRing_.error();
+	}
+
+	bool
+	ShmStream::isOpen(void)
+	{
+		return memory_ != nullptr && !closed_;
+	}
+
+	void
+	ShmStream::close(void)
+	{
+		if (closed_) return;
+		closed_ = true;
+
+		// tell the peer and wakeup its waiting operations
+		if (rxRing_.attached() && txRing_.attached()) {
+			rxRing_.close();
+			txRing_.close();
+			notify(rxSpaceNotifyFd_);
+			notify(txDataNotifyFd_);
+		}
+
+		// pending operations are completed with operation aborted
+		boost::system::error_code ec;
+		rxDataWait_.close(ec);
+		txSpaceWait_.close(ec);
+		peerWatch_.close(ec);
+
+		rxRing_.detach();
+		txRing_.detach();
+		if (memory_ != nullptr) {
+			munmap(memory_, memorySize_);
+			memory_ = nullptr;
+			memorySize_ = 0;
+		}
+		if (memFd_ >= 0) {
+			::close(memFd_);
+			memFd_ = -1;
+		}
+		for (uint32_t idx = 0; idx < E_Max; idx++) {
+			if (eventFd_[idx] >= 0) ::close(eventFd_[idx]);
+			eventFd_[idx] = -1;
+		}
+		rxSpaceNotifyFd_ = -1;
+		txDataNotifyFd_ = -1;
+	}
+
+}
+
+#endif
@@ -0,0 +1,235 @@
+/*
+   Copyright 2015 Kai Huebl (kai@huebl-sgh.de)
+
+   Lizenziert gemäß Apache Licence Version 2.0 (die „Lizenz“); Nutzung dieser
+   Datei nur in Übereinstimmung mit der Lizenz erlaubt.
+   Eine Kopie der Lizenz erhalten Sie auf http://www.apache.org/licenses/LICENSE-2.0.
+
+   Sofern nicht gemäß geltendem Recht vorgeschrieben oder schriftlich vereinbart,
+   erfolgt die Bereitstellung der im Rahmen der Lizenz verbreiteten Software OHNE
+   GEWÄHR ODER VORBEHALTE – ganz gleich, ob ausdrücklich oder stillschweigend.
+
+   Informationen über die jeweiligen Bedingungen für Genehmigungen und Einschränkungen
+   im Rahmen der Lizenz finden Sie in der Lizenz.
+
+   Autor: Kai Huebl (kai@huebl-sgh.de)
+ */
+
+#ifndef __OpcUaStackCore_ShmStream_h__
+#define __OpcUaStackCore_ShmStream_h__
+
+#include <boost/shared_ptr.hpp>
+#include <boost/asio.hpp>
+#include "OpcUaStackCore/Base/os.h"
+#include "OpcUaStackCore/TCPChannel/ShmRingBuffer.h"
+
+#if defined(__linux__) && defined(BOOST_ASIO_HAS_POSIX_STREAM_DESCRIPTOR) && defined(BOOST_ASIO_HAS_LOCAL_SOCKETS)
+	#define OPCUASTACK_HAS_SHM
+#endif
+
+#if defined(OPCUASTACK_HAS_SHM)
+
+namespace OpcUaStackCore
+{
+
+	//
+	// asynchronous stream over two ring buffers in a shared memory region.
+	// The server creates the region (memfd) and four eventfd descriptors and
+	// passes them to the client over the unix domain socket of the connection.
+	// Reading and writing only copies data from and to the ring buffers. An
+	// eventfd is only written if the other side waits for data or space.
+	// The unix domain socket remains open to detect the loss of the peer.
+	//
+	class DLLEXPORT ShmStream
+	{
+	  public:
+		typedef boost::shared_ptr<ShmStream> SPtr;
+		typedef boost::shared_ptr<boost::asio::io_service::strand> StrandSPtr;
+		typedef boost::asio::io_service::executor_type executor_type;
+
+		static const uint32_t DefaultCapacity = 1024 * 1024;
+
+		ShmStream(boost::asio::io_service& io_service, StrandSPtr& strand);
+		~ShmStream(void);
+
+		bool create(uint32_t capacity);
+		bool sendDescriptors(int socket);
+		bool receiveDescriptors(int socket);
+		void watchPeer(int socket);
+		bool isOpen(void);
+		void close(void);
+
+		executor_type get_executor(void);
+
+		template<typename MUTABLE_BUFFER, typename HANDLER>
+		  void async_read_some(const MUTABLE_BUFFER& buffers, HANDLER&& handler)
+		  {
+			  boost::system::error_code ec;
+			  std::size_t bytes = 0;
+			  if (!rxRing_.attached()) {
+				  ec = boost::asio::error::bad_descriptor;
+			  }
+			  else if (boost::asio::buffer_size(buffers) != 0) {
+				  bytes = readSome(buffers);
+				  if (bytes == 0) {
+					  if (!closed()) {
+						  waitRead(buffers, handler);
+						  return;
+					  }
+					  ec = boost::asio::error::eof;
+					  if (protocolError()) ec = boost::asio::error::fault;
+				  }
+			  }
+			  strand_->post(boost::asio::detail::bind_handler(handler, ec, bytes));
+		  }
+
+		template<typename CONST_BUFFER, typename HANDLER>
+		  void async_write_some(const CONST_BUFFER& buffers, HANDLER&& handler)
+		  {
+			  boost::system::error_code ec;
+			  std::size_t bytes = 0;
+			  if (!txRing_.attached()) {
+				  ec = boost::asio::error::bad_descriptor;
+			  }
+			  else if (closed()) {
+				  ec = boost::asio::error::broken_pipe;
+				  if (protocolError()) ec = boost::asio::error::fault;
+			  }
+			  else if (boost::asio::buffer_size(buffers) != 0) {
+				  bytes = writeSome(buffers);
+				  if (bytes == 0) {
+					  if (protocolError()) {
+						  ec = boost::asio::error::fault;
+					  }
+					  else {
+						  waitWrite(buffers, handler);
+						  return;
+					  }
+				  }
+			  }
+			  strand_->post(boost::asio::detail::bind_handler(handler, ec, bytes));
+		  }
+
+	  private:
+		typedef enum {
+			E_DataClientServer = 0,
+			E_SpaceClientServer,
+			E_DataServerClient,
+			E_SpaceServerClient,
+			E_Max
+		} EventType;
+
+		bool map(int memFd, size_t memorySize, bool server, uint32_t capacity);
+		void peerWatchComplete(const boost::system::error_code& error);
+		void notify(int eventFd);
+		bool closed(void);
+		bool protocolError(void);
+
+		template<typename MUTABLE_BUFFER>
+		  std::size_t readSome(const MUTABLE_BUFFER& buffers)
+		  {
+			  std::size_t bytes = 0;
+			  for (auto it = boost::asio::buffer_sequence_begin(buffers); it != boost::asio::buffer_sequence_end(buffers); it++) {
+				  boost::asio::mutable_buffer buffer(*it);
+				  uint32_t len = rxRing_.read((char*)buffer.data(), (uint32_t)buffer.size());
+				  bytes += len;
+				  if (len < buffer.size()) break;
+			  }
+
+			  // wakeup the producer if it waits for free space
+			  if (bytes > 0 && rxRing_.clearWriterWaiting()) notify(rxSpaceNotifyFd_);
+			  return bytes;
+		  }
+
+		template<typename CONST_BUFFER>
+		  std::size_t writeSome(const CONST_BUFFER& buffers)
+		  {
+			  std::size_t bytes = 0;
+			  for (auto it = boost::asio::buffer_sequence_begin(buffers); it != boost::asio::buffer_sequence_end(buffers); it++) {
+				  boost::asio::const_buffer buffer(*it);
+				  uint32_t len = txRing_.write((const char*)buffer.data(), (uint32_t)buffer.size());
+				  bytes += len;
+				  if (len < buffer.size()) break;
+			  }
+
+			  // wakeup the consumer if it waits for data
+			  if (bytes > 0 && txRing_.clearReaderWaiting()) notify(txDataNotifyFd_);
+			  return bytes;
+		  }
+
+		template<typename MUTABLE_BUFFER, typename HANDLER>
+		  void waitRead(const MUTABLE_BUFFER& buffers, HANDLER handler)
+		  {
+			  // announce the waiting reader and check again to avoid a lost wakeup
+			  rxRing_.readerWaiting(true);
+			  if (rxRing_.readAvailable() > 0 || closed()) {
+				  rxRing_.readerWaiting(false);
+				  async_read_some(buffers, handler);
+				  return;
+			  }
+
+			  rxDataWait_.async_read_some(
+				  boost::asio::buffer(&rxEventValue_, sizeof(rxEventValue_)),
+				  strand_->wrap([this, buffers, handler](const boost::system::error_code& error, std::size_t) mutable {
+					  if (error) {
+						  handler(error, 0);
+						  return;
+					  }
+					  async_read_some(buffers, handler);
+				  })
+			  );
+		  }
+
+		template<typename CONST_BUFFER, typename HANDLER>
+		  void waitWrite(const CONST_BUFFER& buffers, HANDLER handler)
+		  {
+			  // announce the waiting writer and check again to avoid a lost wakeup
+			  txRing_.writerWaiting(true);
+			  if (txRing_.writeAvailable() > 0 || closed()) {
+				  txRing_.writerWaiting(false);
+				  async_write_some(buffers, handler);
+				  return;
+			  }
+
+			  txSpaceWait_.async_read_some(
+				  boost::asio::buffer(&txEventValue_, sizeof(txEventValue_)),
+				  strand_->wrap([this, buffers, handler](const boost::system::error_code& error, std::size_t) mutable {
+					  if (error) {
+						  handler(error, 0);
+						  return;
+					  }
+					  async_write_some(buffers, handler);
+				  })
+			  );
+		  }
+
+		boost::asio::io_service& io_service_;
+		StrandSPtr strand_;
+
+		bool server_;
+		bool closed_;
+		bool peerClosed_;
+
+		int memFd_;
+		char* memory_;
+		size_t memorySize_;
+		int eventFd_[E_Max];
+
+		ShmRingBuffer rxRing_;
+		ShmRingBuffer txRing_;
+		int rxSpaceNotifyFd_;
+		int txDataNotifyFd_;
+		uint64_t rxEventValue_;
+		uint64_t txEventValue_;
+		boost::asio::posix::stream_descriptor rxDataWait_;
+		boost::asio::posix::stream_descriptor txSpaceWait_;
+
+		char peerByte_;
+		boost::asio::posix::stream_descriptor peerWatch_;
+	};
+
+}
+
+#endif
+
+#endif
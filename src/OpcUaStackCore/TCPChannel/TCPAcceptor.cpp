@@ -16,6 +16,10 @@
  */
 
 #include "OpcUaStackCore/TCPChannel/TCPAcceptor.h"
+#if defined(BOOST_ASIO_HAS_LOCAL_SOCKETS)
+#include <unistd.h>
+#include <sys/stat.h>
+#endif
 
 namespace OpcUaStackCore
 {
@@ -23,30 +27,117 @@ namespace OpcUaStackCore
 	TCPAcceptor::TCPAcceptor(boost::asio::io_service& io_service, boost::asio::ip::tcp::endpoint& endpoint)
 	: endpoint_(endpoint)
 	, acceptor_(io_service,endpoint_)
+#if defined(BOOST_ASIO_HAS_LOCAL_SOCKETS)
+	, localAcceptor_(io_service)
+#endif
+	, unixSocketPath_("")
+	, memAcceptor_()
 	{
 	}
 
 	TCPAcceptor::TCPAcceptor(boost::asio::io_service& io_service, boost::asio::ip::address& address, uint32_t port)
 	: endpoint_(address, (unsigned short)port)
 	, acceptor_(io_service,endpoint_)
+#if defined(BOOST_ASIO_HAS_LOCAL_SOCKETS)
+	, localAcceptor_(io_service)
+#endif
+	, unixSocketPath_("")
+	, memAcceptor_()
 	{
 	}
 
 	TCPAcceptor::TCPAcceptor(boost::asio::io_service& io_service, std::string& addressString, uint32_t port)
 	: endpoint_(boost::asio::ip::address::from_string(addressString.c_str()), (unsigned short)port)
 	, acceptor_(io_service,endpoint_)
+#if defined(BOOST_ASIO_HAS_LOCAL_SOCKETS)
+	, localAcceptor_(io_service)
+#endif
+	, unixSocketPath_("")
+	, memAcceptor_()
 	{
 	}
 
 	TCPAcceptor::TCPAcceptor(const boost::asio::io_service& io_service, const std::string& addressString, const uint32_t port)
 	: endpoint_(boost::asio::ip::address::from_string(addressString.c_str()), (unsigned short)port)
 	, acceptor_(*const_cast<boost::asio::io_service*>(&io_service),endpoint_)
+#if defined(BOOST_ASIO_HAS_LOCAL_SOCKETS)
+	, localAcceptor_(*const_cast<boost::asio::io_service*>(&io_service))
+#endif
+	, unixSocketPath_("")
+	, memAcceptor_()
 	{
 	}
 
 	TCPAcceptor::TCPAcceptor(boost::asio::io_service& io_service, uint32_t port)
 	: endpoint_(boost::asio::ip::address_v4::any(), (unsigned short)port)
 	, acceptor_(io_service,endpoint_)
+#if defined(BOOST_ASIO_HAS_LOCAL_SOCKETS)
+	, localAcceptor_(io_service)
+#endif
+	, unixSocketPath_("")
+	, memAcceptor_()
+	{
+	}
+
+	TCPAcceptor::TCPAcceptor(boost::asio::io_service& io_service, boost::asio::ip::tcp::endpoint& endpoint, bool reusePort)
+	: endpoint_(endpoint)
+	, acceptor_(io_service)
+#if defined(BOOST_ASIO_HAS_LOCAL_SOCKETS)
+	, localAcceptor_(io_service)
+#endif
+	, unixSocketPath_("")
+	, memAcceptor_()
+	{
+		acceptor_.open(endpoint_.protocol());
+		acceptor_.set_option(boost::asio::ip::tcp::acceptor::reuse_address(true));
+#ifdef SO_REUSEPORT
+		if (reusePort) {
+			typedef boost::asio::detail::socket_option::boolean<SOL_SOCKET, SO_REUSEPORT> ReusePort;
+			acceptor_.set_option(ReusePort(true));
+		}
+#endif
+		acceptor_.bind(endpoint_);
+	}
+
+	TCPAcceptor::TCPAcceptor(boost::asio::io_service& io_service, const std::string& unixSocketPath)
+	: endpoint_()
+	, acceptor_(io_service)
+#if defined(BOOST_ASIO_HAS_LOCAL_SOCKETS)
+	, localAcceptor_(io_service)
+#endif
+	, unixSocketPath_(unixSocketPath)
+	, memAcceptor_()
+	{
+#if defined(BOOST_ASIO_HAS_LOCAL_SOCKETS)
+		// remove socket file from a previous run. Any other file with the
+		// same name is kept and the bind fails
+		removeUnixSocket();
+
+		boost::asio::local::stream_protocol::endpoint endpoint(unixSocketPath_);
+		localAcceptor_.open(endpoint.protocol());
+		localAcceptor_.bind(endpoint);
+
+		// the permissions of the socket file are set before the acceptor
+		// listens and do not depend on the umask of the process
+		try {
+			unixSocketMode(0600);
+		}
+		catch (boost::system::system_error&) {
+			localAcceptor_.close();
+			removeUnixSocket();
+			throw;
+		}
+#endif
+	}
+
+	TCPAcceptor::TCPAcceptor(boost::asio::io_service& io_service, MemAcceptor::SPtr& memAcceptor)
+	: endpoint_()
+	, acceptor_(io_service)
+#if defined(BOOST_ASIO_HAS_LOCAL_SOCKETS)
+	, localAcceptor_(io_service)
+#endif
+	, unixSocketPath_("")
+	, memAcceptor_(memAcceptor)
 	{
 	}
 
@@ -54,30 +145,114 @@ namespace OpcUaStackCore
 	{
 	}
 
+	bool
+	TCPAcceptor::unixSocketSupported(void)
+	{
+#if defined(BOOST_ASIO_HAS_LOCAL_SOCKETS)
+		return true;
+#else
+		return false;
+#endif
+	}
+
+	bool
+	TCPAcceptor::reusePortSupported(void)
+	{
+#ifdef SO_REUSEPORT
+		return true;
+#else
+		return false;
+#endif
+	}
+
 	void
 	TCPAcceptor::listen(void)
 	{
+		if (memAcceptor_.get() != nullptr) {
+			memAcceptor_->listen();
+			return;
+		}
+#if defined(BOOST_ASIO_HAS_LOCAL_SOCKETS)
+		if (!unixSocketPath_.empty()) {
+			localAcceptor_.listen();
+			return;
+		}
+#endif
 		acceptor_.listen();
 	}
 
 	void
 	TCPAcceptor::listen(uint32_t maxConnections)
 	{
+		if (memAcceptor_.get() != nullptr) {
+			memAcceptor_->listen();
+			return;
+		}
+#if defined(BOOST_ASIO_HAS_LOCAL_SOCKETS)
+		if (!unixSocketPath_.empty()) {
+			localAcceptor_.listen(maxConnections);
+			return;
+		}
+#endif
 		acceptor_.listen(maxConnections);
 	}
 
+	void
+	TCPAcceptor::unixSocketMode(uint32_t unixSocketMode)
+	{
+#if defined(BOOST_ASIO_HAS_LOCAL_SOCKETS)
+		if (unixSocketPath_.empty()) return;
+		if (::chmod(unixSocketPath_.c_str(), (mode_t)(unixSocketMode & 0777)) != 0) {
+			boost::system::error_code ec(errno, boost::system::system_category());
+			throw boost::system::system_error(ec, "chmod");
+		}
+#endif
+	}
+
 	void
 	TCPAcceptor::cancel(void)
 	{
+		if (memAcceptor_.get() != nullptr) {
+			memAcceptor_->cancel();
+			return;
+		}
+#if defined(BOOST_ASIO_HAS_LOCAL_SOCKETS)
+		if (!unixSocketPath_.empty()) {
+			localAcceptor_.cancel();
+			return;
+		}
+#endif
 		acceptor_.cancel();
 	}
 
 	void
 	TCPAcceptor::close(void)
 	{
+		if (memAcceptor_.get() != nullptr) {
+			memAcceptor_->close();
+			return;
+		}
+#if defined(BOOST_ASIO_HAS_LOCAL_SOCKETS)
+		if (!unixSocketPath_.empty()) {
+			localAcceptor_.close();
+			removeUnixSocket();
+			return;
+		}
+#endif
 		acceptor_.close();
 	}
 
+	void
+	TCPAcceptor::removeUnixSocket(void)
+	{
+#if defined(BOOST_ASIO_HAS_LOCAL_SOCKETS)
+		struct stat fileStat;
+		if (::lstat(unixSocketPath_.c_str(), &fileStat) != 0) return;
+		if (!S_ISSOCK(fileStat.st_mode)) return;
+		::unlink(unixSocketPath_.c_str());
+#endif
+	}
+
 }
 
 /*--------[ END OF FILE ISOonTCPAcceptor.cxx ]---------------------------------------*/
@@ -22,6 +22,7 @@
 #include <boost/bind.hpp>
 #include "OpcUaStackCore/Base/os.h"
 #include "OpcUaStackCore/Base/ObjectPool.h"
+#include "OpcUaStackCore/TCPChannel/MemAcceptor.h"
 
 namespace OpcUaStackCore
 {
@@ -37,22 +38,57 @@ namespace OpcUaStackCore
 		TCPAcceptor(boost::asio::io_service& io_service, std::string& addressString, uint32_t port);
 		TCPAcceptor(const boost::asio::io_service& io_service, const std::string& addressString, const uint32_t port);
 		TCPAcceptor(boost::asio::io_service& io_service,uint32_t port);
+		TCPAcceptor(boost::asio::io_service& io_service, boost::asio::ip::tcp::endpoint& endpoint, bool reusePort);
+		TCPAcceptor(boost::asio::io_service& io_service, const std::string& unixSocketPath);
+		TCPAcceptor(boost::asio::io_service& io_service, MemAcceptor::SPtr& memAcceptor);
 		~TCPAcceptor(void);
 
+		//
+		// SO_REUSEPORT allows to bind more than one acceptor to the same
+		// endpoint. The kernel distributes new connections between them.
+		//
+		static bool reusePortSupported(void);
+		static bool unixSocketSupported(void);
+
 		void listen(void);
 		void listen(uint32_t maxConnections);
 
+		//
+		// sets the access mode of the socket file of a unix domain socket.
+		// The default mode is 0600 independent of the umask of the process
+		//
+		void unixSocketMode(uint32_t unixSocketMode);
+
 		template<typename HANDLER>
 		  void async_accept(boost::asio::ip::tcp::socket& socket, HANDLER handler)
 		  {
 			  acceptor_.async_accept(socket,handler);
 		  }
+#if defined(BOOST_ASIO_HAS_LOCAL_SOCKETS)
+		template<typename HANDLER>
+		  void async_accept(boost::asio::local::stream_protocol::socket& socket, HANDLER handler)
+		  {
+			  localAcceptor_.async_accept(socket,handler);
+		  }
+#endif
+		template<typename HANDLER>
+		  void async_accept(MemStream& memStream, HANDLER handler)
+		  {
+			  memAcceptor_->async_accept(memStream, handler);
+		  }
 		void cancel(void);
 		void close(void);
 
 	  private:
+		void removeUnixSocket(void);
+
 		boost::asio::ip::tcp::endpoint endpoint_;
 		boost::asio::ip::tcp::acceptor acceptor_;
+#if defined(BOOST_ASIO_HAS_LOCAL_SOCKETS)
+		boost::asio::local::stream_protocol::acceptor localAcceptor_;
+#endif
+		std::string unixSocketPath_;
+		MemAcceptor::SPtr memAcceptor_;
 	};
 
 }
@@ -21,7 +21,17 @@ namespace OpcUaStackCore
 {
 	TCPConnection::TCPConnection(boost::asio::io_service& io_service)
 	: socket_(io_service)
+#if defined(BOOST_ASIO_HAS_LOCAL_SOCKETS)
+	, localSocket_(io_service)
+#endif
+	, unixSocket_(false)
 	, io_service_(io_service)
+	, strand_(new boost::asio::io_service::strand(io_service))
+#if defined(OPCUASTACK_HAS_SHM)
+	, shmStream_()
+#endif
+	, uringStream_()
+	, memStream_()
 	{
 	}
 
@@ -35,17 +45,193 @@ namespace OpcUaStackCore
 		return socket_;
 	}
 
+#if defined(BOOST_ASIO_HAS_LOCAL_SOCKETS)
+	boost::asio::local::stream_protocol::socket&
+	TCPConnection::localSocket(void)
+	{
+		return localSocket_;
+	}
+#endif
+
+	boost::asio::io_service&
+	TCPConnection::io_service(void)
+	{
+		return io_service_;
+	}
+
+	void
+	TCPConnection::unixSocket(bool unixSocket)
+	{
+		unixSocket_ = unixSocket;
+	}
+
+	bool
+	TCPConnection::unixSocket(void)
+	{
+		return unixSocket_;
+	}
+
+	bool
+	TCPConnection::sharedMemory(void)
+	{
+#if defined(OPCUASTACK_HAS_SHM)
+		return shmStream_.get() != nullptr;
+#else
+		return false;
+#endif
+	}
+
+	bool
+	TCPConnection::openSharedMemory(uint32_t capacity)
+	{
+#if defined(OPCUASTACK_HAS_SHM)
+		ShmStream::SPtr shmStream(new ShmStream(io_service_, strand_));
+		if (!shmStream->create(capacity)) return false;
+		if (!shmStream->sendDescriptors(localSocket_.native_handle())) return false;
+		shmStream->watchPeer(localSocket_.native_handle());
+		shmStream_ = shmStream;
+		return true;
+#else
+		return false;
+#endif
+	}
+
+	bool
+	TCPConnection::attachSharedMemory(void)
+	{
+#if defined(OPCUASTACK_HAS_SHM)
+		ShmStream::SPtr shmStream(new ShmStream(io_service_, strand_));
+		if (!shmStream->receiveDescriptors(localSocket_.native_handle())) return false;
+		shmStream->watchPeer(localSocket_.native_handle());
+		shmStream_ = shmStream;
+		return true;
+#else
+		return false;
+#endif
+	}
+
+	void
+	TCPConnection::memory(bool memory)
+	{
+		if (!memory) {
+			memStream_.reset();
+			return;
+		}
+		if (memStream_.get() == nullptr) {
+			memStream_.reset(new MemStream(io_service_, strand_));
+		}
+	}
+
+	bool
+	TCPConnection::memory(void)
+	{
+		return memStream_.get() != nullptr;
+	}
+
+	MemStream&
+	TCPConnection::memStream(void)
+	{
+		return *memStream_;
+	}
+
+	bool
+	TCPConnection::ioUringSupported(void)
+	{
+#if defined(OPCUASTACK_HAS_IO_URING)
+		return true;
+#else
+		return false;
+#endif
+	}
+
+	bool
+	TCPConnection::ioUring(void)
+	{
+#if defined(OPCUASTACK_HAS_IO_URING)
+		return uringStream_.get() != nullptr && uringStream_->isOpen();
+#else
+		return false;
+#endif
+	}
+
+	bool
+	TCPConnection::openIoUring(void)
+	{
+#if defined(OPCUASTACK_HAS_IO_URING)
+		IoUring& ioUring = boost::asio::use_service<IoUring>(io_service_);
+		if (!ioUring.open()) return false;
+		if (uringStream_.get() == nullptr) {
+			uringStream_.reset(new UringStream(ioUring, strand_));
+		}
+		uringStream_->open(socket_.native_handle());
+		return true;
+#else
+		return false;
+#endif
+	}
+
+	TCPConnection::StrandSPtr&
+	TCPConnection::strand(void)
+	{
+		return strand_;
+	}
+
 	void
 	TCPConnection::cancel(void)
 	{
-		if (socket_.is_open()) {
-			socket_.close();
+		close();
+	}
+
+	void
+	TCPConnection::cancelOperations(void)
+	{
+		boost::system::error_code ec;
+		if (memStream_.get() != nullptr) {
+			memStream_->close();
+			return;
 		}
+#if defined(OPCUASTACK_HAS_SHM)
+		if (shmStream_.get() != nullptr) {
+			shmStream_->close();
+			return;
+		}
+#endif
+#if defined(OPCUASTACK_HAS_IO_URING)
+		if (uringStream_.get() != nullptr) {
+			uringStream_->cancel();
+			return;
+		}
+#endif
+#if defined(BOOST_ASIO_HAS_LOCAL_SOCKETS)
+		if (unixSocket_) {
+			localSocket_.cancel(ec);
+			return;
+		}
+#endif
+		socket_.cancel(ec);
 	}
 
 	void
 	TCPConnection::close(void)
 	{
+		if (memStream_.get() != nullptr) {
+			memStream_->close();
+		}
+#if defined(OPCUASTACK_HAS_SHM)
+		if (shmStream_.get() != nullptr) {
+			shmStream_->close();
+		}
+#endif
+#if defined(OPCUASTACK_HAS_IO_URING)
+		if (uringStream_.get() != nullptr) {
+			uringStream_->close();
+		}
+#endif
+#if defined(BOOST_ASIO_HAS_LOCAL_SOCKETS)
+		if (localSocket_.is_open()) {
+			localSocket_.close();
+		}
+#endif
 		if (socket_.is_open()) {
 			socket_.close();
 		}
@@ -24,74 +24,103 @@
 #include <boost/array.hpp>
 #include <sstream>
 #include <iostream>
+#include "OpcUaStackCore/TCPChannel/ShmStream.h"
+#include "OpcUaStackCore/TCPChannel/UringStream.h"
+#include "OpcUaStackCore/TCPChannel/MemStream.h"
 
 namespace OpcUaStackCore
 {
 
+	class UringStream;
+
 	class DLLEXPORT TCPConnection
 	{
 	  public:
 	    typedef boost::shared_ptr<TCPConnection> SPtr;
+	    typedef boost::shared_ptr<boost::asio::io_service::strand> StrandSPtr;
 
 		TCPConnection(boost::asio::io_service& io_service);
 		~TCPConnection(void);
 
 		boost::asio::ip::tcp::socket& socket(void);
+#if defined(BOOST_ASIO_HAS_LOCAL_SOCKETS)
+		boost::asio::local::stream_protocol::socket& localSocket(void);
+#endif
+		boost::asio::io_service& io_service(void);
+
+		//
+		// a connection uses a unix domain socket instead of the tcp socket
+		// if the endpoint url contains the scheme opc.unix. The framing of
+		// the messages is the same for both socket types.
+		//
+		void unixSocket(bool unixSocket);
+		bool unixSocket(void);
+
+		//
+		// a connection with the scheme opc.shm exchanges the messages over
+		// ring buffers in shared memory. The unix domain socket is only used
+		// to pass the shared memory descriptors from the server to the client.
+		//
+		bool sharedMemory(void);
+		bool openSharedMemory(uint32_t capacity);
+		bool attachSharedMemory(void);
+
+		//
+		// a connection with the scheme opc.mem exchanges the messages with
+		// a peer in the same process over buffer queues in memory. No socket
+		// is used by the connection.
+		//
+		void memory(bool memory);
+		bool memory(void);
+		MemStream& memStream(void);
+
+		//
+		// a connected tcp socket can use the io_uring of the io service for
+		// reading and writing instead of the reactor of boost asio. The
+		// io_uring support must be enabled at build time.
+		//
+		static bool ioUringSupported(void);
+		bool ioUring(void);
+		bool openIoUring(void);
+
+		//
+		// all completion handlers of the connection are serialized by the
+		// strand. This allows to run the io service with more than one
+		// thread without locking the connection state.
+		//
+		StrandSPtr& strand(void);
 		void cancel(void);
+		void cancelOperations(void);
 		void close(void);
 
 		template<typename BUFFER, typename HANDLER>
 		  void async_read_until(BUFFER& buffer, HANDLER handler, const std::string& str)
 		  {
-			  boost::asio::async_read_until(
-				  socket_,
-				  buffer,
-				  str.c_str(),
-				  handler
-			  );
+			  dispatch(AsyncReadUntil<BUFFER, HANDLER>(buffer, strand_, handler, str));
 		  }
 
 		template<typename BUFFER, typename HANDLER>
 		  void async_read_atLeast(BUFFER& buffer, HANDLER handler, uint32_t atLeast=0)
 		  {
-			  boost::asio::async_read(
-				  socket_,
-				  buffer,
-				  boost::asio::transfer_at_least(atLeast),
-				  handler
-			  );
+			  asyncRead(buffer, boost::asio::transfer_at_least(atLeast), handler);
 		  }
 
 		template<typename BUFFER, typename HANDLER>
 		  void async_read_exactly(BUFFER& buffer, HANDLER handler, uint32_t exactly)
 		  {
-			  boost::asio::async_read(
-				  socket_,
-				  buffer,
-				  boost::asio::transfer_exactly(exactly),
-				  handler
-			  );
+			  asyncRead(buffer, boost::asio::transfer_exactly(exactly), handler);
 		  }
 
 		template<typename BUFFER, typename HANDLER>
 		  void async_read_all(BUFFER& buffer, HANDLER handler)
 		  {
-			  boost::asio::async_read(
-				  socket_,
-				  buffer,
-				  boost::asio::transfer_all(),
-				  handler
-			  );
+			  asyncRead(buffer, boost::asio::transfer_all(), handler);
 		  }
 
 		template<typename BUFFER, typename HANDLER>
 		  void async_write(BUFFER& buffer, HANDLER handler) 
 		  {
-			  boost::asio::async_write(
-				  socket_,
-				  buffer,
-				  handler
-			  );
+			  dispatch(AsyncWrite<BUFFER, HANDLER>(buffer, strand_, handler));
 		  }
 
 		template<typename BUFFER, typename HANDLER>
@@ -100,11 +129,7 @@ namespace OpcUaStackCore
 			  std::vector<boost::asio::const_buffer> buffer;
 			  buffer.push_back(boost::asio::buffer(buffer1.data()));
 			  buffer.push_back(boost::asio::buffer(buffer2.data()));
-			  boost::asio::async_write(
-				  socket_,
-				  buffer,
-				  handler
-			  );
+			  async_write(buffer, handler);
 		  }
 
 		template<typename BUFFER, typename HANDLER>
@@ -114,26 +139,133 @@ namespace OpcUaStackCore
 			  buffer.push_back(boost::asio::buffer(buffer1.data()));
 			  buffer.push_back(boost::asio::buffer(buffer2.data()));
 			  buffer.push_back(boost::asio::buffer(buffer3.data()));
-			  boost::asio::async_write(
-				  socket_,
-				  buffer,
-				  handler
-			  );
+			  async_write(buffer, handler);
 		  }
 
 		template<typename HANDLER>
 		  void async_write(std::vector<boost::asio::const_buffer>& buffer, HANDLER handler) 
 		  {
-			  boost::asio::async_write(
-				  socket_,
-				  buffer,
-				  handler
-			  );
+			  dispatch(AsyncWrite<std::vector<boost::asio::const_buffer>, HANDLER>(buffer, strand_, handler));
 		  }
 
 	  private:
+		//
+		// the asynchronous operations are started on the stream which is
+		// used by the connection. A new transport only has to be added to
+		// the dispatch function. The completion handler is always wrapped
+		// by the strand of the connection.
+		//
+		template<typename F>
+		  void dispatch(F f)
+		  {
+			  if (memStream_.get() != nullptr) {
+				  f(*memStream_);
+				  return;
+			  }
+#if defined(OPCUASTACK_HAS_SHM)
+			  if (shmStream_.get() != nullptr) {
+				  f(*shmStream_);
+				  return;
+			  }
+#endif
+#if defined(OPCUASTACK_HAS_IO_URING)
+			  if (uringStream_.get() != nullptr) {
+				  f(*uringStream_);
+				  return;
+			  }
+#endif
+#if defined(BOOST_ASIO_HAS_LOCAL_SOCKETS)
+			  if (unixSocket_) {
+				  f(localSocket_);
+				  return;
+			  }
+#endif
+			  f(socket_);
+		  }
+
+		template<typename BUFFER, typename COMPLETION, typename HANDLER>
+		  void asyncRead(BUFFER& buffer, COMPLETION completion, HANDLER& handler)
+		  {
+			  dispatch(AsyncRead<BUFFER, COMPLETION, HANDLER>(buffer, completion, strand_, handler));
+		  }
+
+		template<typename BUFFER, typename HANDLER>
+		  class AsyncReadUntil
+		  {
+			public:
+			  AsyncReadUntil(BUFFER& buffer, StrandSPtr& strand, HANDLER& handler, const std::string& str)
+			  : buffer_(buffer), strand_(strand), handler_(handler), str_(str)
+			  {
+			  }
+
+			  template<typename STREAM>
+			    void operator()(STREAM& stream)
+			    {
+				    boost::asio::async_read_until(stream, buffer_, str_.c_str(), strand_->wrap(handler_));
+			    }
+
+			private:
+			  BUFFER& buffer_;
+			  StrandSPtr& strand_;
+			  HANDLER& handler_;
+			  const std::string& str_;
+		  };
+
+		template<typename BUFFER, typename COMPLETION, typename HANDLER>
+		  class AsyncRead
+		  {
+			public:
+			  AsyncRead(BUFFER& buffer, COMPLETION completion, StrandSPtr& strand, HANDLER& handler)
+			  : buffer_(buffer), completion_(completion), strand_(strand), handler_(handler)
+			  {
+			  }
+
+			  template<typename STREAM>
+			    void operator()(STREAM& stream)
+			    {
+				    boost::asio::async_read(stream, buffer_, completion_, strand_->wrap(handler_));
+			    }
+
+			private:
+			  BUFFER& buffer_;
+			  COMPLETION completion_;
+			  StrandSPtr& strand_;
+			  HANDLER& handler_;
+		  };
+
+		template<typename BUFFER, typename HANDLER>
+		  class AsyncWrite
+		  {
+			public:
+			  AsyncWrite(BUFFER& buffer, StrandSPtr& strand, HANDLER& handler)
+			  : buffer_(buffer), strand_(strand), handler_(handler)
+			  {
+			  }
+
+			  template<typename STREAM>
+			    void operator()(STREAM& stream)
+			    {
+				    boost::asio::async_write(stream, buffer_, strand_->wrap(handler_));
+			    }
+
+			private:
+			  BUFFER& buffer_;
+			  StrandSPtr& strand_;
+			  HANDLER& handler_;
+		  };
+
 		boost::asio::ip::tcp::socket socket_;
+#if defined(BOOST_ASIO_HAS_LOCAL_SOCKETS)
+		boost::asio::local::stream_protocol::socket localSocket_;
+#endif
+		bool unixSocket_;
 		boost::asio::io_service& io_service_;
+		StrandSPtr strand_;
+#if defined(OPCUASTACK_HAS_SHM)
+		ShmStream::SPtr shmStream_;
+#endif
+		boost::shared_ptr<UringStream> uringStream_;
+		MemStream::SPtr memStream_;
 	};
 
 }
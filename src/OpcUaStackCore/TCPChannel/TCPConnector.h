@@ -49,6 +49,15 @@ namespace OpcUaStackCore
 			  boost::asio::ip::address address(boost::asio::ip::address::from_string(addressString.c_str()));
 			  async_connect(socket, address,port,handler);
 		  }
+
+#if defined(BOOST_ASIO_HAS_LOCAL_SOCKETS)
+		template<typename HANDLER>
+		  void async_connect(boost::asio::local::stream_protocol::socket& socket, const std::string& unixSocketPath, HANDLER handler)
+		  {
+			  boost::asio::local::stream_protocol::endpoint endpoint(unixSocketPath);
+			  socket.async_connect(endpoint,handler);
+		  }
+#endif
 	};
 
 }
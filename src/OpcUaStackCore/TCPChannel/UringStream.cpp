@@ -0,0 +1,74 @@
+/*
+   Copyright 2015 Kai Huebl (kai@huebl-sgh.de)
+
+   Lizenziert gemäß Apache Licence Version 2.0 (die „Lizenz“); Nutzung dieser
+   Datei nur in Übereinstimmung mit der Lizenz erlaubt.
+   Eine Kopie der Lizenz erhalten Sie auf http://www.apache.org/licenses/LICENSE-2.0.
+
+   Sofern nicht gemäß geltendem Recht vorgeschrieben oder schriftlich vereinbart,
+   erfolgt die Bereitstellung der im Rahmen der Lizenz verbreiteten Software OHNE
+   GEWÄHR ODER VORBEHALTE – ganz gleich, ob ausdrücklich oder stillschweigend.
+
+   Informationen über die jeweiligen Bedingungen für Genehmigungen und Einschränkungen
+   im Rahmen der Lizenz finden Sie in der Lizenz.
+
+   Autor: Kai Huebl (kai@huebl-sgh.de)
+ */
+
+
+#include "OpcUaStackCore/TCPChannel/UringStream.h"
+
+#if defined(OPCUASTACK_HAS_IO_URING)
+
+namespace OpcUaStackCore
+{
+
+	UringStream::UringStream(IoUring& ioUring, StrandSPtr& strand)
+	: ioUring_(ioUring)
+	, strand_(strand)
+	, fd_(-1)
+	{
+	}
+
+	UringStream::~UringStream(void)
+	{
+	}
+
+	UringStream::executor_type
+	UringStream::get_executor(void)
+	{
+		return ioUring_.get_io_context().get_executor();
+	}
+
+	void
+	UringStream::open(int fd)
+	{
+		fd_ = fd;
+	}
+
+	bool
+	UringStream::isOpen(void)
+	{
+		return fd_ >= 0;
+	}
+
+	void
+	UringStream::cancel(void)
+	{
+		// pending operations are completed with operation aborted
+		if (fd_ < 0) return;
+		ioUring_.cancel(fd_);
+	}
+
+	void
+	UringStream::close(void)
+	{
+		// the stream object remains valid for composed operations which
+		// are still running. New operations fail with bad descriptor.
+		cancel();
+		fd_ = -1;
+	}
+
+}
+
+#endif
@@ -0,0 +1,108 @@
+/*
+   Copyright 2015 Kai Huebl (kai@huebl-sgh.de)
+
+   Lizenziert gemäß Apache Licence Version 2.0 (die „Lizenz“); Nutzung dieser
+   Datei nur in Übereinstimmung mit der Lizenz erlaubt.
+   Eine Kopie der Lizenz erhalten Sie auf http://www.apache.org/licenses/LICENSE-2.0.
+
+   Sofern nicht gemäß geltendem Recht vorgeschrieben oder schriftlich vereinbart,
+   erfolgt die Bereitstellung der im Rahmen der Lizenz verbreiteten Software OHNE
+   GEWÄHR ODER VORBEHALTE – ganz gleich, ob ausdrücklich oder stillschweigend.
+
+   Informationen über die jeweiligen Bedingungen für Genehmigungen und Einschränkungen
+   im Rahmen der Lizenz finden Sie in der Lizenz.
+
+   Autor: Kai Huebl (kai@huebl-sgh.de)
+ */
+
+
+#ifndef __OpcUaStackCore_UringStream_h__
+#define __OpcUaStackCore_UringStream_h__
+
+#include <boost/shared_ptr.hpp>
+#include <boost/asio.hpp>
+#include "OpcUaStackCore/Base/os.h"
+#include "OpcUaStackCore/TCPChannel/IoUring.h"
+
+#if defined(OPCUASTACK_HAS_IO_URING)
+
+namespace OpcUaStackCore
+{
+
+	//
+	// asynchronous stream over a connected socket which uses the io_uring
+	// of the io service instead of the reactor of boost asio. The completion
+	// handlers are called by the strand of the connection.
+	//
+	class DLLEXPORT UringStream
+	{
+	  public:
+		typedef boost::shared_ptr<UringStream> SPtr;
+		typedef boost::shared_ptr<boost::asio::io_service::strand> StrandSPtr;
+		typedef boost::asio::io_service::executor_type executor_type;
+
+		UringStream(IoUring& ioUring, StrandSPtr& strand);
+		~UringStream(void);
+
+		void open(int fd);
+		bool isOpen(void);
+		void cancel(void);
+		void close(void);
+
+		executor_type get_executor(void);
+
+		template<typename MUTABLE_BUFFER, typename HANDLER>
+		  void async_read_some(const MUTABLE_BUFFER& buffers, HANDLER&& handler)
+		  {
+			  if (fd_ < 0) {
+				  strand_->post(boost::asio::detail::bind_handler(handler, boost::asio::error::bad_descriptor, 0));
+				  return;
+			  }
+
+			  IoUring::Operation* operation = new IoUring::Operation(fd_, strand_);
+			  if (operation->buffers(buffers) == 0) {
+				  delete operation;
+				  strand_->post(boost::asio::detail::bind_handler(handler, boost::system::error_code(), 0));
+				  return;
+			  }
+
+			  operation->handler_ = handler;
+			  if (!ioUring_.asyncRecv(operation)) {
+				  delete operation;
+				  strand_->post(boost::asio::detail::bind_handler(handler, boost::asio::error::no_buffer_space, 0));
+			  }
+		  }
+
+		template<typename CONST_BUFFER, typename HANDLER>
+		  void async_write_some(const CONST_BUFFER& buffers, HANDLER&& handler)
+		  {
+			  if (fd_ < 0) {
+				  strand_->post(boost::asio::detail::bind_handler(handler, boost::asio::error::bad_descriptor, 0));
+				  return;
+			  }
+
+			  IoUring::Operation* operation = new IoUring::Operation(fd_, strand_);
+			  if (operation->buffers(buffers) == 0) {
+				  delete operation;
+				  strand_->post(boost::asio::detail::bind_handler(handler, boost::system::error_code(), 0));
+				  return;
+			  }
+
+			  operation->handler_ = handler;
+			  if (!ioUring_.asyncSend(operation)) {
+				  delete operation;
+				  strand_->post(boost::asio::detail::bind_handler(handler, boost::asio::error::no_buffer_space, 0));
+			  }
+		  }
+
+	  private:
+		IoUring& ioUring_;
+		StrandSPtr strand_;
+		int fd_;
+	};
+
+}
+
+#endif
+
+#endif
@@ -65,6 +65,12 @@ namespace OpcUaStackCore
 		numberThreads_ = numberThreads;
 	}
 
+	uint32_t
+	IOThread::numberThreads(void)
+	{
+		return numberThreads_;
+	}
+
 	void
 	IOThread::createIOService(void)
 	{
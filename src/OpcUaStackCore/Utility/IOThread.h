@@ -24,6 +24,7 @@ namespace OpcUaStackCore
 		void slotTimer(const SlotTimer::SPtr& slotTimer);
 		SlotTimer::SPtr& slotTimer(void);
 		void numberThreads(uint32_t numberThreads);
+		uint32_t numberThreads(void);
 
 		bool startup(void);
 		bool shutdown(void);
@@ -256,8 +256,13 @@ namespace OpcUaStackCore
 				slotTimer_->internalStart(slotTimerElement);
 			}
 
+			// the callback is copied while the timer is still locked. A
+			// concurrent stop followed by a reset of the callback can then
+			// no longer race with the call
+			Callback callback = slotTimerElement->callback();
+
 			if (mutex != nullptr) mutex->unlock();
-			slotTimerElement->callback()();
+			callback();
 			if (mutex != nullptr) mutex->lock();
 		}
 
@@ -400,9 +405,9 @@ namespace OpcUaStackCore
 	void 
 	SlotTimer::stop(SlotTimerElement::SPtr slotTimerElement)
 	{
-		if (!slotTimerElement->isRunning()) return;
-
 		boost::mutex::scoped_lock g(mutex_);
+
+		if (!slotTimerElement->isRunning()) return;
 		slotArray1_.remove(slotTimerElement);
 	}
 
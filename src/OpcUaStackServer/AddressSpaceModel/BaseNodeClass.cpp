@@ -29,6 +29,9 @@ namespace OpcUaStackServer
 	, writeMask_()
 	, userWriteMask_()
 	, forwardNodeSync_()
+	, readCacheHitCount_(0)
+	, readCacheMissCount_(0)
+	, readCacheTime_()
 	{
 	}
 
@@ -41,6 +44,9 @@ namespace OpcUaStackServer
 	, writeMask_()
 	, userWriteMask_()
 	, forwardNodeSync_()
+	, readCacheHitCount_(0)
+	, readCacheMissCount_(0)
+	, readCacheTime_()
 	{
 	}
 
@@ -169,4 +175,40 @@ namespace OpcUaStackServer
 		return forwardNodeSync_;
 	}
 
+	void
+	BaseNodeClass::readCacheHit(void)
+	{
+		readCacheHitCount_++;
+	}
+
+	void
+	BaseNodeClass::readCacheMiss(void)
+	{
+		readCacheMissCount_++;
+	}
+
+	uint32_t
+	BaseNodeClass::readCacheHitCount(void)
+	{
+		return readCacheHitCount_;
+	}
+
+	uint32_t
+	BaseNodeClass::readCacheMissCount(void)
+	{
+		return readCacheMissCount_;
+	}
+
+	void
+	BaseNodeClass::readCacheTime(const boost::posix_time::ptime& readCacheTime)
+	{
+		readCacheTime_ = readCacheTime;
+	}
+
+	boost::posix_time::ptime
+	BaseNodeClass::readCacheTime(void)
+	{
+		return readCacheTime_;
+	}
+
 }
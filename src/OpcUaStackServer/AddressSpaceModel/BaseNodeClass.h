@@ -19,6 +19,7 @@
 #define __OpcUaStackServer_BaseNodeClass_h__
 
 #include <vector>
+#include <atomic>
 #include "OpcUaStackCore/Base/os.h"
 #include "OpcUaStackCore/BuildInTypes/BuildInTypes.h"
 #include "OpcUaStackCore/ServiceSetApplication/ForwardNodeSync.h"
@@ -70,6 +71,18 @@ namespace OpcUaStackServer
 		void forwardNodeSync(ForwardNodeSync::SPtr forwardInfo);
 		ForwardNodeSync::SPtr forwardNodeSync(void);
 
+		// statistic of forwarded value reads, which were answered from the
+		// value of the node (hit) or by the application (miss)
+		void readCacheHit(void);
+		void readCacheMiss(void);
+		uint32_t readCacheHitCount(void);
+		uint32_t readCacheMissCount(void);
+
+		// age of the value, which was last read from the application. It is
+		// protected by the mutex of the node
+		void readCacheTime(const boost::posix_time::ptime& readCacheTime);
+		boost::posix_time::ptime readCacheTime(void);
+
 	  private:
 		NodeIdAttribute nodeId_;
 		NodeClassAttribute nodeClass_;
@@ -82,6 +95,10 @@ namespace OpcUaStackServer
 		ReferenceItemMap referenceItemMap_;
 
 		ForwardNodeSync::SPtr forwardNodeSync_;
+
+		std::atomic<uint32_t> readCacheHitCount_;
+		std::atomic<uint32_t> readCacheMissCount_;
+		boost::posix_time::ptime readCacheTime_;
 	};
 
 }
@@ -60,6 +60,8 @@ namespace OpcUaStackServer
 	void
 	InformationModel::clear(void)
 	{
+		boost::mutex::scoped_lock lock(mutex_);
+
 		informationModelMap_.clear();
 		methodMap_.clear();
 		eventHandlerMap_.clear();
@@ -112,6 +114,8 @@ namespace OpcUaStackServer
 	uint32_t
 	InformationModel::size(void)
 	{
+		boost::mutex::scoped_lock lock(mutex_);
+
 		return informationModelMap_.size();
 	}
 
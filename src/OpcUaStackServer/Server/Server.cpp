@@ -120,7 +120,7 @@ namespace OpcUaStackServer
 
 		// startup application
 		Log(Info, "startup application");
-		Component* applicationService = Component::getComponent("ApplicationService");
+		Component* applicationService = serviceManager_.applicationService().get();
 		applicationManager_.serviceComponent(applicationService);
 
 		if (!applicationManager_.startup()) {
@@ -129,7 +129,13 @@ namespace OpcUaStackServer
 		}
 
 		// startup opc ua stack
-		Log(Info, "start opc ua server stack");
+		uint32_t numberIOThreads = 1;
+		config().getConfigParameter("OpcUaServer.Stack.IOThreads", numberIOThreads, "1");
+		if (numberIOThreads == 0) numberIOThreads = 1;
+		ioThread_->numberThreads(numberIOThreads);
+
+		Log(Info, "start opc ua server stack")
+			.parameter("IOThreads", numberIOThreads);
 		if (!ioThread_->startup())
 		{
 			Log(Error, "server io thread start failed");
@@ -390,6 +396,18 @@ namespace OpcUaStackServer
 			return false;
 		}
 
+		// read service pool parameter from configuration file. The attribute,
+		// view and method services are executed by the service pool instead
+		// of the io threads (0 = io threads)
+		uint32_t serviceThreads;
+		uint32_t serviceQueueLength;
+		config().getConfigParameter("OpcUaServer.Stack.ServiceThreads", serviceThreads, "0");
+		config().getConfigParameter("OpcUaServer.Stack.ServiceQueueLength", serviceQueueLength, "1000");
+		if (!serviceManager_.serviceThreads(serviceThreads, serviceQueueLength)) {
+			Log log(Error, "init service pool error");
+			return false;
+		}
+
 		if (!serviceManager_.init()) {
 			Log log(Error, "init service manager error");
 			return false;
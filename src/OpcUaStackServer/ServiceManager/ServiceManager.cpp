@@ -32,6 +32,7 @@ namespace OpcUaStackServer
 	, applicationService_(constructSPtr<ApplicationService>())
 	, discoveryService_(constructSPtr<DiscoveryService>())
 	, forwardGlobalSync_(constructSPtr<ForwardGlobalSync>())
+	, servicePool_()
 	{
 		attributeService_->componentName("AttributeService");
 		methodService_->componentName("MethodService");
@@ -286,6 +287,30 @@ namespace OpcUaStackServer
 		return true;
 	}
 
+	bool
+	ServiceManager::serviceThreads(uint32_t serviceThreads, uint32_t serviceQueueLength)
+	{
+		if (serviceThreads == 0) {
+			return true;
+		}
+
+		// the attribute, view and method services are executed by the
+		// service pool. The nodes of the information model are protected
+		// by the mutex of each node. The responses are sent in the strand
+		// of the secure channel.
+		servicePool_ = constructSPtr<WorkerPool>(std::string("Service"));
+		servicePool_->startup(serviceThreads, serviceQueueLength);
+
+		attributeService_->workerPool(servicePool_);
+		viewService_->workerPool(servicePool_);
+		methodService_->workerPool(servicePool_);
+
+		Log(Info, "start service pool")
+			.parameter("ServiceThreads", serviceThreads)
+			.parameter("ServiceQueueLength", serviceQueueLength);
+		return true;
+	}
+
 	bool
 	ServiceManager::init(void)
 	{
@@ -305,6 +330,14 @@ namespace OpcUaStackServer
 	bool
 	ServiceManager::shutdown(void)
 	{
+		// stop service pool
+		if (servicePool_.get() != nullptr) {
+			Log(Info, "service pool statistic")
+				.parameter("MaxQueueLength", servicePool_->maxQueueLengthObserved())
+				.parameter("RejectCount", servicePool_->rejectCount());
+			servicePool_->shutdown();
+		}
+
 		applicationService_->shutdown();
 		viewService_->shutdown();
 		subscriptionService_->shutdown();
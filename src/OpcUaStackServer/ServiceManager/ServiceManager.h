@@ -46,6 +46,7 @@ namespace OpcUaStackServer
 		bool init(SessionManager& sessionManager);
 		bool informatinModel(InformationModel::SPtr informatinModel);
 		bool ioThread(IOThread* ioThread);
+		bool serviceThreads(uint32_t serviceThreads, uint32_t serviceQueueLength);
 		bool init(void);
 		bool shutdown(void);
 
@@ -56,6 +57,7 @@ namespace OpcUaStackServer
 		void initForwardGlobalSync(void);
 
 		ForwardGlobalSync::SPtr forwardGlobalSync_;
+		WorkerPool::SPtr servicePool_;
 
 		TransactionManager::SPtr transactionManager_;
 		AttributeService::SPtr attributeService_;
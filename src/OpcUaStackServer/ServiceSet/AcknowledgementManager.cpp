@@ -29,6 +29,7 @@ namespace OpcUaStackServer
 	// ------------------------------------------------------------------------
 	AcknowledgementElement::AcknowledgementElement(void)
 	: sequenceNumber_(0)
+	, publishTime_()
 	, notification_()
 	{
 	}
@@ -49,6 +50,18 @@ namespace OpcUaStackServer
 		return sequenceNumber_;
 	}
 
+	void
+	AcknowledgementElement::publishTime(UtcTime& publishTime)
+	{
+		publishTime_ = publishTime;
+	}
+
+	UtcTime&
+	AcknowledgementElement::publishTime(void)
+	{
+		return publishTime_;
+	}
+
 	void
 	AcknowledgementElement::notification(ExtensibleParameter::SPtr& notification)
 	{
@@ -115,11 +128,13 @@ namespace OpcUaStackServer
 	void
 	AcknowledgementManager::addNotification(
 		uint32_t sequenceNumber,
+		UtcTime& publishTime,
 		ExtensibleParameter::SPtr& notification
 	)
 	{
 		AcknowledgementElement::SPtr acknowledgementElement = constructSPtr<AcknowledgementElement>();
 		acknowledgementElement->sequenceNumber(sequenceNumber);
+		acknowledgementElement->publishTime(publishTime);
 		acknowledgementElement->notification(notification);
 		acknowledgementList_.push_back(acknowledgementElement);
 
@@ -163,11 +178,23 @@ namespace OpcUaStackServer
 		uint32_t sequenceNumber,
 		ExtensibleParameter::SPtr& notification
 	)
+	{
+		UtcTime publishTime;
+		return getNotification(sequenceNumber, publishTime, notification);
+	}
+
+	bool
+	AcknowledgementManager::getNotification(
+		uint32_t sequenceNumber,
+		UtcTime& publishTime,
+		ExtensibleParameter::SPtr& notification
+	)
 	{
 		AcknowledgementList::iterator it;
 		for (it = acknowledgementList_.begin(); it != acknowledgementList_.end(); it++) {
 			AcknowledgementElement::SPtr& acknowledgementElement = *it;
 			if (acknowledgementElement->sequenceNumber() == sequenceNumber) {
+				publishTime = acknowledgementElement->publishTime();
 				notification = acknowledgementElement->notification();
 				return true;
 			}
@@ -38,11 +38,14 @@ namespace OpcUaStackServer
 
 		void sequenceNumber(uint32_t sequenceNumber);
 		uint32_t sequenceNumber(void);
+		void publishTime(UtcTime& publishTime);
+		UtcTime& publishTime(void);
 		void notification(ExtensibleParameter::SPtr& notification);
 		ExtensibleParameter::SPtr notification(void);
 
 	  private:
 		uint32_t sequenceNumber_;
+		UtcTime publishTime_;
 		ExtensibleParameter::SPtr notification_;
 
 	};
@@ -64,6 +67,7 @@ namespace OpcUaStackServer
 		uint32_t maxListSize(void);
 		void addNotification(
 			uint32_t sequenceNumber,
+			UtcTime& publishTime,
 			ExtensibleParameter::SPtr& notification
 		);
 		void deleteNotification(
@@ -77,6 +81,11 @@ namespace OpcUaStackServer
 			uint32_t sequenceNumber,
 			ExtensibleParameter::SPtr& notification
 		);
+		bool getNotification(
+			uint32_t sequenceNumber,
+			UtcTime& publishTime,
+			ExtensibleParameter::SPtr& notification
+		);
 		void availableSequenceNumbers(
 			OpcUaUInt32Array::SPtr& availableSequenceNumbers
 		);
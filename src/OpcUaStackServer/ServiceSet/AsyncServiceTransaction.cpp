@@ -0,0 +1,209 @@
+/*
+   Copyright 2015 Kai Huebl (kai@huebl-sgh.de)
+
+   Lizenziert gemäß Apache Licence Version 2.0 (die „Lizenz“); Nutzung dieser
+   Datei nur in Übereinstimmung mit der Lizenz erlaubt.
+   Eine Kopie der Lizenz erhalten Sie auf http://www.apache.org/licenses/LICENSE-2.0.
+
+   Sofern nicht gemäß geltendem Recht vorgeschrieben oder schriftlich vereinbart,
+   erfolgt die Bereitstellung der im Rahmen der Lizenz verbreiteten Software OHNE
+   GEWÄHR ODER VORBEHALTE – ganz gleich, ob ausdrücklich oder stillschweigend.
+
+   Informationen über die jeweiligen Bedingungen für Genehmigungen und Einschränkungen
+   im Rahmen der Lizenz finden Sie in der Lizenz.
+
+   Autor: Kai Huebl (kai@huebl-sgh.de)
+ */
+#include "OpcUaStackServer/ServiceSet/AsyncServiceTransaction.h"
+
+namespace OpcUaStackServer
+{
+
+	AsyncServiceTransaction::AsyncServiceTransaction(
+		const ServiceTransaction::SPtr& serviceTransaction,
+		uint32_t numberItems
+	)
+	: serviceTransaction_(serviceTransaction)
+	, itemCallback_()
+	, timeoutCallback_()
+	, finishCallback_()
+	, mutex_()
+	, started_(false)
+	, finished_(false)
+	, pendingCount_(0)
+	, activeCount_(0)
+	, pendingVec_(numberItems, false)
+	, resultVec_()
+	, slotTimer_()
+	, slotTimerElement_()
+	{
+	}
+
+	AsyncServiceTransaction::~AsyncServiceTransaction(void)
+	{
+	}
+
+	ServiceTransaction::SPtr&
+	AsyncServiceTransaction::serviceTransaction(void)
+	{
+		return serviceTransaction_;
+	}
+
+	AsyncServiceTransaction::ItemCallback&
+	AsyncServiceTransaction::itemCallback(void)
+	{
+		return itemCallback_;
+	}
+
+	AsyncServiceTransaction::TimeoutCallback&
+	AsyncServiceTransaction::timeoutCallback(void)
+	{
+		return timeoutCallback_;
+	}
+
+	AsyncServiceTransaction::FinishCallback&
+	AsyncServiceTransaction::finishCallback(void)
+	{
+		return finishCallback_;
+	}
+
+	ApplicationCompletion::SPtr
+	AsyncServiceTransaction::completion(uint32_t idx)
+	{
+		boost::mutex::scoped_lock g(mutex_);
+		if (idx >= pendingVec_.size() || pendingVec_[idx]) {
+			return ApplicationCompletion::SPtr();
+		}
+		pendingVec_[idx] = true;
+		pendingCount_++;
+
+		// the token keeps the transaction alive until it is completed
+		return constructSPtr<ApplicationCompletion>(
+			boost::bind(&AsyncServiceTransaction::complete, shared_from_this(), idx, _1, _2)
+		);
+	}
+
+	bool
+	AsyncServiceTransaction::start(SlotTimer::SPtr slotTimer, uint32_t timeoutHint)
+	{
+		std::vector<Result::SPtr> resultVec;
+		{
+			boost::mutex::scoped_lock g(mutex_);
+			started_ = true;
+
+			// the completions which arrived during the forward callbacks are
+			// passed to the item callback without holding the lock
+			resultVec.swap(resultVec_);
+			activeCount_++;
+
+			if (pendingCount_ != 0 && timeoutHint != 0 && slotTimer.get() != nullptr) {
+				slotTimer_ = slotTimer;
+				slotTimerElement_ = constructSPtr<SlotTimerElement>();
+				slotTimerElement_->expireFromNow(timeoutHint);
+				slotTimerElement_->callback().reset(
+					boost::bind(&AsyncServiceTransaction::timeout, this, shared_from_this())
+				);
+				slotTimer_->start(slotTimerElement_);
+			}
+		}
+
+		std::vector<Result::SPtr>::iterator it;
+		for (it = resultVec.begin(); it != resultVec.end(); it++) {
+			itemCallback_((*it)->idx_, (*it)->statusCode_, (*it)->dataValue_);
+		}
+
+		return done();
+	}
+
+	void
+	AsyncServiceTransaction::complete(uint32_t idx, OpcUaStatusCode statusCode, OpcUaDataValue& dataValue)
+	{
+		{
+			boost::mutex::scoped_lock g(mutex_);
+			if (finished_ || !pendingVec_[idx]) {
+				return;
+			}
+			pendingVec_[idx] = false;
+			pendingCount_--;
+
+			if (!started_) {
+				Result::SPtr result = constructSPtr<Result>();
+				result->idx_ = idx;
+				result->statusCode_ = statusCode;
+				dataValue.copyTo(result->dataValue_);
+				resultVec_.push_back(result);
+				return;
+			}
+			activeCount_++;
+		}
+
+		// the item callback takes the node lock. It is called without the
+		// lock of the transaction, because the application can complete an
+		// operation while it holds the node lock
+		itemCallback_(idx, statusCode, dataValue);
+		done();
+	}
+
+	void
+	AsyncServiceTransaction::timeout(AsyncServiceTransaction::SPtr asyncServiceTransaction)
+	{
+		std::vector<uint32_t> idxVec;
+		{
+			boost::mutex::scoped_lock g(mutex_);
+			if (finished_) {
+				return;
+			}
+
+			for (uint32_t idx = 0; idx < pendingVec_.size(); idx++) {
+				if (!pendingVec_[idx]) continue;
+				pendingVec_[idx] = false;
+				idxVec.push_back(idx);
+			}
+			pendingCount_ = 0;
+			activeCount_++;
+		}
+
+		std::vector<uint32_t>::iterator it;
+		for (it = idxVec.begin(); it != idxVec.end(); it++) {
+			timeoutCallback_(*it);
+		}
+		done();
+	}
+
+	bool
+	AsyncServiceTransaction::done(void)
+	{
+		// the transaction is finished when all operations are completed and
+		// no item callback is running anymore
+		{
+			boost::mutex::scoped_lock g(mutex_);
+			activeCount_--;
+			if (finished_ || !started_ || pendingCount_ != 0 || activeCount_ != 0) {
+				return false;
+			}
+			finished_ = true;
+		}
+
+		finish();
+		return true;
+	}
+
+	void
+	AsyncServiceTransaction::finish(void)
+	{
+		if (slotTimerElement_.get() != nullptr) {
+			slotTimer_->stop(slotTimerElement_);
+			slotTimerElement_->callback().reset();
+		}
+
+		// the callbacks are released, because they can reference the
+		// service transaction
+		FinishCallback finishCallback;
+		finishCallback.swap(finishCallback_);
+		itemCallback_.clear();
+		timeoutCallback_.clear();
+
+		finishCallback();
+	}
+
+}
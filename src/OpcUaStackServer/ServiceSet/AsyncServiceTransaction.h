@@ -0,0 +1,107 @@
+/*
+   Copyright 2015 Kai Huebl (kai@huebl-sgh.de)
+
+   Lizenziert gemäß Apache Licence Version 2.0 (die „Lizenz“); Nutzung dieser
+   Datei nur in Übereinstimmung mit der Lizenz erlaubt.
+   Eine Kopie der Lizenz erhalten Sie auf http://www.apache.org/licenses/LICENSE-2.0.
+
+   Sofern nicht gemäß geltendem Recht vorgeschrieben oder schriftlich vereinbart,
+   erfolgt die Bereitstellung der im Rahmen der Lizenz verbreiteten Software OHNE
+   GEWÄHR ODER VORBEHALTE – ganz gleich, ob ausdrücklich oder stillschweigend.
+
+   Informationen über die jeweiligen Bedingungen für Genehmigungen und Einschränkungen
+   im Rahmen der Lizenz finden Sie in der Lizenz.
+
+   Autor: Kai Huebl (kai@huebl-sgh.de)
+ */
+#ifndef __OpcUaStackServer_AsyncServiceTransaction_h__
+#define __OpcUaStackServer_AsyncServiceTransaction_h__
+
+#include <vector>
+#include <boost/shared_ptr.hpp>
+#include <boost/enable_shared_from_this.hpp>
+#include <boost/function.hpp>
+#include <boost/thread/mutex.hpp>
+#include "OpcUaStackCore/Base/os.h"
+#include "OpcUaStackCore/Application/ApplicationCompletion.h"
+#include "OpcUaStackCore/ServiceSet/ServiceTransaction.h"
+#include "OpcUaStackCore/Utility/SlotTimer.h"
+
+using namespace OpcUaStackCore;
+
+namespace OpcUaStackServer
+{
+
+	//
+	// service transaction with operations that are completed asynchronously
+	// by the application. The completion of an operation is passed to the
+	// item callback. The finish callback is called once, when all operations
+	// are completed or when the timeout expires. The remaining operations
+	// are passed to the timeout callback in this case.
+	//
+	// Completions that arrive before start() are stored and passed to the
+	// item callback by start(), because the service holds the node lock
+	// while the forward callback is running. The item and timeout callbacks
+	// take the node lock, so they are called without holding the lock of
+	// the transaction. The finish callback waits for running item callbacks.
+	//
+	class DLLEXPORT AsyncServiceTransaction
+	: public Object
+	, public boost::enable_shared_from_this<AsyncServiceTransaction>
+	{
+	  public:
+		typedef boost::shared_ptr<AsyncServiceTransaction> SPtr;
+		typedef boost::function<void (uint32_t, OpcUaStatusCode, OpcUaDataValue&)> ItemCallback;
+		typedef boost::function<void (uint32_t)> TimeoutCallback;
+		typedef boost::function<void (void)> FinishCallback;
+
+		AsyncServiceTransaction(
+			const ServiceTransaction::SPtr& serviceTransaction,
+			uint32_t numberItems
+		);
+		~AsyncServiceTransaction(void);
+
+		ServiceTransaction::SPtr& serviceTransaction(void);
+		ItemCallback& itemCallback(void);
+		TimeoutCallback& timeoutCallback(void);
+		FinishCallback& finishCallback(void);
+
+		ApplicationCompletion::SPtr completion(uint32_t idx);
+		bool start(SlotTimer::SPtr slotTimer, uint32_t timeoutHint);
+
+	  private:
+		class Result
+		{
+		  public:
+			typedef boost::shared_ptr<Result> SPtr;
+
+			uint32_t idx_;
+			OpcUaStatusCode statusCode_;
+			OpcUaDataValue dataValue_;
+		};
+
+		void complete(uint32_t idx, OpcUaStatusCode statusCode, OpcUaDataValue& dataValue);
+		void timeout(AsyncServiceTransaction::SPtr asyncServiceTransaction);
+		bool done(void);
+		void finish(void);
+
+		ServiceTransaction::SPtr serviceTransaction_;
+		ItemCallback itemCallback_;
+		TimeoutCallback timeoutCallback_;
+		FinishCallback finishCallback_;
+
+		boost::mutex mutex_;
+		bool started_;
+		bool finished_;
+		uint32_t pendingCount_;
+		uint32_t activeCount_;
+		std::vector<bool> pendingVec_;
+		std::vector<Result::SPtr> resultVec_;
+
+		SlotTimer::SPtr slotTimer_;
+		SlotTimerElement::SPtr slotTimerElement_;
+	};
+
+}
+
+#endif
@@ -15,13 +15,16 @@
    Autor: Kai Huebl (kai@huebl-sgh.de)
  */
 
+#include <limits>
 #include "OpcUaStackCore/Base/Log.h"
 #include "OpcUaStackCore/ServiceSet/AttributeServiceTransaction.h"
 #include "OpcUaStackCore/Application/ApplicationAutorizationContext.h"
 #include "OpcUaStackCore/Application/ApplicationReadContext.h"
+#include "OpcUaStackCore/Application/ApplicationReadBatchContext.h"
 #include "OpcUaStackCore/Application/ApplicationHReadContext.h"
 #include "OpcUaStackCore/Application/ApplicationHReadEventContext.h"
 #include "OpcUaStackCore/Application/ApplicationWriteContext.h"
+#include "OpcUaStackCore/Application/ApplicationWriteBatchContext.h"
 #include "OpcUaStackCore/Application/ApplicationHWriteContext.h"
 #include "OpcUaStackCore/BuildInTypes/OpcUaIdentifier.h"
 #include "OpcUaStackCore/ServiceSet/HistoryData.h"
@@ -90,10 +93,19 @@ namespace OpcUaStackServer
 			.parameter("NumberNodes", readRequest->readValueIdArray()->size());
 
 		// check attribute maxAge
-		// FIXME: todo 
+		if (readRequest->maxAge() < 0) {
+			trx->statusCode(BadMaxAgeInvalid);
+			trx->componentSession()->send(serviceTransaction);
+			return;
+		}
 
 		// check attribute timestampToReturn
-		// FIXME: todo
+		if (readRequest->timestampsToReturn() < TimestampsToReturn_Source ||
+			readRequest->timestampsToReturn() > TimestampsToReturn_Neither) {
+			trx->statusCode(BadTimestampsToReturnInvalid);
+			trx->componentSession()->send(serviceTransaction);
+			return;
+		}
 
 		// check node id array
 		if (readRequest->readValueIdArray()->size() == 0) {
@@ -108,6 +120,8 @@ namespace OpcUaStackServer
 		}
 
 		// read values
+		AsyncServiceTransaction::SPtr asyncServiceTransaction;
+		ReadBatchMap readBatchMap;
 		readResponse->dataValueArray()->resize(readRequest->readValueIdArray()->size());
 		for (uint32_t idx = 0; idx < readRequest->readValueIdArray()->size(); idx++) {
 			OpcUaDataValue::SPtr dataValue = constructSPtr<OpcUaDataValue>();
@@ -142,64 +156,114 @@ namespace OpcUaStackServer
 				continue;
 			}
 
-			boost::shared_lock<boost::shared_mutex> lock(baseNodeClass->mutex());
-
-			// forward read request
-			forwardRead(
-				serviceTransaction->userContext(),
-				baseNodeClass,
-				readRequest,
-				readValueId
-			);
-
-			// determine the attribute to be read
-			Attribute* attribute = baseNodeClass->attribute((AttributeId)readValueId->attributeId());
-			if (attribute == nullptr) {
-				dataValue->statusCode(BadAttributeIdInvalid);
-				Log(Debug, "read value error, because node attribute not exist in node")
-					.parameter("Trx", serviceTransaction->transactionId())
-					.parameter("Idx", idx)
-					.parameter("Node", *readValueId->nodeId())
-					.parameter("Attr", readValueId->attributeId())
-					.parameter("Class", baseNodeClass->nodeClass().data());
+			// a forwarded value which is not older than maxAge is read from
+			// the information model without calling the application
+			if (readCache(baseNodeClass, readValueId, readRequest->maxAge())) {
+				boost::shared_lock<boost::shared_mutex> lock(baseNodeClass->mutex());
+				readValue(serviceTransaction, idx, baseNodeClass, readValueId, dataValue);
 				continue;
 			}
 
-			if (attribute->exist() == false) {
-				Log(Debug, "read value error, because node attribute is empty")
-					.parameter("Trx", serviceTransaction->transactionId())
-					.parameter("Idx", idx)
-					.parameter("Node", *readValueId->nodeId())
-					.parameter("Attr", readValueId->attributeId())
-					.parameter("Class", baseNodeClass->nodeClass().data());
-				dataValue->statusCode(BadNotReadable);
+			// the items of a batch read callback are read after the loop
+			// with one callback for each application
+			CallbackBase* callbackBase;
+			if (isReadBatch(baseNodeClass, readValueId, callbackBase)) {
+				readBatchMap[callbackBase].push_back(std::make_pair(idx, baseNodeClass));
 				continue;
 			}
 
-			if (!AttributeAccess::copy(*attribute, *dataValue)) {
-				Log(Debug, "read value error, because value error")
-					.parameter("Trx", serviceTransaction->transactionId())
-					.parameter("Idx", idx)
-					.parameter("Node", *readValueId->nodeId())
-					.parameter("Attr", readValueId->attributeId())
-					.parameter("Class", baseNodeClass->nodeClass().data());
-				dataValue->reset();
-				dataValue->statusCode(BadAttributeIdInvalid);
+			// forward read request. The value is read when the application
+			// completes an asynchronous read
+			if (forwardRead(
+				serviceTransaction,
+				asyncServiceTransaction,
+				idx,
+				baseNodeClass,
+				readRequest,
+				readValueId
+			)) {
 				continue;
 			}
 
-			Log(Debug, "read value")
+			boost::shared_lock<boost::shared_mutex> lock(baseNodeClass->mutex());
+			readValue(serviceTransaction, idx, baseNodeClass, readValueId, dataValue);
+		}
+
+		// forward batch read requests
+		ReadBatchMap::iterator it;
+		for (it = readBatchMap.begin(); it != readBatchMap.end(); it++) {
+			forwardReadBatch(serviceTransaction, asyncServiceTransaction, it->second);
+		}
+
+		// wait for the asynchronous reads of the application
+		if (asyncServiceTransaction.get() != nullptr) {
+			asyncServiceTransaction->itemCallback() = boost::bind(&AttributeService::asyncReadComplete, this, serviceTransaction, _1, _2, _3);
+			asyncServiceTransaction->timeoutCallback() = boost::bind(&AttributeService::asyncReadTimeout, this, serviceTransaction, _1);
+			asyncStart(asyncServiceTransaction);
+			return;
+		}
+
+		trx->statusCode(Success);
+		trx->componentSession()->send(serviceTransaction);
+	}
+
+	void
+	AttributeService::readValue(
+		ServiceTransaction::SPtr& serviceTransaction,
+		uint32_t idx,
+		BaseNodeClass::SPtr& baseNodeClass,
+		ReadValueId::SPtr& readValueId,
+		OpcUaDataValue::SPtr& dataValue
+	)
+	{
+		// determine the attribute to be read
+		Attribute* attribute = baseNodeClass->attribute((AttributeId)readValueId->attributeId());
+		if (attribute == nullptr) {
+			dataValue->statusCode(BadAttributeIdInvalid);
+			Log(Debug, "read value error, because node attribute not exist in node")
 				.parameter("Trx", serviceTransaction->transactionId())
 				.parameter("Idx", idx)
 				.parameter("Node", *readValueId->nodeId())
 				.parameter("Attr", readValueId->attributeId())
-				.parameter("Class", baseNodeClass->nodeClass().data())
-				.parameter("Data", *dataValue)
-				.parameter("Type", attribute->type());
+				.parameter("Class", baseNodeClass->nodeClass().data());
+			return;
 		}
 
-		trx->statusCode(Success);
-		trx->componentSession()->send(serviceTransaction);
+		if (attribute->exist() == false) {
+			Log(Debug, "read value error, because node attribute is empty")
+				.parameter("Trx", serviceTransaction->transactionId())
+				.parameter("Idx", idx)
+				.parameter("Node", *readValueId->nodeId())
+				.parameter("Attr", readValueId->attributeId())
+				.parameter("Class", baseNodeClass->nodeClass().data());
+			dataValue->statusCode(BadNotReadable);
+			return;
+		}
+
+		if (!AttributeAccess::copy(*attribute, *dataValue)) {
+			Log(Debug, "read value error, because value error")
+				.parameter("Trx", serviceTransaction->transactionId())
+				.parameter("Idx", idx)
+				.parameter("Node", *readValueId->nodeId())
+				.parameter("Attr", readValueId->attributeId())
+				.parameter("Class", baseNodeClass->nodeClass().data());
+			dataValue->reset();
+			dataValue->statusCode(BadAttributeIdInvalid);
+			return;
+		}
+
+		// only the timestamps requested by the client are encoded
+		ServiceTransactionRead::SPtr trx = boost::static_pointer_cast<ServiceTransactionRead>(serviceTransaction);
+		dataValue->timestampsToReturn(trx->request()->timestampsToReturn());
+
+		Log(Debug, "read value")
+			.parameter("Trx", serviceTransaction->transactionId())
+			.parameter("Idx", idx)
+			.parameter("Node", *readValueId->nodeId())
+			.parameter("Attr", readValueId->attributeId())
+			.parameter("Class", baseNodeClass->nodeClass().data())
+			.parameter("Data", *dataValue)
+			.parameter("Type", attribute->type());
 	}
 
 	OpcUaStatusCode
@@ -219,31 +283,227 @@ namespace OpcUaStackServer
 		return context.statusCode_;
 	}
 
-	void
+	bool
 	AttributeService::forwardRead(
-		UserContext::SPtr& userContext,
+		ServiceTransaction::SPtr& serviceTransaction,
+		AsyncServiceTransaction::SPtr& asyncServiceTransaction,
+		uint32_t idx,
 		BaseNodeClass::SPtr baseNodeClass,
 		ReadRequest::SPtr readRequest,
 		ReadValueId::SPtr readValueId
 	)
 	{
-		if ((AttributeId)readValueId->attributeId() != AttributeId_Value) return;
+		if ((AttributeId)readValueId->attributeId() != AttributeId_Value) return false;
 
 		ForwardNodeSync::SPtr forwardNodeSync = baseNodeClass->forwardNodeSync();
-		if (forwardNodeSync.get() == nullptr) return;
-		if (!forwardNodeSync->readService().isCallback()) return;
+		if (forwardNodeSync.get() == nullptr) return false;
+		if (!forwardNodeSync->readService().isCallback()) return false;
 
 		ApplicationReadContext applicationReadContext;
 		applicationReadContext.nodeId_ = *readValueId->nodeId();
 		applicationReadContext.attributeId_ = readValueId->attributeId();
 		applicationReadContext.statusCode_ = Success;
 		applicationReadContext.applicationContext_ = forwardNodeSync->readService().applicationContext();
-		applicationReadContext.userContext_ = userContext;
+		applicationReadContext.userContext_ = serviceTransaction->userContext();
+		applicationReadContext.completionFactory_ = boost::bind(
+			&AttributeService::asyncCompletion,
+			this,
+			boost::ref(asyncServiceTransaction),
+			boost::ref(serviceTransaction),
+			readRequest->readValueIdArray()->size(),
+			idx
+		);
 
 		forwardNodeSync->readService().callback()(&applicationReadContext);
 
-		if (applicationReadContext.statusCode_ != Success) return;
-		baseNodeClass->setValue(applicationReadContext.dataValue_);
+		// the application completes the read later
+		if (applicationReadContext.completion_.get() != nullptr) return true;
+
+		if (applicationReadContext.statusCode_ != Success) return false;
+		boost::unique_lock<boost::shared_mutex> lock(baseNodeClass->mutex());
+		readCacheUpdate(baseNodeClass, applicationReadContext.dataValue_);
+		return false;
+	}
+
+	bool
+	AttributeService::readCache(BaseNodeClass::SPtr& baseNodeClass, ReadValueId::SPtr& readValueId, OpcUaDouble maxAge)
+	{
+		if ((AttributeId)readValueId->attributeId() != AttributeId_Value) return false;
+
+		ForwardNodeSync::SPtr forwardNodeSync = baseNodeClass->forwardNodeSync();
+		if (forwardNodeSync.get() == nullptr) return false;
+		if (!forwardNodeSync->readService().isCallback() &&
+			!forwardNodeSync->readBatchService().isCallback()) {
+			return false;
+		}
+
+		// maxAge 0 requests a new value from the application. It is not
+		// counted as a cache miss
+		if (maxAge <= 0) return false;
+
+		{
+			boost::shared_lock<boost::shared_mutex> lock(baseNodeClass->mutex());
+
+			boost::posix_time::ptime readCacheTime = baseNodeClass->readCacheTime();
+			if (!readCacheTime.is_not_a_date_time()) {
+				boost::posix_time::ptime now = boost::posix_time::microsec_clock::universal_time();
+
+				if (readCacheTime <= now &&
+					(maxAge >= std::numeric_limits<OpcUaInt32>::max() || (now - readCacheTime).total_milliseconds() <= maxAge)) {
+					baseNodeClass->readCacheHit();
+					return true;
+				}
+			}
+		}
+
+		baseNodeClass->readCacheMiss();
+		return false;
+	}
+
+	void
+	AttributeService::readCacheUpdate(BaseNodeClass::SPtr& baseNodeClass, OpcUaDataValue& dataValue)
+	{
+		// the caller holds the unique lock of the node. The age of the value
+		// for the maxAge parameter of later read requests is the server
+		// timestamp of the application or the time of the read. It is kept
+		// beside the value, the value is stored as it is
+		if (dataValue.serverTimestamp().exist()) {
+			baseNodeClass->readCacheTime(dataValue.serverTimestamp().dateTime());
+		}
+		else {
+			baseNodeClass->readCacheTime(boost::posix_time::microsec_clock::universal_time());
+		}
+		baseNodeClass->setValue(dataValue);
+	}
+
+	bool
+	AttributeService::isReadBatch(BaseNodeClass::SPtr& baseNodeClass, ReadValueId::SPtr& readValueId, CallbackBase*& callbackBase)
+	{
+		if ((AttributeId)readValueId->attributeId() != AttributeId_Value) return false;
+
+		ForwardNodeSync::SPtr forwardNodeSync = baseNodeClass->forwardNodeSync();
+		if (forwardNodeSync.get() == nullptr) return false;
+		if (!forwardNodeSync->readBatchService().isCallback()) return false;
+
+		callbackBase = forwardNodeSync->readBatchService().callback().callbackBase();
+		return true;
+	}
+
+	void
+	AttributeService::forwardReadBatch(
+		ServiceTransaction::SPtr& serviceTransaction,
+		AsyncServiceTransaction::SPtr& asyncServiceTransaction,
+		ReadBatchItemVec& readBatchItemVec
+	)
+	{
+		ServiceTransactionRead::SPtr trx = boost::static_pointer_cast<ServiceTransactionRead>(serviceTransaction);
+		ReadRequest::SPtr readRequest = trx->request();
+		ReadResponse::SPtr readResponse = trx->response();
+
+		ForwardNodeSync::SPtr forwardNodeSync = readBatchItemVec[0].second->forwardNodeSync();
+		Callback callback = forwardNodeSync->readBatchService().callback();
+
+		ApplicationReadBatchContext applicationReadBatchContext;
+		applicationReadBatchContext.applicationContext_ = forwardNodeSync->readBatchService().applicationContext();
+		applicationReadBatchContext.userContext_ = serviceTransaction->userContext();
+		applicationReadBatchContext.readContextVec_.resize(readBatchItemVec.size());
+
+		for (uint32_t pos = 0; pos < readBatchItemVec.size(); pos++) {
+			uint32_t idx = readBatchItemVec[pos].first;
+			BaseNodeClass::SPtr& baseNodeClass = readBatchItemVec[pos].second;
+
+			ReadValueId::SPtr readValueId;
+			readRequest->readValueIdArray()->get(idx, readValueId);
+
+			ApplicationReadContext& applicationReadContext = applicationReadBatchContext.readContextVec_[pos];
+			applicationReadContext.nodeId_ = *readValueId->nodeId();
+			applicationReadContext.attributeId_ = readValueId->attributeId();
+			applicationReadContext.statusCode_ = Success;
+			applicationReadContext.applicationContext_ = baseNodeClass->forwardNodeSync()->readBatchService().applicationContext();
+			applicationReadContext.userContext_ = serviceTransaction->userContext();
+			applicationReadContext.completionFactory_ = boost::bind(
+				&AttributeService::asyncCompletion,
+				this,
+				boost::ref(asyncServiceTransaction),
+				boost::ref(serviceTransaction),
+				readRequest->readValueIdArray()->size(),
+				idx
+			);
+		}
+
+		Log(Debug, "forward batch read")
+			.parameter("Trx", serviceTransaction->transactionId())
+			.parameter("NumberNodes", readBatchItemVec.size());
+
+		callback(&applicationReadBatchContext);
+
+		for (uint32_t pos = 0; pos < readBatchItemVec.size(); pos++) {
+			uint32_t idx = readBatchItemVec[pos].first;
+			BaseNodeClass::SPtr& baseNodeClass = readBatchItemVec[pos].second;
+			ApplicationReadContext& applicationReadContext = applicationReadBatchContext.readContextVec_[pos];
+
+			// the application completes the read later
+			if (applicationReadContext.completion_.get() != nullptr) continue;
+
+			ReadValueId::SPtr readValueId;
+			OpcUaDataValue::SPtr dataValue;
+			readRequest->readValueIdArray()->get(idx, readValueId);
+			readResponse->dataValueArray()->get(idx, dataValue);
+
+			if (applicationReadContext.statusCode_ == Success) {
+				boost::unique_lock<boost::shared_mutex> lock(baseNodeClass->mutex());
+				readCacheUpdate(baseNodeClass, applicationReadContext.dataValue_);
+			}
+
+			boost::shared_lock<boost::shared_mutex> lock(baseNodeClass->mutex());
+			readValue(serviceTransaction, idx, baseNodeClass, readValueId, dataValue);
+		}
+	}
+
+	void
+	AttributeService::asyncReadComplete(
+		ServiceTransaction::SPtr serviceTransaction,
+		uint32_t idx,
+		OpcUaStatusCode statusCode,
+		OpcUaDataValue& dataValue
+	)
+	{
+		ServiceTransactionRead::SPtr trx = boost::static_pointer_cast<ServiceTransactionRead>(serviceTransaction);
+
+		ReadValueId::SPtr readValueId;
+		OpcUaDataValue::SPtr responseDataValue;
+		trx->request()->readValueIdArray()->get(idx, readValueId);
+		trx->response()->dataValueArray()->get(idx, responseDataValue);
+
+		BaseNodeClass::SPtr baseNodeClass = informationModel_->find(readValueId->nodeId());
+		if (baseNodeClass.get() == nullptr) {
+			responseDataValue->statusCode(BadNodeIdUnknown);
+			return;
+		}
+
+		// the value of the application is stored in the node and read like
+		// the value of a synchronous read
+		if (statusCode == Success) {
+			boost::unique_lock<boost::shared_mutex> lock(baseNodeClass->mutex());
+			readCacheUpdate(baseNodeClass, dataValue);
+		}
+
+		boost::shared_lock<boost::shared_mutex> lock(baseNodeClass->mutex());
+		readValue(serviceTransaction, idx, baseNodeClass, readValueId, responseDataValue);
+	}
+
+	void
+	AttributeService::asyncReadTimeout(ServiceTransaction::SPtr serviceTransaction, uint32_t idx)
+	{
+		ServiceTransactionRead::SPtr trx = boost::static_pointer_cast<ServiceTransactionRead>(serviceTransaction);
+
+		OpcUaDataValue::SPtr dataValue;
+		trx->response()->dataValueArray()->get(idx, dataValue);
+		dataValue->statusCode(BadTimeout);
+
+		Log(Debug, "read value error, because application read timeout")
+			.parameter("Trx", serviceTransaction->transactionId())
+			.parameter("Idx", idx);
 	}
 
 	// ------------------------------------------------------------------------
@@ -279,7 +539,9 @@ namespace OpcUaStackServer
 			return;
 		}
 
-		// read values
+		// write values
+		AsyncServiceTransaction::SPtr asyncServiceTransaction;
+		WriteBatchMap writeBatchMap;
 		writeResponse->results()->resize(writeRequest->writeValueArray()->size());
 		for (uint32_t idx=0; idx<writeRequest->writeValueArray()->size(); idx++) {
 
@@ -322,14 +584,28 @@ namespace OpcUaStackServer
 				continue;
 			}
 
+			// the items of a batch write callback are written after the loop
+			// with one callback for each application
+			CallbackBase* callbackBase;
+			if (isWriteBatch(baseNodeClass, writeValue, callbackBase)) {
+				writeBatchMap[callbackBase].push_back(std::make_pair(idx, baseNodeClass));
+				continue;
+			}
+
 			boost::unique_lock<boost::shared_mutex> lock(baseNodeClass->mutex());
 
 			OpcUaStatusCode statusCode = forwardWrite(
-				serviceTransaction->userContext(),
+				serviceTransaction,
+				asyncServiceTransaction,
+				idx,
 				baseNodeClass,
 				writeRequest,
 				writeValue
 			);
+			if (statusCode == GoodCompletesAsynchronously) {
+				// the value is written when the application completes the write
+				continue;
+			}
 			if (statusCode != Success) {
 				writeResponse->results()->set(idx, statusCode);
 				Log(Debug, "write value error, because invalid status code from library")
@@ -362,6 +638,20 @@ namespace OpcUaStackServer
 			writeResponse->results()->set(idx, Success);
 		}
 
+		// forward batch write requests
+		WriteBatchMap::iterator it;
+		for (it = writeBatchMap.begin(); it != writeBatchMap.end(); it++) {
+			forwardWriteBatch(serviceTransaction, asyncServiceTransaction, it->second);
+		}
+
+		// wait for the asynchronous writes of the application
+		if (asyncServiceTransaction.get() != nullptr) {
+			asyncServiceTransaction->itemCallback() = boost::bind(&AttributeService::writeComplete, this, serviceTransaction, _1, _2, _3);
+			asyncServiceTransaction->timeoutCallback() = boost::bind(&AttributeService::asyncWriteTimeout, this, serviceTransaction, _1);
+			asyncStart(asyncServiceTransaction);
+			return;
+		}
+
 		serviceTransaction->statusCode(Success);
 		serviceTransaction->componentSession()->send(serviceTransaction);
 	}
@@ -385,7 +675,9 @@ namespace OpcUaStackServer
 
 	OpcUaStatusCode
 	AttributeService::forwardWrite(
-		UserContext::SPtr& userContext,
+		ServiceTransaction::SPtr& serviceTransaction,
+		AsyncServiceTransaction::SPtr& asyncServiceTransaction,
+		uint32_t idx,
 		BaseNodeClass::SPtr baseNodeClass,
 		WriteRequest::SPtr writeRequest,
 		WriteValue::SPtr writeValue
@@ -403,13 +695,201 @@ namespace OpcUaStackServer
 		writeValue->dataValue().copyTo(applicationWriteContext.dataValue_);
 		applicationWriteContext.statusCode_ = Success;
 		applicationWriteContext.applicationContext_ = forwardNodeSync->writeService().applicationContext();
-		applicationWriteContext.userContext_ = userContext;
+		applicationWriteContext.userContext_ = serviceTransaction->userContext();
+		applicationWriteContext.completionFactory_ = boost::bind(
+			&AttributeService::asyncCompletion,
+			this,
+			boost::ref(asyncServiceTransaction),
+			boost::ref(serviceTransaction),
+			writeRequest->writeValueArray()->size(),
+			idx
+		);
 
 		forwardNodeSync->writeService().callback()(&applicationWriteContext);
 
+		// the application completes the write later
+		if (applicationWriteContext.completion_.get() != nullptr) return GoodCompletesAsynchronously;
+
 		return applicationWriteContext.statusCode_;
 	}
 
+	bool
+	AttributeService::isWriteBatch(BaseNodeClass::SPtr& baseNodeClass, WriteValue::SPtr& writeValue, CallbackBase*& callbackBase)
+	{
+		if ((AttributeId)writeValue->attributeId() != AttributeId_Value) return false;
+
+		ForwardNodeSync::SPtr forwardNodeSync = baseNodeClass->forwardNodeSync();
+		if (forwardNodeSync.get() == nullptr) return false;
+		if (!forwardNodeSync->writeBatchService().isCallback()) return false;
+
+		callbackBase = forwardNodeSync->writeBatchService().callback().callbackBase();
+		return true;
+	}
+
+	void
+	AttributeService::forwardWriteBatch(
+		ServiceTransaction::SPtr& serviceTransaction,
+		AsyncServiceTransaction::SPtr& asyncServiceTransaction,
+		WriteBatchItemVec& writeBatchItemVec
+	)
+	{
+		ServiceTransactionWrite::SPtr trx = boost::static_pointer_cast<ServiceTransactionWrite>(serviceTransaction);
+		WriteRequest::SPtr writeRequest = trx->request();
+
+		ForwardNodeSync::SPtr forwardNodeSync = writeBatchItemVec[0].second->forwardNodeSync();
+		Callback callback = forwardNodeSync->writeBatchService().callback();
+
+		ApplicationWriteBatchContext applicationWriteBatchContext;
+		applicationWriteBatchContext.applicationContext_ = forwardNodeSync->writeBatchService().applicationContext();
+		applicationWriteBatchContext.userContext_ = serviceTransaction->userContext();
+		applicationWriteBatchContext.writeContextVec_.resize(writeBatchItemVec.size());
+
+		for (uint32_t pos = 0; pos < writeBatchItemVec.size(); pos++) {
+			uint32_t idx = writeBatchItemVec[pos].first;
+			BaseNodeClass::SPtr& baseNodeClass = writeBatchItemVec[pos].second;
+
+			WriteValue::SPtr writeValue;
+			writeRequest->writeValueArray()->get(idx, writeValue);
+
+			ApplicationWriteContext& applicationWriteContext = applicationWriteBatchContext.writeContextVec_[pos];
+			applicationWriteContext.nodeId_ = *writeValue->nodeId();
+			applicationWriteContext.attributeId_ = writeValue->attributeId();
+			writeValue->dataValue().copyTo(applicationWriteContext.dataValue_);
+			applicationWriteContext.statusCode_ = Success;
+			applicationWriteContext.applicationContext_ = baseNodeClass->forwardNodeSync()->writeBatchService().applicationContext();
+			applicationWriteContext.userContext_ = serviceTransaction->userContext();
+			applicationWriteContext.completionFactory_ = boost::bind(
+				&AttributeService::asyncCompletion,
+				this,
+				boost::ref(asyncServiceTransaction),
+				boost::ref(serviceTransaction),
+				writeRequest->writeValueArray()->size(),
+				idx
+			);
+		}
+
+		Log(Debug, "forward batch write")
+			.parameter("Trx", serviceTransaction->transactionId())
+			.parameter("NumberNodes", writeBatchItemVec.size());
+
+		callback(&applicationWriteBatchContext);
+
+		// the status code of each item is the result of the item. The value
+		// of a successful item is written into the node
+		for (uint32_t pos = 0; pos < writeBatchItemVec.size(); pos++) {
+			uint32_t idx = writeBatchItemVec[pos].first;
+			ApplicationWriteContext& applicationWriteContext = applicationWriteBatchContext.writeContextVec_[pos];
+
+			// the application completes the write later
+			if (applicationWriteContext.completion_.get() != nullptr) continue;
+
+			writeComplete(serviceTransaction, idx, applicationWriteContext.statusCode_, applicationWriteContext.dataValue_);
+		}
+	}
+
+	void
+	AttributeService::writeComplete(
+		ServiceTransaction::SPtr serviceTransaction,
+		uint32_t idx,
+		OpcUaStatusCode statusCode,
+		OpcUaDataValue& dataValue
+	)
+	{
+		ServiceTransactionWrite::SPtr trx = boost::static_pointer_cast<ServiceTransactionWrite>(serviceTransaction);
+		WriteResponse::SPtr writeResponse = trx->response();
+
+		if (statusCode != Success) {
+			writeResponse->results()->set(idx, statusCode);
+			Log(Debug, "write value error, because invalid status code from library")
+				.parameter("Trx", serviceTransaction->transactionId())
+				.parameter("Idx", idx)
+				.parameter("StatusCode", OpcUaStatusCodeMap::shortString(statusCode));
+			return;
+		}
+
+		WriteValue::SPtr writeValue;
+		trx->request()->writeValueArray()->get(idx, writeValue);
+
+		BaseNodeClass::SPtr baseNodeClass = informationModel_->find(writeValue->nodeId());
+		if (baseNodeClass.get() == nullptr) {
+			writeResponse->results()->set(idx, BadNodeIdUnknown);
+			return;
+		}
+
+		boost::unique_lock<boost::shared_mutex> lock(baseNodeClass->mutex());
+
+		Attribute* attribute = baseNodeClass->attribute((AttributeId)writeValue->attributeId());
+		if (attribute == nullptr || !AttributeAccess::copy(writeValue->dataValue(), *attribute)) {
+			writeResponse->results()->set(idx, BadAttributeIdInvalid);
+			return;
+		}
+
+		Log(Debug, "write value")
+			.parameter("Trx", serviceTransaction->transactionId())
+			.parameter("Idx", idx)
+			.parameter("Node", *writeValue->nodeId())
+			.parameter("Attr", writeValue->attributeId())
+			.parameter("Class", baseNodeClass->nodeClass().data())
+			.parameter("Data", writeValue->dataValue());
+
+		writeResponse->results()->set(idx, Success);
+	}
+
+	void
+	AttributeService::asyncWriteTimeout(ServiceTransaction::SPtr serviceTransaction, uint32_t idx)
+	{
+		ServiceTransactionWrite::SPtr trx = boost::static_pointer_cast<ServiceTransactionWrite>(serviceTransaction);
+		trx->response()->results()->set(idx, BadTimeout);
+
+		Log(Debug, "write value error, because application write timeout")
+			.parameter("Trx", serviceTransaction->transactionId())
+			.parameter("Idx", idx);
+	}
+
+	// ------------------------------------------------------------------------
+	// ------------------------------------------------------------------------
+	//
+	// asynchronous read and write
+	//
+	// ------------------------------------------------------------------------
+	// ------------------------------------------------------------------------
+	ApplicationCompletion::SPtr
+	AttributeService::asyncCompletion(
+		AsyncServiceTransaction::SPtr& asyncServiceTransaction,
+		ServiceTransaction::SPtr& serviceTransaction,
+		uint32_t numberItems,
+		uint32_t idx
+	)
+	{
+		if (asyncServiceTransaction.get() == nullptr) {
+			asyncServiceTransaction = constructSPtr<AsyncServiceTransaction>(serviceTransaction, numberItems);
+		}
+		return asyncServiceTransaction->completion(idx);
+	}
+
+	void
+	AttributeService::asyncStart(AsyncServiceTransaction::SPtr& asyncServiceTransaction)
+	{
+		ServiceTransaction::SPtr serviceTransaction = asyncServiceTransaction->serviceTransaction();
+		asyncServiceTransaction->finishCallback() = boost::bind(&AttributeService::asyncFinish, this, serviceTransaction);
+
+		// the response is sent when all operations are completed or when the
+		// timeout hint of the request expires (0 = no timeout)
+		SlotTimer::SPtr slotTimer;
+		if (ioThread() != nullptr) slotTimer = ioThread()->slotTimer();
+		asyncServiceTransaction->start(slotTimer, serviceTransaction->requestHeader()->timeoutHint());
+	}
+
+	void
+	AttributeService::asyncFinish(ServiceTransaction::SPtr serviceTransaction)
+	{
+		Log(Debug, "attribute service asynchronous request finished")
+			.parameter("Trx", serviceTransaction->transactionId());
+
+		serviceTransaction->statusCode(Success);
+		serviceTransaction->componentSession()->send(serviceTransaction);
+	}
+
 	// ------------------------------------------------------------------------
 	// ------------------------------------------------------------------------
 	//
@@ -431,6 +911,12 @@ namespace OpcUaStackServer
 			.parameter("NumberNodes", readRequest->nodesToRead()->size());
 
 		// check timestampsToReturn attribute
+		if (readRequest->timestampsToReturn() < TimestampsToReturn_Source ||
+			readRequest->timestampsToReturn() > TimestampsToReturn_Neither) {
+			trx->statusCode(BadTimestampsToReturnInvalid);
+			trx->componentSession()->send(serviceTransaction);
+			return;
+		}
 		if (readRequest->timestampsToReturn() == TimestampsToReturn_Neither) {
 			trx->statusCode(BadInvalidTimestampArgument);
 			trx->componentSession()->send(serviceTransaction);
@@ -588,6 +1074,10 @@ namespace OpcUaStackServer
 			readResult->historyData()->parameterTypeId().set((OpcUaUInt32)OpcUaId_HistoryData_Encoding_DefaultBinary);
 			historyData = readResult->historyData()->parameter<HistoryData>();
 			historyData->dataValues(applicationReadContext.dataValueArray_);
+
+			// the data values can be shared with the application. The
+			// timestamps are removed when the history data is encoded
+			historyData->timestampsToReturn(readRequest->timestampsToReturn());
 		}
 
 		trx->statusCode(Success);
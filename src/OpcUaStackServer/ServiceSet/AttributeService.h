@@ -25,6 +25,7 @@
 #include "OpcUaStackCore/ServiceSet/ReadRawModifiedDetails.h"
 #include "OpcUaStackCore/ServiceSet/UpdateStructureDataDetails.h"
 #include "OpcUaStackServer/ServiceSet/ServiceSetBase.h"
+#include "OpcUaStackServer/ServiceSet/AsyncServiceTransaction.h"
 
 using namespace OpcUaStackCore;
 
@@ -46,21 +47,63 @@ namespace OpcUaStackServer
 		//- Component -----------------------------------------------------------------
 
 	  private:
+		typedef std::vector<std::pair<uint32_t, BaseNodeClass::SPtr> > ReadBatchItemVec;
+		typedef std::map<CallbackBase*, ReadBatchItemVec> ReadBatchMap;
+		typedef std::vector<std::pair<uint32_t, BaseNodeClass::SPtr> > WriteBatchItemVec;
+		typedef std::map<CallbackBase*, WriteBatchItemVec> WriteBatchMap;
+
 		void receiveReadRequest(ServiceTransaction::SPtr serviceTransaction);
-		void forwardRead(
-			UserContext::SPtr& userContext,
+		bool readCache(BaseNodeClass::SPtr& baseNodeClass, ReadValueId::SPtr& readValueId, OpcUaDouble maxAge);
+		void readCacheUpdate(BaseNodeClass::SPtr& baseNodeClass, OpcUaDataValue& dataValue);
+		bool isReadBatch(BaseNodeClass::SPtr& baseNodeClass, ReadValueId::SPtr& readValueId, CallbackBase*& callbackBase);
+		void forwardReadBatch(
+			ServiceTransaction::SPtr& serviceTransaction,
+			AsyncServiceTransaction::SPtr& asyncServiceTransaction,
+			ReadBatchItemVec& readBatchItemVec
+		);
+		bool forwardRead(
+			ServiceTransaction::SPtr& serviceTransaction,
+			AsyncServiceTransaction::SPtr& asyncServiceTransaction,
+			uint32_t idx,
 			BaseNodeClass::SPtr baseNodeClass,
 			ReadRequest::SPtr readRequest,
 			ReadValueId::SPtr readValueId
 		);
+		void readValue(
+			ServiceTransaction::SPtr& serviceTransaction,
+			uint32_t idx,
+			BaseNodeClass::SPtr& baseNodeClass,
+			ReadValueId::SPtr& readValueId,
+			OpcUaDataValue::SPtr& dataValue
+		);
+		void asyncReadComplete(ServiceTransaction::SPtr serviceTransaction, uint32_t idx, OpcUaStatusCode statusCode, OpcUaDataValue& dataValue);
+		void asyncReadTimeout(ServiceTransaction::SPtr serviceTransaction, uint32_t idx);
 		OpcUaStatusCode forwardAuthorizationRead(UserContext::SPtr& userContext, ReadValueId::SPtr& readValueId);
 		void receiveWriteRequest(ServiceTransaction::SPtr serviceTransaction);
 		OpcUaStatusCode forwardWrite(
-			UserContext::SPtr& userContext,
+			ServiceTransaction::SPtr& serviceTransaction,
+			AsyncServiceTransaction::SPtr& asyncServiceTransaction,
+			uint32_t idx,
 			BaseNodeClass::SPtr baseNodeClass,
 			WriteRequest::SPtr writeRequest,
 			WriteValue::SPtr writeValue
 		);
+		bool isWriteBatch(BaseNodeClass::SPtr& baseNodeClass, WriteValue::SPtr& writeValue, CallbackBase*& callbackBase);
+		void forwardWriteBatch(
+			ServiceTransaction::SPtr& serviceTransaction,
+			AsyncServiceTransaction::SPtr& asyncServiceTransaction,
+			WriteBatchItemVec& writeBatchItemVec
+		);
+		void writeComplete(ServiceTransaction::SPtr serviceTransaction, uint32_t idx, OpcUaStatusCode statusCode, OpcUaDataValue& dataValue);
+		void asyncWriteTimeout(ServiceTransaction::SPtr serviceTransaction, uint32_t idx);
+		ApplicationCompletion::SPtr asyncCompletion(
+			AsyncServiceTransaction::SPtr& asyncServiceTransaction,
+			ServiceTransaction::SPtr& serviceTransaction,
+			uint32_t numberItems,
+			uint32_t idx
+		);
+		void asyncStart(AsyncServiceTransaction::SPtr& asyncServiceTransaction);
+		void asyncFinish(ServiceTransaction::SPtr serviceTransaction);
 		OpcUaStatusCode forwardAuthorizationWrite(UserContext::SPtr& userContext, WriteValue::SPtr& writeValue);
 		void receiveHistoryReadRequest(ServiceTransaction::SPtr serviceTransaction);
 		void receiveHistoryReadRawRequest(
@@ -24,6 +24,7 @@ namespace OpcUaStackServer
 	: secureChannelState_(SCS_Invalid)
 	, secureChannel_(nullptr)
 	, secureChannelServer_()
+	, strand_()
 	, sessionState_(SS_Invalid)
 	, session_()
 	{
@@ -36,30 +37,39 @@ namespace OpcUaStackServer
 	ChannelSessionHandle::SecureChannelState
 	ChannelSessionHandle::secureChannelState(void)
 	{
+		boost::mutex::scoped_lock g(mutex_);
 		return secureChannelState_;
 	}
 
 	bool
 	ChannelSessionHandle::secureChannelIsValid(void)
 	{
+		boost::mutex::scoped_lock g(mutex_);
 		return secureChannelState_ == SCS_Valid;
 	}
 
 	void
 	ChannelSessionHandle::secureChannel(SecureChannel* secureChannel)
 	{
+		boost::mutex::scoped_lock g(mutex_);
 		secureChannel_ = secureChannel;
 		if (secureChannel == nullptr) {
 			secureChannelState_ = SCS_Invalid;
 		}
 		else {
 			secureChannelState_ = SCS_Valid;
+
+			// the strand survives the secure channel. Responses which are
+			// completed after the channel has been closed are still
+			// serialized with the channel handlers
+			strand_ = secureChannel->strand();
 		}
 	}
 
 	SecureChannel*
 	ChannelSessionHandle::secureChannel(void)
 	{
+		boost::mutex::scoped_lock g(mutex_);
 		return secureChannel_;
 	}
 
@@ -75,21 +85,31 @@ namespace OpcUaStackServer
 		return secureChannelServer_;
 	}
 
+	TCPConnection::StrandSPtr
+	ChannelSessionHandle::strand(void)
+	{
+		boost::mutex::scoped_lock g(mutex_);
+		return strand_;
+	}
+
 	ChannelSessionHandle::SessionState
 	ChannelSessionHandle::sessionState(void)
 	{
+		boost::mutex::scoped_lock g(mutex_);
 		return sessionState_;
 	}
 
 	bool
 	ChannelSessionHandle::sessionIsValid(void)
 	{
+		boost::mutex::scoped_lock g(mutex_);
 		return sessionState_ == SS_Valid;
 	}
 
 	void
 	ChannelSessionHandle::session(Session::SPtr& session)
 	{
+		boost::mutex::scoped_lock g(mutex_);
 		session_ = session;
 		if (session_.get() == nullptr) {
 			sessionState_ = SS_Invalid;
@@ -99,9 +119,10 @@ namespace OpcUaStackServer
 		}
 	}
 
-	Session::SPtr&
+	Session::SPtr
 	ChannelSessionHandle::session(void)
 	{
+		boost::mutex::scoped_lock g(mutex_);
 		return session_;
 	}
 
@@ -18,7 +18,9 @@
 #ifndef __OpcUaStackServer_ChannelSessionHandle_h__
 #define __OpcUaStackServer_ChannelSessionHandle_h__
 
+#include <vector>
 #include <boost/shared_ptr.hpp>
+#include <boost/thread/mutex.hpp>
 #include "OpcUaStackCore/Base/os.h"
 #include "OpcUaStackCore/SecureChannel/SecureChannelServer.h"
 #include "OpcUaStackServer/ServiceSet/Session.h"
@@ -35,6 +37,7 @@ namespace OpcUaStackServer
 
 		typedef boost::shared_ptr<ChannelSessionHandle> SPtr;
 		typedef std::map<uint32_t,ChannelSessionHandle::SPtr> Map;
+		typedef std::vector<ChannelSessionHandle::SPtr> Vec;
 
 		typedef enum
 		{
@@ -57,20 +60,26 @@ namespace OpcUaStackServer
 		SecureChannel* secureChannel(void);
 		void secureChannelServer(SecureChannelServer::SPtr& secureChannelServer);
 		SecureChannelServer::SPtr& secureChannelServer(void);
+		TCPConnection::StrandSPtr strand(void);
 
 		SessionState sessionState(void);
 		bool sessionIsValid(void);
 		void session(Session::SPtr& session);
-		Session::SPtr& session(void);
+		Session::SPtr session(void);
 
 
 	  private:
 		SecureChannelState secureChannelState_;
 		SecureChannel* secureChannel_;
 		SecureChannelServer::SPtr secureChannelServer_;
+		TCPConnection::StrandSPtr strand_;
 
 		SessionState sessionState_;
 		Session::SPtr session_;
+
+		// the handle is used by the io threads of the channel and by the
+		// threads of the service components
+		boost::mutex mutex_;
 	};
 
 }
@@ -21,7 +21,8 @@ namespace OpcUaStackServer
 {
 
 	ChannelSessionHandleMap::ChannelSessionHandleMap(void)
-	: channelIdMap_()
+	: mutex_()
+	, channelIdMap_()
 	, sessionMap_()
 	{
 	}
@@ -35,6 +36,8 @@ namespace OpcUaStackServer
 		SecureChannelServer::SPtr& secureChannelServer,
 		SecureChannel* secureChannel)
 	{
+		boost::mutex::scoped_lock g(mutex_);
+
 		// create new channel session handle
 		ChannelSessionHandle::SPtr channelSessionHandle = constructSPtr<ChannelSessionHandle>();
 		channelSessionHandle->secureChannel(secureChannel);
@@ -49,6 +52,8 @@ namespace OpcUaStackServer
 	void
 	ChannelSessionHandleMap::deleteSecureChannel(SecureChannel* secureChannel)
 	{
+		boost::mutex::scoped_lock g(mutex_);
+
 		// find secure channel
 		ChannelSessionHandle::Map::iterator it;
 		it = channelIdMap_.find(secureChannel->channelId_);
@@ -63,13 +68,16 @@ namespace OpcUaStackServer
 	}
 
 	void
-	ChannelSessionHandleMap::getSecureChannelList(std::vector<SecureChannel*>& secureChannelList)
+	ChannelSessionHandleMap::getSecureChannelList(ChannelSessionHandle::Vec& channelSessionHandleVec)
 	{
-		// get all secure channel
+		boost::mutex::scoped_lock g(mutex_);
+
+		// get the handles of all secure channels. The secure channel itself
+		// may only be used in the strand of the channel
 		ChannelSessionHandle::Map::iterator it;
 		for (it = channelIdMap_.begin(); it != channelIdMap_.end(); it++) {
 			if (it->second->secureChannelState() == ChannelSessionHandle::SCS_Valid) {
-				secureChannelList.push_back(it->second->secureChannel());
+				channelSessionHandleVec.push_back(it->second);
 			}
 		}
 	}
@@ -77,12 +85,16 @@ namespace OpcUaStackServer
 	uint32_t
 	ChannelSessionHandleMap::secureChannelSize(void)
 	{
+		boost::mutex::scoped_lock g(mutex_);
+
 		return channelIdMap_.size();
 	}
 
 	ChannelSessionHandle::SPtr
 	ChannelSessionHandleMap::createSession(Session::SPtr& session, SecureChannel* secureChannel)
 	{
+		boost::mutex::scoped_lock g(mutex_);
+
 		ChannelSessionHandle::SPtr channelSessionHandle;
 
 		// find secure channel
@@ -109,6 +121,8 @@ namespace OpcUaStackServer
 	void
 	ChannelSessionHandleMap::deleteSession(uint32_t authenticationToken)
 	{
+		boost::mutex::scoped_lock g(mutex_);
+
 		// find session
 		ChannelSessionHandle::Map::iterator it;
 		it = sessionMap_.find(authenticationToken);
@@ -126,6 +140,8 @@ namespace OpcUaStackServer
 	uint32_t
 	ChannelSessionHandleMap::sessionSize(void)
 	{
+		boost::mutex::scoped_lock g(mutex_);
+
 		return sessionMap_.size();
 	}
 
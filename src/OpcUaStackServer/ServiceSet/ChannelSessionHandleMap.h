@@ -19,6 +19,7 @@
 #define __OpcUaStackServer_ChannelSessionHandleMap_h__
 
 #include <boost/shared_ptr.hpp>
+#include <boost/thread/mutex.hpp>
 #include "OpcUaStackCore/Base/os.h"
 #include "OpcUaStackServer/ServiceSet/ChannelSessionHandle.h"
 
@@ -39,7 +40,7 @@ namespace OpcUaStackServer
 			SecureChannel* secureChannel
 		);
 		void deleteSecureChannel(SecureChannel* secureChannel);
-		void getSecureChannelList(std::vector<SecureChannel*>& secureChannelList);
+		void getSecureChannelList(ChannelSessionHandle::Vec& channelSessionHandleVec);
 		uint32_t secureChannelSize(void);
 
 		ChannelSessionHandle::SPtr createSession(Session::SPtr& session, SecureChannel* secureChannel);
@@ -48,6 +49,7 @@ namespace OpcUaStackServer
 		uint32_t sessionSize(void);
 
 	  private:
+		boost::mutex mutex_;
 		ChannelSessionHandle::Map channelIdMap_;
 		ChannelSessionHandle::Map sessionMap_;
 	};
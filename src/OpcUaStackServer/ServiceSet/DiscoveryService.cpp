@@ -15,6 +15,7 @@
    Autor: Kai Huebl (kai@huebl-sgh.de)
  */
 
+#include <sstream>
 #include "OpcUaStackCore/BuildInTypes/OpcUaIdentifier.h"
 #include "OpcUaStackCore/Base/Log.h"
 #include "OpcUaStackCore/SecureChannel/RequestHeader.h"
@@ -31,9 +32,13 @@ namespace OpcUaStackServer
 {
 
 	DiscoveryService::DiscoveryService(void)
-	: discoveryIf_(nullptr)
-	, applicationCertificate_(nullptr)
+	: endpointCacheMutex_()
+	, endpointCache_()
+	, endpointCacheHits_(0)
+	, endpointCacheMisses_(0)
 	, endpointDescriptionArray_()
+	, applicationCertificate_(nullptr)
+	, discoveryIf_(nullptr)
 	{
 	}
 
@@ -56,6 +61,7 @@ namespace OpcUaStackServer
 
 		endpointDescriptionArray_ = constructSPtr<EndpointDescriptionArray>();
 		endpointDescriptionSet->getEndpoints(endpointDescriptionArray_);
+		invalidateEndpointCache();
 	}
 
 	void
@@ -66,6 +72,7 @@ namespace OpcUaStackServer
 		assert(applicationCertificate.get() != nullptr);
 
 		applicationCertificate_ = applicationCertificate;
+		invalidateEndpointCache();
 
 		if (!applicationCertificate_->enable()) {
 			return;
@@ -96,6 +103,57 @@ namespace OpcUaStackServer
 		delete [] certBuf;
 	}
 
+	void
+	DiscoveryService::invalidateEndpointCache(void)
+	{
+		boost::mutex::scoped_lock g(endpointCacheMutex_);
+		endpointCache_.reset();
+	}
+
+	uint32_t
+	DiscoveryService::endpointCacheHits(void)
+	{
+		boost::mutex::scoped_lock g(endpointCacheMutex_);
+		return endpointCacheHits_;
+	}
+
+	uint32_t
+	DiscoveryService::endpointCacheMisses(void)
+	{
+		boost::mutex::scoped_lock g(endpointCacheMutex_);
+		return endpointCacheMisses_;
+	}
+
+	DiscoveryService::EncodedEndpoints
+	DiscoveryService::encodedEndpoints(void)
+	{
+		//
+		// the endpoint array contains the server certificate and is the same
+		// for each request. It is encoded only once and the cache is cleared
+		// if the endpoints or the certificate changes. The encoded endpoints
+		// are shared by all responses and are never changed.
+		//
+		{
+			boost::mutex::scoped_lock g(endpointCacheMutex_);
+			if (endpointCache_.get() != nullptr) {
+				endpointCacheHits_++;
+				return endpointCache_;
+			}
+			endpointCacheMisses_++;
+		}
+
+		GetEndpointsResponse getEndpointsResponse;
+		getEndpointsResponse.endpoints(endpointDescriptionArray_);
+
+		std::stringstream ss;
+		getEndpointsResponse.opcUaBinaryEncode(ss);
+		EncodedEndpoints encodedEndpoints(new std::string(ss.str()));
+
+		boost::mutex::scoped_lock g(endpointCacheMutex_);
+		endpointCache_ = encodedEndpoints;
+		return encodedEndpoints;
+	}
+
 	void
 	DiscoveryService::getEndpointRequest(
 		RequestHeader::SPtr requestHeader,
@@ -123,12 +181,13 @@ namespace OpcUaStackServer
 		ResponseHeader responseHeader;
 		GetEndpointsResponse getEndpointsResponse;
 
+		EncodedEndpoints endpoints = encodedEndpoints();
+
 		responseHeader.requestHandle(requestHeader->requestHandle());
 		responseHeader.serviceResult(Success);
-		getEndpointsResponse.endpoints(endpointDescriptionArray_);
 
 		responseHeader.opcUaBinaryEncode(os);
-		getEndpointsResponse.opcUaBinaryEncode(os);
+		os.write(endpoints->c_str(), endpoints->size());
 
 		if (discoveryIf_ != nullptr) {
 			ResponseHeader::SPtr responseHeader = getEndpointsResponse.responseHeader();
@@ -18,6 +18,7 @@
 #ifndef __OpcUaStackServer_DiscoveryService_h__
 #define __OpcUaStackServer_DiscoveryService_h__
 
+#include <boost/thread/mutex.hpp>
 #include "OpcUaStackCore/Base/os.h"
 #include "OpcUaStackCore/Base/ObjectPool.h"
 #include "OpcUaStackCore/Certificate/ApplicationCertificate.h"
@@ -46,6 +47,9 @@ namespace OpcUaStackServer
 		void discoveryIf(DiscoveryIf* discoveryIf);
 		void endpointDescriptionSet(EndpointDescriptionSet::SPtr& endpointDescriptionSet);
 		void applicationCertificate(ApplicationCertificate::SPtr& applicationCertificate);
+		void invalidateEndpointCache(void);
+		uint32_t endpointCacheHits(void);
+		uint32_t endpointCacheMisses(void);
 
 		void getEndpointRequest(
 			RequestHeader::SPtr requestHeader,
@@ -65,6 +69,15 @@ namespace OpcUaStackServer
 		//- Component -----------------------------------------------------------------
 
 	  private:
+		typedef boost::shared_ptr<const std::string> EncodedEndpoints;
+
+		EncodedEndpoints encodedEndpoints(void);
+
+		boost::mutex endpointCacheMutex_;
+		EncodedEndpoints endpointCache_;
+		uint32_t endpointCacheHits_;
+		uint32_t endpointCacheMisses_;
+
 		EndpointDescriptionArray::SPtr endpointDescriptionArray_;
 		ApplicationCertificate::SPtr applicationCertificate_;
 		DiscoveryIf* discoveryIf_;
@@ -29,6 +29,7 @@ namespace OpcUaStackServer
 	, queSize_(0)
 	, discardOldest_(false)
 	, clientHandle_(0)
+	, timestampsToReturn_(TimestampsToReturn_Both)
 	, monitorItemList_()
 	, baseNodeClass_()
 	, attribute_(nullptr)
@@ -91,6 +92,18 @@ namespace OpcUaStackServer
 		return userContext_;
 	}
 
+	void
+	MonitorItem::timestampsToReturn(TimestampsToReturn timestampsToReturn)
+	{
+		timestampsToReturn_ = timestampsToReturn;
+	}
+
+	TimestampsToReturn
+	MonitorItem::timestampsToReturn(void)
+	{
+		return timestampsToReturn_;
+	}
+
 	uint32_t 
 	MonitorItem::size(void)
 	{
@@ -222,6 +235,7 @@ namespace OpcUaStackServer
 		}
 
 		monitoredItemNotification->clientHandle(clientHandle_);
+		monitoredItemNotification->dataValue().timestampsToReturn(timestampsToReturn_);
 		monitorItemList_.push_back(monitoredItemNotification);
 	}
 
@@ -61,6 +61,8 @@ namespace OpcUaStackServer
 		MonitoredItemCreateRequest::SPtr monitoredItemCreateRequest(void);
 		void userContext(UserContext::SPtr& userContext);
 		UserContext::SPtr& userContext(void);
+		void timestampsToReturn(TimestampsToReturn timestampsToReturn);
+		TimestampsToReturn timestampsToReturn(void);
 
 		SampleResult sample(void);
 
@@ -73,6 +75,7 @@ namespace OpcUaStackServer
 		uint32_t queSize_;
 		bool discardOldest_;
 		uint32_t clientHandle_;
+		TimestampsToReturn timestampsToReturn_;
 
 		MonitoredItemCreateRequest::SPtr monitoredItemCreateRequest_;
 		MonitorItemList monitorItemList_;
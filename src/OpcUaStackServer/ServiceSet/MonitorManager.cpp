@@ -39,6 +39,8 @@ namespace OpcUaStackServer
 
 	MonitorManager::~MonitorManager(void)
 	{
+		boost::mutex::scoped_lock g(mutex_);
+
 		//
 		// cleanup monitored item
 		//
@@ -116,6 +118,8 @@ namespace OpcUaStackServer
 	uint32_t 
 	MonitorManager::noticicationNumber(void)
 	{
+		boost::mutex::scoped_lock g(mutex_);
+
 		uint32_t notificationNumber = 0;
 		MonitorItemMap::iterator it;
 		for (it = monitorItemMap_.begin(); it != monitorItemMap_.end(); it++) {
@@ -127,6 +131,8 @@ namespace OpcUaStackServer
 	bool 
 	MonitorManager::notificationAvailable(void)
 	{
+		boost::mutex::scoped_lock g(mutex_);
+
 		MonitorItemMap::iterator it;
 		for (it = monitorItemMap_.begin(); it != monitorItemMap_.end(); it++) {
 			if (it->second->size() > 0) return true;
@@ -137,9 +143,16 @@ namespace OpcUaStackServer
 	OpcUaStatusCode 
 	MonitorManager::receive(ServiceTransactionCreateMonitoredItems::SPtr trx)
 	{
+		boost::mutex::scoped_lock g(mutex_);
+
 		CreateMonitoredItemsRequest::SPtr createMonitorItemRequest = trx->request();
 		CreateMonitoredItemsResponse::SPtr createMonitorItemResponse = trx->response();
 
+		if (createMonitorItemRequest->timestampsToReturn() < TimestampsToReturn_Source ||
+			createMonitorItemRequest->timestampsToReturn() > TimestampsToReturn_Neither) {
+			return BadTimestampsToReturnInvalid;
+		}
+
 		uint32_t size = createMonitorItemRequest->itemsToCreate()->size();
 		createMonitorItemResponse->results()->resize(size);
 
@@ -211,6 +224,7 @@ namespace OpcUaStackServer
 		// create new monitor item
 		MonitorItem::SPtr monitorItem = constructSPtr<MonitorItem>();
 		monitorItem->userContext(serviceTransaction->userContext());
+		monitorItem->timestampsToReturn(createMonitorItemRequest->timestampsToReturn());
 		statusCode = monitorItem->receive(baseNodeClass, monitoredItemCreateRequest);
 
 		if (statusCode != Success) {
@@ -331,6 +345,8 @@ namespace OpcUaStackServer
 	OpcUaStatusCode 
 	MonitorManager::receive(ServiceTransactionDeleteMonitoredItems::SPtr trx)
 	{
+		boost::mutex::scoped_lock g(mutex_);
+
 		DeleteMonitoredItemsRequest::SPtr deleteMonitorItemRequest = trx->request();
 		DeleteMonitoredItemsResponse::SPtr deleteMonitorItemResponse = trx->response();
 
@@ -435,6 +451,16 @@ namespace OpcUaStackServer
 	void 
 	MonitorManager::sampleTimeout(MonitorItem::SPtr monitorItem)
 	{
+		// the sample timer runs in the slot timer thread and not in the
+		// thread of the subscription service
+		boost::mutex::scoped_lock g(mutex_);
+
+		// the timer can expire once more after the monitored item has
+		// been deleted
+		if (monitorItemMap_.find(monitorItem->monitorItemId()) == monitorItemMap_.end()) {
+			return;
+		}
+
 		SampleResult sampleResult = monitorItem->sample();
 		switch (sampleResult)
 		{
@@ -461,6 +487,8 @@ namespace OpcUaStackServer
 	OpcUaStatusCode 
 	MonitorManager::receive(MonitoredItemNotificationArray::SPtr monitoredItemNotificationArray)
 	{
+		boost::mutex::scoped_lock g(mutex_);
+
 		uint32_t numberNotifications = 0;
 		MonitorItemMap::iterator it;
 		for (it = monitorItemMap_.begin(); it != monitorItemMap_.end(); it++) {
@@ -485,6 +513,8 @@ namespace OpcUaStackServer
 	OpcUaStatusCode
 	MonitorManager::receive(EventFieldListArray::SPtr eventFieldListArray)
 	{
+		boost::mutex::scoped_lock g(mutex_);
+
 		uint32_t numberNotifications = 0;
 		EventItem::Map::iterator it;
 		for (it = eventItemMap_.begin(); it != eventItemMap_.end(); it++) {
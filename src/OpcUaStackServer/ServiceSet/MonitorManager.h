@@ -19,6 +19,7 @@
 #define __OpcUaStackServer_MonitorManager_h__
 
 #include <stdint.h>
+#include <boost/thread/mutex.hpp>
 
 #include "OpcUaStackCore/BuildInTypes/OpcUaStatusCode.h"
 #include "OpcUaStackCore/ServiceSet/MonitoredItemServiceTransaction.h"
@@ -96,6 +97,9 @@ namespace OpcUaStackServer
 		ForwardGlobalSync::SPtr forwardGlobalSync_;
 
 		MonitoredItemIds monitoredItemIds_;
+
+		// protects the monitor item map against the sample timer
+		boost::mutex mutex_;
 	};
 
 }
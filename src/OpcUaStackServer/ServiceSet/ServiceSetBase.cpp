@@ -15,6 +15,7 @@
    Autor: Kai Huebl (kai@huebl-sgh.de)
  */
 
+#include "OpcUaStackCore/ServiceSet/ServiceTransaction.h"
 #include "OpcUaStackServer/ServiceSet/ServiceSetBase.h"
 
 namespace OpcUaStackServer
@@ -71,4 +72,14 @@ namespace OpcUaStackServer
 		forwardGlobalSync_ = forwardGlobalSync;
 	}
 
+	void
+	ServiceSetBase::receiveOverload(Message::SPtr message)
+	{
+		// the service worker pool is overloaded. The request is rejected
+		// and the response is sent to the session.
+		ServiceTransaction::SPtr serviceTransaction = boost::static_pointer_cast<ServiceTransaction>(message);
+		serviceTransaction->statusCode(BadTooManyOperations);
+		serviceTransaction->componentSession()->send(serviceTransaction);
+	}
+
 }
@@ -45,6 +45,10 @@ namespace OpcUaStackServer
 		void forwardGlobalSync(ForwardGlobalSync::SPtr forwardGlobalSync);
 		ForwardGlobalSync::SPtr forwardGlobalSync(void);
 
+		//- Component -----------------------------------------------------------------
+		void receiveOverload(Message::SPtr message);
+		//- Component -----------------------------------------------------------------
+
 		virtual bool init(void) { return true; }
 		virtual bool shutdown(void) { return true; }
 
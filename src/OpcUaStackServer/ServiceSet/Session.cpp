@@ -16,6 +16,7 @@
  */
 
 #include "OpcUaStackServer/ServiceSet/Session.h"
+#include "OpcUaStackServer/ServiceSet/ChannelSessionHandle.h"
 #include "OpcUaStackCore/BuildInTypes/OpcUaIdentifier.h"
 #include "OpcUaStackCore/Base/Log.h"
 #include "OpcUaStackCore/Base/MemoryBuffer.h"
@@ -63,16 +64,22 @@ namespace OpcUaStackServer
 
 	Session::Session(void)
 	: Component()
-	, forwardGlobalSync_()
-	, sessionIf_(nullptr)
-	, sessionState_(SessionState_Close)
 	, sessionId_(getUniqueSessionId())
 	, authenticationToken_(getUniqueAuthenticationToken())
-	, applicationCertificate_()
+	, sessionState_(SessionState_Close)
+	, sessionIf_(nullptr)
 	, endpointDescriptionArray_()
 	, endpointDescription_()
-	, userContext_()
+	, applicationCertificate_()
 	, clientCertificate_()
+	, forwardGlobalSync_()
+	, decodePool_()
+	, decodeMinSize_(0)
+	, decodeMutex_()
+	, decodeRequestList_()
+	, decodeRunning_(false)
+	, cryptoPool_()
+	, userContext_()
 	{
 		Log(Info, "session construct")
 			.parameter("SessionId", sessionId_)
@@ -87,6 +94,34 @@ namespace OpcUaStackServer
 			.parameter("AuthenticationToken", authenticationToken_);
 	}
 
+	void
+	Session::sessionState(SessionState sessionState)
+	{
+		boost::mutex::scoped_lock g(sessionMutex_);
+		sessionState_ = sessionState;
+	}
+
+	SessionState
+	Session::sessionState(void)
+	{
+		boost::mutex::scoped_lock g(sessionMutex_);
+		return sessionState_;
+	}
+
+	void
+	Session::userContext(const UserContext::SPtr& userContext)
+	{
+		boost::mutex::scoped_lock g(sessionMutex_);
+		userContext_ = userContext;
+	}
+
+	UserContext::SPtr
+	Session::userContext(void)
+	{
+		boost::mutex::scoped_lock g(sessionMutex_);
+		return userContext_;
+	}
+
 	void
 	Session::createServerNonce(void)
 	{
@@ -107,6 +142,12 @@ namespace OpcUaStackServer
 		cryptoManager_ = cryptoManager;
 	}
 
+	void
+	Session::certificateValidator(CertificateValidator::SPtr& certificateValidator)
+	{
+		certificateValidator_ = certificateValidator;
+	}
+
 	void 
 	Session::transactionManager(TransactionManager::SPtr transactionManagerSPtr)
 	{
@@ -119,6 +160,19 @@ namespace OpcUaStackServer
 		forwardGlobalSync_ = forwardGlobalSync;
 	}
 
+	void
+	Session::decodePool(WorkerPool::SPtr& decodePool, uint32_t decodeMinSize)
+	{
+		decodePool_ = decodePool;
+		decodeMinSize_ = decodeMinSize;
+	}
+
+	void
+	Session::cryptoPool(WorkerPool::SPtr& cryptoPool)
+	{
+		cryptoPool_ = cryptoPool;
+	}
+
 	void
 	Session::sessionIf(SessionIf* sessionIf)
 	{
@@ -157,9 +211,9 @@ namespace OpcUaStackServer
 	// ------------------------------------------------------------------------
 	// ------------------------------------------------------------------------
 	OpcUaStatusCode
-	Session::authentication(ActivateSessionRequest& activateSessionRequest)
+	Session::authentication(ActivateSessionRequest& activateSessionRequest, OpcUaStatusCode tokenStatusCode)
 	{
-		userContext_.reset();
+		userContext(UserContext::SPtr());
 
 		if (forwardGlobalSync_.get() == nullptr) {
 			// no authentication is activated
@@ -189,13 +243,13 @@ namespace OpcUaStackServer
 					return authenticationAnonymous(activateSessionRequest, parameter);
 				}
 				else if (typeId == OpcUaNodeId(OpcUaId_UserNameIdentityToken_Encoding_DefaultBinary)) {
-					return authenticationUserName(activateSessionRequest, parameter);
+					return authenticationIdentityToken(OpcUaId_UserNameIdentityToken_Encoding_DefaultBinary, parameter, tokenStatusCode);
 				}
 				else if (typeId == OpcUaId_X509IdentityToken_Encoding_DefaultBinary) {
-					return authenticationX509(activateSessionRequest, parameter);
+					return authenticationIdentityToken(OpcUaId_X509IdentityToken_Encoding_DefaultBinary, parameter, tokenStatusCode);
 				}
 				else if (typeId == OpcUaId_IssuedIdentityToken_Encoding_DefaultBinary) {
-					return authenticationIssued(activateSessionRequest, parameter);
+					return authenticationIdentityToken(OpcUaId_IssuedIdentityToken_Encoding_DefaultBinary, parameter, tokenStatusCode);
 				}
 				else {
 					// user identity token is invalid
@@ -215,13 +269,13 @@ namespace OpcUaStackServer
 		ApplicationCloseSessionContext context;
 		context.sessionId_ = sessionId_;
 		context.statusCode_ = Success;
-		context.userContext_ = userContext_;
+		context.userContext_ = userContext();
 
 		if (forwardGlobalSync_->closeSessionService().isCallback()) {
 			forwardGlobalSync_->closeSessionService().callback()(&context);
 		}
 
-		userContext_.reset();
+		userContext(UserContext::SPtr());
 		return context.statusCode_;
 	}
 
@@ -255,17 +309,76 @@ namespace OpcUaStackServer
 		forwardGlobalSync_->authenticationService().callback()(&context);
 
 		if (context.statusCode_ == Success) {
-			userContext_ = context.userContext_;
+			userContext(context.userContext_);
+		}
+
+		return context.statusCode_;
+	}
+
+	OpcUaStatusCode
+	Session::authenticationIdentityToken(uint32_t authenticationType, ExtensibleParameter::SPtr& parameter, OpcUaStatusCode tokenStatusCode)
+	{
+		Log(Debug, "Session::authenticationIdentityToken");
+
+		// the token has been checked and decrypted before
+		if (tokenStatusCode != Success) {
+			return tokenStatusCode;
+		}
+
+		// create application context
+		ApplicationAuthenticationContext context;
+		context.authenticationType_ = authenticationType;
+		context.parameter_ = parameter;
+		context.sessionId_ = sessionId_;
+		context.statusCode_ = Success;
+		context.userContext_.reset();
+
+		forwardGlobalSync_->authenticationService().callback()(&context);
+
+		if (context.statusCode_ == Success) {
+			userContext(context.userContext_);
 		}
 
 		return context.statusCode_;
 	}
 
 	OpcUaStatusCode
-	Session::authenticationUserName(ActivateSessionRequest& activateSessionRequest, ExtensibleParameter::SPtr& parameter)
+	Session::identityTokenCrypto(ActivateSessionRequest& activateSessionRequest, MemoryBuffer& serverNonce)
+	{
+		if (forwardGlobalSync_.get() == nullptr) {
+			// no authentication is activated
+			return Success;
+		}
+		if (!forwardGlobalSync_->authenticationService().isCallback()) {
+			// no authentication is activated
+			return Success;
+		}
+
+		// an invalid user identity token is rejected by the authentication
+		ExtensibleParameter::SPtr parameter = activateSessionRequest.userIdentityToken();
+		if (parameter.get() == nullptr || !parameter->exist()) {
+			return Success;
+		}
+
+		OpcUaNodeId typeId = parameter->parameterTypeId();
+		if (typeId == OpcUaNodeId(OpcUaId_UserNameIdentityToken_Encoding_DefaultBinary)) {
+			return decryptUserNameToken(parameter, serverNonce);
+		}
+		else if (typeId == OpcUaId_X509IdentityToken_Encoding_DefaultBinary) {
+			return verifyX509Token(activateSessionRequest, parameter);
+		}
+		else if (typeId == OpcUaId_IssuedIdentityToken_Encoding_DefaultBinary) {
+			return decryptIssuedToken(parameter, serverNonce);
+		}
+
+		return Success;
+	}
+
+	OpcUaStatusCode
+	Session::decryptUserNameToken(ExtensibleParameter::SPtr& parameter, MemoryBuffer& serverNonce)
 	{
 		OpcUaStatusCode statusCode;
-		Log(Debug, "Session::authenticationUserName");
+		Log(Debug, "Session::decryptUserNameToken");
 
 		UserNameIdentityToken::SPtr token = parameter->parameter<UserNameIdentityToken>();
 
@@ -290,23 +403,7 @@ namespace OpcUaStackServer
 
 		if (token->encryptionAlgorithm() == "") {
 			// we use a plain password
-
-			// create application context
-			ApplicationAuthenticationContext context;
-			context.authenticationType_ = OpcUaId_UserNameIdentityToken_Encoding_DefaultBinary;
-			context.parameter_ = parameter;
-			context.sessionId_ = sessionId_;
-			context.statusCode_ = Success;
-			context.userContext_.reset();
-
-			// call user name authentication
-			forwardGlobalSync_->authenticationService().callback()(&context);
-
-			if (context.statusCode_ == Success) {
-				userContext_ = context.userContext_;
-			}
-
-			return context.statusCode_;
+			return Success;
 		}
 
 		// get cryption base and check cryption alg
@@ -354,34 +451,20 @@ namespace OpcUaStackServer
 		}
 
 		// check decrypted password and server nonce
-		if (memcmp(serverNonce_, &plainTextBuf[plainTextLen-32] , 32) != 0) {
+		if (memcmp(serverNonce.memBuf(), &plainTextBuf[plainTextLen-32] , 32) != 0) {
 			Log(Debug, "decrypt password server nonce error");
 				return BadIdentityTokenRejected;;
 		}
 		token->password((const OpcUaByte*)&plainTextBuf[4], plainTextLen-36);
 
-		// create application context
-		ApplicationAuthenticationContext context;
-		context.authenticationType_ = OpcUaId_UserNameIdentityToken_Encoding_DefaultBinary;
-		context.parameter_ = parameter;
-		context.sessionId_ = sessionId_;
-		context.statusCode_ = Success;
-		context.userContext_.reset();
-
-		forwardGlobalSync_->authenticationService().callback()(&context);
-
-		if (context.statusCode_ == Success) {
-			userContext_ = context.userContext_;
-		}
-
-		return context.statusCode_;
+		return Success;
 	}
 
 	OpcUaStatusCode
-	Session::authenticationX509(ActivateSessionRequest& activateSessionRequest, ExtensibleParameter::SPtr& parameter)
+	Session::verifyX509Token(ActivateSessionRequest& activateSessionRequest, ExtensibleParameter::SPtr& parameter)
 	{
 		OpcUaStatusCode statusCode;
-		Log(Debug, "Session::authenticationX509");
+		Log(Debug, "Session::verifyX509Token");
 
 		X509IdentityToken::SPtr token = parameter->parameter<X509IdentityToken>();
 
@@ -435,7 +518,15 @@ namespace OpcUaStackServer
 		}
 		PublicKey publicKey = certificate.publicKey();
 
-		// FIXME: certificate must be trusted ...
+		// check if the user certificate is trusted
+		if (certificateValidator_.get() != nullptr) {
+			statusCode = certificateValidator_->validate(certificate);
+			if (statusCode != Success) {
+				Log(Debug, "user certificate validation error")
+					.parameter("StatusCode", OpcUaStatusCodeMap::shortString(statusCode));
+				return BadIdentityTokenRejected;
+			}
+		}
 
 		// validate signature
 		statusCode = userTokenSignature->verifySignature(
@@ -444,28 +535,14 @@ namespace OpcUaStackServer
 			*cryptoBase
 		);
 
-		// create application context
-		ApplicationAuthenticationContext context;
-		context.authenticationType_ = OpcUaId_X509IdentityToken_Encoding_DefaultBinary;
-		context.parameter_ = parameter;
-		context.sessionId_ = sessionId_;
-		context.statusCode_ = Success;
-		context.userContext_.reset();
-
-		forwardGlobalSync_->authenticationService().callback()(&context);
-
-		if (context.statusCode_ == Success) {
-			userContext_ = context.userContext_;
-		}
-
-		return context.statusCode_;
+		return Success;
 	}
 
 	OpcUaStatusCode
-	Session::authenticationIssued(ActivateSessionRequest& activateSessionRequest, ExtensibleParameter::SPtr& parameter)
+	Session::decryptIssuedToken(ExtensibleParameter::SPtr& parameter, MemoryBuffer& serverNonce)
 	{
 		OpcUaStatusCode statusCode;
-		Log(Debug, "Session::authenticationIssued");
+		Log(Debug, "Session::decryptIssuedToken");
 
 		IssuedIdentityToken::SPtr token = parameter->parameter<IssuedIdentityToken>();
 
@@ -532,27 +609,13 @@ namespace OpcUaStackServer
 		}
 
 		// check decrypted password and server nonce
-		if (memcmp(serverNonce_, &plainTextBuf[plainTextLen-32] , 32) != 0) {
+		if (memcmp(serverNonce.memBuf(), &plainTextBuf[plainTextLen-32] , 32) != 0) {
 			Log(Debug, "decrypt token data server nonce error");
 				return BadIdentityTokenRejected;;
 		}
 		token->tokenData((const OpcUaByte*)&plainTextBuf[4], plainTextLen-36);
 
-		// create application context
-		ApplicationAuthenticationContext context;
-		context.authenticationType_ = OpcUaId_IssuedIdentityToken_Encoding_DefaultBinary;
-		context.parameter_ = parameter;
-		context.sessionId_ = sessionId_;
-		context.statusCode_ = Success;
-		context.userContext_.reset();
-
-		forwardGlobalSync_->authenticationService().callback()(&context);
-
-		if (context.statusCode_ == Success) {
-			userContext_ = context.userContext_;
-		}
-
-		return context.statusCode_;
+		return Success;
 	}
 
 	OpcUaStatusCode
@@ -613,73 +676,149 @@ namespace OpcUaStackServer
 	{
 		createServerNonce();
 
-		OpcUaStatusCode statusCode;
 		OpcUaStatusCode serviceResult = Success;
 
 		Log(Debug, "receive create session request");
 		secureChannelTransaction->responseTypeNodeId_ = OpcUaId_CreateSessionResponse_Encoding_DefaultBinary;
 
-		if (sessionState_ != SessionState_Close) {
+		if (sessionState() != SessionState_Close) {
 			Log(Error, "receive create session request in invalid state")
-				.parameter("SessionState", sessionState_);
+				.parameter("SessionState", sessionState());
 			// FIXME: handle error ...
 		}
 
 		std::iostream ios(&secureChannelTransaction->is_);
-		CreateSessionRequest createSessionRequest;
-		createSessionRequest.opcUaBinaryDecode(ios);
-
-		std::iostream iosres(&secureChannelTransaction->os_);
+		CreateSessionRequest::SPtr createSessionRequest = constructSPtr<CreateSessionRequest>();
+		createSessionRequest->opcUaBinaryDecode(ios);
 
-		CreateSessionResponse createSessionResponse;
-		createSessionResponse.responseHeader()->requestHandle(requestHeader->requestHandle());
-		createSessionResponse.responseHeader()->serviceResult(serviceResult);
+		CreateSessionResponse::SPtr createSessionResponse = constructSPtr<CreateSessionResponse>();
+		createSessionResponse->responseHeader()->requestHandle(requestHeader->requestHandle());
+		createSessionResponse->responseHeader()->serviceResult(serviceResult);
 
-		if (createSessionRequest.clientCertificate().exist()) {
+		if (createSessionRequest->clientCertificate().exist()) {
 			clientCertificate_.fromDERBuf(
-				createSessionRequest.clientCertificate().memBuf(),
-				createSessionRequest.clientCertificate().size()
+				createSessionRequest->clientCertificate().memBuf(),
+				createSessionRequest->clientCertificate().size()
 			);
 		}
 
-		createSessionResponse.sessionId().namespaceIndex(1);
-		createSessionResponse.sessionId().nodeId(sessionId_);
-		createSessionResponse.authenticationToken().namespaceIndex(1);
-		createSessionResponse.authenticationToken().nodeId(authenticationToken_);
-		createSessionResponse.receivedSessionTimeout(120000);
-		createSessionResponse.serverEndpoints(endpointDescriptionArray_);
-		createSessionResponse.maxRequestMessageSize(0);
+		createSessionResponse->sessionId().namespaceIndex(1);
+		createSessionResponse->sessionId().nodeId(sessionId_);
+		createSessionResponse->authenticationToken().namespaceIndex(1);
+		createSessionResponse->authenticationToken().nodeId(authenticationToken_);
+		createSessionResponse->receivedSessionTimeout(120000);
+		createSessionResponse->serverEndpoints(endpointDescriptionArray_);
+		createSessionResponse->maxRequestMessageSize(0);
 
 		// added server certificate
-		createSessionResponse.serverNonce((const OpcUaByte*)serverNonce_, 32);
-		applicationCertificate_->certificate()->toDERBuf(createSessionResponse.serverCertificate());
-
-		if (applicationCertificate_.get() != nullptr && secureChannelTransaction->cryptoBase_.get() != nullptr) {
-
-			// create server signature
-			MemoryBuffer clientCertificate(createSessionRequest.clientCertificate());
-			MemoryBuffer clientNonce(createSessionRequest.clientNonce());
-			PrivateKey privateKey = *applicationCertificate_->privateKey();
-			statusCode = createSessionResponse.signatureData()->createSignature(
-				clientCertificate,
-				clientNonce,
-				privateKey,
-				*secureChannelTransaction->cryptoBase_
+		createSessionResponse->serverNonce((const OpcUaByte*)serverNonce_, 32);
+		applicationCertificate_->certificate()->toDERBuf(createSessionResponse->serverCertificate());
+
+		if (applicationCertificate_.get() == nullptr || secureChannelTransaction->cryptoBase_.get() == nullptr) {
+			sendCreateSessionResponse(Success, createSessionResponse, requestHeader, secureChannelTransaction);
+			return;
+		}
+
+		// the server signature is created by the crypto pool. The response
+		// is sent in the strand of the secure channel
+		if (cryptoPool_.get() != nullptr) {
+			bool success = cryptoPool_->post(
+				boost::bind(
+					&Session::cryptoCreateSession,
+					shared_from_this(),
+					createSessionRequest,
+					createSessionResponse,
+					requestHeader,
+					secureChannelTransaction
+				)
 			);
-			if (statusCode != Success) {
-				Log(Error, "create server signature in create session request error")
-					.parameter("StatusCode", OpcUaStatusCodeMap::shortString(statusCode));
-				createSessionResponse.responseHeader()->serviceResult(BadSecurityChecksFailed);
+			if (!success) {
+				Log(Warning, "crypto pool overload; reject create session request")
+					.parameter("QueueLength", cryptoPool_->queueLength());
+				createSessionResponse->responseHeader()->serviceResult(BadResourceUnavailable);
+				sendCreateSessionResponse(Success, createSessionResponse, requestHeader, secureChannelTransaction);
 			}
+			return;
+		}
+
+		OpcUaStatusCode statusCode = createServerSignature(
+			*createSessionRequest,
+			*createSessionResponse,
+			*secureChannelTransaction->cryptoBase_
+		);
+		sendCreateSessionResponse(statusCode, createSessionResponse, requestHeader, secureChannelTransaction);
+	}
+
+	OpcUaStatusCode
+	Session::createServerSignature(
+		CreateSessionRequest& createSessionRequest,
+		CreateSessionResponse& createSessionResponse,
+		CryptoBase& cryptoBase
+	)
+	{
+		// create server signature
+		MemoryBuffer clientCertificate(createSessionRequest.clientCertificate());
+		MemoryBuffer clientNonce(createSessionRequest.clientNonce());
+		PrivateKey privateKey = *applicationCertificate_->privateKey();
+		return createSessionResponse.signatureData()->createSignature(
+			clientCertificate,
+			clientNonce,
+			privateKey,
+			cryptoBase
+		);
+	}
+
+	void
+	Session::cryptoCreateSession(
+		CreateSessionRequest::SPtr createSessionRequest,
+		CreateSessionResponse::SPtr createSessionResponse,
+		RequestHeader::SPtr requestHeader,
+		SecureChannelTransaction::SPtr secureChannelTransaction
+	)
+	{
+		// this function is called by a thread of the crypto pool
+		OpcUaStatusCode statusCode = createServerSignature(
+			*createSessionRequest,
+			*createSessionResponse,
+			*secureChannelTransaction->cryptoBase_
+		);
+
+		ChannelSessionHandle::SPtr channelSessionHandle;
+		channelSessionHandle = boost::static_pointer_cast<ChannelSessionHandle>(secureChannelTransaction->handle_);
+		channelSessionHandle->strand()->post(
+			boost::bind(
+				&Session::sendCreateSessionResponse,
+				shared_from_this(),
+				statusCode,
+				createSessionResponse,
+				requestHeader,
+				secureChannelTransaction
+			)
+		);
+	}
+
+	void
+	Session::sendCreateSessionResponse(
+		OpcUaStatusCode statusCode,
+		CreateSessionResponse::SPtr createSessionResponse,
+		RequestHeader::SPtr requestHeader,
+		SecureChannelTransaction::SPtr secureChannelTransaction
+	)
+	{
+		if (statusCode != Success) {
+			Log(Error, "create server signature in create session request error")
+				.parameter("StatusCode", OpcUaStatusCodeMap::shortString(statusCode));
+			createSessionResponse->responseHeader()->serviceResult(BadSecurityChecksFailed);
 		}
 
-		createSessionResponse.responseHeader()->opcUaBinaryEncode(iosres);
-		createSessionResponse.opcUaBinaryEncode(iosres);
+		std::iostream iosres(&secureChannelTransaction->os_);
+		createSessionResponse->responseHeader()->opcUaBinaryEncode(iosres);
+		createSessionResponse->opcUaBinaryEncode(iosres);
 
-		sessionState_ = SessionState_CreateSessionResponse;
+		sessionState(SessionState_CreateSessionResponse);
 
 		if (sessionIf_ != nullptr) {
-			ResponseHeader::SPtr responseHeader = createSessionResponse.responseHeader();
+			ResponseHeader::SPtr responseHeader = createSessionResponse->responseHeader();
 			sessionIf_->responseMessage(responseHeader, secureChannelTransaction);
 		}
 	}
@@ -697,8 +836,6 @@ namespace OpcUaStackServer
 		SecureChannelTransaction::SPtr secureChannelTransaction
 	)
 	{
-		OpcUaStatusCode statusCode;
-
 		Log(Debug, "receive activate session request");
 		secureChannelTransaction->responseTypeNodeId_ = OpcUaId_ActivateSessionResponse_Encoding_DefaultBinary;
 
@@ -707,47 +844,144 @@ namespace OpcUaStackServer
 
 
 		std::iostream ios(&secureChannelTransaction->is_);
-		ActivateSessionRequest activateSessionRequest;
-		activateSessionRequest.opcUaBinaryDecode(ios);
+		ActivateSessionRequest::SPtr activateSessionRequest = constructSPtr<ActivateSessionRequest>();
+		activateSessionRequest->opcUaBinaryDecode(ios);
 
-		if (sessionState_ != SessionState_CreateSessionResponse) {
+		if (sessionState() != SessionState_CreateSessionResponse) {
 			Log(Error, "receive activate session request in invalid state")
-				.parameter("SessionState", sessionState_);
+				.parameter("SessionState", sessionState());
 			activateSessionRequestError(requestHeader, secureChannelTransaction, BadIdentityTokenInvalid);
 			return;
 		}
 
+		// the crypto operations use the server nonce of the create session
+		// response
+		MemoryBuffer::SPtr serverNonce = constructSPtr<MemoryBuffer>(serverNonce_, 32);
+
+		// the client signature and the user identity token are checked by
+		// the crypto pool. The response is sent in the strand of the secure
+		// channel
+		if (cryptoPool_.get() != nullptr && secureChannelTransaction->cryptoBase_.get() != nullptr) {
+			bool success = cryptoPool_->post(
+				boost::bind(
+					&Session::cryptoActivateSession,
+					shared_from_this(),
+					activateSessionRequest,
+					serverNonce,
+					requestHeader,
+					secureChannelTransaction
+				)
+			);
+			if (!success) {
+				Log(Warning, "crypto pool overload; reject activate session request")
+					.parameter("QueueLength", cryptoPool_->queueLength());
+				activateSessionRequestError(requestHeader, secureChannelTransaction, BadResourceUnavailable);
+			}
+			return;
+		}
+
 		// check client signature
+		OpcUaStatusCode signatureStatusCode = Success;
 		if (secureChannelTransaction->cryptoBase_.get() != nullptr) {
-			// create certificate
-			uint32_t derCertSize = applicationCertificate_->certificate()->getDERBufSize();
-			MemoryBuffer certificate(derCertSize);
-			applicationCertificate_->certificate()->toDERBuf(
-				certificate.memBuf(),
-				&derCertSize
+			signatureStatusCode = verifyClientSignature(
+				*activateSessionRequest,
+				*serverNonce,
+				*secureChannelTransaction->cryptoBase_
 			);
+		}
 
-			// create server nonce
-			MemoryBuffer serverNonce(serverNonce_, 32);
+		// check and decrypt user identity token
+		OpcUaStatusCode tokenStatusCode = Success;
+		if (signatureStatusCode == Success) {
+			tokenStatusCode = identityTokenCrypto(*activateSessionRequest, *serverNonce);
+		}
 
-			// verify signature
-			PublicKey publicKey = clientCertificate_.publicKey();
-			statusCode = activateSessionRequest.clientSignature()->verifySignature(
-				certificate,
-				serverNonce,
-				publicKey,
-				*secureChannelTransaction->cryptoBase_
-			);
+		sendActivateSessionResponse(
+			signatureStatusCode,
+			tokenStatusCode,
+			activateSessionRequest,
+			requestHeader,
+			secureChannelTransaction
+		);
+	}
 
-			if (statusCode != Success) {
-				Log(Error, "client signature error");
-				activateSessionRequestError(requestHeader, secureChannelTransaction, BadSecurityChecksFailed);
-				return;
-			}
+	OpcUaStatusCode
+	Session::verifyClientSignature(
+		ActivateSessionRequest& activateSessionRequest,
+		MemoryBuffer& serverNonce,
+		CryptoBase& cryptoBase
+	)
+	{
+		// create certificate
+		uint32_t derCertSize = applicationCertificate_->certificate()->getDERBufSize();
+		MemoryBuffer certificate(derCertSize);
+		applicationCertificate_->certificate()->toDERBuf(
+			certificate.memBuf(),
+			&derCertSize
+		);
+
+		// verify signature
+		PublicKey publicKey = clientCertificate_.publicKey();
+		return activateSessionRequest.clientSignature()->verifySignature(
+			certificate,
+			serverNonce,
+			publicKey,
+			cryptoBase
+		);
+	}
+
+	void
+	Session::cryptoActivateSession(
+		ActivateSessionRequest::SPtr activateSessionRequest,
+		MemoryBuffer::SPtr serverNonce,
+		RequestHeader::SPtr requestHeader,
+		SecureChannelTransaction::SPtr secureChannelTransaction
+	)
+	{
+		// this function is called by a thread of the crypto pool
+		OpcUaStatusCode signatureStatusCode = verifyClientSignature(
+			*activateSessionRequest,
+			*serverNonce,
+			*secureChannelTransaction->cryptoBase_
+		);
+
+		OpcUaStatusCode tokenStatusCode = Success;
+		if (signatureStatusCode == Success) {
+			tokenStatusCode = identityTokenCrypto(*activateSessionRequest, *serverNonce);
+		}
+
+		ChannelSessionHandle::SPtr channelSessionHandle;
+		channelSessionHandle = boost::static_pointer_cast<ChannelSessionHandle>(secureChannelTransaction->handle_);
+		channelSessionHandle->strand()->post(
+			boost::bind(
+				&Session::sendActivateSessionResponse,
+				shared_from_this(),
+				signatureStatusCode,
+				tokenStatusCode,
+				activateSessionRequest,
+				requestHeader,
+				secureChannelTransaction
+			)
+		);
+	}
+
+	void
+	Session::sendActivateSessionResponse(
+		OpcUaStatusCode signatureStatusCode,
+		OpcUaStatusCode tokenStatusCode,
+		ActivateSessionRequest::SPtr activateSessionRequest,
+		RequestHeader::SPtr requestHeader,
+		SecureChannelTransaction::SPtr secureChannelTransaction
+	)
+	{
+		if (signatureStatusCode != Success) {
+			Log(Error, "client signature error");
+			activateSessionRequestError(requestHeader, secureChannelTransaction, BadSecurityChecksFailed);
+			return;
 		}
 
 		// check username and password
-		statusCode = authentication(activateSessionRequest);
+		OpcUaStatusCode statusCode = authentication(*activateSessionRequest, tokenStatusCode);
 
 		std::iostream iosres(&secureChannelTransaction->os_);
 
@@ -760,7 +994,7 @@ namespace OpcUaStackServer
 		activateSessionResponse.responseHeader()->opcUaBinaryEncode(iosres);
 		activateSessionResponse.opcUaBinaryEncode(iosres);
 
-		sessionState_ = SessionState_Ready;
+		sessionState(SessionState_Ready);
 
 		//secureChannelTransaction->authenticationToken_ = authenticationToken_;
 
@@ -897,9 +1131,9 @@ namespace OpcUaStackServer
 	{
 		Log(Debug, "receive message request");
 
-		if (sessionState_ != SessionState_Ready) {
+		if (sessionState() != SessionState_Ready) {
 			Log(Error, "receive message request in invalid state")
-				.parameter("SessionState", sessionState_)
+				.parameter("SessionState", sessionState())
 				.parameter("TypeId", secureChannelTransaction->requestTypeNodeId_);
 
 			// FIXME: error handling
@@ -922,13 +1156,68 @@ namespace OpcUaStackServer
 		secureChannelTransaction->responseTypeNodeId_ = OpcUaNodeId(serviceTransactionSPtr->nodeTypeResponse().nodeId<uint32_t>());
 		serviceTransactionSPtr->componentSession(this);
 		serviceTransactionSPtr->sessionId(sessionId_);
-		serviceTransactionSPtr->userContext(userContext_);
+		UserContext::SPtr userContext = this->userContext();
+		serviceTransactionSPtr->userContext(userContext);
 		Object::SPtr handle = secureChannelTransaction;
 		serviceTransactionSPtr->handle(handle);
 		// FIXME: serviceTransactionSPtr->channelId(secureChannelTransaction->channelId_);
+		serviceTransactionSPtr->requestHeader(requestHeader);
+
+		// large request bodies are decoded by the decode pool, so that the
+		// io thread continues to read the messages of the other channels.
+		// A request that arrives while the decode pool processes requests
+		// of this session is queued behind them
+		if (decodePool_.get() != nullptr) {
+			boost::mutex::scoped_lock g(decodeMutex_);
+			if (decodeRunning_ || secureChannelTransaction->is_.size() >= decodeMinSize_) {
+				decodeRequestList_.push_back(std::make_pair(serviceTransactionSPtr, secureChannelTransaction));
+				if (decodeRunning_) return;
+
+				bool success = decodePool_->post(
+					boost::bind(&Session::decodeMessageRequestList, shared_from_this())
+				);
+				if (success) {
+					decodeRunning_ = true;
+					return;
+				}
+
+				// the queue of the decode pool is full. The request is decoded
+				// in the io thread
+				decodeRequestList_.pop_back();
+			}
+		}
+
+		decodeMessageRequest(serviceTransactionSPtr, secureChannelTransaction);
+	}
+
+	void
+	Session::decodeMessageRequestList(void)
+	{
+		// the requests are removed one by one, so that the io thread queues
+		// new requests until the last request is dispatched
+		while (true) {
+			DecodeRequest decodeRequest;
+			{
+				boost::mutex::scoped_lock g(decodeMutex_);
+				if (decodeRequestList_.empty()) {
+					decodeRunning_ = false;
+					return;
+				}
+				decodeRequest = decodeRequestList_.front();
+				decodeRequestList_.pop_front();
+			}
 
+			decodeMessageRequest(decodeRequest.first, decodeRequest.second);
+		}
+	}
+
+	void
+	Session::decodeMessageRequest(
+		ServiceTransaction::SPtr serviceTransactionSPtr,
+		SecureChannelTransaction::SPtr secureChannelTransaction
+	)
+	{
 		std::iostream ios(&secureChannelTransaction->is_);
-		serviceTransactionSPtr->requestHeader(requestHeader);
 		//OpcUaStackCore::dumpHex(sb);
 		serviceTransactionSPtr->opcUaBinaryDecodeRequest(ios);
 		//OpcUaStackCore::dumpHex(sb);
@@ -940,7 +1229,16 @@ namespace OpcUaStackServer
 			.parameter("TypeId", serviceTransactionSPtr->requestName())
 			.parameter("RequestId", serviceTransactionSPtr->requestId_);
 
-		serviceTransactionSPtr->componentService()->send(serviceTransactionSPtr);
+		// a service without a service pool expects its requests in its io
+		// thread. If the decode pool is used, all requests are passed
+		// through the mailbox of the service, so that a request decoded in
+		// the io thread does not overtake a request decoded by the pool
+		Component* componentService = serviceTransactionSPtr->componentService();
+		if (decodePool_.get() != nullptr && componentService->workerPool().get() == nullptr) {
+			componentService->sendAsync(serviceTransactionSPtr);
+			return;
+		}
+		componentService->send(serviceTransactionSPtr);
 	}
 
 	void
@@ -970,6 +1268,22 @@ namespace OpcUaStackServer
 		SecureChannelTransaction::SPtr secureChannelTransaction;
 		secureChannelTransaction = boost::static_pointer_cast<SecureChannelTransaction>(serviceTransactionSPtr->handle());
 
+		// streaming mode: queue the response first. The chunks are sent
+		// while the response is encoded
+		MessageChunkBuffer::SPtr chunkBuffer = secureChannelTransaction->chunkBuffer_;
+		if (chunkBuffer.get() != nullptr) {
+			if (sessionIf_ != nullptr) {
+				sessionIf_->responseMessage(responseHeader, secureChannelTransaction);
+			}
+
+			std::ostream oschunk(chunkBuffer.get());
+			secureChannelTransaction->responseTypeNodeId_.opcUaBinaryEncode(oschunk);
+			responseHeader->opcUaBinaryEncode(oschunk);
+			serviceTransactionSPtr->opcUaBinaryEncodeResponse(oschunk);
+			chunkBuffer->finish();
+			return;
+		}
+
 		std::iostream iosres(&secureChannelTransaction->os_);
 
 		responseHeader->opcUaBinaryEncode(iosres);
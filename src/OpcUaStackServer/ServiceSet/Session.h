@@ -18,18 +18,25 @@
 #ifndef __OpcUaStackServer_Session_h__
 #define __OpcUaStackServer_Session_h__
 
+#include <list>
+#include <boost/enable_shared_from_this.hpp>
 #include "OpcUaStackCore/Base/os.h"
 #include "OpcUaStackCore/Base/ObjectPool.h"
+#include "OpcUaStackCore/Base/MemoryBuffer.h"
 #include "OpcUaStackCore/Base/UserContext.h"
+#include "OpcUaStackCore/Base/WorkerPool.h"
 #include "OpcUaStackCore/Component/Component.h"
 #include "OpcUaStackCore/BuildInTypes/BuildInTypes.h"
 #include "OpcUaStackCore/SecureChannel/SecureChannelTransaction.h"
 #include "OpcUaStackCore/ServiceSet/ActivateSessionRequest.h"
+#include "OpcUaStackCore/ServiceSet/CreateSessionRequest.h"
+#include "OpcUaStackCore/ServiceSet/CreateSessionResponse.h"
 #include "OpcUaStackCore/ServiceSet/CancelRequest.h"
 #include "OpcUaStackCore/ServiceSet/EndpointDescription.h"
 #include "OpcUaStackCore/ServiceSetApplication/ForwardGlobalSync.h"
 #include "OpcUaStackCore/Certificate/ApplicationCertificate.h"
 #include "OpcUaStackCore/Certificate/CryptoManager.h"
+#include "OpcUaStackCore/Certificate/CertificateValidator.h"
 #include "OpcUaStackServer/ServiceSet/SessionIf.h"
 #include "OpcUaStackServer/ServiceSet/TransactionManager.h"
 
@@ -51,6 +58,7 @@ namespace OpcUaStackServer
 	class DLLEXPORT Session
 	: public OpcUaStackCore::Object
 	, public Component
+	, public boost::enable_shared_from_this<Session>
 	{
 	  public:
 		Session(void);
@@ -60,8 +68,11 @@ namespace OpcUaStackServer
 
 		void applicationCertificate(ApplicationCertificate::SPtr& applicationCertificate);
 		void cryptoManager(CryptoManager::SPtr& cryptoManager);
+		void certificateValidator(CertificateValidator::SPtr& certificateValidator);
 		void transactionManager(TransactionManager::SPtr transactionManager);
 		void forwardGlobalSync(ForwardGlobalSync::SPtr& forwardGlobalSync);
+		void decodePool(WorkerPool::SPtr& decodePool, uint32_t decodeMinSize);
+		void cryptoPool(WorkerPool::SPtr& cryptoPool);
 
 		void sessionIf(SessionIf* sessionIf);
 		OpcUaUInt32 sessionId(void);
@@ -96,16 +107,53 @@ namespace OpcUaStackServer
 		// - Component -------------------------------------------------------
 
 	  private:
+		void sessionState(SessionState sessionState);
+		SessionState sessionState(void);
+		void userContext(const UserContext::SPtr& userContext);
+		UserContext::SPtr userContext(void);
 		void createServerNonce(void);
 
-		OpcUaStatusCode authentication(ActivateSessionRequest& activateSessionRequest);
+		OpcUaStatusCode authentication(ActivateSessionRequest& activateSessionRequest, OpcUaStatusCode tokenStatusCode);
 		OpcUaStatusCode authenticationCloseSession(void);
 		OpcUaStatusCode authenticationAnonymous(ActivateSessionRequest& activateSessionRequest, ExtensibleParameter::SPtr& parameter);
-		OpcUaStatusCode authenticationUserName(ActivateSessionRequest& activateSessionRequest, ExtensibleParameter::SPtr& parameter);
-		OpcUaStatusCode authenticationX509(ActivateSessionRequest& activateSessionRequest, ExtensibleParameter::SPtr& parameter);
-		OpcUaStatusCode authenticationIssued(ActivateSessionRequest& activateSessionRequest, ExtensibleParameter::SPtr& parameter);
+		OpcUaStatusCode authenticationIdentityToken(uint32_t authenticationType, ExtensibleParameter::SPtr& parameter, OpcUaStatusCode tokenStatusCode);
 		OpcUaStatusCode checkUserTokenPolicy(const std::string& policyId, UserIdentityTokenType tokenType, UserTokenPolicy::SPtr& userTokenPolicy);
 
+		// asymmetric operations of the session handshake. These functions
+		// are called by a thread of the crypto pool
+		OpcUaStatusCode createServerSignature(CreateSessionRequest& createSessionRequest, CreateSessionResponse& createSessionResponse, CryptoBase& cryptoBase);
+		OpcUaStatusCode verifyClientSignature(ActivateSessionRequest& activateSessionRequest, MemoryBuffer& serverNonce, CryptoBase& cryptoBase);
+		OpcUaStatusCode identityTokenCrypto(ActivateSessionRequest& activateSessionRequest, MemoryBuffer& serverNonce);
+		OpcUaStatusCode decryptUserNameToken(ExtensibleParameter::SPtr& parameter, MemoryBuffer& serverNonce);
+		OpcUaStatusCode verifyX509Token(ActivateSessionRequest& activateSessionRequest, ExtensibleParameter::SPtr& parameter);
+		OpcUaStatusCode decryptIssuedToken(ExtensibleParameter::SPtr& parameter, MemoryBuffer& serverNonce);
+
+		void cryptoCreateSession(
+			CreateSessionRequest::SPtr createSessionRequest,
+			CreateSessionResponse::SPtr createSessionResponse,
+			RequestHeader::SPtr requestHeader,
+			SecureChannelTransaction::SPtr secureChannelTransaction
+		);
+		void sendCreateSessionResponse(
+			OpcUaStatusCode statusCode,
+			CreateSessionResponse::SPtr createSessionResponse,
+			RequestHeader::SPtr requestHeader,
+			SecureChannelTransaction::SPtr secureChannelTransaction
+		);
+		void cryptoActivateSession(
+			ActivateSessionRequest::SPtr activateSessionRequest,
+			MemoryBuffer::SPtr serverNonce,
+			RequestHeader::SPtr requestHeader,
+			SecureChannelTransaction::SPtr secureChannelTransaction
+		);
+		void sendActivateSessionResponse(
+			OpcUaStatusCode signatureStatusCode,
+			OpcUaStatusCode tokenStatusCode,
+			ActivateSessionRequest::SPtr activateSessionRequest,
+			RequestHeader::SPtr requestHeader,
+			SecureChannelTransaction::SPtr secureChannelTransaction
+		);
+
 		void activateSessionRequestError(
 			RequestHeader::SPtr& requestHeader,
 			SecureChannelTransaction::SPtr secureChannelTransaction,
@@ -121,6 +169,11 @@ namespace OpcUaStackServer
 			SecureChannelTransaction::SPtr secureChannelTransaction,
 			OpcUaStatusCode statusCode
 		);
+		void decodeMessageRequest(
+			ServiceTransaction::SPtr serviceTransactionSPtr,
+			SecureChannelTransaction::SPtr secureChannelTransaction
+		);
+		void decodeMessageRequestList(void);
 
 		static boost::mutex mutex_;
 		static OpcUaUInt32 uniqueSessionId_;
@@ -136,13 +189,30 @@ namespace OpcUaStackServer
 		EndpointDescription::SPtr endpointDescription_;
 		ApplicationCertificate::SPtr applicationCertificate_;
 		CryptoManager::SPtr cryptoManager_;
+		CertificateValidator::SPtr certificateValidator_;
 		Certificate clientCertificate_;
 
 		ForwardGlobalSync::SPtr forwardGlobalSync_;
 		TransactionManager::SPtr transactionManagerSPtr_;
+		WorkerPool::SPtr decodePool_;
+		uint32_t decodeMinSize_;
+
+		// requests of the session that wait for the decode pool. While the
+		// list is processed, all following requests of the session are
+		// queued, so that the requests keep their order
+		typedef std::pair<ServiceTransaction::SPtr, SecureChannelTransaction::SPtr> DecodeRequest;
+		typedef std::list<DecodeRequest> DecodeRequestList;
+		boost::mutex decodeMutex_;
+		DecodeRequestList decodeRequestList_;
+		bool decodeRunning_;
+		WorkerPool::SPtr cryptoPool_;
 
 		UserContext::SPtr userContext_;
 		char serverNonce_[32];
+
+		// the session state and the user context are used by the threads of
+		// all channels the session is activated on
+		boost::mutex sessionMutex_;
 	};
 
 }
@@ -37,6 +37,14 @@ namespace OpcUaStackServer
 	, transactionManagerSPtr_()
 	, channelSessionHandleMap_()
 	, forwardGlobalSync_()
+	, streamingResponse_(false)
+	, streamingQueuedChunks_(16)
+	, cryptoPool_()
+	, decodePool_()
+	, decodeMinSize_(0)
+	, certificateValidator_()
+	, admissionControl_()
+	, secureChannelCapture_()
 	{
 	}
 
@@ -100,6 +108,77 @@ namespace OpcUaStackServer
 		bool secureChannelLog = false;
 		config_->getConfigParameter("OpcUaServer.Logging.SecureChannelLog", secureChannelLog, "0");
 
+		// read AcceptorSharding parameter from configuration file. If sharding
+		// is enabled the endpoint gets one acceptor (SO_REUSEPORT) per
+		// configured io thread. All acceptors share the io thread pool
+		bool acceptorSharding = false;
+		config_->getConfigParameter("OpcUaServer.Stack.AcceptorSharding", acceptorSharding, "0");
+		uint32_t numberAcceptors = acceptorSharding ? ioThread_->numberThreads() : 1;
+
+		// read send queue limits from configuration file
+		SendQueueLimit sendQueueLimit;
+		if (!readSendQueueLimit(sendQueueLimit)) {
+			return false;
+		}
+
+		// read size of the request window of a secure channel. The channel
+		// stops reading if this number of requests is in progress (0 = unlimited)
+		uint32_t maxRequestsInFlight = 0;
+		config_->getConfigParameter("OpcUaServer.Stack.MaxRequestsInFlight", maxRequestsInFlight, "0");
+
+		// read size of the ring buffers used by shared memory endpoints (opc.shm)
+		uint32_t sharedMemoryBufferSize = 1048576;
+		config_->getConfigParameter("OpcUaServer.Stack.SharedMemoryBufferSize", sharedMemoryBufferSize, "1048576");
+		if (sharedMemoryBufferSize == 0 || (sharedMemoryBufferSize & (sharedMemoryBufferSize - 1)) != 0) {
+			Log(Error, "shared memory buffer size must be a power of two")
+				.parameter("Parameter", "OpcUaServer.Stack.SharedMemoryBufferSize")
+				.parameter("Value", sharedMemoryBufferSize);
+			return false;
+		}
+
+		// read access mode (octal) of the socket file of unix domain socket
+		// and shared memory endpoints
+		std::string unixSocketModeString = "0600";
+		config_->getConfigParameter("OpcUaServer.Stack.UnixSocketMode", unixSocketModeString, "0600");
+		uint32_t unixSocketMode = (uint32_t)strtoul(unixSocketModeString.c_str(), nullptr, 8);
+
+		// read IoUring parameter from configuration file. The tcp connections
+		// use io_uring instead of the reactor if the stack is built with it
+		bool ioUring = false;
+		config_->getConfigParameter("OpcUaServer.Stack.IoUring", ioUring, "0");
+
+		// read StreamingResponse parameter from configuration file. Large
+		// responses are sent chunk by chunk while they are encoded
+		config_->getConfigParameter("OpcUaServer.Stack.StreamingResponse", streamingResponse_, "0");
+
+		// read maximum number of queued chunks of a streamed response. An
+		// encoder in a service thread waits until a chunk is sent (0 = unlimited)
+		config_->getConfigParameter("OpcUaServer.Stack.StreamingQueuedChunks", streamingQueuedChunks_, "16");
+
+		// read crypto pool parameter from configuration file. The asymmetric
+		// operations of the handshake are done by the crypto pool
+		if (!startupCryptoPool()) {
+			return false;
+		}
+
+		// read decode pool parameter from configuration file. Large request
+		// bodies are decoded by the decode pool
+		if (!startupDecodePool()) {
+			return false;
+		}
+
+		// read admission control parameter from configuration file
+		startupAdmissionControl();
+
+		// read certificate validation parameter from configuration file
+		startupCertificateValidator();
+
+		// read SecureChannelCapture parameter from configuration file. The
+		// traffic of all secure channels is written to the capture file
+		if (!startupSecureChannelCapture()) {
+			return false;
+		}
+
 		// get all endpoint urls from endpoint description set
 		std::vector<std::string> endpointUrls;
 		endpointDescriptionSet_->getEndpointUrls(endpointUrls);
@@ -118,12 +197,22 @@ namespace OpcUaStackServer
 			secureChannelServerConfig->endpointDescriptionArray(endpointDescriptionArray);
 			secureChannelServerConfig->endpointUrl(endpointUrl);
 			secureChannelServerConfig->secureChannelLog(secureChannelLog);
+			secureChannelServerConfig->numberAcceptors(numberAcceptors);
+			secureChannelServerConfig->sendQueueLimit() = sendQueueLimit;
+			secureChannelServerConfig->sharedMemoryBufferSize(sharedMemoryBufferSize);
+			secureChannelServerConfig->unixSocketMode(unixSocketMode);
+			secureChannelServerConfig->ioUring(ioUring);
+			secureChannelServerConfig->maxRequestsInFlight(maxRequestsInFlight);
 
 			// create new secure channel
 			SecureChannelServer::SPtr secureChannelServer = constructSPtr<SecureChannelServer>(ioThread_);
 			secureChannelServer->secureChannelServerIf(this);
 			secureChannelServer->applicationCertificate(applicationCertificate_);
 			secureChannelServer->cryptoManager(cryptoManager_);
+			secureChannelServer->cryptoPool(cryptoPool_);
+			secureChannelServer->certificateValidator(certificateValidator_);
+			secureChannelServer->admissionControl(admissionControl_);
+			secureChannelServer->secureChannelCapture(secureChannelCapture_);
 
 			// open server socket
 			if (!secureChannelServer->accept(secureChannelServerConfig)) {
@@ -132,18 +221,222 @@ namespace OpcUaStackServer
 				return false;
 			}
 
+			boost::mutex::scoped_lock g(secureChannelServerMapMutex_);
 			secureChannelServerMap_.insert(std::make_pair(endpointUrl, secureChannelServer));
 		}
 
 		return true;
 	}
 
+	bool
+	SessionManager::readSendQueueLimit(SendQueueLimit& sendQueueLimit)
+	{
+		uint32_t value;
+
+		config_->getConfigParameter("OpcUaServer.Stack.SendQueue.HighWaterMarkBytes", value, "0");
+		sendQueueLimit.highWaterMarkBytes(value);
+		config_->getConfigParameter("OpcUaServer.Stack.SendQueue.LowWaterMarkBytes", value, "0");
+		sendQueueLimit.lowWaterMarkBytes(value);
+		config_->getConfigParameter("OpcUaServer.Stack.SendQueue.HighWaterMarkMessages", value, "0");
+		sendQueueLimit.highWaterMarkMessages(value);
+		config_->getConfigParameter("OpcUaServer.Stack.SendQueue.LowWaterMarkMessages", value, "0");
+		sendQueueLimit.lowWaterMarkMessages(value);
+
+		std::string policyString;
+		config_->getConfigParameter("OpcUaServer.Stack.SendQueue.SlowConsumerPolicy", policyString, "DropOldest");
+		SlowConsumerPolicy slowConsumerPolicy;
+		if (!SendQueueLimit::slowConsumerPolicy(policyString, slowConsumerPolicy)) {
+			Log(Error, "invalid slow consumer policy in configuration file")
+				.parameter("Parameter", "OpcUaServer.Stack.SendQueue.SlowConsumerPolicy")
+				.parameter("Value", policyString);
+			return false;
+		}
+		sendQueueLimit.slowConsumerPolicy(slowConsumerPolicy);
+
+		return true;
+	}
+
+	bool
+	SessionManager::startupCryptoPool(void)
+	{
+		uint32_t cryptoThreads;
+		uint32_t cryptoQueueLength;
+		config_->getConfigParameter("OpcUaServer.Stack.CryptoThreads", cryptoThreads, "0");
+		config_->getConfigParameter("OpcUaServer.Stack.CryptoQueueLength", cryptoQueueLength, "100");
+		if (cryptoThreads == 0) {
+			return true;
+		}
+
+		cryptoPool_ = constructSPtr<WorkerPool>(std::string("Crypto"));
+		cryptoPool_->startup(cryptoThreads, cryptoQueueLength);
+
+		Log(Info, "start crypto pool")
+			.parameter("CryptoThreads", cryptoThreads)
+			.parameter("CryptoQueueLength", cryptoQueueLength);
+		return true;
+	}
+
+	bool
+	SessionManager::startupDecodePool(void)
+	{
+		uint32_t decodeThreads;
+		uint32_t decodeQueueLength;
+		config_->getConfigParameter("OpcUaServer.Stack.DecodeThreads", decodeThreads, "0");
+		config_->getConfigParameter("OpcUaServer.Stack.DecodeQueueLength", decodeQueueLength, "100");
+		config_->getConfigParameter("OpcUaServer.Stack.DecodeMinSize", decodeMinSize_, "4096");
+		if (decodeThreads == 0) {
+			return true;
+		}
+
+		decodePool_ = constructSPtr<WorkerPool>(std::string("Decode"));
+		decodePool_->startup(decodeThreads, decodeQueueLength);
+
+		Log(Info, "start decode pool")
+			.parameter("DecodeThreads", decodeThreads)
+			.parameter("DecodeQueueLength", decodeQueueLength)
+			.parameter("DecodeMinSize", decodeMinSize_);
+		return true;
+	}
+
+	void
+	SessionManager::startupAdmissionControl(void)
+	{
+		AdmissionControl::SPtr admissionControl = constructSPtr<AdmissionControl>();
+		uint32_t value;
+
+		config_->getConfigParameter("OpcUaServer.Stack.Admission.MaxHandshakes", value, "0");
+		admissionControl->maxHandshakes(value);
+		config_->getConfigParameter("OpcUaServer.Stack.Admission.AcceptRate", value, "0");
+		admissionControl->acceptRate(value);
+		config_->getConfigParameter("OpcUaServer.Stack.Admission.AcceptBurst", value, "0");
+		admissionControl->acceptBurst(value);
+		config_->getConfigParameter("OpcUaServer.Stack.Admission.MaxConnectionsPerAddress", value, "0");
+		admissionControl->maxConnectionsPerAddress(value);
+		config_->getConfigParameter("OpcUaServer.Stack.Admission.HandshakeTimeout", value, "0");
+		admissionControl->handshakeTimeout(value);
+
+		if (!admissionControl->enabled()) {
+			return;
+		}
+		admissionControl_ = admissionControl;
+
+		Log(Info, "start admission control")
+			.parameter("MaxHandshakes", admissionControl_->maxHandshakes())
+			.parameter("AcceptRate", admissionControl_->acceptRate())
+			.parameter("AcceptBurst", admissionControl_->acceptBurst())
+			.parameter("MaxConnectionsPerAddress", admissionControl_->maxConnectionsPerAddress())
+			.parameter("HandshakeTimeout", admissionControl_->handshakeTimeout());
+	}
+
+	bool
+	SessionManager::startupSecureChannelCapture(void)
+	{
+		std::string captureFile;
+		config_->getConfigParameter("OpcUaServer.Logging.SecureChannelCapture", captureFile, "");
+		if (captureFile.empty()) {
+			return true;
+		}
+
+		// records are dropped when the capture file reaches the maximum size
+		uint64_t maxSize;
+		config_->getConfigParameter("OpcUaServer.Logging.SecureChannelCaptureMaxSize", maxSize, "104857600");
+
+		secureChannelCapture_ = constructSPtr<SecureChannelCapture>();
+		secureChannelCapture_->maxFileSize(maxSize);
+		if (!secureChannelCapture_->open(captureFile)) {
+			secureChannelCapture_.reset();
+			return false;
+		}
+
+		Log(Info, "start secure channel capture")
+			.parameter("CaptureFile", captureFile)
+			.parameter("MaxSize", maxSize);
+		return true;
+	}
+
+	AdmissionControl::SPtr&
+	SessionManager::admissionControl(void)
+	{
+		return admissionControl_;
+	}
+
+	void
+	SessionManager::admissionStatistic(
+		uint64_t& acceptCount,
+		uint64_t& rejectHandshakesCount,
+		uint64_t& rejectRateCount,
+		uint64_t& rejectAddressCount,
+		uint64_t& handshakeExpiredCount
+	)
+	{
+		acceptCount = 0;
+		rejectHandshakesCount = 0;
+		rejectRateCount = 0;
+		rejectAddressCount = 0;
+		handshakeExpiredCount = 0;
+
+		if (admissionControl_.get() == nullptr) {
+			return;
+		}
+		admissionControl_->statistic(
+			acceptCount,
+			rejectHandshakesCount,
+			rejectRateCount,
+			rejectAddressCount,
+			handshakeExpiredCount
+		);
+	}
+
+	void
+	SessionManager::startupCertificateValidator(void)
+	{
+		bool enable;
+		uint32_t cacheTimeout;
+		uint32_t cacheSize;
+		config_->getConfigParameter("OpcUaServer.Stack.CertificateValidation.Enable", enable, "0");
+		config_->getConfigParameter("OpcUaServer.Stack.CertificateValidation.CacheTimeout", cacheTimeout, "300");
+		config_->getConfigParameter("OpcUaServer.Stack.CertificateValidation.CacheSize", cacheSize, "1000");
+		if (!enable || applicationCertificate_.get() == nullptr || !applicationCertificate_->enable()) {
+			return;
+		}
+
+		// the validation results are cached until the timeout expires or
+		// the content of the PKI directories changes
+		certificateValidator_ = constructSPtr<CertificateValidator>();
+		certificateValidator_->certificateTrustListLocation(applicationCertificate_->certificateTrustListLocation());
+		certificateValidator_->certificateRevocationListLocation(applicationCertificate_->certificateRevocationListLocation());
+		certificateValidator_->issuersCertificatesLocation(applicationCertificate_->issuersCertificatesLocation());
+		certificateValidator_->issuersRevocationListLocation(applicationCertificate_->issuersRevocationListLocation());
+		certificateValidator_->cacheTimeout(cacheTimeout);
+		certificateValidator_->maxCacheEntries(cacheSize);
+	}
+
+	CertificateValidator::SPtr&
+	SessionManager::certificateValidator(void)
+	{
+		return certificateValidator_;
+	}
+
+	WorkerPool::SPtr&
+	SessionManager::cryptoPool(void)
+	{
+		return cryptoPool_;
+	}
+
 	bool
 	SessionManager::shutdown(void)
 	{
+		// the map is not locked while the endpoints are closed, because the
+		// close of an endpoint is reported by handleEndpointClose
+		SecureChannelServer::Map secureChannelServerMap;
+		{
+			boost::mutex::scoped_lock g(secureChannelServerMapMutex_);
+			secureChannelServerMap = secureChannelServerMap_;
+		}
+
 		// close acceptor socket
 		SecureChannelServer::Map::iterator it;
-		for (it = secureChannelServerMap_.begin(); it != secureChannelServerMap_.end(); it++) {
+		for (it = secureChannelServerMap.begin(); it != secureChannelServerMap.end(); it++) {
 			SecureChannelServer::SPtr secureChannelServer = it->second;
 
 			secureChannelServerShutdown_.start();
@@ -152,7 +445,44 @@ namespace OpcUaStackServer
 		}
 
 		// delete secure channel server
+		boost::mutex::scoped_lock g(secureChannelServerMapMutex_);
 		secureChannelServerMap_.clear();
+		g.unlock();
+
+		if (admissionControl_.get() != nullptr) {
+			uint64_t acceptCount, rejectHandshakesCount, rejectRateCount, rejectAddressCount, handshakeExpiredCount;
+			admissionStatistic(acceptCount, rejectHandshakesCount, rejectRateCount, rejectAddressCount, handshakeExpiredCount);
+			Log(Info, "admission control statistic")
+				.parameter("AcceptCount", acceptCount)
+				.parameter("RejectHandshakesCount", rejectHandshakesCount)
+				.parameter("RejectRateCount", rejectRateCount)
+				.parameter("RejectAddressCount", rejectAddressCount)
+				.parameter("HandshakeExpiredCount", handshakeExpiredCount);
+		}
+
+		// close capture file
+		if (secureChannelCapture_.get() != nullptr) {
+			Log(Info, "secure channel capture statistic")
+				.parameter("NumberRecords", secureChannelCapture_->numberRecords())
+				.parameter("DroppedRecords", secureChannelCapture_->droppedRecords());
+			secureChannelCapture_->close();
+			secureChannelCapture_.reset();
+		}
+
+		// stop crypto pool
+		if (cryptoPool_.get() != nullptr) {
+			cryptoPool_->shutdown();
+			cryptoPool_.reset();
+		}
+
+		// stop decode pool
+		if (decodePool_.get() != nullptr) {
+			Log(Info, "decode pool statistic")
+				.parameter("MaxQueueLength", decodePool_->maxQueueLengthObserved())
+				.parameter("RejectCount", decodePool_->rejectCount());
+			decodePool_->shutdown();
+			decodePool_.reset();
+		}
 
 		return true;
 	}
@@ -174,6 +504,7 @@ namespace OpcUaStackServer
 			.parameter("SessionCount", channelSessionHandleMap_.sessionSize());
 
 		// find secure channel server
+		boost::mutex::scoped_lock g(secureChannelServerMapMutex_);
 		SecureChannelServer::Map::iterator it;
 		it = secureChannelServerMap_.find(secureChannel->endpointUrl_);
 		if (it == secureChannelServerMap_.end()) {
@@ -182,6 +513,7 @@ namespace OpcUaStackServer
 			return;
 		}
 		SecureChannelServer::SPtr secureChannelServer = it->second;
+		g.unlock();
 
 		// create new secure channel handle
 		Object::SPtr handle = channelSessionHandleMap_.createSecureChannel(secureChannelServer, secureChannel);
@@ -288,10 +620,13 @@ namespace OpcUaStackServer
 		session->sessionIf(this);
 		session->applicationCertificate(applicationCertificate_);
 		session->cryptoManager(cryptoManager_);
+		session->certificateValidator(certificateValidator_);
 		session->endpointDescriptionArray(endpointDescriptionArray);
 		session->endpointDescription(endpointDescription);
 		session->transactionManager(transactionManagerSPtr_);
 		session->forwardGlobalSync(forwardGlobalSync_);
+		session->decodePool(decodePool_, decodeMinSize_);
+		session->cryptoPool(cryptoPool_);
 
 		Object::SPtr handle = channelSessionHandleMap_.createSession(session, secureChannel);
 		secureChannel->secureChannelTransaction_->handle_ = handle;
@@ -513,10 +848,44 @@ namespace OpcUaStackServer
 		}
 		Session::SPtr session = channelSessionHandle->session();
 
+		// encode large responses into chunks which are sent while the
+		// encoding continues
+		if (streamingResponse_ && isStreamingResponse(secureChannelTransaction)) {
+			MessageChunkBuffer::SPtr chunkBuffer(new MessageChunkBuffer(
+				secureChannel->sendChunkBodySize(),
+				secureChannel->maxChunkCount_,
+				secureChannel->maxMessageSize_
+			));
+			chunkBuffer->maxQueuedChunks(streamingQueuedChunks_);
+			chunkBuffer->chunkCallback(boost::bind(&SessionManager::responseChunk, this, channelSessionHandle));
+			secureChannelTransaction->chunkBuffer_ = chunkBuffer;
+		}
+
+		// the request can be processed by a service worker thread. The
+		// session must exist until the response is sent.
+		secureChannelTransaction->sessionHandle_ = session;
+
 		// handle message request
 		session->messageRequest(requestHeader, secureChannel->secureChannelTransaction_);
 	}
 
+	bool
+	SessionManager::isStreamingResponse(SecureChannelTransaction::SPtr& secureChannelTransaction)
+	{
+		if (secureChannelTransaction->requestTypeNodeId_.namespaceIndex() != 0) return false;
+		if (secureChannelTransaction->requestTypeNodeId_.nodeIdType() != OpcUaBuildInType_OpcUaUInt32) return false;
+
+		switch (secureChannelTransaction->requestTypeNodeId_.nodeId<OpcUaUInt32>())
+		{
+			case OpcUaId_ReadRequest_Encoding_DefaultBinary:
+			case OpcUaId_BrowseRequest_Encoding_DefaultBinary:
+			case OpcUaId_HistoryReadRequest_Encoding_DefaultBinary:
+				return true;
+			default:
+				return false;
+		}
+	}
+
 	void
 	SessionManager::errorMessageRequest(
 		SecureChannel* secureChannel,
@@ -615,6 +984,7 @@ namespace OpcUaStackServer
 		// find secure channel server
 		SecureChannelServer::SPtr secureChannelServer;
 		SecureChannelServer::Map::iterator it0;
+		boost::mutex::scoped_lock g(secureChannelServerMapMutex_);
 		it0 = secureChannelServerMap_.find(endpointUrl);
 		if (it0 == secureChannelServerMap_.end()) {
 			Log(Info, "close opc ua endpoint error, because secure channel server not found")
@@ -623,28 +993,29 @@ namespace OpcUaStackServer
 		else {
 			secureChannelServer = it0->second;
 		}
+		g.unlock();
 
 		//
-		// close all channels
+		// close all channels. The secure channels are closed in their own
+		// strand. The handle keeps the strand alive until the close is done
 		//
-		std::vector<SecureChannel*> secureChannelList;
-		std::vector<SecureChannel*>::iterator it1;
-		channelSessionHandleMap_.getSecureChannelList(secureChannelList);
+		ChannelSessionHandle::Vec channelSessionHandleVec;
+		ChannelSessionHandle::Vec::iterator it1;
+		channelSessionHandleMap_.getSecureChannelList(channelSessionHandleVec);
 		if (secureChannelServer.get() != nullptr) {
-			for (it1 = secureChannelList.begin(); it1 != secureChannelList.end(); it1++) {
-				SecureChannel* secureChannel = *it1;
-
-				SecureChannelServerConfig::SPtr cfg = boost::static_pointer_cast<SecureChannelServerConfig>(secureChannel->config_);
-
-				if (cfg->endpointUrl() != endpointUrl) {
+			for (it1 = channelSessionHandleVec.begin(); it1 != channelSessionHandleVec.end(); it1++) {
+				ChannelSessionHandle::SPtr channelSessionHandle = *it1;
+				if (channelSessionHandle->secureChannelServer() != secureChannelServer) {
 					continue;
 				}
 
-				secureChannelServer->disconnect(secureChannel);
+				channelSessionHandle->strand()->post(
+					boost::bind(&SessionManager::disconnectSecureChannel, this, channelSessionHandle)
+				);
 			}
 		}
 
-		if (secureChannelList.size() == 0) {
+		if (channelSessionHandleVec.size() == 0) {
 			secureChannelServerShutdown_.ready();
 		}
 	}
@@ -665,6 +1036,20 @@ namespace OpcUaStackServer
 		// get channel session handle
 		ChannelSessionHandle::SPtr channelSessionHandle;
 		channelSessionHandle = boost::static_pointer_cast<ChannelSessionHandle>(secureChannelTransaction->handle_);
+
+		// the response can be completed by any io thread. The response is
+		// sent in the strand of the secure channel
+		channelSessionHandle->strand()->dispatch(
+			boost::bind(&SessionManager::sendResponse, this, channelSessionHandle, secureChannelTransaction)
+		);
+	}
+
+	void
+	SessionManager::sendResponse(
+		ChannelSessionHandle::SPtr channelSessionHandle,
+		SecureChannelTransaction::SPtr secureChannelTransaction
+	)
+	{
 		if (!channelSessionHandle->secureChannelIsValid()) {
 			// channel do not exist anymore - ignore response
 			return;
@@ -678,6 +1063,40 @@ namespace OpcUaStackServer
 		);
 	}
 
+	void
+	SessionManager::responseChunk(ChannelSessionHandle::SPtr channelSessionHandle)
+	{
+		// a chunk of a streamed response is complete. The chunk is sent in
+		// the strand of the secure channel
+		channelSessionHandle->strand()->dispatch(
+			boost::bind(&SessionManager::sendResponseChunk, this, channelSessionHandle)
+		);
+	}
+
+	void
+	SessionManager::sendResponseChunk(ChannelSessionHandle::SPtr channelSessionHandle)
+	{
+		if (!channelSessionHandle->secureChannelIsValid()) {
+			// channel do not exist anymore - ignore chunk
+			return;
+		}
+
+		SecureChannelServer::SPtr secureChannelServer = channelSessionHandle->secureChannelServer();
+		secureChannelServer->sendResponseChunk(channelSessionHandle->secureChannel());
+	}
+
+	void
+	SessionManager::disconnectSecureChannel(ChannelSessionHandle::SPtr channelSessionHandle)
+	{
+		if (!channelSessionHandle->secureChannelIsValid()) {
+			// channel is already closed
+			return;
+		}
+
+		SecureChannelServer::SPtr secureChannelServer = channelSessionHandle->secureChannelServer();
+		secureChannelServer->disconnect(channelSessionHandle->secureChannel());
+	}
+
 	void
 	SessionManager::deleteSession(
 		uint32_t authenticationToken
@@ -702,15 +1121,11 @@ namespace OpcUaStackServer
 		// get channel session handle
 		ChannelSessionHandle::SPtr channelSessionHandle;
 		channelSessionHandle = boost::static_pointer_cast<ChannelSessionHandle>(secureChannelTransaction->handle_);
-		if (!channelSessionHandle->secureChannelIsValid()) {
-			// channel do not exist anymore - ignore response
-			return;
-		}
 
-		// send response
-		channelSessionHandle->secureChannelServer()->sendResponse(
-			channelSessionHandle->secureChannel(),
-			secureChannelTransaction
+		// the response can be completed by any io thread. The response is
+		// sent in the strand of the secure channel
+		channelSessionHandle->strand()->dispatch(
+			boost::bind(&SessionManager::sendResponse, this, channelSessionHandle, secureChannelTransaction)
 		);
 	}
 
@@ -23,6 +23,7 @@
 #include "OpcUaStackCore/Base/Config.h"
 #include "OpcUaStackCore/Base/Url.h"
 #include "OpcUaStackCore/Base/ConditionProcess.h"
+#include "OpcUaStackCore/Base/WorkerPool.h"
 #include "OpcUaStackCore/Certificate/ApplicationCertificate.h"
 #include "OpcUaStackCore/Certificate/CryptoManager.h"
 #include "OpcUaStackCore/Utility/IOThread.h"
@@ -61,6 +62,16 @@ namespace OpcUaStackServer
 
 		bool startup(void);
 		bool shutdown(void);
+		WorkerPool::SPtr& cryptoPool(void);
+		CertificateValidator::SPtr& certificateValidator(void);
+		AdmissionControl::SPtr& admissionControl(void);
+		void admissionStatistic(
+			uint64_t& acceptCount,
+			uint64_t& rejectHandshakesCount,
+			uint64_t& rejectRateCount,
+			uint64_t& rejectAddressCount,
+			uint64_t& handshakeExpiredCount
+		);
 
 		//- SecureChannelServerIf ---------------------------------------------
 		virtual void handleConnect(SecureChannel* secureChannel);
@@ -89,6 +100,21 @@ namespace OpcUaStackServer
 		//- DiscoveryIf -------------------------------------------------------
 
 	  private:
+		bool readSendQueueLimit(SendQueueLimit& sendQueueLimit);
+		bool startupCryptoPool(void);
+		bool startupDecodePool(void);
+		void startupCertificateValidator(void);
+		bool startupSecureChannelCapture(void);
+		void startupAdmissionControl(void);
+		void sendResponse(
+			ChannelSessionHandle::SPtr channelSessionHandle,
+			SecureChannelTransaction::SPtr secureChannelTransaction
+		);
+		bool isStreamingResponse(SecureChannelTransaction::SPtr& secureChannelTransaction);
+		void responseChunk(ChannelSessionHandle::SPtr channelSessionHandle);
+		void sendResponseChunk(ChannelSessionHandle::SPtr channelSessionHandle);
+		void disconnectSecureChannel(ChannelSessionHandle::SPtr channelSessionHandle);
+
 		void createSessionRequest(
 			SecureChannel* secureChannel,
 			RequestHeader::SPtr requestHeader
@@ -157,12 +183,21 @@ namespace OpcUaStackServer
 
 		ConditionProcess secureChannelServerShutdown_;
 		SecureChannelServer::Map secureChannelServerMap_;
+		boost::mutex secureChannelServerMapMutex_;
 		ForwardGlobalSync::SPtr forwardGlobalSync_;
 
 		DiscoveryService::SPtr discoveryService_;
 		TransactionManager::SPtr transactionManagerSPtr_;
 
 		ChannelSessionHandleMap channelSessionHandleMap_;
+		bool streamingResponse_;
+		uint32_t streamingQueuedChunks_;
+		WorkerPool::SPtr cryptoPool_;
+		WorkerPool::SPtr decodePool_;
+		uint32_t decodeMinSize_;
+		CertificateValidator::SPtr certificateValidator_;
+		AdmissionControl::SPtr admissionControl_;
+		SecureChannelCapture::SPtr secureChannelCapture_;
 	};
 
 }
@@ -147,12 +147,13 @@ namespace OpcUaStackServer
 		if (eventNotificationList->events()->size() > 0) {
 			actMaxKeepAliveCount_ = maxKeepAliveCount_;
 
-			uint32_t sequencenumber = acknowledgementManager_.nextSequenceNumber();
-			acknowledgementManager_.addNotification(sequencenumber, extensibleParameter);
-
 			PublishResponse::SPtr publishResponse = trx->response();
 			publishResponse->notificationMessage()->notificationData()->set(0, extensibleParameter);
 			publishResponse->notificationMessage()->publishTime().dateTime(boost::posix_time::microsec_clock::local_time());
+
+			// the notification is kept for a republish until it is acknowledged
+			uint32_t sequencenumber = acknowledgementManager_.nextSequenceNumber();
+			acknowledgementManager_.addNotification(sequencenumber, publishResponse->notificationMessage()->publishTime(), extensibleParameter);
 			publishResponse->notificationMessage()->sequenceNumber(sequencenumber);
 			publishResponse->subscriptionId(subscriptionId_);
 			publishResponse->moreNotifications(false);
@@ -173,12 +174,13 @@ namespace OpcUaStackServer
 		if (dataChangeNotification->monitoredItems()->size() > 0) {
 			actMaxKeepAliveCount_ = maxKeepAliveCount_;
 
-			uint32_t sequencenumber = acknowledgementManager_.nextSequenceNumber();
-			acknowledgementManager_.addNotification(sequencenumber, extensibleParameter);
-
 			PublishResponse::SPtr publishResponse = trx->response();
 			publishResponse->notificationMessage()->notificationData()->set(0, extensibleParameter);
 			publishResponse->notificationMessage()->publishTime().dateTime(boost::posix_time::microsec_clock::local_time());
+
+			// the notification is kept for a republish until it is acknowledged
+			uint32_t sequencenumber = acknowledgementManager_.nextSequenceNumber();
+			acknowledgementManager_.addNotification(sequencenumber, publishResponse->notificationMessage()->publishTime(), extensibleParameter);
 			publishResponse->notificationMessage()->sequenceNumber(sequencenumber);
 			publishResponse->subscriptionId(subscriptionId_);
 			publishResponse->moreNotifications(false);
@@ -273,4 +275,26 @@ namespace OpcUaStackServer
 	{
 		return monitorManager_.receive(trx);
 	}
+
+	OpcUaStatusCode
+	Subscription::receive(ServiceTransactionRepublish::SPtr trx)
+	{
+		RepublishRequest::SPtr republishRequest = trx->request();
+		RepublishResponse::SPtr republishResponse = trx->response();
+
+		// the notifications which are not acknowledged by the client can be
+		// sent again. This includes publish responses which are dropped from
+		// the send queue of a slow secure channel
+		UtcTime publishTime;
+		ExtensibleParameter::SPtr notification;
+		if (!acknowledgementManager_.getNotification(republishRequest->retransmitSequenceNumber(), publishTime, notification)) {
+			return BadMessageNotAvailable;
+		}
+
+		NotificationMessage::SPtr notificationMessage = republishResponse->notificationMessage();
+		notificationMessage->sequenceNumber(republishRequest->retransmitSequenceNumber());
+		notificationMessage->publishTime() = publishTime;
+		notificationMessage->notificationData()->set(0, notification);
+		return Success;
+	}
 }
@@ -76,6 +76,7 @@ namespace OpcUaStackServer
 		OpcUaStatusCode receive(ServiceTransactionModifyMonitoredItems::SPtr trx);
 		OpcUaStatusCode receive(ServiceTransactionSetMonitoringMode::SPtr trx);
 		OpcUaStatusCode receive(ServiceTransactionSetTriggering::SPtr trx);
+		OpcUaStatusCode receive(ServiceTransactionRepublish::SPtr trx);
 
 		SlotTimerElement::SPtr slotTimerElement(void);
 
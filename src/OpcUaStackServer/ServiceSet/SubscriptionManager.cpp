@@ -63,12 +63,16 @@ namespace OpcUaStackServer
 	uint32_t 
 	SubscriptionManager::size(void)
 	{
+		boost::mutex::scoped_lock g(mutex_);
+
 		return subscriptionMap_.size();
 	}
 
 	OpcUaStatusCode 
 	SubscriptionManager::receive(ServiceTransactionCreateSubscription::SPtr trx)
 	{
+		boost::mutex::scoped_lock g(mutex_);
+
 		CreateSubscriptionRequest::SPtr createSubscriptionRequest = trx->request();
 		CreateSubscriptionResponse::SPtr createSubscriptionResponse = trx->response();
 
@@ -116,6 +120,9 @@ namespace OpcUaStackServer
 	OpcUaStatusCode 
 	SubscriptionManager::receive(ServiceTransactionDeleteSubscriptions::SPtr trx)
 	{
+		ServiceTransactionPublishList serviceTransactionPublishList;
+		boost::mutex::scoped_lock g(mutex_);
+
 		DeleteSubscriptionsRequest::SPtr deleteSubscriptionsRequest = trx->request();
 		DeleteSubscriptionsResponse::SPtr deleteSubscriptionsResponse = trx->response();
 
@@ -142,16 +149,18 @@ namespace OpcUaStackServer
 
 		if (subscriptionMap_.size() == 0) {
 			// answer all open publish requests with status code BadNoSubscriptions
+			serviceTransactionPublishList.swap(serviceTransactionPublishList_);
+		}
 
-			while (serviceTransactionPublishList_.size() != 0) {
-				ServiceTransactionPublish::SPtr trx = serviceTransactionPublishList_.front();
-				serviceTransactionPublishList_.pop_front();
+		// the responses are sent without holding the lock, because the
+		// session can call back into the subscription manager
+		g.unlock();
+		while (serviceTransactionPublishList.size() != 0) {
+			ServiceTransactionPublish::SPtr trx = serviceTransactionPublishList.front();
+			serviceTransactionPublishList.pop_front();
 
-				OpcUaNodeId typeId;
-				typeId.set(OpcUaId_PublishResponse_Encoding_DefaultBinary);
-				trx->statusCode(BadNoSubscription);
-				trx->componentSession()->send(trx);
-			}
+			trx->statusCode(BadNoSubscription);
+			trx->componentSession()->send(trx);
 		}
 	
 		return Success;
@@ -160,6 +169,8 @@ namespace OpcUaStackServer
 	OpcUaStatusCode 
 	SubscriptionManager::receive(ServiceTransactionPublish::SPtr trx)
 	{
+		boost::mutex::scoped_lock g(mutex_);
+
 		// get publish request
 		PublishRequest::SPtr publishRequest = trx->request();
 
@@ -184,9 +195,31 @@ namespace OpcUaStackServer
 		return Success;
 	}
 
+	OpcUaStatusCode
+	SubscriptionManager::receive(ServiceTransactionRepublish::SPtr trx)
+	{
+		boost::mutex::scoped_lock g(mutex_);
+
+		RepublishRequest::SPtr republishRequest = trx->request();
+
+		SubscriptionMap::iterator it;
+		it = subscriptionMap_.find(republishRequest->subscriptionId());
+		if (it == subscriptionMap_.end()) return BadSubscriptionIdInvalid;
+		return it->second->receive(trx);
+	}
+
 	void 
 	SubscriptionManager::subscriptionPublishTimeout(Subscription::SPtr subscription)
 	{
+		boost::mutex::scoped_lock g(mutex_);
+
+		// the timer can expire once more after the subscription has
+		// been deleted
+		SubscriptionMap::iterator it = subscriptionMap_.find(subscription->subscriptionId());
+		if (it == subscriptionMap_.end() || it->second != subscription) {
+			return;
+		}
+
 		ServiceTransactionPublish::SPtr trx;
 		if (serviceTransactionPublishList_.size() != 0) {
 		    trx = serviceTransactionPublishList_.front();
@@ -219,8 +252,8 @@ namespace OpcUaStackServer
 					.parameter("SequenceNumber", trx->response()->notificationMessage()->sequenceNumber())
 					.parameter("Unack-SequenceNumber", *trx->response()->availableSequenceNumbers());
 
-				OpcUaNodeId typeId;
-				typeId.set(OpcUaId_PublishResponse_Encoding_DefaultBinary);
+				// send the response without holding the lock
+				g.unlock();
 				trx->statusCode(Success);
 				trx->componentSession()->send(trx);
 				break;
@@ -243,6 +276,8 @@ namespace OpcUaStackServer
 	OpcUaStatusCode 
 	SubscriptionManager::receive(ServiceTransactionCreateMonitoredItems::SPtr trx)
 	{
+		boost::mutex::scoped_lock g(mutex_);
+
 		CreateMonitoredItemsRequest::SPtr createMonitoredItemsRequest = trx->request();
 
 		SubscriptionMap::iterator it;
@@ -254,6 +289,8 @@ namespace OpcUaStackServer
 	OpcUaStatusCode 
 	SubscriptionManager::receive(ServiceTransactionDeleteMonitoredItems::SPtr trx)
 	{
+		boost::mutex::scoped_lock g(mutex_);
+
 		DeleteMonitoredItemsRequest::SPtr deleteMonitoredItemsRequest = trx->request();
 
 		SubscriptionMap::iterator it;
@@ -265,6 +302,8 @@ namespace OpcUaStackServer
 	OpcUaStatusCode 
 	SubscriptionManager::receive(ServiceTransactionModifyMonitoredItems::SPtr trx)
 	{
+		boost::mutex::scoped_lock g(mutex_);
+
 		ModifyMonitoredItemsRequest::SPtr modifyMonitoredItemsRequest = trx->request();
 
 		SubscriptionMap::iterator it;
@@ -276,6 +315,8 @@ namespace OpcUaStackServer
 	OpcUaStatusCode 
 	SubscriptionManager::receive(ServiceTransactionSetMonitoringMode::SPtr trx)
 	{
+		boost::mutex::scoped_lock g(mutex_);
+
 		SetMonitoringModeRequest::SPtr setMonitoringModeRequest = trx->request();
 
 		SubscriptionMap::iterator it;
@@ -287,6 +328,8 @@ namespace OpcUaStackServer
 	OpcUaStatusCode 
 	SubscriptionManager::receive(ServiceTransactionSetTriggering::SPtr trx)
 	{
+		boost::mutex::scoped_lock g(mutex_);
+
 		SetTriggeringRequest::SPtr setTriggeringRequest = trx->request();
 
 		SubscriptionMap::iterator it;
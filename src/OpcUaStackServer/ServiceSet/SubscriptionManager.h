@@ -30,6 +30,7 @@
 #include "OpcUaStackServer/InformationModel/InformationModel.h"
 
 #include <set>
+#include <boost/thread/mutex.hpp>
 
 using namespace OpcUaStackCore;
 
@@ -56,6 +57,7 @@ namespace OpcUaStackServer
 		OpcUaStatusCode receive(ServiceTransactionCreateSubscription::SPtr trx);
 		OpcUaStatusCode receive(ServiceTransactionDeleteSubscriptions::SPtr trx);
 		OpcUaStatusCode receive(ServiceTransactionPublish::SPtr trx);
+		OpcUaStatusCode receive(ServiceTransactionRepublish::SPtr trx);
 
 		OpcUaStatusCode receive(ServiceTransactionCreateMonitoredItems::SPtr trx);
 		OpcUaStatusCode receive(ServiceTransactionDeleteMonitoredItems::SPtr trx);
@@ -81,6 +83,10 @@ namespace OpcUaStackServer
 		double minPublishingInterval_;
 		uint32_t minLifetimeCount_;
 		uint32_t minMaxKeepAliveCount_;
+
+		// protects the subscription map and the publish list against
+		// concurrent access from io threads and the slot timer
+		boost::mutex mutex_;
 	};
 
 }
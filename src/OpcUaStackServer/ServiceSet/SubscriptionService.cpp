@@ -109,6 +109,7 @@ namespace OpcUaStackServer
 
 		// find subscription manager
 		SubscriptionManager::SPtr subscriptionManager;
+		boost::mutex::scoped_lock g(mutex_);
 		SubscriptionManagerMap::iterator it = subscriptionManagerMap_.find(trx->sessionId());
 		if (it == subscriptionManagerMap_.end()) {
 			subscriptionManager = constructSPtr<SubscriptionManager>();
@@ -122,7 +123,13 @@ namespace OpcUaStackServer
 			subscriptionManager = it->second;
 		}
 
-		serviceTransaction->statusCode(subscriptionManager->receive(trx));
+		// the subscription is created while the lock is held. Otherwise a
+		// concurrent delete subscriptions request could remove the still
+		// empty subscription manager from the map
+		OpcUaStatusCode statusCode = subscriptionManager->receive(trx);
+		g.unlock();
+
+		serviceTransaction->statusCode(statusCode);
 		serviceTransaction->componentSession()->send(serviceTransaction);
 	}
 
@@ -137,19 +144,21 @@ namespace OpcUaStackServer
 			.parameter("Trx", serviceTransaction->transactionId());
 
 		// find subscription manager
-		SubscriptionManager::SPtr subscriptionManager;
-		SubscriptionManagerMap::iterator it = subscriptionManagerMap_.find(trx->sessionId());
-		if (it == subscriptionManagerMap_.end()) {
+		SubscriptionManager::SPtr subscriptionManager = findSubscriptionManager(trx->sessionId());
+		if (subscriptionManager.get() == nullptr) {
 			serviceTransaction->statusCode(BadNothingToDo);
 			serviceTransaction->componentSession()->send(serviceTransaction);
 			return;
 		}
-		subscriptionManager = it->second;
 		
 		serviceTransaction->statusCode(subscriptionManager->receive(trx));
 		serviceTransaction->componentSession()->send(serviceTransaction);
 
-		if (subscriptionManager->size() == 0) {
+		// the size is checked again under the lock, because subscriptions
+		// are only added to a subscription manager while the lock is held
+		boost::mutex::scoped_lock g(mutex_);
+		SubscriptionManagerMap::iterator it = subscriptionManagerMap_.find(trx->sessionId());
+		if (it != subscriptionManagerMap_.end() && it->second == subscriptionManager && subscriptionManager->size() == 0) {
 			subscriptionManagerMap_.erase(it);
 		}
 	}
@@ -183,14 +192,12 @@ namespace OpcUaStackServer
 		}
 
 		// find subscription manager
-		SubscriptionManager::SPtr subscriptionManager;
-		SubscriptionManagerMap::iterator it = subscriptionManagerMap_.find(trx->sessionId());
-		if (it == subscriptionManagerMap_.end()) {
+		SubscriptionManager::SPtr subscriptionManager = findSubscriptionManager(trx->sessionId());
+		if (subscriptionManager.get() == nullptr) {
 			serviceTransaction->statusCode(BadNothingToDo);
 			serviceTransaction->componentSession()->send(serviceTransaction);
 			return;
 		}
-		subscriptionManager = it->second;
 
 		subscriptionManager->receive(trx);
 	}
@@ -206,8 +213,16 @@ namespace OpcUaStackServer
 		    .parameter("Trx", serviceTransaction->transactionId())
 		    .parameter("SequenceNumber", republishRequest->retransmitSequenceNumber());
 
-		// FIXME:
-		serviceTransaction->statusCode(BadMessageNotAvailable);
+		// find subscription manager
+		SubscriptionManager::SPtr subscriptionManager = findSubscriptionManager(trx->sessionId());
+		if (subscriptionManager.get() == nullptr) {
+			serviceTransaction->statusCode(BadSubscriptionIdInvalid);
+			serviceTransaction->componentSession()->send(serviceTransaction);
+			return;
+		}
+
+		// call service function in subscription manager
+		serviceTransaction->statusCode(subscriptionManager->receive(trx));
 		serviceTransaction->componentSession()->send(serviceTransaction);
 	}
 
@@ -242,14 +257,12 @@ namespace OpcUaStackServer
 		ServiceTransactionCreateMonitoredItems::SPtr trx = boost::static_pointer_cast<ServiceTransactionCreateMonitoredItems>(serviceTransaction);
 
 		// find subscription manager
-		SubscriptionManager::SPtr subscriptionManager;
-		SubscriptionManagerMap::iterator it = subscriptionManagerMap_.find(trx->sessionId());
-		if (it == subscriptionManagerMap_.end()) {
+		SubscriptionManager::SPtr subscriptionManager = findSubscriptionManager(trx->sessionId());
+		if (subscriptionManager.get() == nullptr) {
 			serviceTransaction->statusCode(BadSubscriptionIdInvalid);
 			serviceTransaction->componentSession()->send(serviceTransaction);
 			return;
 		}
-		subscriptionManager = it->second;
 		
 		// call service function in subscription manager
 		serviceTransaction->statusCode(subscriptionManager->receive(trx));
@@ -262,14 +275,12 @@ namespace OpcUaStackServer
 		ServiceTransactionDeleteMonitoredItems::SPtr trx = boost::static_pointer_cast<ServiceTransactionDeleteMonitoredItems>(serviceTransaction);
 		
 		// find subscription manager
-		SubscriptionManager::SPtr subscriptionManager;
-		SubscriptionManagerMap::iterator it = subscriptionManagerMap_.find(trx->sessionId());
-		if (it == subscriptionManagerMap_.end()) {
+		SubscriptionManager::SPtr subscriptionManager = findSubscriptionManager(trx->sessionId());
+		if (subscriptionManager.get() == nullptr) {
 			serviceTransaction->statusCode(BadSubscriptionIdInvalid);
 			serviceTransaction->componentSession()->send(serviceTransaction);
 			return;
 		}
-		subscriptionManager = it->second;
 		
 		// call service function in subscription manager
 		serviceTransaction->statusCode(subscriptionManager->receive(trx));
@@ -282,14 +293,12 @@ namespace OpcUaStackServer
 		ServiceTransactionModifyMonitoredItems::SPtr trx = boost::static_pointer_cast<ServiceTransactionModifyMonitoredItems>(serviceTransaction);
 
 		// find subscription manager
-		SubscriptionManager::SPtr subscriptionManager;
-		SubscriptionManagerMap::iterator it = subscriptionManagerMap_.find(trx->sessionId());
-		if (it == subscriptionManagerMap_.end()) {
+		SubscriptionManager::SPtr subscriptionManager = findSubscriptionManager(trx->sessionId());
+		if (subscriptionManager.get() == nullptr) {
 			serviceTransaction->statusCode(BadSubscriptionIdInvalid);
 			serviceTransaction->componentSession()->send(serviceTransaction);
 			return;
 		}
-		subscriptionManager = it->second;
 		
 		// call service function in subscription manager
 		serviceTransaction->statusCode(subscriptionManager->receive(trx));
@@ -302,14 +311,12 @@ namespace OpcUaStackServer
 		ServiceTransactionSetMonitoringMode::SPtr trx = boost::static_pointer_cast<ServiceTransactionSetMonitoringMode>(serviceTransaction);
 
 		// find subscription manager
-		SubscriptionManager::SPtr subscriptionManager;
-		SubscriptionManagerMap::iterator it = subscriptionManagerMap_.find(trx->sessionId());
-		if (it == subscriptionManagerMap_.end()) {
+		SubscriptionManager::SPtr subscriptionManager = findSubscriptionManager(trx->sessionId());
+		if (subscriptionManager.get() == nullptr) {
 			serviceTransaction->statusCode(BadSubscriptionIdInvalid);
 			serviceTransaction->componentSession()->send(serviceTransaction);
 			return;
 		}
-		subscriptionManager = it->second;
 		
 		// call service function in subscription manager
 		serviceTransaction->statusCode(subscriptionManager->receive(trx));
@@ -322,18 +329,29 @@ namespace OpcUaStackServer
 		ServiceTransactionSetTriggering::SPtr trx = boost::static_pointer_cast<ServiceTransactionSetTriggering>(serviceTransaction);
 
 		// find subscription manager
-		SubscriptionManager::SPtr subscriptionManager;
-		SubscriptionManagerMap::iterator it = subscriptionManagerMap_.find(trx->sessionId());
-		if (it == subscriptionManagerMap_.end()) {
+		SubscriptionManager::SPtr subscriptionManager = findSubscriptionManager(trx->sessionId());
+		if (subscriptionManager.get() == nullptr) {
 			serviceTransaction->statusCode(BadSubscriptionIdInvalid);
 			serviceTransaction->componentSession()->send(serviceTransaction);
 			return;
 		}
-		subscriptionManager = it->second;
 		
 		// call service function in subscription manager
 		serviceTransaction->statusCode(subscriptionManager->receive(trx));
 		serviceTransaction->componentSession()->send(serviceTransaction);
 	}
 
+	SubscriptionManager::SPtr
+	SubscriptionService::findSubscriptionManager(uint32_t sessionId)
+	{
+		boost::mutex::scoped_lock g(mutex_);
+
+		SubscriptionManagerMap::iterator it = subscriptionManagerMap_.find(sessionId);
+		if (it == subscriptionManagerMap_.end()) {
+			SubscriptionManager::SPtr subscriptionManager;
+			return subscriptionManager;
+		}
+		return it->second;
+	}
+
 }
@@ -65,6 +65,9 @@ namespace OpcUaStackServer
 		void receiveSetMonitoringModeRequest(ServiceTransaction::SPtr serviceTransaction);
 		void receiveSetTriggeringRequest(ServiceTransaction::SPtr serviceTransaction);
 
+		SubscriptionManager::SPtr findSubscriptionManager(uint32_t sessionId);
+
+		boost::mutex mutex_;
 		SubscriptionManagerMap subscriptionManagerMap_;
 	};
 
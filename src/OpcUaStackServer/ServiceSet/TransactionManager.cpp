@@ -21,7 +21,8 @@ namespace OpcUaStackServer
 {
 
 	TransactionManager::TransactionManager(void)
-	: serviceTransactionMap_()
+	: serviceTransactionVec_()
+	, serviceTransactionMap_()
 	{
 	}
 
@@ -32,23 +33,21 @@ namespace OpcUaStackServer
 	bool 
 	TransactionManager::registerTransaction(ServiceTransaction::SPtr serviceTransactionSPtr)
 	{
-		ServiceTransactionMap::iterator it;
 		OpcUaNodeId typeIdRequest = serviceTransactionSPtr->nodeTypeRequest();
 		OpcUaNodeId typeIdResponse = serviceTransactionSPtr->nodeTypeResponse();
 
-		it = serviceTransactionMap_.find(typeIdRequest);
-		if (it != serviceTransactionMap_.end()) {
+		if (findTransaction(typeIdRequest).get() != nullptr) {
 			return false;
 		}
-
-		it = serviceTransactionMap_.find(typeIdResponse);
-		if (it != serviceTransactionMap_.end()) {
+		if (findTransaction(typeIdResponse).get() != nullptr) {
 			return false;
 		}
 
-		serviceTransactionMap_.insert(std::make_pair(typeIdRequest, serviceTransactionSPtr));
-		serviceTransactionMap_.insert(std::make_pair(typeIdResponse, serviceTransactionSPtr));
-		return false;
+		// the result is true for a new service type and false for a type
+		// that is already registered
+		insertTransaction(typeIdRequest, serviceTransactionSPtr);
+		insertTransaction(typeIdResponse, serviceTransactionSPtr);
+		return true;
 	}
 		
 	ServiceTransaction::SPtr 
@@ -56,15 +55,58 @@ namespace OpcUaStackServer
 	{
 		ServiceTransaction::SPtr serviceTransactionSPtr;
 
-		ServiceTransactionMap::iterator it;
-		it = serviceTransactionMap_.find(typeId);
-		if (it == serviceTransactionMap_.end()) {
+		ServiceTransaction::SPtr prototype = findTransaction(typeId);
+		if (prototype.get() == nullptr) {
 			return serviceTransactionSPtr;
 		}
 
-		serviceTransactionSPtr = it->second->constructTransaction();
-		serviceTransactionSPtr->componentService(it->second->componentService());
+		serviceTransactionSPtr = prototype->constructTransaction();
+		serviceTransactionSPtr->componentService(prototype->componentService());
 		return serviceTransactionSPtr;
 	}
 
+	bool
+	TransactionManager::tableIndex(OpcUaNodeId& typeId, uint32_t& index)
+	{
+		if (typeId.namespaceIndex() != 0 || typeId.nodeIdType() != OpcUaBuildInType_OpcUaUInt32) {
+			return false;
+		}
+
+		index = typeId.nodeId<OpcUaUInt32>();
+		return index < MaxTableSize;
+	}
+
+	ServiceTransaction::SPtr
+	TransactionManager::findTransaction(OpcUaNodeId& typeId)
+	{
+		uint32_t index;
+		if (tableIndex(typeId, index)) {
+			if (index < serviceTransactionVec_.size()) {
+				return serviceTransactionVec_[index];
+			}
+			return ServiceTransaction::SPtr();
+		}
+
+		ServiceTransactionMap::iterator it = serviceTransactionMap_.find(typeId);
+		if (it == serviceTransactionMap_.end()) {
+			return ServiceTransaction::SPtr();
+		}
+		return it->second;
+	}
+
+	void
+	TransactionManager::insertTransaction(OpcUaNodeId& typeId, ServiceTransaction::SPtr& serviceTransaction)
+	{
+		uint32_t index;
+		if (tableIndex(typeId, index)) {
+			if (index >= serviceTransactionVec_.size()) {
+				serviceTransactionVec_.resize(index + 1);
+			}
+			serviceTransactionVec_[index] = serviceTransaction;
+			return;
+		}
+
+		serviceTransactionMap_.insert(std::make_pair(typeId, serviceTransaction));
+	}
+
 }
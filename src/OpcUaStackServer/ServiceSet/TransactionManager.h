@@ -18,6 +18,7 @@
 #ifndef __OpcUaStackServer_TransactionManager_h__
 #define __OpcUaStackServer_TransactionManager_h__
 
+#include <vector>
 #include "OpcUaStackCore/Base/os.h"
 #include "OpcUaStackCore/Base/ObjectPool.h"
 #include "OpcUaStackCore/ServiceSet/ServiceTransaction.h"
@@ -27,12 +28,20 @@ using namespace OpcUaStackCore;
 namespace OpcUaStackServer
 {
 
+	//
+	// the transaction manager creates the service transaction of an incoming
+	// request. The prototype transactions of the service types are found in
+	// a table that is indexed by the numeric binary encoding id of the
+	// request and the response.
+	//
 	class DLLEXPORT TransactionManager
 	: public Object
 	{
 	  public:
 		typedef boost::shared_ptr<TransactionManager> SPtr;
 
+		static const uint32_t MaxTableSize = 0x10000;
+
 		TransactionManager(void);
 		~TransactionManager(void);
 
@@ -40,7 +49,13 @@ namespace OpcUaStackServer
 		ServiceTransaction::SPtr getTransaction(OpcUaNodeId& typeId);
 
 	  private:
+		bool tableIndex(OpcUaNodeId& typeId, uint32_t& index);
+		ServiceTransaction::SPtr findTransaction(OpcUaNodeId& typeId);
+		void insertTransaction(OpcUaNodeId& typeId, ServiceTransaction::SPtr& serviceTransaction);
+
+		typedef std::vector<ServiceTransaction::SPtr> ServiceTransactionVec;
 		typedef std::map<OpcUaNodeId, ServiceTransaction::SPtr> ServiceTransactionMap;
+		ServiceTransactionVec serviceTransactionVec_;
 		ServiceTransactionMap serviceTransactionMap_;
 	};
 
@@ -134,4 +134,41 @@ BOOST_AUTO_TEST_CASE(Url_check_function)
 	BOOST_REQUIRE(url.isHostAddress() == false);
 }
 
+BOOST_AUTO_TEST_CASE(Url_local_transport)
+{
+	Url url;
+
+	url.url("opc.unix:///var/run/opcua.sock");
+	BOOST_REQUIRE(url.good() == true);
+	BOOST_REQUIRE(url.isUnixSocket() == true);
+	BOOST_REQUIRE(url.unixSocketPath() == "/var/run/opcua.sock");
+
+	url.url("opc.unix://localhost/tmp/opcua.sock");
+	BOOST_REQUIRE(url.good() == true);
+	BOOST_REQUIRE(url.isUnixSocket() == true);
+	BOOST_REQUIRE(url.unixSocketPath() == "/tmp/opcua.sock");
+
+	url.url("opc.shm:///tmp/opcua.sock");
+	BOOST_REQUIRE(url.good() == true);
+	BOOST_REQUIRE(url.isUnixSocket() == false);
+	BOOST_REQUIRE(url.isSharedMemory() == true);
+	BOOST_REQUIRE(url.unixSocketPath() == "/tmp/opcua.sock");
+
+	url.url("opc.mem://server");
+	BOOST_REQUIRE(url.good() == true);
+	BOOST_REQUIRE(url.isMemory() == true);
+	BOOST_REQUIRE(url.isSharedMemory() == false);
+	BOOST_REQUIRE(url.memoryName() == "server");
+
+	url.url("opc.mem://server:4841/path");
+	BOOST_REQUIRE(url.good() == true);
+	BOOST_REQUIRE(url.isMemory() == true);
+	BOOST_REQUIRE(url.memoryName() == "server:4841/path");
+
+	url.url("opc.tcp://127.0.0.1:4841");
+	BOOST_REQUIRE(url.isUnixSocket() == false);
+	BOOST_REQUIRE(url.isSharedMemory() == false);
+	BOOST_REQUIRE(url.isMemory() == false);
+}
+
 BOOST_AUTO_TEST_SUITE_END()
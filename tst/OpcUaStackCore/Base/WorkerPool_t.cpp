@@ -0,0 +1,115 @@
+#include "unittest.h"
+#include "OpcUaStackCore/Base/WorkerPool.h"
+#include "OpcUaStackCore/Base/Condition.h"
+
+
+using namespace OpcUaStackCore;
+
+BOOST_AUTO_TEST_SUITE(WorkerPool_t)
+
+class TestWorkerPool
+{
+  public:
+
+	TestWorkerPool(void)
+	: condition_(0, 0)
+	, release_(0, 0)
+	{
+	}
+
+	void run(void) {
+		condition_.conditionValueInc();
+	}
+
+	void block(void) {
+		release_.waitForCondition(5000);
+		condition_.conditionValueInc();
+	}
+
+	Condition condition_;
+	Condition release_;
+};
+
+BOOST_AUTO_TEST_CASE(WorkerPool_)
+{
+	std::cout << "WorkerPool_t" << std::endl;
+}
+
+BOOST_AUTO_TEST_CASE(WorkerPool_construct_destruct)
+{
+	WorkerPool workerPool("Test");
+}
+
+BOOST_AUTO_TEST_CASE(WorkerPool_post_without_startup)
+{
+	WorkerPool workerPool("Test");
+	TestWorkerPool testWorkerPool;
+
+	BOOST_REQUIRE(workerPool.post(boost::bind(&TestWorkerPool::run, &testWorkerPool)) == false);
+}
+
+BOOST_AUTO_TEST_CASE(WorkerPool_run_tasks)
+{
+	WorkerPool workerPool("Test");
+	TestWorkerPool testWorkerPool;
+
+	workerPool.startup(4, 0);
+	testWorkerPool.condition_.condition(0, 100);
+	for (uint32_t idx=0; idx<100; idx++) {
+		BOOST_REQUIRE(workerPool.post(boost::bind(&TestWorkerPool::run, &testWorkerPool)) == true);
+	}
+	BOOST_REQUIRE(testWorkerPool.condition_.waitForCondition(1000));
+	workerPool.shutdown();
+
+	BOOST_REQUIRE(workerPool.rejectCount() == 0);
+	BOOST_REQUIRE(workerPool.queueLength() == 0);
+}
+
+BOOST_AUTO_TEST_CASE(WorkerPool_reject_task)
+{
+	WorkerPool workerPool("Test");
+	TestWorkerPool testWorkerPool;
+
+	workerPool.startup(1, 2);
+	testWorkerPool.condition_.condition(0, 2);
+	testWorkerPool.release_.condition(0, 1);
+
+	// the first task blocks the only thread and the second task waits
+	BOOST_REQUIRE(workerPool.post(boost::bind(&TestWorkerPool::block, &testWorkerPool)) == true);
+	BOOST_REQUIRE(workerPool.post(boost::bind(&TestWorkerPool::run, &testWorkerPool)) == true);
+	BOOST_REQUIRE(workerPool.queueLength() == 2);
+
+	// the queue is full
+	BOOST_REQUIRE(workerPool.post(boost::bind(&TestWorkerPool::run, &testWorkerPool)) == false);
+	BOOST_REQUIRE(workerPool.rejectCount() == 1);
+
+	testWorkerPool.release_.conditionValueInc();
+	BOOST_REQUIRE(testWorkerPool.condition_.waitForCondition(1000));
+	workerPool.shutdown();
+
+	BOOST_REQUIRE(workerPool.maxQueueLengthObserved() == 2);
+}
+
+BOOST_AUTO_TEST_CASE(WorkerPool_shutdown_queued_tasks)
+{
+	WorkerPool workerPool("Test");
+	TestWorkerPool testWorkerPool;
+
+	workerPool.startup(1, 0);
+	testWorkerPool.condition_.condition(0, 11);
+	testWorkerPool.release_.condition(0, 1);
+
+	// the queued tasks are finished by the shutdown
+	BOOST_REQUIRE(workerPool.post(boost::bind(&TestWorkerPool::block, &testWorkerPool)) == true);
+	for (uint32_t idx=0; idx<10; idx++) {
+		BOOST_REQUIRE(workerPool.post(boost::bind(&TestWorkerPool::run, &testWorkerPool)) == true);
+	}
+	testWorkerPool.release_.conditionValueInc();
+	workerPool.shutdown();
+
+	BOOST_REQUIRE(testWorkerPool.condition_.conditionValue() == 11);
+	BOOST_REQUIRE(workerPool.queueLength() == 0);
+	BOOST_REQUIRE(workerPool.post(boost::bind(&TestWorkerPool::run, &testWorkerPool)) == false);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -1,6 +1,7 @@
 #include "unittest.h"
 #include "OpcUaStackCore/BuildInTypes/OpcUaDataValue.h"
 #include "OpcUaStackCore/Base/Utility.h"
+#include "OpcUaStackCore/ServiceSet/TimestampsToReturn.h"
 #include <boost/iostreams/stream.hpp>
 #include <boost/property_tree/ptree.hpp>
 
@@ -241,6 +242,65 @@ BOOST_AUTO_TEST_CASE(OpcUaDataValue_copyTo_string)
 	BOOST_REQUIRE(value2.serverPicoseconds() == 5678);
 }
 
+BOOST_AUTO_TEST_CASE(OpcUaDataValue_timestampsToReturn_neither)
+{
+	boost::posix_time::ptime ptime1 = boost::posix_time::from_iso_string("20140506T102013.123456789");
+	boost::posix_time::ptime ptime2 = boost::posix_time::from_iso_string("20140506T102014.123456789");
+	std::stringstream ss1, ss2;
+	OpcUaDataValue value1, value2, value3;
+
+	value1.variant()->variant((OpcUaUInt16)1234);
+	value1.sourceTimestamp().dateTime(ptime1);
+	value1.serverTimestamp().dateTime(ptime2);
+
+	value1.opcUaBinaryEncode(ss1);
+	BOOST_REQUIRE(count(ss1) == 20);
+
+	value1.copyTo(value2);
+	value2.timestampsToReturn(TimestampsToReturn_Neither);
+	BOOST_REQUIRE(value2.sourceTimestamp().exist() == false);
+	BOOST_REQUIRE(value2.serverTimestamp().exist() == false);
+
+	value2.opcUaBinaryEncode(ss2);
+	BOOST_REQUIRE(count(ss2) == 4);
+
+	value3.opcUaBinaryDecode(ss2);
+	BOOST_REQUIRE(value3.variant()->variant<OpcUaUInt16>() == 1234);
+	BOOST_REQUIRE(value3.sourceTimestamp().exist() == false);
+	BOOST_REQUIRE(value3.serverTimestamp().exist() == false);
+
+	// the original value is not changed
+
+	BOOST_REQUIRE(boost::posix_time::to_iso_string(value1.sourceTimestamp().dateTime()) == "20140506T102013.123456");
+	BOOST_REQUIRE(boost::posix_time::to_iso_string(value1.serverTimestamp().dateTime()) == "20140506T102014.123456");
+}
+
+BOOST_AUTO_TEST_CASE(OpcUaDataValue_encode_timestampsToReturn_source)
+{
+	boost::posix_time::ptime ptime1 = boost::posix_time::from_iso_string("20140506T102013.123456789");
+	boost::posix_time::ptime ptime2 = boost::posix_time::from_iso_string("20140506T102014.123456789");
+	std::stringstream ss;
+	OpcUaDataValue value1, value2;
+
+	value1.variant()->variant((OpcUaUInt16)1234);
+	value1.sourceTimestamp().dateTime(ptime1);
+	value1.sourcePicoseconds(1234);
+	value1.serverTimestamp().dateTime(ptime2);
+	value1.serverPicoseconds(5678);
+
+	value1.opcUaBinaryEncode(ss, TimestampsToReturn_Source);
+	value2.opcUaBinaryDecode(ss);
+
+	// the encoded value is not changed
+	BOOST_REQUIRE(value1.serverTimestamp().exist() == true);
+	BOOST_REQUIRE(value1.serverPicoseconds() == 5678);
+
+	BOOST_REQUIRE(boost::posix_time::to_iso_string(value2.sourceTimestamp().dateTime()) == "20140506T102013.123456");
+	BOOST_REQUIRE(value2.sourcePicoseconds() == 1234);
+	BOOST_REQUIRE(value2.serverTimestamp().exist() == false);
+	BOOST_REQUIRE(value2.serverPicoseconds() == 0);
+}
+
 #if 0
 BOOST_AUTO_TEST_CASE(OpcUaDataValue_string_array_with_timestamp)
 {
@@ -0,0 +1,147 @@
+#include <iostream>
+#include <boost/filesystem.hpp>
+#include <boost/thread/thread.hpp>
+
+#include "unittest.h"
+#include "OpcUaStackCore/Certificate/CertificateValidator.h"
+
+using namespace OpcUaStackCore;
+
+BOOST_AUTO_TEST_SUITE(CertificateValidator_)
+
+static Certificate::SPtr
+createCertificate(uint32_t serialNumber, uint32_t validTime = 3600*24*365*5)
+{
+	RSAKey key(2048);
+	CertificateInfo info;
+	Identity identity;
+
+	info.uri("urn:localhost:ASNeG:MyServiceApplication");
+	info.ipAddresses().push_back("127.0.0.1");
+	info.dnsNames().push_back("ASNeG.de");
+	info.eMail("info@ASNeG.de");
+	info.validTime(boost::posix_time::microsec_clock::local_time() + boost::posix_time::seconds(validTime));
+	info.serialNumber(serialNumber);
+	info.validFrom(boost::posix_time::microsec_clock::local_time());
+
+	identity.organization("ASNeG");
+	identity.organizationUnit("OPC UA Service Department");
+	identity.commonName("MyServiceApplication");
+	identity.locality("Neukirchen");
+	identity.state("Hessen");
+	identity.country("DE");
+	identity.domainComponent("asneg.de");
+
+	return Certificate::SPtr(new Certificate(info, identity, key));
+}
+
+BOOST_AUTO_TEST_CASE(CertificateValidator_)
+{
+	std::cout << "CertificateValidator_t" << std::endl;
+}
+
+BOOST_AUTO_TEST_CASE(CertificateValidator_trusted_untrusted)
+{
+	std::string trustList = "CertificateValidatorTrustList";
+	boost::filesystem::remove_all(trustList);
+	boost::filesystem::create_directory(trustList);
+
+	Certificate::SPtr trusted = createCertificate(1);
+	Certificate::SPtr untrusted = createCertificate(2);
+	BOOST_REQUIRE(trusted->toDERFile(trustList + "/trusted.der") == true);
+
+	CertificateValidator certificateValidator;
+	certificateValidator.certificateTrustListLocation(trustList);
+
+	BOOST_REQUIRE(certificateValidator.validate(*trusted) == Success);
+	BOOST_REQUIRE(certificateValidator.validate(*untrusted) == BadCertificateUntrusted);
+	BOOST_REQUIRE(certificateValidator.cacheMisses() == 2);
+	BOOST_REQUIRE(certificateValidator.cacheHits() == 0);
+
+	// the second validation uses the cache
+	BOOST_REQUIRE(certificateValidator.validate(*trusted) == Success);
+	BOOST_REQUIRE(certificateValidator.validate(*untrusted) == BadCertificateUntrusted);
+	BOOST_REQUIRE(certificateValidator.cacheMisses() == 2);
+	BOOST_REQUIRE(certificateValidator.cacheHits() == 2);
+	BOOST_REQUIRE(certificateValidator.cacheSize() == 2);
+
+	boost::filesystem::remove_all(trustList);
+}
+
+BOOST_AUTO_TEST_CASE(CertificateValidator_invalidate)
+{
+	std::string trustList = "CertificateValidatorTrustList";
+	boost::filesystem::remove_all(trustList);
+	boost::filesystem::create_directory(trustList);
+
+	Certificate::SPtr certificate = createCertificate(1);
+
+	CertificateValidator certificateValidator;
+	certificateValidator.certificateTrustListLocation(trustList);
+	BOOST_REQUIRE(certificateValidator.validate(*certificate) == BadCertificateUntrusted);
+	uint32_t generation = certificateValidator.generation();
+
+	// trust the certificate
+	BOOST_REQUIRE(certificate->toDERFile(trustList + "/certificate.der") == true);
+	certificateValidator.invalidate();
+	BOOST_REQUIRE(certificateValidator.generation() != generation);
+	BOOST_REQUIRE(certificateValidator.cacheSize() == 0);
+	BOOST_REQUIRE(certificateValidator.validate(*certificate) == Success);
+	BOOST_REQUIRE(certificateValidator.cacheMisses() == 2);
+
+	boost::filesystem::remove_all(trustList);
+}
+
+BOOST_AUTO_TEST_CASE(CertificateValidator_cache_timeout)
+{
+	Certificate::SPtr certificate = createCertificate(1);
+
+	CertificateValidator certificateValidator;
+	certificateValidator.cacheTimeout(0);
+
+	BOOST_REQUIRE(certificateValidator.validate(*certificate) == BadCertificateUntrusted);
+	BOOST_REQUIRE(certificateValidator.validate(*certificate) == BadCertificateUntrusted);
+	BOOST_REQUIRE(certificateValidator.cacheMisses() == 2);
+	BOOST_REQUIRE(certificateValidator.cacheSize() == 0);
+}
+
+BOOST_AUTO_TEST_CASE(CertificateValidator_issuers_not_trusted)
+{
+	std::string issuers = "CertificateValidatorIssuers";
+	boost::filesystem::remove_all(issuers);
+	boost::filesystem::create_directory(issuers);
+
+	// a certificate in the issuers directory is not a trust anchor
+	Certificate::SPtr certificate = createCertificate(1);
+	BOOST_REQUIRE(certificate->toDERFile(issuers + "/certificate.der") == true);
+
+	CertificateValidator certificateValidator;
+	certificateValidator.issuersCertificatesLocation(issuers);
+	BOOST_REQUIRE(certificateValidator.validate(*certificate) == BadCertificateUntrusted);
+
+	boost::filesystem::remove_all(issuers);
+}
+
+BOOST_AUTO_TEST_CASE(CertificateValidator_cache_not_after)
+{
+	std::string trustList = "CertificateValidatorTrustList";
+	boost::filesystem::remove_all(trustList);
+	boost::filesystem::create_directory(trustList);
+
+	// the certificate expires before the cache timeout
+	Certificate::SPtr certificate = createCertificate(1, 2);
+	BOOST_REQUIRE(certificate->toDERFile(trustList + "/certificate.der") == true);
+
+	CertificateValidator certificateValidator;
+	certificateValidator.certificateTrustListLocation(trustList);
+	certificateValidator.cacheTimeout(300);
+	BOOST_REQUIRE(certificateValidator.validate(*certificate) == Success);
+
+	boost::this_thread::sleep(boost::posix_time::seconds(3));
+	BOOST_REQUIRE(certificateValidator.validate(*certificate) == BadCertificateTimeInvalid);
+	BOOST_REQUIRE(certificateValidator.cacheMisses() == 2);
+
+	boost::filesystem::remove_all(trustList);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
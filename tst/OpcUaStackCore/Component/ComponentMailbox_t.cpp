@@ -0,0 +1,104 @@
+#include "unittest.h"
+#include <boost/thread.hpp>
+#include "OpcUaStackCore/Component/ComponentMailbox.h"
+
+using namespace OpcUaStackCore;
+
+BOOST_AUTO_TEST_SUITE(ComponentMailbox_t)
+
+class TestMessage
+: public Message
+{
+  public:
+	typedef boost::shared_ptr<TestMessage> SPtr;
+
+	TestMessage(uint32_t producer, uint32_t number)
+	: producer_(producer)
+	, number_(number)
+	{
+	}
+
+	uint32_t producer_;
+	uint32_t number_;
+};
+
+void
+producer(ComponentMailbox* mailbox, uint32_t producerId, uint32_t numberMessages)
+{
+	for (uint32_t idx = 0; idx < numberMessages; idx++) {
+		Message::SPtr message(new TestMessage(producerId, idx));
+		mailbox->push(message);
+	}
+}
+
+BOOST_AUTO_TEST_CASE(ComponentMailbox_)
+{
+	std::cout << "ComponentMailbox_t" << std::endl;
+}
+
+BOOST_AUTO_TEST_CASE(ComponentMailbox_push_pop)
+{
+	ComponentMailbox mailbox;
+	Message::SPtr message;
+
+	BOOST_REQUIRE(mailbox.pop(message) == false);
+
+	producer(&mailbox, 0, 10);
+	for (uint32_t idx = 0; idx < 10; idx++) {
+		BOOST_REQUIRE(mailbox.pop(message) == true);
+		TestMessage::SPtr testMessage = boost::static_pointer_cast<TestMessage>(message);
+		BOOST_REQUIRE(testMessage->number_ == idx);
+	}
+	BOOST_REQUIRE(mailbox.pop(message) == false);
+}
+
+BOOST_AUTO_TEST_CASE(ComponentMailbox_schedule)
+{
+	ComponentMailbox mailbox;
+	Message::SPtr message;
+
+	// only the first producer starts the consumer
+	BOOST_REQUIRE(mailbox.schedule() == true);
+	BOOST_REQUIRE(mailbox.schedule() == false);
+
+	// the consumer continues if a message arrives while it stops
+	producer(&mailbox, 0, 1);
+	BOOST_REQUIRE(mailbox.unschedule() == true);
+	BOOST_REQUIRE(mailbox.pop(message) == true);
+	BOOST_REQUIRE(mailbox.unschedule() == false);
+	BOOST_REQUIRE(mailbox.schedule() == true);
+}
+
+BOOST_AUTO_TEST_CASE(ComponentMailbox_multi_producer)
+{
+	ComponentMailbox mailbox;
+	uint32_t numberProducers = 4;
+	uint32_t numberMessages = 10000;
+
+	boost::thread_group threadGroup;
+	for (uint32_t idx = 0; idx < numberProducers; idx++) {
+		threadGroup.create_thread(boost::bind(producer, &mailbox, idx, numberMessages));
+	}
+
+	// the messages of each producer are received in order
+	std::vector<uint32_t> nextNumber(numberProducers, 0);
+	uint32_t received = 0;
+	while (received < numberProducers * numberMessages) {
+		Message::SPtr message;
+		if (!mailbox.pop(message)) {
+			boost::this_thread::yield();
+			continue;
+		}
+
+		TestMessage::SPtr testMessage = boost::static_pointer_cast<TestMessage>(message);
+		BOOST_REQUIRE(testMessage->number_ == nextNumber[testMessage->producer_]);
+		nextNumber[testMessage->producer_]++;
+		received++;
+	}
+	threadGroup.join_all();
+
+	Message::SPtr message;
+	BOOST_REQUIRE(mailbox.pop(message) == false);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,134 @@
+#include "unittest.h"
+#include <boost/thread.hpp>
+#include "OpcUaStackCore/Component/Component.h"
+#include "OpcUaStackCore/Base/Condition.h"
+
+using namespace OpcUaStackCore;
+
+BOOST_AUTO_TEST_SUITE(Component_t)
+
+class TestComponent
+: public Component
+{
+  public:
+
+	TestComponent(void)
+	: condition_(0, 0)
+	, release_(0, 0)
+	, block_(false)
+	, overloadCount_(0)
+	, threadId_()
+	, messageVec_()
+	{
+	}
+
+	void receive(Message::SPtr message) {
+		if (block_) release_.waitForCondition(5000);
+		messageVec_.push_back(message);
+		threadId_ = boost::this_thread::get_id();
+		condition_.conditionValueInc();
+	}
+
+	void receiveOverload(Message::SPtr message) {
+		overloadCount_++;
+	}
+
+	Condition condition_;
+	Condition release_;
+	bool block_;
+	uint32_t overloadCount_;
+	boost::thread::id threadId_;
+	std::vector<Message::SPtr> messageVec_;
+};
+
+BOOST_AUTO_TEST_CASE(Component_)
+{
+	std::cout << "Component_t" << std::endl;
+}
+
+BOOST_AUTO_TEST_CASE(Component_send)
+{
+	TestComponent testComponent;
+	Message::SPtr message = constructSPtr<Message>();
+
+	testComponent.condition_.condition(0, 1);
+	testComponent.send(message);
+	BOOST_REQUIRE(testComponent.condition_.waitForCondition(1000));
+	BOOST_REQUIRE(testComponent.threadId_ == boost::this_thread::get_id());
+}
+
+BOOST_AUTO_TEST_CASE(Component_name_removed)
+{
+	TestComponent testComponent1;
+	testComponent1.componentName("TestComponent");
+	{
+		TestComponent testComponent2;
+		testComponent2.componentName("TestComponent");
+	}
+	BOOST_REQUIRE(Component::getComponent("TestComponent") == &testComponent1);
+}
+
+BOOST_AUTO_TEST_CASE(Component_send_worker_pool)
+{
+	TestComponent testComponent;
+	Message::SPtr message = constructSPtr<Message>();
+
+	WorkerPool::SPtr workerPool = constructSPtr<WorkerPool>(std::string("Test"));
+	workerPool->startup(2, 0);
+	testComponent.workerPool(workerPool);
+
+	testComponent.condition_.condition(0, 1);
+	testComponent.send(message);
+	BOOST_REQUIRE(testComponent.condition_.waitForCondition(1000));
+	BOOST_REQUIRE(testComponent.threadId_ != boost::this_thread::get_id());
+
+	workerPool->shutdown();
+}
+
+BOOST_AUTO_TEST_CASE(Component_send_worker_pool_overload)
+{
+	TestComponent testComponent;
+	Message::SPtr message = constructSPtr<Message>();
+
+	WorkerPool::SPtr workerPool = constructSPtr<WorkerPool>(std::string("Test"));
+	workerPool->startup(1, 1);
+	testComponent.workerPool(workerPool);
+	testComponent.block_ = true;
+	testComponent.release_.condition(0, 1);
+
+	// the first message blocks the queue of the worker pool
+	testComponent.condition_.condition(0, 1);
+	testComponent.send(message);
+	testComponent.send(message);
+	BOOST_REQUIRE(testComponent.overloadCount_ == 1);
+
+	testComponent.release_.conditionValueInc();
+	BOOST_REQUIRE(testComponent.condition_.waitForCondition(1000));
+
+	workerPool->shutdown();
+}
+
+BOOST_AUTO_TEST_CASE(Component_sendAsync)
+{
+	TestComponent testComponent;
+
+	IOThread ioThread;
+	ioThread.numberThreads(2);
+	ioThread.startup();
+	testComponent.ioThread(&ioThread);
+
+	// the messages are received in the order of sending
+	std::vector<Message::SPtr> messageVec;
+	testComponent.condition_.condition(0, 1000);
+	for (uint32_t idx = 0; idx < 1000; idx++) {
+		Message::SPtr message = constructSPtr<Message>();
+		messageVec.push_back(message);
+		testComponent.sendAsync(message);
+	}
+	BOOST_REQUIRE(testComponent.condition_.waitForCondition(1000));
+	BOOST_REQUIRE(testComponent.messageVec_ == messageVec);
+
+	ioThread.shutdown();
+}
+
+BOOST_AUTO_TEST_SUITE_END()
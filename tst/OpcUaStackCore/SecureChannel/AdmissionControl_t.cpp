@@ -0,0 +1,123 @@
+#include "unittest.h"
+#include <boost/thread.hpp>
+#include "OpcUaStackCore/SecureChannel/AdmissionControl.h"
+
+using namespace OpcUaStackCore;
+
+BOOST_AUTO_TEST_SUITE(AdmissionControl_)
+
+BOOST_AUTO_TEST_CASE(AdmissionControl_)
+{
+	std::cout << "AdmissionControl_t" << std::endl;
+}
+
+BOOST_AUTO_TEST_CASE(AdmissionControl_disabled)
+{
+	AdmissionControl admissionControl;
+	BOOST_REQUIRE(admissionControl.enabled() == false);
+
+	for (uint32_t idx=0; idx<100; idx++) {
+		BOOST_REQUIRE(admissionControl.admit("127.0.0.1") == AR_Accept);
+	}
+	BOOST_REQUIRE(admissionControl.connections() == 100);
+	BOOST_REQUIRE(admissionControl.handshakes() == 100);
+	BOOST_REQUIRE(admissionControl.acceptCount() == 100);
+}
+
+BOOST_AUTO_TEST_CASE(AdmissionControl_max_handshakes)
+{
+	AdmissionControl admissionControl;
+	admissionControl.maxHandshakes(2);
+
+	BOOST_REQUIRE(admissionControl.admit("10.0.0.1") == AR_Accept);
+	BOOST_REQUIRE(admissionControl.admit("10.0.0.2") == AR_Accept);
+	BOOST_REQUIRE(admissionControl.admit("10.0.0.3") == AR_RejectHandshakes);
+	BOOST_REQUIRE(admissionControl.rejectHandshakesCount() == 1);
+
+	// the first handshake is complete
+	admissionControl.handshakeComplete();
+	BOOST_REQUIRE(admissionControl.admit("10.0.0.3") == AR_Accept);
+	BOOST_REQUIRE(admissionControl.handshakes() == 2);
+	BOOST_REQUIRE(admissionControl.connections() == 3);
+
+	// the second connection is closed during the handshake
+	admissionControl.release("10.0.0.2", true);
+	BOOST_REQUIRE(admissionControl.handshakes() == 1);
+	BOOST_REQUIRE(admissionControl.connections() == 2);
+}
+
+BOOST_AUTO_TEST_CASE(AdmissionControl_max_connections_per_address)
+{
+	AdmissionControl admissionControl;
+	admissionControl.maxConnectionsPerAddress(2);
+
+	BOOST_REQUIRE(admissionControl.admit("10.0.0.1") == AR_Accept);
+	BOOST_REQUIRE(admissionControl.admit("10.0.0.1") == AR_Accept);
+	BOOST_REQUIRE(admissionControl.admit("10.0.0.1") == AR_RejectAddress);
+	BOOST_REQUIRE(admissionControl.admit("10.0.0.2") == AR_Accept);
+	BOOST_REQUIRE(admissionControl.rejectAddressCount() == 1);
+
+	// connections without address are not limited
+	BOOST_REQUIRE(admissionControl.admit("") == AR_Accept);
+	BOOST_REQUIRE(admissionControl.admit("") == AR_Accept);
+	BOOST_REQUIRE(admissionControl.admit("") == AR_Accept);
+
+	admissionControl.release("10.0.0.1", false);
+	BOOST_REQUIRE(admissionControl.admit("10.0.0.1") == AR_Accept);
+}
+
+BOOST_AUTO_TEST_CASE(AdmissionControl_accept_rate)
+{
+	AdmissionControl admissionControl;
+	admissionControl.acceptRate(10);
+	admissionControl.acceptBurst(3);
+
+	BOOST_REQUIRE(admissionControl.admit("10.0.0.1") == AR_Accept);
+	BOOST_REQUIRE(admissionControl.admit("10.0.0.2") == AR_Accept);
+	BOOST_REQUIRE(admissionControl.admit("10.0.0.3") == AR_Accept);
+	BOOST_REQUIRE(admissionControl.admit("10.0.0.4") == AR_RejectRate);
+	BOOST_REQUIRE(admissionControl.rejectRateCount() == 1);
+
+	// one token is added each 100 milliseconds
+	boost::this_thread::sleep(boost::posix_time::milliseconds(150));
+	BOOST_REQUIRE(admissionControl.admit("10.0.0.4") == AR_Accept);
+	BOOST_REQUIRE(admissionControl.admit("10.0.0.5") == AR_RejectRate);
+}
+
+
+BOOST_AUTO_TEST_CASE(AdmissionControl_handshake_timeout)
+{
+	AdmissionControl admissionControl;
+	BOOST_REQUIRE(admissionControl.enabled() == false);
+
+	admissionControl.handshakeTimeout(1000);
+	BOOST_REQUIRE(admissionControl.enabled() == true);
+	BOOST_REQUIRE(admissionControl.handshakeTimeout() == 1000);
+
+	BOOST_REQUIRE(admissionControl.admit("10.0.0.1") == AR_Accept);
+	admissionControl.handshakeExpired();
+	admissionControl.release("10.0.0.1", true);
+	BOOST_REQUIRE(admissionControl.handshakeExpiredCount() == 1);
+	BOOST_REQUIRE(admissionControl.handshakes() == 0);
+	BOOST_REQUIRE(admissionControl.connections() == 0);
+
+	uint64_t acceptCount;
+	uint64_t rejectHandshakesCount;
+	uint64_t rejectRateCount;
+	uint64_t rejectAddressCount;
+	uint64_t handshakeExpiredCount;
+	admissionControl.statistic(
+		acceptCount,
+		rejectHandshakesCount,
+		rejectRateCount,
+		rejectAddressCount,
+		handshakeExpiredCount
+	);
+	BOOST_REQUIRE(acceptCount == 1);
+	BOOST_REQUIRE(rejectHandshakesCount == 0);
+	BOOST_REQUIRE(rejectRateCount == 0);
+	BOOST_REQUIRE(rejectAddressCount == 0);
+	BOOST_REQUIRE(handshakeExpiredCount == 1);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
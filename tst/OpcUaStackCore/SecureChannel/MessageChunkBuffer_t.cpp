@@ -0,0 +1,163 @@
+#include "unittest.h"
+#include "OpcUaStackCore/SecureChannel/MessageChunkBuffer.h"
+#include "OpcUaStackCore/Base/WorkerPool.h"
+
+#include <ostream>
+#include <atomic>
+#include <boost/bind.hpp>
+
+using namespace OpcUaStackCore;
+
+static void chunkCallback(uint32_t* callbackCount)
+{
+	(*callbackCount)++;
+}
+
+static void encode(MessageChunkBuffer* chunkBuffer, uint32_t size, std::atomic<bool>* done)
+{
+	std::ostream os(chunkBuffer);
+	for (uint32_t idx = 0; idx < size; idx++) os << 'x';
+	os.flush();
+	chunkBuffer->finish();
+	*done = true;
+}
+
+BOOST_AUTO_TEST_SUITE(MessageChunkBuffer_)
+
+BOOST_AUTO_TEST_CASE(MessageChunkBuffer_)
+{
+	std::cout << "MessageChunkBuffer_t" << std::endl;
+}
+
+BOOST_AUTO_TEST_CASE(MessageChunkBuffer_split)
+{
+	MessageChunkBuffer chunkBuffer(4, 0, 0);
+	std::ostream os(&chunkBuffer);
+
+	boost::asio::streambuf chunk;
+	bool lastChunk = false;
+
+	os << "0123456789";
+	BOOST_REQUIRE(chunkBuffer.chunkCount() == 2);
+	BOOST_REQUIRE(chunkBuffer.getChunk(chunk, lastChunk) == true);
+	BOOST_REQUIRE(lastChunk == false);
+	BOOST_REQUIRE(chunk.size() == 4);
+
+	chunkBuffer.finish();
+	BOOST_REQUIRE(chunkBuffer.chunkCount() == 3);
+	BOOST_REQUIRE(chunkBuffer.messageSize() == 10);
+	BOOST_REQUIRE(chunkBuffer.getChunk(chunk, lastChunk) == true);
+	BOOST_REQUIRE(lastChunk == false);
+	BOOST_REQUIRE(chunkBuffer.getChunk(chunk, lastChunk) == true);
+	BOOST_REQUIRE(lastChunk == true);
+	BOOST_REQUIRE(chunkBuffer.getChunk(chunk, lastChunk) == false);
+
+	std::string str((std::istreambuf_iterator<char>(&chunk)), std::istreambuf_iterator<char>());
+	BOOST_REQUIRE(str == "0123456789");
+	BOOST_REQUIRE(chunkBuffer.aborted() == false);
+}
+
+BOOST_AUTO_TEST_CASE(MessageChunkBuffer_max_chunk_count)
+{
+	uint32_t callbackCount = 0;
+	MessageChunkBuffer chunkBuffer(4, 2, 0);
+	chunkBuffer.chunkCallback(boost::bind(&chunkCallback, &callbackCount));
+	std::ostream os(&chunkBuffer);
+
+	os << "0123456789abcdef";
+	chunkBuffer.finish();
+	BOOST_REQUIRE(chunkBuffer.aborted() == true);
+	BOOST_REQUIRE(callbackCount == 3);
+
+	boost::asio::streambuf chunk;
+	bool lastChunk = false;
+	BOOST_REQUIRE(chunkBuffer.getChunk(chunk, lastChunk) == false);
+}
+
+BOOST_AUTO_TEST_CASE(MessageChunkBuffer_max_message_size)
+{
+	MessageChunkBuffer chunkBuffer(4, 0, 9);
+	std::ostream os(&chunkBuffer);
+
+	os << "01234567";
+	chunkBuffer.finish();
+	BOOST_REQUIRE(chunkBuffer.aborted() == false);
+	BOOST_REQUIRE(chunkBuffer.messageSize() == 8);
+
+	MessageChunkBuffer chunkBuffer2(4, 0, 9);
+	std::ostream os2(&chunkBuffer2);
+	os2 << "0123456789";
+	chunkBuffer2.finish();
+	BOOST_REQUIRE(chunkBuffer2.aborted() == true);
+}
+
+BOOST_AUTO_TEST_CASE(MessageChunkBuffer_max_queued_chunks)
+{
+	MessageChunkBuffer chunkBuffer(4, 0, 0);
+	chunkBuffer.maxQueuedChunks(2);
+	std::atomic<bool> done(false);
+
+	WorkerPool workerPool("Test");
+	workerPool.startup(1, 10);
+	workerPool.post(boost::bind(&encode, &chunkBuffer, 40, &done));
+
+	// the encoder waits until a queued chunk is taken
+	IOService::msecSleep(100);
+	BOOST_REQUIRE(done == false);
+	BOOST_REQUIRE(chunkBuffer.chunkCount() == 2);
+
+	uint32_t messageSize = 0;
+	bool lastChunk = false;
+	for (uint32_t idx = 0; idx < 1000 && !lastChunk; idx++) {
+		boost::asio::streambuf chunk;
+		if (!chunkBuffer.getChunk(chunk, lastChunk)) {
+			IOService::msecSleep(1);
+			continue;
+		}
+		messageSize += chunk.size();
+	}
+	BOOST_REQUIRE(lastChunk == true);
+	BOOST_REQUIRE(messageSize == 40);
+
+	workerPool.shutdown();
+	BOOST_REQUIRE(done == true);
+}
+
+BOOST_AUTO_TEST_CASE(MessageChunkBuffer_max_queued_chunks_cancel)
+{
+	MessageChunkBuffer chunkBuffer(4, 0, 0);
+	chunkBuffer.maxQueuedChunks(2);
+	std::atomic<bool> done(false);
+
+	WorkerPool workerPool("Test");
+	workerPool.startup(1, 10);
+	workerPool.post(boost::bind(&encode, &chunkBuffer, 40, &done));
+
+	IOService::msecSleep(100);
+	BOOST_REQUIRE(done == false);
+
+	// the secure channel is closed and the encoder continues
+	chunkBuffer.cancel();
+	for (uint32_t idx = 0; idx < 1000 && !done; idx++) {
+		IOService::msecSleep(1);
+	}
+	BOOST_REQUIRE(done == true);
+	BOOST_REQUIRE(chunkBuffer.aborted() == true);
+	BOOST_REQUIRE(chunkBuffer.chunkCount() == 2);
+
+	workerPool.shutdown();
+}
+
+BOOST_AUTO_TEST_CASE(MessageChunkBuffer_max_queued_chunks_no_worker_pool)
+{
+	MessageChunkBuffer chunkBuffer(4, 0, 0);
+	chunkBuffer.maxQueuedChunks(2);
+	std::atomic<bool> done(false);
+
+	// outside of a worker pool the encoder does not wait
+	encode(&chunkBuffer, 40, &done);
+	BOOST_REQUIRE(done == true);
+	BOOST_REQUIRE(chunkBuffer.chunkCount() == 10);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,121 @@
+#include "unittest.h"
+#include "OpcUaStackCore/Base/Condition.h"
+#include "OpcUaStackCore/Base/IOService.h"
+#include "OpcUaStackCore/SecureChannel/RequestWindow.h"
+#include "OpcUaStackCore/SecureChannel/SecureChannelTransaction.h"
+
+using namespace OpcUaStackCore;
+
+class RequestWindowTest
+{
+  public:
+	RequestWindowTest(void)
+	: resumeCount_(0)
+	, resume_()
+	{
+	}
+
+	void resume(void)
+	{
+		resumeCount_++;
+		resume_.conditionValueDec();
+	}
+
+	uint32_t resumeCount_;
+	Condition resume_;
+};
+
+BOOST_AUTO_TEST_SUITE(RequestWindow_)
+
+BOOST_AUTO_TEST_CASE(RequestWindow_)
+{
+	std::cout << "RequestWindow_t" << std::endl;
+}
+
+BOOST_AUTO_TEST_CASE(RequestWindow_no_limit)
+{
+	RequestWindow::SPtr requestWindow = constructSPtr<RequestWindow>();
+
+	std::vector<RequestWindowSlot::SPtr> slotVec;
+	for (uint32_t idx = 0; idx < 10; idx++) {
+		requestWindow->request();
+		slotVec.push_back(requestWindow->enter());
+	}
+	BOOST_REQUIRE(requestWindow->full() == false);
+	BOOST_REQUIRE(requestWindow->pause() == false);
+}
+
+BOOST_AUTO_TEST_CASE(RequestWindow_request_dropped_later)
+{
+	RequestWindowTest test;
+	IOService ioService;
+	ioService.start(1);
+	RequestWindow::StrandSPtr strand(new boost::asio::io_service::strand(ioService.io_service()));
+
+	RequestWindow::SPtr requestWindow = constructSPtr<RequestWindow>();
+	requestWindow->windowSize(2);
+	requestWindow->open(strand, boost::bind(&RequestWindowTest::resume, &test));
+
+	// the first request is answered, the second request is still referenced
+	// by the server after it is handled
+	SecureChannelTransaction::SPtr trx1 = constructSPtr<SecureChannelTransaction>();
+	SecureChannelTransaction::SPtr trx2 = constructSPtr<SecureChannelTransaction>();
+	requestWindow->request();
+	trx1->requestWindowSlot_ = requestWindow->enter();
+	requestWindow->request();
+	trx2->requestWindowSlot_ = requestWindow->enter();
+	BOOST_REQUIRE(requestWindow->full() == true);
+	BOOST_REQUIRE(requestWindow->pause() == true);
+
+	// the server drops the second request without a response in another
+	// thread. The secure channel continues reading in its strand.
+	test.resume_.condition(1, 0);
+	boost::thread thread([&trx2](void) { trx2.reset(); });
+	thread.join();
+	BOOST_REQUIRE(test.resume_.waitForCondition(1000) == true);
+	BOOST_REQUIRE(requestWindow->full() == false);
+
+	// the window is not paused anymore
+	trx1->requestWindowSlot_.reset();
+	IOService::msecSleep(50);
+	BOOST_REQUIRE(test.resumeCount_ == 1);
+
+	uint32_t requestCount;
+	uint32_t requestsInFlight;
+	uint32_t requestsInFlightMax;
+	uint32_t pauseCount;
+	requestWindow->statistic(requestCount, requestsInFlight, requestsInFlightMax, pauseCount);
+	BOOST_REQUIRE(requestCount == 2);
+	BOOST_REQUIRE(requestsInFlight == 0);
+	BOOST_REQUIRE(requestsInFlightMax == 2);
+	BOOST_REQUIRE(pauseCount == 1);
+
+	ioService.stop();
+}
+
+BOOST_AUTO_TEST_CASE(RequestWindow_closed)
+{
+	RequestWindowTest test;
+	IOService ioService;
+	ioService.start(1);
+	RequestWindow::StrandSPtr strand(new boost::asio::io_service::strand(ioService.io_service()));
+
+	RequestWindow::SPtr requestWindow = constructSPtr<RequestWindow>();
+	requestWindow->windowSize(1);
+	requestWindow->open(strand, boost::bind(&RequestWindowTest::resume, &test));
+
+	RequestWindowSlot::SPtr slot = requestWindow->enter();
+	BOOST_REQUIRE(requestWindow->pause() == true);
+
+	// the request outlives the secure channel
+	requestWindow->close();
+	requestWindow.reset();
+	slot.reset();
+
+	IOService::msecSleep(50);
+	BOOST_REQUIRE(test.resumeCount_ == 0);
+
+	ioService.stop();
+}
+
+BOOST_AUTO_TEST_SUITE_END()
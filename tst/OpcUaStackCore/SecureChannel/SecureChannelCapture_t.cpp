@@ -0,0 +1,117 @@
+#include "unittest.h"
+#include <fstream>
+#include <sys/stat.h>
+#include "OpcUaStackCore/SecureChannel/SecureChannelCapture.h"
+
+using namespace OpcUaStackCore;
+
+BOOST_AUTO_TEST_SUITE(SecureChannelCapture_)
+
+BOOST_AUTO_TEST_CASE(SecureChannelCapture_)
+{
+	std::cout << "SecureChannelCapture_t" << std::endl;
+}
+
+BOOST_AUTO_TEST_CASE(SecureChannelCapture_write_read)
+{
+	std::string fileName = "/tmp/SecureChannelCapture_t.cap";
+
+	SecureChannelCapture secureChannelCapture;
+	BOOST_REQUIRE(secureChannelCapture.open(fileName) == true);
+
+	boost::asio::streambuf sb;
+	std::ostream os(&sb);
+	os << "RequestBody";
+
+	secureChannelCapture.writeOpen(17, "opc.tcp://127.0.0.1:4841");
+	secureChannelCapture.writeRequest(17, 1, 631, sb);
+	secureChannelCapture.writeResponse(17, 1, 634, 123);
+	secureChannelCapture.writeClose(17);
+	BOOST_REQUIRE(secureChannelCapture.numberRecords() == 4);
+	secureChannelCapture.close();
+
+	// the request is not consumed
+	BOOST_REQUIRE(sb.size() == 11);
+
+	std::ifstream ifs(fileName.c_str(), std::ios::in | std::ios::binary);
+	BOOST_REQUIRE(SecureChannelCapture::readHeader(ifs) == true);
+
+	SecureChannelCaptureRecord record;
+	BOOST_REQUIRE(SecureChannelCapture::readRecord(ifs, record) == true);
+	BOOST_REQUIRE(record.recordType_ == CRT_Open);
+	BOOST_REQUIRE(record.channelId_ == 17);
+	BOOST_REQUIRE(record.data_ == "opc.tcp://127.0.0.1:4841");
+	uint64_t openTime = record.time_;
+
+	BOOST_REQUIRE(SecureChannelCapture::readRecord(ifs, record) == true);
+	BOOST_REQUIRE(record.recordType_ == CRT_Request);
+	BOOST_REQUIRE(record.requestId_ == 1);
+	BOOST_REQUIRE(record.typeId_ == 631);
+	BOOST_REQUIRE(record.size_ == 11);
+	BOOST_REQUIRE(record.data_ == "RequestBody");
+	BOOST_REQUIRE(record.time_ >= openTime);
+
+	BOOST_REQUIRE(SecureChannelCapture::readRecord(ifs, record) == true);
+	BOOST_REQUIRE(record.recordType_ == CRT_Response);
+	BOOST_REQUIRE(record.typeId_ == 634);
+	BOOST_REQUIRE(record.size_ == 123);
+	BOOST_REQUIRE(record.data_.empty());
+
+	BOOST_REQUIRE(SecureChannelCapture::readRecord(ifs, record) == true);
+	BOOST_REQUIRE(record.recordType_ == CRT_Close);
+	BOOST_REQUIRE(record.channelId_ == 17);
+
+	BOOST_REQUIRE(SecureChannelCapture::readRecord(ifs, record) == false);
+}
+
+BOOST_AUTO_TEST_CASE(SecureChannelCapture_access_mode_max_size)
+{
+	std::string fileName = "/tmp/SecureChannelCapture_t.max";
+	std::ofstream ofs(fileName.c_str(), std::ios::out | std::ios::binary | std::ios::trunc);
+	ofs.close();
+	BOOST_REQUIRE(chmod(fileName.c_str(), 0644) == 0);
+
+	// header (8 bytes) and two close records (29 bytes each)
+	SecureChannelCapture secureChannelCapture;
+	secureChannelCapture.maxFileSize(8 + 2 * 29);
+	BOOST_REQUIRE(secureChannelCapture.open(fileName) == true);
+
+	// the capture file is readable by the owner only
+	struct stat fileStat;
+	BOOST_REQUIRE(stat(fileName.c_str(), &fileStat) == 0);
+	BOOST_REQUIRE((fileStat.st_mode & 0777) == 0600);
+
+	secureChannelCapture.writeClose(1);
+	secureChannelCapture.writeClose(2);
+	secureChannelCapture.writeClose(3);
+	BOOST_REQUIRE(secureChannelCapture.numberRecords() == 2);
+	BOOST_REQUIRE(secureChannelCapture.droppedRecords() == 1);
+	secureChannelCapture.close();
+	BOOST_REQUIRE(secureChannelCapture.isOpen() == false);
+
+	// the pending records are written before the file is closed
+	BOOST_REQUIRE(stat(fileName.c_str(), &fileStat) == 0);
+	BOOST_REQUIRE(fileStat.st_size == 8 + 2 * 29);
+
+	std::ifstream ifs(fileName.c_str(), std::ios::in | std::ios::binary);
+	BOOST_REQUIRE(SecureChannelCapture::readHeader(ifs) == true);
+	SecureChannelCaptureRecord record;
+	BOOST_REQUIRE(SecureChannelCapture::readRecord(ifs, record) == true);
+	BOOST_REQUIRE(record.channelId_ == 1);
+	BOOST_REQUIRE(SecureChannelCapture::readRecord(ifs, record) == true);
+	BOOST_REQUIRE(record.channelId_ == 2);
+	BOOST_REQUIRE(SecureChannelCapture::readRecord(ifs, record) == false);
+}
+
+BOOST_AUTO_TEST_CASE(SecureChannelCapture_invalid_file)
+{
+	std::string fileName = "/tmp/SecureChannelCapture_t.inv";
+	std::ofstream ofs(fileName.c_str(), std::ios::out | std::ios::binary | std::ios::trunc);
+	ofs << "no capture file";
+	ofs.close();
+
+	std::ifstream ifs(fileName.c_str(), std::ios::in | std::ios::binary);
+	BOOST_REQUIRE(SecureChannelCapture::readHeader(ifs) == false);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,85 @@
+#include "unittest.h"
+#include <boost/thread.hpp>
+#include "OpcUaStackCore/SecureChannel/SecureChannelSecuritySettings.h"
+
+using namespace OpcUaStackCore;
+
+BOOST_AUTO_TEST_SUITE(SecureChannelSecuritySettings_)
+
+BOOST_AUTO_TEST_CASE(SecureChannelSecuritySettings_)
+{
+	std::cout << "SecureChannelSecuritySettings_t" << std::endl;
+}
+
+BOOST_AUTO_TEST_CASE(SecureChannelSecuritySettings_issue)
+{
+	SecureChannelSecuritySettings securitySettings;
+
+	securitySettings.nextSecurityToken(1, 60000);
+	securitySettings.nextSecurityKeySetClient().signKey().set("client1", 7);
+	securitySettings.nextSecurityKeySetServer().signKey().set("server1", 7);
+
+	// the key set is not ready before the response is sent
+	BOOST_REQUIRE(securitySettings.selectSecurityToken(1) == false);
+
+	securitySettings.nextSecurityKeySetReady();
+	BOOST_REQUIRE(securitySettings.selectSecurityToken(1) == true);
+	BOOST_REQUIRE(securitySettings.tokenId() == 1);
+	BOOST_REQUIRE(memcmp(securitySettings.securityKeySetClient().signKey().memBuf(), "client1", 7) == 0);
+	BOOST_REQUIRE(memcmp(securitySettings.securityKeySetServer().signKey().memBuf(), "server1", 7) == 0);
+
+	BOOST_REQUIRE(securitySettings.selectSecurityToken(2) == false);
+}
+
+BOOST_AUTO_TEST_CASE(SecureChannelSecuritySettings_renew)
+{
+	SecureChannelSecuritySettings securitySettings;
+
+	securitySettings.nextSecurityToken(1, 60000);
+	securitySettings.nextSecurityKeySetClient().signKey().set("client1", 7);
+	securitySettings.nextSecurityKeySetServer().signKey().set("server1", 7);
+	securitySettings.nextSecurityKeySetReady();
+	BOOST_REQUIRE(securitySettings.selectSecurityToken(1) == true);
+
+	// renew security token
+	securitySettings.nextSecurityToken(2, 60000);
+	securitySettings.nextSecurityKeySetClient().signKey().set("client2", 7);
+	securitySettings.nextSecurityKeySetServer().signKey().set("server2", 7);
+	securitySettings.nextSecurityKeySetReady();
+
+	// the partner still uses the old token
+	BOOST_REQUIRE(securitySettings.selectSecurityToken(1) == true);
+	BOOST_REQUIRE(securitySettings.tokenId() == 1);
+	BOOST_REQUIRE(memcmp(securitySettings.securityKeySetServer().signKey().memBuf(), "server1", 7) == 0);
+
+	// the partner uses the new token
+	BOOST_REQUIRE(securitySettings.selectSecurityToken(2) == true);
+	BOOST_REQUIRE(securitySettings.tokenId() == 2);
+	BOOST_REQUIRE(memcmp(securitySettings.securityKeySetClient().signKey().memBuf(), "client2", 7) == 0);
+	BOOST_REQUIRE(memcmp(securitySettings.securityKeySetServer().signKey().memBuf(), "server2", 7) == 0);
+
+	// the old token is valid for received messages until it expires
+	BOOST_REQUIRE(securitySettings.selectSecurityToken(1) == true);
+	BOOST_REQUIRE(memcmp(securitySettings.securityKeySetClient().signKey().memBuf(), "client1", 7) == 0);
+	BOOST_REQUIRE(securitySettings.tokenId() == 2);
+	BOOST_REQUIRE(memcmp(securitySettings.securityKeySetServer().signKey().memBuf(), "server2", 7) == 0);
+}
+
+BOOST_AUTO_TEST_CASE(SecureChannelSecuritySettings_expire)
+{
+	SecureChannelSecuritySettings securitySettings;
+
+	securitySettings.nextSecurityToken(1, 50);
+	securitySettings.nextSecurityKeySetReady();
+	BOOST_REQUIRE(securitySettings.selectSecurityToken(1) == true);
+
+	securitySettings.nextSecurityToken(2, 60000);
+	securitySettings.nextSecurityKeySetReady();
+	BOOST_REQUIRE(securitySettings.selectSecurityToken(2) == true);
+
+	boost::this_thread::sleep(boost::posix_time::milliseconds(100));
+	BOOST_REQUIRE(securitySettings.selectSecurityToken(1) == false);
+	BOOST_REQUIRE(securitySettings.selectSecurityToken(2) == true);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -5,6 +5,8 @@
 #include "OpcUaStackCore/SecureChannel/SecureChannelClient.h"
 #include "OpcUaStackCore/SecureChannel/SecureChannelServer.h"
 #include "OpcUaStackCore/ServiceSet/GetEndpointsRequest.h"
+#include "OpcUaStackCore/Certificate/ApplicationCertificate.h"
+#include "OpcUaStackCore/Certificate/CryptoManager.h"
 
 using namespace OpcUaStackCore;
 
@@ -40,6 +42,10 @@ class SecureChannelServerTest
   public:
 	SecureChannelServerTest(void)
     : secureChannelServer_(nullptr)
+    , secureChannel_(nullptr)
+    , deferResponse_(false)
+    , deferredResponseMutex_()
+    , deferredResponseVec_()
   	{
     }
 
@@ -47,6 +53,7 @@ class SecureChannelServerTest
 	void handleConnect(SecureChannel* secureChannel)
 	{
 		std::cout << "handleConnect server" << std::endl;
+		secureChannel_ = secureChannel;
 		handleConnect_.conditionValueDec();
 	}
 
@@ -76,6 +83,13 @@ class SecureChannelServerTest
 		secureChannelTransaction->responseTypeNodeId_. nodeId((uint32_t)OpcUaId_GetEndpointsResponse_Encoding_DefaultBinary);
 		secureChannelTransaction->osAppend(sb);
 
+		// the test sends the response later
+		if (deferResponse_) {
+			boost::mutex::scoped_lock g(deferredResponseMutex_);
+			deferredResponseVec_.push_back(secureChannelTransaction);
+			return;
+		}
+
 		secureChannelServer_->asyncWriteMessageResponse(secureChannel, secureChannelTransaction);
 	}
 
@@ -94,8 +108,40 @@ class SecureChannelServerTest
 	}
 
 	SecureChannelServer* secureChannelServer_;
+	SecureChannel* secureChannel_;
+	bool deferResponse_;
+	boost::mutex deferredResponseMutex_;
+	std::vector<SecureChannelTransaction::SPtr> deferredResponseVec_;
 };
 
+ApplicationCertificate::SPtr
+createApplicationCertificate(void)
+{
+	ApplicationCertificate::SPtr applicationCertificate = constructSPtr<ApplicationCertificate>();
+	applicationCertificate->enable(true);
+	applicationCertificate->certificateTrustListLocation("/tmp/SecureChannel_t/pki/trusted/certs/");
+	applicationCertificate->certificateRejectListLocation("/tmp/SecureChannel_t/pki/reject/certs/");
+	applicationCertificate->certificateRevocationListLocation("/tmp/SecureChannel_t/pki/trusted/crl/");
+	applicationCertificate->issuersCertificatesLocation("/tmp/SecureChannel_t/pki/issuers/certs/");
+	applicationCertificate->issuersRevocationListLocation("/tmp/SecureChannel_t/pki/issuers/crl/");
+	applicationCertificate->serverCertificateFile("/tmp/SecureChannel_t/pki/own/certs/SecureChannel_t.der");
+	applicationCertificate->privateKeyFile("/tmp/SecureChannel_t/pki/own/private/SecureChannel_t.pem");
+	applicationCertificate->generateCertificate(true);
+	applicationCertificate->uri("urn:asneg.de:ASNeG:SecureChannel_t");
+	applicationCertificate->commonName("SecureChannel_t");
+	applicationCertificate->domainComponent("127.0.0.1");
+	applicationCertificate->organization("ASNeG");
+	applicationCertificate->organizationUnit("OPC UA Service Department");
+	applicationCertificate->locality("Neukirchen");
+	applicationCertificate->state("Hessen");
+	applicationCertificate->country("DE");
+	applicationCertificate->yearsValidFor(5);
+	applicationCertificate->keyLength(2048);
+	applicationCertificate->certificateType("RsaSha256");
+	applicationCertificate->init();
+	return applicationCertificate;
+}
+
 BOOST_AUTO_TEST_SUITE(SecureChannel_)
 
 BOOST_AUTO_TEST_CASE(SecureChannel)
@@ -300,4 +346,299 @@ BOOST_AUTO_TEST_CASE(SecureChannel_Connect_SendRequest_ReceiveResponse_Disconnec
 	ioThread.shutdown();
 }
 
+BOOST_AUTO_TEST_CASE(SecureChannel_memory_Connect_SendRequest_ReceiveResponse_Disconnect)
+{
+	OpcUaStackCore::SecureChannel* secureChannel;
+	SecureChannelClientTest secureChannelClientTest;
+	SecureChannelServerTest secureChannelServerTest;
+
+	IOThread ioThread;
+	ioThread.startup();
+
+	SecureChannelServer secureChannelServer(&ioThread);
+	SecureChannelClient secureChannelClient(&ioThread);
+	secureChannelServer.secureChannelServerIf(&secureChannelServerTest);
+	secureChannelClient.secureChannelClientIf(&secureChannelClientTest);
+
+	secureChannelServerTest.secureChannelServer_ = &secureChannelServer;
+
+	// the server records the traffic of the secure channel
+	SecureChannelCapture::SPtr secureChannelCapture = constructSPtr<SecureChannelCapture>();
+	BOOST_REQUIRE(secureChannelCapture->open("/tmp/SecureChannel_t.cap") == true);
+	secureChannelServer.secureChannelCapture(secureChannelCapture);
+
+	ApplicationCertificate::SPtr applicationCertificate = createApplicationCertificate();
+	CryptoManager::SPtr cryptoManager = constructSPtr<CryptoManager>();
+	secureChannelServer.applicationCertificate(applicationCertificate);
+	secureChannelServer.cryptoManager(cryptoManager);
+	secureChannelClient.applicationCertificate(applicationCertificate);
+	secureChannelClient.cryptoManager(cryptoManager);
+
+	// server open in process endpoint
+	EndpointDescription::SPtr endpointDescription = constructSPtr<EndpointDescription>();
+	endpointDescription->endpointUrl("opc.mem://SecureChannel_t");
+	EndpointDescriptionArray::SPtr endpointDescriptionArray = constructSPtr<EndpointDescriptionArray>();
+	endpointDescriptionArray->resize(1);
+	endpointDescriptionArray->push_back(endpointDescription);
+
+	secureChannelServerTest.handleEndpointOpen_.condition(1,0);
+	SecureChannelServerConfig::SPtr secureChannelServerConfig = constructSPtr<SecureChannelServerConfig>();
+	secureChannelServerConfig->endpointUrl("opc.mem://SecureChannel_t");
+	secureChannelServerConfig->endpointDescriptionArray(endpointDescriptionArray);
+	secureChannelServer.accept(secureChannelServerConfig);
+	BOOST_REQUIRE(secureChannelServerTest.handleEndpointOpen_.waitForCondition(1000) == true);
+
+	// client connect to server
+	secureChannelClientTest.handleConnect_.condition(1,0);
+	secureChannelServerTest.handleConnect_.condition(1,0);
+	SecureChannelClientConfig::SPtr secureChannelClientConfig = constructSPtr<SecureChannelClientConfig>();
+	secureChannelClientConfig->endpointUrl("opc.mem://SecureChannel_t");
+	secureChannel = secureChannelClient.connect(secureChannelClientConfig);
+	BOOST_REQUIRE(secureChannel != nullptr);
+	BOOST_REQUIRE(secureChannelClientTest.handleConnect_.waitForCondition(1000) == true);
+	BOOST_REQUIRE(secureChannelServerTest.handleConnect_.waitForCondition(1000) == true);
+
+	// send requests one after another and measure the throughput
+	boost::posix_time::ptime start = boost::posix_time::microsec_clock::local_time();
+	uint32_t numberRequests = 1000;
+	for (uint32_t idx = 0; idx < numberRequests; idx++) {
+		boost::asio::streambuf sb;
+		std::iostream os(&sb);
+		GetEndpointsRequest getEndpointsRequest;
+		getEndpointsRequest.endpointUrl("opc.mem://SecureChannel_t");
+		getEndpointsRequest.opcUaBinaryEncode(os);
+
+		SecureChannelTransaction::SPtr secureChannelTransaction = constructSPtr<SecureChannelTransaction>();
+		secureChannelTransaction->requestTypeNodeId_. nodeId((uint32_t)OpcUaId_GetEndpointsRequest_Encoding_DefaultBinary);
+		secureChannelTransaction->requestId_ = idx + 1;
+		secureChannelTransaction->osAppend(sb);
+
+		secureChannelClientTest.handleMessageResponse_.condition(1,0);
+		secureChannelServerTest.handleMessageRequest_.condition(1,0);
+		secureChannelClient.asyncWriteMessageRequest(secureChannel, secureChannelTransaction);
+		BOOST_REQUIRE(secureChannelServerTest.handleMessageRequest_.waitForCondition(1000) == true);
+		BOOST_REQUIRE(secureChannelClientTest.handleMessageResponse_.waitForCondition(1000) == true);
+	}
+	boost::posix_time::time_duration duration = boost::posix_time::microsec_clock::local_time() - start;
+	std::cout << "opc.mem requests per second: "
+		<< (numberRequests * 1000000LL) / (duration.total_microseconds() + 1) << std::endl;
+
+	// diconnect
+	secureChannelClientTest.handleDisconnect_.condition(1,0);
+	secureChannelServerTest.handleDisconnect_.condition(1,0);
+	secureChannelClient.disconnect(secureChannel);
+	BOOST_REQUIRE(secureChannelClientTest.handleDisconnect_.waitForCondition(1000) == true);
+	BOOST_REQUIRE(secureChannelServerTest.handleDisconnect_.waitForCondition(1000) == true);
+
+	// open, requests and close are recorded
+	BOOST_REQUIRE(secureChannelCapture->numberRecords() == numberRequests + 2);
+	secureChannelCapture->close();
+
+	// disconnect server endpoint
+	secureChannelServerTest.handleEndpointClose_.condition(1,0);
+	secureChannelServer.disconnect();
+	BOOST_REQUIRE(secureChannelServerTest.handleEndpointClose_.waitForCondition(1000) == true);
+
+	ioThread.shutdown();
+}
+
+BOOST_AUTO_TEST_CASE(SecureChannel_memory_RequestWindow)
+{
+	OpcUaStackCore::SecureChannel* secureChannel;
+	SecureChannelClientTest secureChannelClientTest;
+	SecureChannelServerTest secureChannelServerTest;
+
+	IOThread ioThread;
+	ioThread.startup();
+
+	SecureChannelServer secureChannelServer(&ioThread);
+	SecureChannelClient secureChannelClient(&ioThread);
+	secureChannelServer.secureChannelServerIf(&secureChannelServerTest);
+	secureChannelClient.secureChannelClientIf(&secureChannelClientTest);
+
+	secureChannelServerTest.secureChannelServer_ = &secureChannelServer;
+	secureChannelServerTest.deferResponse_ = true;
+
+	ApplicationCertificate::SPtr applicationCertificate = createApplicationCertificate();
+	CryptoManager::SPtr cryptoManager = constructSPtr<CryptoManager>();
+	secureChannelServer.applicationCertificate(applicationCertificate);
+	secureChannelServer.cryptoManager(cryptoManager);
+	secureChannelClient.applicationCertificate(applicationCertificate);
+	secureChannelClient.cryptoManager(cryptoManager);
+
+	// server open in process endpoint with a request window of two requests
+	EndpointDescription::SPtr endpointDescription = constructSPtr<EndpointDescription>();
+	endpointDescription->endpointUrl("opc.mem://SecureChannel_t_window");
+	EndpointDescriptionArray::SPtr endpointDescriptionArray = constructSPtr<EndpointDescriptionArray>();
+	endpointDescriptionArray->resize(1);
+	endpointDescriptionArray->push_back(endpointDescription);
+
+	secureChannelServerTest.handleEndpointOpen_.condition(1,0);
+	SecureChannelServerConfig::SPtr secureChannelServerConfig = constructSPtr<SecureChannelServerConfig>();
+	secureChannelServerConfig->endpointUrl("opc.mem://SecureChannel_t_window");
+	secureChannelServerConfig->endpointDescriptionArray(endpointDescriptionArray);
+	secureChannelServerConfig->maxRequestsInFlight(2);
+	secureChannelServer.accept(secureChannelServerConfig);
+	BOOST_REQUIRE(secureChannelServerTest.handleEndpointOpen_.waitForCondition(1000) == true);
+
+	// client connect to server
+	secureChannelClientTest.handleConnect_.condition(1,0);
+	secureChannelServerTest.handleConnect_.condition(1,0);
+	SecureChannelClientConfig::SPtr secureChannelClientConfig = constructSPtr<SecureChannelClientConfig>();
+	secureChannelClientConfig->endpointUrl("opc.mem://SecureChannel_t_window");
+	secureChannel = secureChannelClient.connect(secureChannelClientConfig);
+	BOOST_REQUIRE(secureChannel != nullptr);
+	BOOST_REQUIRE(secureChannelClientTest.handleConnect_.waitForCondition(1000) == true);
+	BOOST_REQUIRE(secureChannelServerTest.handleConnect_.waitForCondition(1000) == true);
+	OpcUaStackCore::SecureChannel* serverChannel = secureChannelServerTest.secureChannel_;
+
+	// send five requests without waiting for the responses. The server
+	// reads only the first two requests.
+	uint32_t numberRequests = 5;
+	secureChannelServerTest.handleMessageRequest_.condition(2,0);
+	secureChannelClientTest.handleMessageResponse_.condition(numberRequests,0);
+	for (uint32_t idx = 0; idx < numberRequests; idx++) {
+		boost::asio::streambuf sb;
+		std::iostream os(&sb);
+		GetEndpointsRequest getEndpointsRequest;
+		getEndpointsRequest.endpointUrl("opc.mem://SecureChannel_t_window");
+		getEndpointsRequest.opcUaBinaryEncode(os);
+
+		SecureChannelTransaction::SPtr secureChannelTransaction = constructSPtr<SecureChannelTransaction>();
+		secureChannelTransaction->requestTypeNodeId_. nodeId((uint32_t)OpcUaId_GetEndpointsRequest_Encoding_DefaultBinary);
+		secureChannelTransaction->requestId_ = idx + 1;
+		secureChannelTransaction->osAppend(sb);
+
+		SecureChannelClient* client = &secureChannelClient;
+		secureChannel->strand()->post([client, secureChannel, secureChannelTransaction](void) {
+			client->asyncWriteMessageRequest(secureChannel, secureChannelTransaction);
+		});
+	}
+	BOOST_REQUIRE(secureChannelServerTest.handleMessageRequest_.waitForCondition(1000) == true);
+	boost::this_thread::sleep(boost::posix_time::milliseconds(100));
+	{
+		boost::mutex::scoped_lock g(secureChannelServerTest.deferredResponseMutex_);
+		BOOST_REQUIRE(secureChannelServerTest.deferredResponseVec_.size() == 2);
+	}
+
+	// the responses are sent in reverse order. Each response opens the
+	// request window for the next request.
+	for (uint32_t idx = 0; idx < numberRequests; idx++) {
+		SecureChannelTransaction::SPtr secureChannelTransaction;
+		for (uint32_t wait = 0; wait < 100; wait++) {
+			boost::mutex::scoped_lock g(secureChannelServerTest.deferredResponseMutex_);
+			if (!secureChannelServerTest.deferredResponseVec_.empty()) {
+				secureChannelTransaction = secureChannelServerTest.deferredResponseVec_.back();
+				secureChannelServerTest.deferredResponseVec_.pop_back();
+				break;
+			}
+			g.unlock();
+			boost::this_thread::sleep(boost::posix_time::milliseconds(10));
+		}
+		BOOST_REQUIRE(secureChannelTransaction.get() != nullptr);
+
+		SecureChannelServer* server = &secureChannelServer;
+		serverChannel->strand()->post([server, serverChannel, secureChannelTransaction](void) mutable {
+			server->sendResponse(serverChannel, secureChannelTransaction);
+		});
+	}
+	BOOST_REQUIRE(secureChannelClientTest.handleMessageResponse_.waitForCondition(1000) == true);
+
+	// concurrency statistic of the server channel
+	uint32_t requestCount;
+	uint32_t requestsInFlight;
+	uint32_t requestsInFlightMax;
+	uint32_t requestWindowPauseCount;
+	serverChannel->requestWindowStatistic(requestCount, requestsInFlight, requestsInFlightMax, requestWindowPauseCount);
+	BOOST_REQUIRE(requestCount == numberRequests);
+	BOOST_REQUIRE(requestsInFlight == 0);
+	BOOST_REQUIRE(requestsInFlightMax == 2);
+	BOOST_REQUIRE(requestWindowPauseCount >= 1);
+
+	// diconnect
+	secureChannelClientTest.handleDisconnect_.condition(1,0);
+	secureChannelServerTest.handleDisconnect_.condition(1,0);
+	secureChannelClient.disconnect(secureChannel);
+	BOOST_REQUIRE(secureChannelClientTest.handleDisconnect_.waitForCondition(1000) == true);
+	BOOST_REQUIRE(secureChannelServerTest.handleDisconnect_.waitForCondition(1000) == true);
+
+	// disconnect server endpoint
+	secureChannelServerTest.handleEndpointClose_.condition(1,0);
+	secureChannelServer.disconnect();
+	BOOST_REQUIRE(secureChannelServerTest.handleEndpointClose_.waitForCondition(1000) == true);
+
+	ioThread.shutdown();
+}
+
+
+BOOST_AUTO_TEST_CASE(SecureChannel_handshake_timeout)
+{
+	SecureChannelServerTest secureChannelServerTest;
+
+	IOThread ioThread;
+	ioThread.startup();
+
+	SecureChannelServer secureChannelServer(&ioThread);
+	secureChannelServer.secureChannelServerIf(&secureChannelServerTest);
+
+	ApplicationCertificate::SPtr applicationCertificate = createApplicationCertificate();
+	CryptoManager::SPtr cryptoManager = constructSPtr<CryptoManager>();
+	secureChannelServer.applicationCertificate(applicationCertificate);
+	secureChannelServer.cryptoManager(cryptoManager);
+
+	AdmissionControl::SPtr admissionControl = constructSPtr<AdmissionControl>();
+	admissionControl->handshakeTimeout(200);
+	secureChannelServer.admissionControl(admissionControl);
+
+	// server open endpoint
+	EndpointDescription::SPtr endpointDescription = constructSPtr<EndpointDescription>();
+	endpointDescription->endpointUrl("opc.tcp://127.0.0.1:48013");
+	EndpointDescriptionArray::SPtr endpointDescriptionArray = constructSPtr<EndpointDescriptionArray>();
+	endpointDescriptionArray->resize(1);
+	endpointDescriptionArray->push_back(endpointDescription);
+
+	secureChannelServerTest.handleEndpointOpen_.condition(1,0);
+	SecureChannelServerConfig::SPtr secureChannelServerConfig = constructSPtr<SecureChannelServerConfig>();
+	secureChannelServerConfig->endpointUrl("opc.tcp://127.0.0.1:48013");
+	secureChannelServerConfig->endpointDescriptionArray(endpointDescriptionArray);
+	secureChannelServer.accept(secureChannelServerConfig);
+	BOOST_REQUIRE(secureChannelServerTest.handleEndpointOpen_.waitForCondition(1000) == true);
+
+	// the client connects but never sends the hello message
+	boost::asio::io_service ioService;
+	boost::asio::ip::tcp::socket socket(ioService);
+	boost::system::error_code ec;
+	socket.connect(
+		boost::asio::ip::tcp::endpoint(boost::asio::ip::address::from_string("127.0.0.1"), 48013),
+		ec
+	);
+	BOOST_REQUIRE(!ec);
+
+	for (uint32_t wait = 0; wait < 100; wait++) {
+		if (admissionControl->handshakeExpiredCount() != 0) break;
+		boost::this_thread::sleep(boost::posix_time::milliseconds(10));
+	}
+	BOOST_REQUIRE(admissionControl->handshakeExpiredCount() == 1);
+
+	// the server has closed the connection
+	char buf[1];
+	socket.read_some(boost::asio::buffer(buf, 1), ec);
+	BOOST_REQUIRE(ec == boost::asio::error::eof || ec == boost::asio::error::connection_reset);
+	socket.close();
+
+	for (uint32_t wait = 0; wait < 100; wait++) {
+		if (admissionControl->connections() == 0) break;
+		boost::this_thread::sleep(boost::posix_time::milliseconds(10));
+	}
+	BOOST_REQUIRE(admissionControl->handshakes() == 0);
+	BOOST_REQUIRE(admissionControl->connections() == 0);
+
+	// disconnect server endpoint
+	secureChannelServerTest.handleEndpointClose_.condition(1,0);
+	secureChannelServer.disconnect();
+	BOOST_REQUIRE(secureChannelServerTest.handleEndpointClose_.waitForCondition(1000) == true);
+
+	ioThread.shutdown();
+}
+
 BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,223 @@
+#include "unittest.h"
+#include "OpcUaStackCore/SecureChannel/SendQueueLimit.h"
+#include "OpcUaStackCore/SecureChannel/SecureChannel.h"
+#include "OpcUaStackCore/BuildInTypes/OpcUaIdentifier.h"
+
+using namespace OpcUaStackCore;
+
+void
+sendQueuePush(SecureChannel& secureChannel, OpcUaUInt32 responseType, OpcUaUInt32 requestId)
+{
+	SecureChannelTransaction::SPtr secureChannelTransaction = constructSPtr<SecureChannelTransaction>();
+	secureChannelTransaction->responseTypeNodeId_ = OpcUaNodeId(responseType);
+	secureChannelTransaction->requestId_ = requestId;
+	std::ostream os(&secureChannelTransaction->os_);
+	os << std::string(100, 'x');
+	secureChannel.sendQueuePush(secureChannelTransaction);
+}
+
+OpcUaUInt32
+sendQueueRequestId(SecureChannel& secureChannel, uint32_t idx)
+{
+	SecureChannelTransaction::List::iterator it = secureChannel.secureChannelTransactionList_.begin();
+	std::advance(it, idx);
+	return (*it)->requestId_;
+}
+
+BOOST_AUTO_TEST_SUITE(SendQueueLimit_)
+
+BOOST_AUTO_TEST_CASE(SendQueueLimit_)
+{
+	std::cout << "SendQueueLimit_t" << std::endl;
+}
+
+BOOST_AUTO_TEST_CASE(SendQueueLimit_disabled)
+{
+	SendQueueLimit sendQueueLimit;
+
+	BOOST_REQUIRE(sendQueueLimit.enabled() == false);
+	BOOST_REQUIRE(sendQueueLimit.aboveHighWaterMark(1000000, 1000000000) == false);
+	BOOST_REQUIRE(sendQueueLimit.belowLowWaterMark(1000000, 1000000000) == true);
+}
+
+BOOST_AUTO_TEST_CASE(SendQueueLimit_bytes)
+{
+	SendQueueLimit sendQueueLimit;
+	sendQueueLimit.highWaterMarkBytes(1000);
+	sendQueueLimit.lowWaterMarkBytes(200);
+
+	BOOST_REQUIRE(sendQueueLimit.enabled() == true);
+	BOOST_REQUIRE(sendQueueLimit.aboveHighWaterMark(100, 1000) == false);
+	BOOST_REQUIRE(sendQueueLimit.aboveHighWaterMark(100, 1001) == true);
+	BOOST_REQUIRE(sendQueueLimit.belowLowWaterMark(100, 201) == false);
+	BOOST_REQUIRE(sendQueueLimit.belowLowWaterMark(100, 200) == true);
+}
+
+BOOST_AUTO_TEST_CASE(SendQueueLimit_messages)
+{
+	SendQueueLimit sendQueueLimit;
+	sendQueueLimit.highWaterMarkMessages(10);
+
+	// low water mark is half of the high water mark
+	BOOST_REQUIRE(sendQueueLimit.lowWaterMarkMessages() == 5);
+	BOOST_REQUIRE(sendQueueLimit.aboveHighWaterMark(10, 100000) == false);
+	BOOST_REQUIRE(sendQueueLimit.aboveHighWaterMark(11, 0) == true);
+	BOOST_REQUIRE(sendQueueLimit.belowLowWaterMark(6, 0) == false);
+	BOOST_REQUIRE(sendQueueLimit.belowLowWaterMark(5, 100000) == true);
+}
+
+BOOST_AUTO_TEST_CASE(SendQueueLimit_policy)
+{
+	SlowConsumerPolicy slowConsumerPolicy;
+
+	BOOST_REQUIRE(SendQueueLimit::slowConsumerPolicy("DropOldest", slowConsumerPolicy) == true);
+	BOOST_REQUIRE(slowConsumerPolicy == SCP_DropOldest);
+	BOOST_REQUIRE(SendQueueLimit::slowConsumerPolicy("Coalesce", slowConsumerPolicy) == true);
+	BOOST_REQUIRE(slowConsumerPolicy == SCP_Coalesce);
+	BOOST_REQUIRE(SendQueueLimit::slowConsumerPolicy("Close", slowConsumerPolicy) == true);
+	BOOST_REQUIRE(slowConsumerPolicy == SCP_Close);
+	BOOST_REQUIRE(SendQueueLimit::slowConsumerPolicy("Unknown", slowConsumerPolicy) == false);
+
+	BOOST_REQUIRE(SendQueueLimit::slowConsumerPolicyToString(SCP_Coalesce) == "Coalesce");
+}
+
+BOOST_AUTO_TEST_CASE(SendQueueLimit_drop_oldest)
+{
+	IOThread ioThread;
+	ioThread.startup();
+	{
+		SecureChannel secureChannel(&ioThread);
+		secureChannel.sendQueueLimit_.highWaterMarkMessages(3);
+
+		sendQueuePush(secureChannel, OpcUaId_PublishResponse_Encoding_DefaultBinary, 1);
+		sendQueuePush(secureChannel, OpcUaId_ReadResponse_Encoding_DefaultBinary, 2);
+		sendQueuePush(secureChannel, OpcUaId_PublishResponse_Encoding_DefaultBinary, 3);
+		sendQueuePush(secureChannel, OpcUaId_PublishResponse_Encoding_DefaultBinary, 4);
+		sendQueuePush(secureChannel, OpcUaId_PublishResponse_Encoding_DefaultBinary, 5);
+		BOOST_REQUIRE(secureChannel.sendQueueMessages() == 5);
+		BOOST_REQUIRE(secureChannel.sendQueueBytes() == 500);
+		BOOST_REQUIRE(secureChannel.sendQueueAboveHighWaterMark() == true);
+
+		// the oldest publish responses are dropped until the queue is not
+		// above the high water mark. The read response is kept
+		BOOST_REQUIRE(secureChannel.sendQueueDrop(false) == 2);
+		BOOST_REQUIRE(secureChannel.sendQueueMessages() == 3);
+		BOOST_REQUIRE(secureChannel.sendQueueBytes() == 300);
+		BOOST_REQUIRE(secureChannel.sendQueueDropCount() == 2);
+		BOOST_REQUIRE(sendQueueRequestId(secureChannel, 0) == 2);
+		BOOST_REQUIRE(sendQueueRequestId(secureChannel, 1) == 4);
+		BOOST_REQUIRE(sendQueueRequestId(secureChannel, 2) == 5);
+
+		BOOST_REQUIRE(secureChannel.sendQueueMaxMessages() == 5);
+		BOOST_REQUIRE(secureChannel.sendQueueMaxBytes() == 500);
+	}
+	ioThread.shutdown();
+}
+
+BOOST_AUTO_TEST_CASE(SendQueueLimit_drop_in_progress)
+{
+	IOThread ioThread;
+	ioThread.startup();
+	{
+		SecureChannel secureChannel(&ioThread);
+		secureChannel.sendQueueLimit_.highWaterMarkMessages(1);
+
+		sendQueuePush(secureChannel, OpcUaId_PublishResponse_Encoding_DefaultBinary, 1);
+		sendQueuePush(secureChannel, OpcUaId_PublishResponse_Encoding_DefaultBinary, 2);
+
+		// the first response is partially sent and must not be dropped
+		secureChannel.sendFirstSegment_ = false;
+		BOOST_REQUIRE(secureChannel.sendQueueDrop(false) == 1);
+		BOOST_REQUIRE(secureChannel.sendQueueMessages() == 1);
+		BOOST_REQUIRE(sendQueueRequestId(secureChannel, 0) == 1);
+	}
+	ioThread.shutdown();
+}
+
+BOOST_AUTO_TEST_CASE(SendQueueLimit_coalesce)
+{
+	IOThread ioThread;
+	ioThread.startup();
+	{
+		SecureChannel secureChannel(&ioThread);
+		secureChannel.sendQueueLimit_.highWaterMarkMessages(10);
+
+		sendQueuePush(secureChannel, OpcUaId_PublishResponse_Encoding_DefaultBinary, 1);
+		sendQueuePush(secureChannel, OpcUaId_PublishResponse_Encoding_DefaultBinary, 2);
+		sendQueuePush(secureChannel, OpcUaId_ReadResponse_Encoding_DefaultBinary, 3);
+		sendQueuePush(secureChannel, OpcUaId_PublishResponse_Encoding_DefaultBinary, 4);
+		sendQueuePush(secureChannel, OpcUaId_ReadResponse_Encoding_DefaultBinary, 5);
+
+		// only the latest publish response is kept
+		BOOST_REQUIRE(secureChannel.sendQueueDrop(true) == 2);
+		BOOST_REQUIRE(secureChannel.sendQueueMessages() == 3);
+		BOOST_REQUIRE(secureChannel.sendQueueBytes() == 300);
+		BOOST_REQUIRE(sendQueueRequestId(secureChannel, 0) == 3);
+		BOOST_REQUIRE(sendQueueRequestId(secureChannel, 1) == 4);
+		BOOST_REQUIRE(sendQueueRequestId(secureChannel, 2) == 5);
+	}
+	ioThread.shutdown();
+}
+
+BOOST_AUTO_TEST_CASE(SendQueueLimit_pause_resume)
+{
+	IOThread ioThread;
+	ioThread.startup();
+	{
+		SecureChannel secureChannel(&ioThread);
+		secureChannel.sendQueueLimit_.highWaterMarkMessages(4);
+
+		for (uint32_t idx = 0; idx < 4; idx++) {
+			sendQueuePush(secureChannel, OpcUaId_ReadResponse_Encoding_DefaultBinary, idx);
+		}
+		BOOST_REQUIRE(secureChannel.sendQueuePauseRead() == false);
+		BOOST_REQUIRE(secureChannel.recvPause_ == false);
+
+		sendQueuePush(secureChannel, OpcUaId_ReadResponse_Encoding_DefaultBinary, 4);
+		BOOST_REQUIRE(secureChannel.sendQueuePauseRead() == true);
+		BOOST_REQUIRE(secureChannel.recvPause_ == true);
+
+		// reading is continued below the low water mark (half of the high
+		// water mark)
+		secureChannel.sendQueuePop();
+		secureChannel.sendQueuePop();
+		BOOST_REQUIRE(secureChannel.sendQueueResumeRead() == false);
+		secureChannel.sendQueuePop();
+		BOOST_REQUIRE(secureChannel.sendQueueResumeRead() == true);
+		BOOST_REQUIRE(secureChannel.recvPause_ == false);
+		BOOST_REQUIRE(secureChannel.sendQueueResumeRead() == false);
+	}
+	ioThread.shutdown();
+}
+
+BOOST_AUTO_TEST_CASE(SendQueueLimit_streamed_response)
+{
+	IOThread ioThread;
+	ioThread.startup();
+	{
+		SecureChannel secureChannel(&ioThread);
+
+		SecureChannelTransaction::SPtr secureChannelTransaction = constructSPtr<SecureChannelTransaction>();
+		MessageChunkBuffer::SPtr chunkBuffer(new MessageChunkBuffer(100, 0, 0));
+		secureChannelTransaction->chunkBuffer_ = chunkBuffer;
+		secureChannel.sendQueuePush(secureChannelTransaction);
+		BOOST_REQUIRE(secureChannel.sendQueueBytes() == 0);
+
+		// the queued size grows while the response is encoded
+		std::ostream os(chunkBuffer.get());
+		os << std::string(250, 'x');
+		os.flush();
+		secureChannel.sendQueueUpdate();
+		BOOST_REQUIRE(secureChannel.sendQueueBytes() == 200);
+
+		chunkBuffer->finish();
+		secureChannel.sendQueueUpdate();
+		BOOST_REQUIRE(secureChannel.sendQueueBytes() == 250);
+
+		secureChannel.sendQueuePop();
+		BOOST_REQUIRE(secureChannel.sendQueueBytes() == 0);
+	}
+	ioThread.shutdown();
+}
+
+BOOST_AUTO_TEST_SUITE_END()
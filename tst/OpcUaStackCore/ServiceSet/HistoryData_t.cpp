@@ -1,6 +1,7 @@
 #include "unittest.h"
 #include "OpcUaStackCore/ServiceSet/HistoryModifiedData.h"
 #include "OpcUaStackCore/ServiceSet/HistoryData.h"
+#include "OpcUaStackCore/ServiceSet/TimestampsToReturn.h"
 #include "OpcUaStackCore/Base/Utility.h"
 #include <boost/iostreams/stream.hpp>
 
@@ -39,6 +40,54 @@ BOOST_AUTO_TEST_CASE(HistoryData_HistoryData)
 
 }
 
+BOOST_AUTO_TEST_CASE(HistoryData_timestampsToReturn)
+{
+	boost::asio::streambuf sb;
+	std::iostream ios(&sb);
+
+	boost::posix_time::ptime ptime = boost::posix_time::from_iso_string("20140506T102013.123456");
+
+	OpcUaDataValue::SPtr value1, value2, value;
+	HistoryData data1, data2;
+
+	// encode
+	value1 = constructSPtr<OpcUaDataValue>();
+	value1->variant()->variant((OpcUaUInt32)1);
+	value1->sourceTimestamp().dateTime(ptime);
+	value1->serverTimestamp().dateTime(ptime);
+	value2 = constructSPtr<OpcUaDataValue>();
+	value2->variant()->variant((OpcUaUInt32)2);
+	value2->sourceTimestamp().dateTime(ptime);
+	value2->serverTimestamp().dateTime(ptime);
+
+	data1.dataValues()->resize(3);
+	data1.dataValues()->push_back(value1);
+	data1.dataValues()->push_back(value);
+	data1.dataValues()->push_back(value2);
+	data1.timestampsToReturn(TimestampsToReturn_Source);
+	data1.opcUaBinaryEncode(ios);
+
+	// the values of the application are not changed
+	BOOST_REQUIRE(value1->serverTimestamp().exist() == true);
+	BOOST_REQUIRE(value2->serverTimestamp().exist() == true);
+
+	// decode
+	data2.opcUaBinaryDecode(ios);
+	BOOST_REQUIRE(data2.dataValues()->size() == 3);
+
+	data2.dataValues()->get(0, value);
+	BOOST_REQUIRE(value->variant()->get<OpcUaUInt32>() == 1);
+	BOOST_REQUIRE(value->sourceTimestamp().dateTime() == ptime);
+	BOOST_REQUIRE(value->serverTimestamp().exist() == false);
+
+	data2.dataValues()->get(1, value);
+	BOOST_REQUIRE(value->variant()->isNull() == true);
+
+	data2.dataValues()->get(2, value);
+	BOOST_REQUIRE(value->variant()->get<OpcUaUInt32>() == 2);
+	BOOST_REQUIRE(value->serverTimestamp().exist() == false);
+}
+
 BOOST_AUTO_TEST_CASE(HistoryData_HistoryModifiedData)
 {
 	boost::asio::streambuf sb;
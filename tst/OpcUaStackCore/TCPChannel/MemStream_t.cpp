@@ -0,0 +1,186 @@
+#include "unittest.h"
+
+#include "OpcUaStackCore/Base/IOService.h"
+#include "OpcUaStackCore/TCPChannel/TCPAcceptor.h"
+#include "OpcUaStackCore/TCPChannel/TCPConnection.h"
+#include "OpcUaStackCore/TCPChannel/TCPTestHandler.h"
+
+#define MEMORY_NAME	"MemStream_t"
+
+using namespace OpcUaStackCore;
+
+BOOST_AUTO_TEST_SUITE(MemStream_)
+
+BOOST_AUTO_TEST_CASE(MemStream_)
+{
+	std::cout << "MemStream_t" << std::endl;
+}
+
+BOOST_AUTO_TEST_CASE(MemStream_send_receive_close)
+{
+	boost::asio::streambuf isServer;
+	boost::asio::streambuf osClient;
+	std::ostream os(&osClient);
+
+	TCPTestHandler tcpTestHandler;
+
+	IOService ioService;
+	TCPConnection tcpConnectionServer(ioService.io_service());
+	TCPConnection tcpConnectionClient(ioService.io_service());
+	tcpConnectionServer.memory(true);
+	tcpConnectionClient.memory(true);
+	MemAcceptor::SPtr memAcceptor(new MemAcceptor(ioService.io_service(), MEMORY_NAME));
+	TCPAcceptor tcpAcceptor(ioService.io_service(), memAcceptor);
+	ioService.start();
+
+	//
+	// connect the memory streams
+	//
+	tcpTestHandler.handleAcceptCondition_.condition(0, 1);
+
+	tcpAcceptor.listen();
+	tcpAcceptor.async_accept(
+		tcpConnectionServer.memStream(),
+		boost::bind(&TCPTestHandler::handleAccept, &tcpTestHandler, boost::asio::placeholders::error)
+	);
+	BOOST_REQUIRE(MemAcceptor::connect(MEMORY_NAME, tcpConnectionClient.memStream()) == true);
+	BOOST_REQUIRE(tcpTestHandler.handleAcceptCondition_.waitForCondition(1000) == true);
+	BOOST_REQUIRE(tcpTestHandler.handleAcceptError_.value() == 0);
+	BOOST_REQUIRE(tcpConnectionServer.memStream().isOpen() == true);
+	BOOST_REQUIRE(tcpConnectionClient.memStream().isOpen() == true);
+
+	//
+	// send message from client to server
+	//
+	for (uint32_t idx = 0; idx < 100000; idx++) os << (char)('a' + (idx % 26));
+
+	tcpTestHandler.handleReadServerCondition_.condition(0, 1);
+	tcpTestHandler.handleWriteClientCondition_.condition(0, 1);
+
+	tcpConnectionServer.async_read_exactly(
+		isServer,
+		boost::bind(&TCPTestHandler::handleReadServer, &tcpTestHandler, boost::asio::placeholders::error, boost::asio::placeholders::bytes_transferred),
+		100000
+	);
+	tcpConnectionClient.async_write(
+		osClient,
+		boost::bind(&TCPTestHandler::handleWriteClient, &tcpTestHandler, boost::asio::placeholders::error)
+	);
+
+	BOOST_REQUIRE(tcpTestHandler.handleReadServerCondition_.waitForCondition(10000) == true);
+	BOOST_REQUIRE(tcpTestHandler.handleWriteClientCondition_.waitForCondition(10000) == true);
+	BOOST_REQUIRE(tcpTestHandler.handleReadServerError_.value() == 0);
+	BOOST_REQUIRE(tcpTestHandler.handleWriteClientError_.value() == 0);
+	BOOST_REQUIRE(isServer.size() == 100000);
+
+	std::istream is(&isServer);
+	char c1, c2;
+	is.get(c1);
+	is.ignore(99998);
+	is.get(c2);
+	BOOST_REQUIRE(c1 == 'a');
+	BOOST_REQUIRE(c2 == (char)('a' + (99999 % 26)));
+
+	//
+	// send message in two buffers from client to server
+	//
+	boost::asio::streambuf osClient1;
+	boost::asio::streambuf osClient2;
+	std::ostream os1(&osClient1);
+	std::ostream os2(&osClient2);
+	os1 << "Hello";
+	os2 << "World";
+
+	tcpTestHandler.handleReadServerCondition_.condition(0, 1);
+	tcpTestHandler.handleWriteClientCondition_.condition(0, 1);
+
+	tcpConnectionServer.async_read_exactly(
+		isServer,
+		boost::bind(&TCPTestHandler::handleReadServer, &tcpTestHandler, boost::asio::placeholders::error, boost::asio::placeholders::bytes_transferred),
+		10
+	);
+	tcpConnectionClient.async_write(
+		osClient1,
+		osClient2,
+		boost::bind(&TCPTestHandler::handleWriteClient, &tcpTestHandler, boost::asio::placeholders::error)
+	);
+
+	BOOST_REQUIRE(tcpTestHandler.handleReadServerCondition_.waitForCondition(10000) == true);
+	BOOST_REQUIRE(tcpTestHandler.handleWriteClientCondition_.waitForCondition(10000) == true);
+	BOOST_REQUIRE(tcpTestHandler.handleReadServerError_.value() == 0);
+	BOOST_REQUIRE(isServer.size() == 10);
+
+	std::string str;
+	is >> str;
+	BOOST_REQUIRE(str == "HelloWorld");
+
+	//
+	// close by client
+	//
+	tcpTestHandler.handleReadServerCondition_.condition(0, 1);
+	tcpConnectionServer.async_read_atLeast(
+		isServer,
+		boost::bind(&TCPTestHandler::handleReadServer, &tcpTestHandler, boost::asio::placeholders::error, boost::asio::placeholders::bytes_transferred),
+		1
+	);
+	tcpConnectionClient.close();
+
+	BOOST_REQUIRE(tcpTestHandler.handleReadServerCondition_.waitForCondition(10000) == true);
+	BOOST_REQUIRE(tcpTestHandler.handleReadServerError_ == boost::asio::error::eof);
+
+	tcpConnectionServer.close();
+	tcpAcceptor.close();
+	ioService.stop();
+}
+
+BOOST_AUTO_TEST_CASE(MemStream_backlog_refused)
+{
+	TCPTestHandler tcpTestHandler;
+
+	IOService ioService;
+	TCPConnection tcpConnectionServer(ioService.io_service());
+	TCPConnection tcpConnectionClient(ioService.io_service());
+	tcpConnectionServer.memory(true);
+	tcpConnectionClient.memory(true);
+	MemAcceptor::SPtr memAcceptor(new MemAcceptor(ioService.io_service(), MEMORY_NAME));
+	TCPAcceptor tcpAcceptor(ioService.io_service(), memAcceptor);
+	ioService.start();
+
+	// no acceptor is listening
+	BOOST_REQUIRE(MemAcceptor::connect(MEMORY_NAME, tcpConnectionClient.memStream()) == false);
+
+	// the name of a listening acceptor is unique
+	tcpAcceptor.listen();
+	MemAcceptor memAcceptor2(ioService.io_service(), MEMORY_NAME);
+	BOOST_REQUIRE_THROW(memAcceptor2.listen(), boost::system::system_error);
+
+	// the connection waits in the backlog for the accept
+	BOOST_REQUIRE(MemAcceptor::connect(MEMORY_NAME, tcpConnectionClient.memStream()) == true);
+
+	tcpTestHandler.handleAcceptCondition_.condition(0, 1);
+	tcpAcceptor.async_accept(
+		tcpConnectionServer.memStream(),
+		boost::bind(&TCPTestHandler::handleAccept, &tcpTestHandler, boost::asio::placeholders::error)
+	);
+	BOOST_REQUIRE(tcpTestHandler.handleAcceptCondition_.waitForCondition(1000) == true);
+	BOOST_REQUIRE(tcpTestHandler.handleAcceptError_.value() == 0);
+	BOOST_REQUIRE(tcpConnectionServer.memStream().isOpen() == true);
+
+	// a pending accept is aborted by the close of the acceptor
+	TCPConnection tcpConnectionServer2(ioService.io_service());
+	tcpConnectionServer2.memory(true);
+	tcpTestHandler.handleAcceptCondition_.condition(0, 1);
+	tcpAcceptor.async_accept(
+		tcpConnectionServer2.memStream(),
+		boost::bind(&TCPTestHandler::handleAccept, &tcpTestHandler, boost::asio::placeholders::error)
+	);
+	tcpAcceptor.close();
+	BOOST_REQUIRE(tcpTestHandler.handleAcceptCondition_.waitForCondition(1000) == true);
+	BOOST_REQUIRE(tcpTestHandler.handleAcceptError_ == boost::asio::error::operation_aborted);
+
+	tcpConnectionClient.close();
+	tcpConnectionServer.close();
+	ioService.stop();
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,121 @@
+#include "unittest.h"
+#include "OpcUaStackCore/TCPChannel/ShmRingBuffer.h"
+
+#include <vector>
+
+using namespace OpcUaStackCore;
+
+BOOST_AUTO_TEST_SUITE(ShmRingBuffer_)
+
+BOOST_AUTO_TEST_CASE(ShmRingBuffer_)
+{
+	std::cout << "ShmRingBuffer_t" << std::endl;
+}
+
+BOOST_AUTO_TEST_CASE(ShmRingBuffer_init_attach)
+{
+	std::vector<char> memory(ShmRingBuffer::memorySize(16));
+
+	ShmRingBuffer producer;
+	BOOST_REQUIRE(producer.init(&memory[0], 15) == false);
+	BOOST_REQUIRE(producer.init(&memory[0], 16) == true);
+
+	ShmRingBuffer consumer;
+	BOOST_REQUIRE(consumer.attach(&memory[0]) == true);
+	BOOST_REQUIRE(consumer.capacity() == 16);
+	BOOST_REQUIRE(consumer.readAvailable() == 0);
+	BOOST_REQUIRE(producer.writeAvailable() == 16);
+}
+
+BOOST_AUTO_TEST_CASE(ShmRingBuffer_write_read_wrap)
+{
+	std::vector<char> memory(ShmRingBuffer::memorySize(16));
+	ShmRingBuffer producer;
+	ShmRingBuffer consumer;
+	producer.init(&memory[0], 16);
+	consumer.attach(&memory[0]);
+
+	char buf[32];
+	BOOST_REQUIRE(producer.write("0123456789", 10) == 10);
+	BOOST_REQUIRE(consumer.read(buf, 8) == 8);
+	BOOST_REQUIRE(std::string(buf, 8) == "01234567");
+
+	// the next write wraps around the end of the buffer
+	BOOST_REQUIRE(producer.write("abcdefghijklmnopq", 17) == 14);
+	BOOST_REQUIRE(producer.writeAvailable() == 0);
+	BOOST_REQUIRE(producer.write("x", 1) == 0);
+
+	BOOST_REQUIRE(consumer.read(buf, 32) == 16);
+	BOOST_REQUIRE(std::string(buf, 16) == "89abcdefghijklmn");
+	BOOST_REQUIRE(consumer.read(buf, 32) == 0);
+}
+
+BOOST_AUTO_TEST_CASE(ShmRingBuffer_waiting_close)
+{
+	std::vector<char> memory(ShmRingBuffer::memorySize(16));
+	ShmRingBuffer producer;
+	ShmRingBuffer consumer;
+	producer.init(&memory[0], 16);
+	consumer.attach(&memory[0]);
+
+	BOOST_REQUIRE(producer.clearReaderWaiting() == false);
+	consumer.readerWaiting(true);
+	BOOST_REQUIRE(producer.clearReaderWaiting() == true);
+	BOOST_REQUIRE(producer.clearReaderWaiting() == false);
+
+	producer.writerWaiting(true);
+	BOOST_REQUIRE(consumer.clearWriterWaiting() == true);
+
+	BOOST_REQUIRE(consumer.closed() == false);
+	producer.close();
+	BOOST_REQUIRE(consumer.closed() == true);
+}
+
+BOOST_AUTO_TEST_CASE(ShmRingBuffer_capacity_cached)
+{
+	std::vector<char> memory(ShmRingBuffer::memorySize(16));
+	ShmRingBuffer producer;
+	ShmRingBuffer consumer;
+	producer.init(&memory[0], 16);
+	consumer.attach(&memory[0]);
+
+	// a capacity changed by the peer is not used
+	reinterpret_cast<ShmRingBuffer::Header*>(&memory[0])->capacity_ = 1024;
+	BOOST_REQUIRE(consumer.capacity() == 16);
+	BOOST_REQUIRE(producer.writeAvailable() == 16);
+
+	char buf[32];
+	BOOST_REQUIRE(producer.write("abcdefghijklmnopqrstuvwxyz", 26) == 16);
+	BOOST_REQUIRE(consumer.read(buf, 32) == 16);
+	BOOST_REQUIRE(producer.error() == false);
+	BOOST_REQUIRE(consumer.error() == false);
+}
+
+BOOST_AUTO_TEST_CASE(ShmRingBuffer_invalid_position)
+{
+	std::vector<char> memory(ShmRingBuffer::memorySize(16));
+	ShmRingBuffer producer;
+	ShmRingBuffer consumer;
+	producer.init(&memory[0], 16);
+	consumer.attach(&memory[0]);
+
+	// the peer moves the head beyond the capacity
+	reinterpret_cast<ShmRingBuffer::Header*>(&memory[0])->head_.store(17);
+
+	char buf[32];
+	BOOST_REQUIRE(consumer.readAvailable() == 16);
+	BOOST_REQUIRE(consumer.read(buf, 32) == 0);
+	BOOST_REQUIRE(consumer.error() == true);
+	BOOST_REQUIRE(consumer.closed() == true);
+
+	// the peer moves the tail before the head
+	producer.init(&memory[0], 16);
+	consumer.attach(&memory[0]);
+	reinterpret_cast<ShmRingBuffer::Header*>(&memory[0])->tail_.store(1);
+
+	BOOST_REQUIRE(producer.write("abc", 3) == 0);
+	BOOST_REQUIRE(producer.error() == true);
+	BOOST_REQUIRE(producer.closed() == true);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,190 @@
+#include "unittest.h"
+
+#include "OpcUaStackCore/Base/IOService.h"
+#include "OpcUaStackCore/TCPChannel/TCPAcceptor.h"
+#include "OpcUaStackCore/TCPChannel/TCPConnector.h"
+#include "OpcUaStackCore/TCPChannel/TCPConnection.h"
+#include "OpcUaStackCore/TCPChannel/TCPTestHandler.h"
+
+#define SOCKET_PATH	"/tmp/ShmStream_t.sock"
+
+using namespace OpcUaStackCore;
+
+BOOST_AUTO_TEST_SUITE(ShmStream_)
+
+BOOST_AUTO_TEST_CASE(ShmStream_)
+{
+	std::cout << "ShmStream_t" << std::endl;
+}
+
+#if defined(OPCUASTACK_HAS_SHM)
+
+BOOST_AUTO_TEST_CASE(ShmStream_send_receive_close)
+{
+	boost::asio::streambuf isServer;
+	boost::asio::streambuf osClient;
+	std::ostream os(&osClient);
+
+	TCPTestHandler tcpTestHandler;
+
+	IOService ioService;
+	TCPConnector tcpConnector;
+	TCPConnection tcpConnectionServer(ioService.io_service());
+	TCPConnection tcpConnectionClient(ioService.io_service());
+	tcpConnectionServer.unixSocket(true);
+	tcpConnectionClient.unixSocket(true);
+	TCPAcceptor tcpAcceptor(ioService.io_service(), SOCKET_PATH);
+	ioService.start();
+
+	//
+	// open unix domain socket and exchange shared memory descriptors
+	//
+	tcpTestHandler.handleAcceptCondition_.condition(0, 1);
+	tcpTestHandler.handleConnectCondition_.condition(0, 1);
+
+	tcpAcceptor.listen();
+	tcpAcceptor.async_accept(
+		tcpConnectionServer.localSocket(),
+		boost::bind(&TCPTestHandler::handleAccept, &tcpTestHandler, boost::asio::placeholders::error)
+	);
+	tcpConnector.async_connect(
+		tcpConnectionClient.localSocket(),
+		SOCKET_PATH,
+		boost::bind(&TCPTestHandler::handleConnect, &tcpTestHandler, boost::asio::placeholders::error)
+	);
+	BOOST_REQUIRE(tcpTestHandler.handleAcceptCondition_.waitForCondition(1000) == true);
+	BOOST_REQUIRE(tcpTestHandler.handleConnectCondition_.waitForCondition(1000) == true);
+
+	BOOST_REQUIRE(tcpConnectionServer.openSharedMemory(4096) == true);
+	BOOST_REQUIRE(tcpConnectionClient.attachSharedMemory() == true);
+	BOOST_REQUIRE(tcpConnectionServer.sharedMemory() == true);
+	BOOST_REQUIRE(tcpConnectionClient.sharedMemory() == true);
+
+	//
+	// send a message larger than the ring buffer from client to server
+	//
+	for (uint32_t idx = 0; idx < 100000; idx++) os << (char)('a' + (idx % 26));
+
+	tcpTestHandler.handleReadServerCondition_.condition(0, 1);
+	tcpTestHandler.handleWriteClientCondition_.condition(0, 1);
+
+	tcpConnectionServer.async_read_exactly(
+		isServer,
+		boost::bind(&TCPTestHandler::handleReadServer, &tcpTestHandler, boost::asio::placeholders::error, boost::asio::placeholders::bytes_transferred),
+		100000
+	);
+	tcpConnectionClient.async_write(
+		osClient,
+		boost::bind(&TCPTestHandler::handleWriteClient, &tcpTestHandler, boost::asio::placeholders::error)
+	);
+
+	BOOST_REQUIRE(tcpTestHandler.handleReadServerCondition_.waitForCondition(10000) == true);
+	BOOST_REQUIRE(tcpTestHandler.handleWriteClientCondition_.waitForCondition(10000) == true);
+	BOOST_REQUIRE(tcpTestHandler.handleReadServerError_.value() == 0);
+	BOOST_REQUIRE(tcpTestHandler.handleWriteClientError_.value() == 0);
+	BOOST_REQUIRE(isServer.size() == 100000);
+
+	std::istream is(&isServer);
+	char c1, c2;
+	is.get(c1);
+	is.ignore(99998);
+	is.get(c2);
+	BOOST_REQUIRE(c1 == 'a');
+	BOOST_REQUIRE(c2 == (char)('a' + (99999 % 26)));
+
+	//
+	// close by client
+	//
+	tcpTestHandler.handleReadServerCondition_.condition(0, 1);
+	tcpConnectionServer.async_read_atLeast(
+		isServer,
+		boost::bind(&TCPTestHandler::handleReadServer, &tcpTestHandler, boost::asio::placeholders::error, boost::asio::placeholders::bytes_transferred),
+		1
+	);
+	tcpConnectionClient.close();
+
+	BOOST_REQUIRE(tcpTestHandler.handleReadServerCondition_.waitForCondition(10000) == true);
+	BOOST_REQUIRE(tcpTestHandler.handleReadServerError_ == boost::asio::error::eof);
+
+	tcpConnectionServer.close();
+	tcpAcceptor.close();
+	ioService.stop();
+}
+
+BOOST_AUTO_TEST_CASE(ShmStream_buffer_sequence)
+{
+	boost::asio::streambuf isServer;
+	boost::asio::streambuf osClient1;
+	boost::asio::streambuf osClient2;
+	std::ostream os1(&osClient1);
+	std::ostream os2(&osClient2);
+
+	TCPTestHandler tcpTestHandler;
+
+	IOService ioService;
+	TCPConnector tcpConnector;
+	TCPConnection tcpConnectionServer(ioService.io_service());
+	TCPConnection tcpConnectionClient(ioService.io_service());
+	tcpConnectionServer.unixSocket(true);
+	tcpConnectionClient.unixSocket(true);
+	TCPAcceptor tcpAcceptor(ioService.io_service(), SOCKET_PATH);
+	ioService.start();
+
+	tcpTestHandler.handleAcceptCondition_.condition(0, 1);
+	tcpTestHandler.handleConnectCondition_.condition(0, 1);
+
+	tcpAcceptor.listen();
+	tcpAcceptor.async_accept(
+		tcpConnectionServer.localSocket(),
+		boost::bind(&TCPTestHandler::handleAccept, &tcpTestHandler, boost::asio::placeholders::error)
+	);
+	tcpConnector.async_connect(
+		tcpConnectionClient.localSocket(),
+		SOCKET_PATH,
+		boost::bind(&TCPTestHandler::handleConnect, &tcpTestHandler, boost::asio::placeholders::error)
+	);
+	BOOST_REQUIRE(tcpTestHandler.handleAcceptCondition_.waitForCondition(1000) == true);
+	BOOST_REQUIRE(tcpTestHandler.handleConnectCondition_.waitForCondition(1000) == true);
+
+	//
+	// the ring buffer size must be a power of two
+	//
+	BOOST_REQUIRE(tcpConnectionServer.openSharedMemory(4000) == false);
+	BOOST_REQUIRE(tcpConnectionServer.openSharedMemory(4096) == true);
+	BOOST_REQUIRE(tcpConnectionClient.attachSharedMemory() == true);
+
+	//
+	// a message header and a message body are written as one buffer sequence
+	//
+	for (uint32_t idx = 0; idx < 24; idx++) os1 << 'h';
+	for (uint32_t idx = 0; idx < 10000; idx++) os2 << 'b';
+
+	tcpTestHandler.handleReadServerCondition_.condition(0, 1);
+	tcpTestHandler.handleWriteClientCondition_.condition(0, 1);
+
+	tcpConnectionServer.async_read_exactly(
+		isServer,
+		boost::bind(&TCPTestHandler::handleReadServer, &tcpTestHandler, boost::asio::placeholders::error, boost::asio::placeholders::bytes_transferred),
+		10024
+	);
+	tcpConnectionClient.async_write(
+		osClient1,
+		osClient2,
+		boost::bind(&TCPTestHandler::handleWriteClient, &tcpTestHandler, boost::asio::placeholders::error)
+	);
+
+	BOOST_REQUIRE(tcpTestHandler.handleReadServerCondition_.waitForCondition(10000) == true);
+	BOOST_REQUIRE(tcpTestHandler.handleWriteClientCondition_.waitForCondition(10000) == true);
+	BOOST_REQUIRE(tcpTestHandler.handleReadServerError_.value() == 0);
+	BOOST_REQUIRE(tcpTestHandler.handleWriteClientError_.value() == 0);
+	BOOST_REQUIRE(isServer.size() == 10024);
+
+	tcpConnectionClient.close();
+	tcpConnectionServer.close();
+	tcpAcceptor.close();
+	ioService.stop();
+}
+
+#endif
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -6,12 +6,53 @@
 #include "OpcUaStackCore/TCPChannel/TCPTestHandler.h"
 
 #include <boost/asio/error.hpp>
+#include <fstream>
+#include <sys/stat.h>
+#include <unistd.h>
 
 #define SOCKET_ADDRESS	"127.0.0.1"
 #define SOCKET_PORT		3456
 
 using namespace OpcUaStackCore;
 
+class TCPAcceptorShard
+{
+  public:
+	TCPAcceptorShard(boost::asio::io_service& io_service, boost::asio::ip::tcp::endpoint& endpoint, Condition& condition)
+	: io_service_(io_service)
+	, tcpAcceptor_(io_service, endpoint, true)
+	, condition_(condition)
+	, socketVec_()
+	, acceptCount_(0)
+	{
+		tcpAcceptor_.listen();
+	}
+
+	void accept(void)
+	{
+		boost::shared_ptr<boost::asio::ip::tcp::socket> socket(new boost::asio::ip::tcp::socket(io_service_));
+		socketVec_.push_back(socket);
+		tcpAcceptor_.async_accept(
+			*socket,
+			boost::bind(&TCPAcceptorShard::handleAccept, this, boost::asio::placeholders::error)
+		);
+	}
+
+	void handleAccept(const boost::system::error_code& error)
+	{
+		if (error) return;
+		acceptCount_++;
+		condition_.conditionValueInc();
+		accept();
+	}
+
+	boost::asio::io_service& io_service_;
+	TCPAcceptor tcpAcceptor_;
+	Condition& condition_;
+	std::vector<boost::shared_ptr<boost::asio::ip::tcp::socket> > socketVec_;
+	uint32_t acceptCount_;
+};
+
 BOOST_AUTO_TEST_SUITE(TCPAcceptor_)
 
 BOOST_AUTO_TEST_CASE(TCPAcceptor_)
@@ -77,4 +118,177 @@ BOOST_AUTO_TEST_CASE(TCPAcceptor_close)
 	ioService.stop();
 }
 
+BOOST_AUTO_TEST_CASE(TCPAcceptor_reusePort)
+{
+	if (!TCPAcceptor::reusePortSupported()) return;
+
+	TCPTestHandler tcpTestHandler;
+
+	IOService ioService;
+	TCPConnection tcpConnectionServer1(ioService.io_service());
+	TCPConnection tcpConnectionServer2(ioService.io_service());
+	boost::asio::ip::tcp::endpoint endpoint(boost::asio::ip::address::from_string(SOCKET_ADDRESS), SOCKET_PORT);
+	TCPAcceptor tcpAcceptor1(ioService.io_service(), endpoint, true);
+	TCPAcceptor tcpAcceptor2(ioService.io_service(), endpoint, true);
+	ioService.start();
+
+	//
+	// open both listeners on the same endpoint
+	//
+	tcpTestHandler.handleAcceptCondition_.condition(0, 2);
+
+	tcpAcceptor1.listen();
+	tcpAcceptor1.async_accept(
+		tcpConnectionServer1.socket(),
+		boost::bind(&TCPTestHandler::handleAccept, &tcpTestHandler, boost::asio::placeholders::error)
+	);
+	tcpAcceptor2.listen();
+	tcpAcceptor2.async_accept(
+		tcpConnectionServer2.socket(),
+		boost::bind(&TCPTestHandler::handleAccept, &tcpTestHandler, boost::asio::placeholders::error)
+	);
+
+	tcpAcceptor1.cancel();
+	tcpAcceptor2.cancel();
+	tcpTestHandler.handleAcceptCondition_.waitForCondition();
+	BOOST_REQUIRE(tcpTestHandler.handleAcceptError_.value() == CONNECTION_OPERATION_ABORTED);
+	BOOST_REQUIRE(tcpTestHandler.handleAcceptCount_ == 2);
+
+	ioService.stop();
+}
+
+BOOST_AUTO_TEST_CASE(TCPAcceptor_reusePort_distribution)
+{
+	if (!TCPAcceptor::reusePortSupported()) return;
+
+	const uint32_t numberConnections = 32;
+	Condition condition;
+	condition.condition(0, numberConnections);
+
+	//
+	// each acceptor runs in its own io service
+	//
+	IOService ioService1;
+	IOService ioService2;
+	IOService ioServiceClient;
+	boost::asio::ip::tcp::endpoint endpoint(boost::asio::ip::address::from_string(SOCKET_ADDRESS), SOCKET_PORT);
+	TCPAcceptorShard tcpAcceptorShard1(ioService1.io_service(), endpoint, condition);
+	TCPAcceptorShard tcpAcceptorShard2(ioService2.io_service(), endpoint, condition);
+	ioService1.start();
+	ioService2.start();
+
+	//
+	// the kernel distributes the connections over both acceptors
+	//
+	std::vector<boost::shared_ptr<boost::asio::ip::tcp::socket> > clientVec;
+	for (uint32_t idx = 0; idx < numberConnections; idx++) {
+		boost::shared_ptr<boost::asio::ip::tcp::socket> client(new boost::asio::ip::tcp::socket(ioServiceClient.io_service()));
+		client->connect(endpoint);
+		clientVec.push_back(client);
+	}
+
+	tcpAcceptorShard1.accept();
+	tcpAcceptorShard2.accept();
+	BOOST_REQUIRE(condition.waitForCondition(5000) == true);
+
+	tcpAcceptorShard1.tcpAcceptor_.cancel();
+	tcpAcceptorShard2.tcpAcceptor_.cancel();
+	ioService1.stop();
+	ioService2.stop();
+
+	BOOST_REQUIRE(tcpAcceptorShard1.acceptCount_ + tcpAcceptorShard2.acceptCount_ == numberConnections);
+	BOOST_REQUIRE(tcpAcceptorShard1.acceptCount_ > 0);
+	BOOST_REQUIRE(tcpAcceptorShard2.acceptCount_ > 0);
+}
+
+BOOST_AUTO_TEST_CASE(TCPAcceptor_unixSocket)
+{
+	if (!TCPAcceptor::unixSocketSupported()) return;
+
+	TCPTestHandler tcpTestHandler;
+
+	IOService ioService;
+	TCPConnector tcpConnector;
+	TCPConnection tcpConnectionServer(ioService.io_service());
+	TCPConnection tcpConnectionClient(ioService.io_service());
+	tcpConnectionServer.unixSocket(true);
+	tcpConnectionClient.unixSocket(true);
+	TCPAcceptor tcpAcceptor(ioService.io_service(), "/tmp/TCPAcceptor_t.sock");
+	ioService.start();
+
+	//
+	// accept and connect on the unix domain socket
+	//
+	tcpTestHandler.handleAcceptCondition_.condition(0, 1);
+	tcpTestHandler.handleConnectCondition_.condition(0, 1);
+
+	tcpAcceptor.listen();
+	tcpAcceptor.async_accept(
+		tcpConnectionServer.localSocket(),
+		boost::bind(&TCPTestHandler::handleAccept, &tcpTestHandler, boost::asio::placeholders::error)
+	);
+	tcpConnector.async_connect(
+		tcpConnectionClient.localSocket(),
+		"/tmp/TCPAcceptor_t.sock",
+		boost::bind(&TCPTestHandler::handleConnect, &tcpTestHandler, boost::asio::placeholders::error)
+	);
+
+	tcpTestHandler.handleAcceptCondition_.waitForCondition();
+	tcpTestHandler.handleConnectCondition_.waitForCondition();
+	BOOST_REQUIRE(tcpTestHandler.handleAcceptError_.value() == 0);
+	BOOST_REQUIRE(tcpTestHandler.handleConnectError_.value() == 0);
+
+	tcpConnectionClient.close();
+	tcpConnectionServer.close();
+	tcpAcceptor.close();
+	ioService.stop();
+}
+
+BOOST_AUTO_TEST_CASE(TCPAcceptor_unixSocket_file)
+{
+	if (!TCPAcceptor::unixSocketSupported()) return;
+
+	IOService ioService;
+	std::string unixSocketPath = "/tmp/TCPAcceptor_file_t.sock";
+
+	//
+	// the socket file gets the configured access mode
+	//
+	{
+		TCPAcceptor tcpAcceptor(ioService.io_service(), unixSocketPath);
+		struct stat fileStat;
+		BOOST_REQUIRE(::lstat(unixSocketPath.c_str(), &fileStat) == 0);
+		BOOST_REQUIRE(S_ISSOCK(fileStat.st_mode));
+		BOOST_REQUIRE((fileStat.st_mode & 0777) == 0600);
+
+		tcpAcceptor.unixSocketMode(0640);
+		BOOST_REQUIRE(::lstat(unixSocketPath.c_str(), &fileStat) == 0);
+		BOOST_REQUIRE((fileStat.st_mode & 0777) == 0640);
+		tcpAcceptor.close();
+		BOOST_REQUIRE(::lstat(unixSocketPath.c_str(), &fileStat) != 0);
+	}
+
+	//
+	// a file which is not a socket is not removed
+	//
+	{
+		std::ofstream file(unixSocketPath.c_str());
+		file << "data";
+	}
+
+	bool exception = false;
+	try {
+		TCPAcceptor tcpAcceptor(ioService.io_service(), unixSocketPath);
+	}
+	catch (boost::system::system_error&) {
+		exception = true;
+	}
+	BOOST_REQUIRE(exception == true);
+
+	struct stat fileStat;
+	BOOST_REQUIRE(::lstat(unixSocketPath.c_str(), &fileStat) == 0);
+	BOOST_REQUIRE(S_ISREG(fileStat.st_mode));
+	::unlink(unixSocketPath.c_str());
+}
+
 BOOST_AUTO_TEST_SUITE_END()
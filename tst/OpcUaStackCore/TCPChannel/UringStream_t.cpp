@@ -0,0 +1,306 @@
+#include "unittest.h"
+
+#include "OpcUaStackCore/Base/IOService.h"
+#include "OpcUaStackCore/TCPChannel/TCPAcceptor.h"
+#include "OpcUaStackCore/TCPChannel/TCPConnector.h"
+#include "OpcUaStackCore/TCPChannel/TCPConnection.h"
+#include "OpcUaStackCore/TCPChannel/TCPTestHandler.h"
+
+#define SOCKET_ADDRESS	"127.0.0.1"
+#define SOCKET_PORT		3457
+
+using namespace OpcUaStackCore;
+
+#if defined(OPCUASTACK_HAS_IO_URING)
+
+//
+// ping pong between a client and a server connection. The server echoes
+// each message of the client. Used to compare the io_uring stream with the
+// reactor of boost asio.
+//
+class UringStreamPingPong
+{
+  public:
+	static const uint32_t MessageSize = 64;
+
+	UringStreamPingPong(boost::asio::io_service& io_service)
+	: server_(io_service)
+	, client_(io_service)
+	, serverBuffer_()
+	, clientBuffer_()
+	, numberMessages_(0)
+	, count_(0)
+	, errorCount_(0)
+	, condition_()
+	{
+		memset(message_, 'x', MessageSize);
+	}
+
+	void start(uint32_t numberMessages)
+	{
+		numberMessages_ = numberMessages;
+		count_ = 0;
+		serverRead();
+		clientWrite();
+	}
+
+	void serverRead(void)
+	{
+		server_.async_read_exactly(
+			serverBuffer_,
+			boost::bind(&UringStreamPingPong::serverReadComplete, this, boost::asio::placeholders::error),
+			MessageSize
+		);
+	}
+
+	void serverReadComplete(const boost::system::error_code& error)
+	{
+		if (error) return;
+		server_.async_write(
+			serverBuffer_,
+			boost::bind(&UringStreamPingPong::serverWriteComplete, this, boost::asio::placeholders::error)
+		);
+	}
+
+	void serverWriteComplete(const boost::system::error_code& error)
+	{
+		if (error) { errorCount_++; return; }
+		serverRead();
+	}
+
+	void clientWrite(void)
+	{
+		std::ostream os(&clientBuffer_);
+		os.write(message_, MessageSize);
+		client_.async_write(
+			clientBuffer_,
+			boost::bind(&UringStreamPingPong::clientWriteComplete, this, boost::asio::placeholders::error)
+		);
+	}
+
+	void clientWriteComplete(const boost::system::error_code& error)
+	{
+		if (error) { errorCount_++; condition_.conditionValueInc(); return; }
+		client_.async_read_exactly(
+			clientBuffer_,
+			boost::bind(&UringStreamPingPong::clientReadComplete, this, boost::asio::placeholders::error),
+			MessageSize
+		);
+	}
+
+	void clientReadComplete(const boost::system::error_code& error)
+	{
+		if (error) { errorCount_++; condition_.conditionValueInc(); return; }
+		clientBuffer_.consume(clientBuffer_.size());
+
+		count_++;
+		if (count_ == numberMessages_) {
+			condition_.conditionValueInc();
+			return;
+		}
+		clientWrite();
+	}
+
+	TCPConnection server_;
+	TCPConnection client_;
+	boost::asio::streambuf serverBuffer_;
+	boost::asio::streambuf clientBuffer_;
+	char message_[MessageSize];
+	uint32_t numberMessages_;
+	uint32_t count_;
+	uint32_t errorCount_;
+	Condition condition_;
+};
+
+static void
+connect(IOService& ioService, TCPAcceptor& tcpAcceptor, UringStreamPingPong& pingPong)
+{
+	TCPTestHandler tcpTestHandler;
+	TCPConnector tcpConnector;
+
+	tcpTestHandler.handleAcceptCondition_.condition(0, 1);
+	tcpTestHandler.handleConnectCondition_.condition(0, 1);
+
+	tcpAcceptor.async_accept(
+		pingPong.server_.socket(),
+		boost::bind(&TCPTestHandler::handleAccept, &tcpTestHandler, boost::asio::placeholders::error)
+	);
+	tcpConnector.async_connect(
+		pingPong.client_.socket(),
+		SOCKET_ADDRESS,
+		SOCKET_PORT,
+		boost::bind(&TCPTestHandler::handleConnect, &tcpTestHandler, boost::asio::placeholders::error)
+	);
+	BOOST_REQUIRE(tcpTestHandler.handleAcceptCondition_.waitForCondition(1000) == true);
+	BOOST_REQUIRE(tcpTestHandler.handleConnectCondition_.waitForCondition(1000) == true);
+
+	pingPong.server_.socket().set_option(boost::asio::ip::tcp::no_delay(true));
+	pingPong.client_.socket().set_option(boost::asio::ip::tcp::no_delay(true));
+}
+
+static double
+benchmark(bool ioUring, uint32_t numberConnections, uint32_t numberMessages)
+{
+	IOService ioService;
+	TCPAcceptor tcpAcceptor(ioService.io_service(), SOCKET_ADDRESS, SOCKET_PORT);
+	ioService.start();
+	tcpAcceptor.listen();
+
+	std::vector<UringStreamPingPong*> pingPongVec;
+	for (uint32_t idx = 0; idx < numberConnections; idx++) {
+		UringStreamPingPong* pingPong = new UringStreamPingPong(ioService.io_service());
+		connect(ioService, tcpAcceptor, *pingPong);
+		if (ioUring) {
+			BOOST_REQUIRE(pingPong->server_.openIoUring() == true);
+			BOOST_REQUIRE(pingPong->client_.openIoUring() == true);
+		}
+		pingPong->condition_.condition(0, 1);
+		pingPongVec.push_back(pingPong);
+	}
+
+	boost::posix_time::ptime start = boost::posix_time::microsec_clock::universal_time();
+	for (uint32_t idx = 0; idx < numberConnections; idx++) {
+		ioService.io_service().post(boost::bind(&UringStreamPingPong::start, pingPongVec[idx], numberMessages));
+	}
+	for (uint32_t idx = 0; idx < numberConnections; idx++) {
+		BOOST_REQUIRE(pingPongVec[idx]->condition_.waitForCondition(60000) == true);
+		BOOST_REQUIRE(pingPongVec[idx]->errorCount_ == 0);
+		BOOST_REQUIRE(pingPongVec[idx]->count_ == numberMessages);
+	}
+	boost::posix_time::ptime stop = boost::posix_time::microsec_clock::universal_time();
+
+	for (uint32_t idx = 0; idx < numberConnections; idx++) {
+		pingPongVec[idx]->server_.close();
+		pingPongVec[idx]->client_.close();
+	}
+	tcpAcceptor.close();
+	IOService::msecSleep(100);
+	ioService.stop();
+	for (uint32_t idx = 0; idx < numberConnections; idx++) {
+		delete pingPongVec[idx];
+	}
+
+	double seconds = (stop - start).total_microseconds() / 1000000.0;
+	return (numberConnections * numberMessages) / seconds;
+}
+
+#endif
+
+BOOST_AUTO_TEST_SUITE(UringStream_)
+
+BOOST_AUTO_TEST_CASE(UringStream_)
+{
+	std::cout << "UringStream_t" << std::endl;
+}
+
+#if defined(OPCUASTACK_HAS_IO_URING)
+
+BOOST_AUTO_TEST_CASE(UringStream_send_receive_close)
+{
+	IOService ioService;
+	TCPAcceptor tcpAcceptor(ioService.io_service(), SOCKET_ADDRESS, SOCKET_PORT);
+	UringStreamPingPong pingPong(ioService.io_service());
+	ioService.start();
+	tcpAcceptor.listen();
+
+	connect(ioService, tcpAcceptor, pingPong);
+	if (!pingPong.server_.openIoUring()) {
+		// io_uring is not available in the kernel
+		tcpAcceptor.close();
+		ioService.stop();
+		return;
+	}
+	BOOST_REQUIRE(pingPong.client_.openIoUring() == true);
+	BOOST_REQUIRE(pingPong.server_.ioUring() == true);
+
+	//
+	// exchange messages
+	//
+	pingPong.condition_.condition(0, 1);
+	ioService.io_service().post(boost::bind(&UringStreamPingPong::start, &pingPong, 100));
+	BOOST_REQUIRE(pingPong.condition_.waitForCondition(1000) == true);
+	BOOST_REQUIRE(pingPong.count_ == 100);
+	BOOST_REQUIRE(pingPong.errorCount_ == 0);
+
+	//
+	// a pending read is aborted when the connection is closed
+	//
+	TCPTestHandler tcpTestHandler;
+	boost::asio::streambuf is;
+	tcpTestHandler.handleReadServerCondition_.condition(0, 1);
+	pingPong.client_.async_read_exactly(
+		is,
+		boost::bind(&TCPTestHandler::handleReadServer, &tcpTestHandler, boost::asio::placeholders::error, boost::asio::placeholders::bytes_transferred),
+		10
+	);
+	pingPong.client_.close();
+	BOOST_REQUIRE(tcpTestHandler.handleReadServerCondition_.waitForCondition(1000) == true);
+	BOOST_REQUIRE(tcpTestHandler.handleReadServerError_ == boost::asio::error::operation_aborted);
+	BOOST_REQUIRE(pingPong.client_.ioUring() == false);
+
+	pingPong.server_.close();
+	tcpAcceptor.close();
+	IOService::msecSleep(100);
+	ioService.stop();
+}
+
+BOOST_AUTO_TEST_CASE(UringStream_shutdown_pending_read)
+{
+	TCPTestHandler tcpTestHandler;
+	boost::asio::streambuf is;
+	tcpTestHandler.handleReadServerCondition_.condition(0, 1);
+
+	{
+		IOService ioService;
+		TCPAcceptor tcpAcceptor(ioService.io_service(), SOCKET_ADDRESS, SOCKET_PORT);
+		UringStreamPingPong pingPong(ioService.io_service());
+		ioService.start();
+		tcpAcceptor.listen();
+
+		connect(ioService, tcpAcceptor, pingPong);
+		if (!pingPong.server_.openIoUring()) {
+			// io_uring is not available in the kernel
+			tcpAcceptor.close();
+			ioService.stop();
+			return;
+		}
+
+		//
+		// the read is still submitted to the kernel when the io service is
+		// shut down. The operation is cancelled and reaped before it is
+		// deleted. The handler is not invoked.
+		//
+		pingPong.server_.async_read_exactly(
+			is,
+			boost::bind(&TCPTestHandler::handleReadServer, &tcpTestHandler, boost::asio::placeholders::error, boost::asio::placeholders::bytes_transferred),
+			10
+		);
+		IOService::msecSleep(100);
+
+		tcpAcceptor.close();
+		ioService.stop();
+	}
+
+	BOOST_REQUIRE(tcpTestHandler.handleReadServerCondition_.waitForCondition(100) == false);
+}
+
+BOOST_AUTO_TEST_CASE(UringStream_benchmark)
+{
+	IOService ioService;
+	TCPConnection probe(ioService.io_service());
+	probe.socket().open(boost::asio::ip::tcp::v4());
+	if (!probe.openIoUring()) return;
+	probe.close();
+
+	double reactor = benchmark(false, 1, 20000);
+	double ioUring = benchmark(true, 1, 20000);
+	std::cout << "ping pong 1 connection: reactor " << (uint32_t)reactor << " msg/s, io_uring " << (uint32_t)ioUring << " msg/s" << std::endl;
+
+	reactor = benchmark(false, 100, 500);
+	ioUring = benchmark(true, 100, 500);
+	std::cout << "ping pong 100 connections: reactor " << (uint32_t)reactor << " msg/s, io_uring " << (uint32_t)ioUring << " msg/s" << std::endl;
+}
+
+#endif
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,54 @@
+#include "unittest.h"
+
+#include "OpcUaStackServer/ServiceSet/AcknowledgementManager.h"
+
+using namespace OpcUaStackServer;
+
+BOOST_AUTO_TEST_SUITE(AcknowledgementManager_)
+
+BOOST_AUTO_TEST_CASE(AcknowledgementManager_)
+{
+	std::cout << "AcknowledgementManager_t" << std::endl;
+}
+
+BOOST_AUTO_TEST_CASE(AcknowledgementManager_republish)
+{
+	boost::posix_time::ptime ptime = boost::posix_time::from_iso_string("20140506T102013.123456");
+	AcknowledgementManager acknowledgementManager;
+
+	UtcTime publishTime;
+	publishTime.dateTime(ptime);
+	ExtensibleParameter::SPtr notification = constructSPtr<ExtensibleParameter>();
+	uint32_t sequenceNumber = acknowledgementManager.nextSequenceNumber();
+	acknowledgementManager.addNotification(sequenceNumber, publishTime, notification);
+
+	// the notification is available until it is acknowledged
+	UtcTime republishTime;
+	ExtensibleParameter::SPtr republishNotification;
+	BOOST_REQUIRE(acknowledgementManager.getNotification(sequenceNumber, republishTime, republishNotification) == true);
+	BOOST_REQUIRE(republishTime.dateTime() == ptime);
+	BOOST_REQUIRE(republishNotification == notification);
+
+	acknowledgementManager.deleteNotification(sequenceNumber);
+	BOOST_REQUIRE(acknowledgementManager.getNotification(sequenceNumber, republishTime, republishNotification) == false);
+}
+
+BOOST_AUTO_TEST_CASE(AcknowledgementManager_maxListSize)
+{
+	AcknowledgementManager acknowledgementManager;
+	acknowledgementManager.maxListSize(2);
+
+	UtcTime publishTime;
+	ExtensibleParameter::SPtr notification = constructSPtr<ExtensibleParameter>();
+	for (uint32_t idx = 0; idx < 3; idx++) {
+		acknowledgementManager.addNotification(acknowledgementManager.nextSequenceNumber(), publishTime, notification);
+	}
+
+	// the oldest notification is removed
+	BOOST_REQUIRE(acknowledgementManager.size() == 2);
+	BOOST_REQUIRE(acknowledgementManager.getNotification(1, notification) == false);
+	BOOST_REQUIRE(acknowledgementManager.getNotification(2, notification) == true);
+	BOOST_REQUIRE(acknowledgementManager.getNotification(3, notification) == true);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,159 @@
+#include "unittest.h"
+
+#include "OpcUaStackCore/Base/Condition.h"
+#include "OpcUaStackCore/ServiceSet/AttributeServiceTransaction.h"
+#include "OpcUaStackCore/Utility/IOThread.h"
+#include "OpcUaStackServer/ServiceSet/AsyncServiceTransaction.h"
+
+using namespace OpcUaStackServer;
+
+class AsyncServiceTransactionTest
+{
+  public:
+	AsyncServiceTransactionTest(void)
+	: statusCodeVec_(3, BadUnexpectedError)
+	, finishCount_(0)
+	, finishCondition_()
+	, nextCompletion_()
+	{
+	}
+
+	void item(uint32_t idx, OpcUaStatusCode statusCode, OpcUaDataValue& dataValue)
+	{
+		statusCodeVec_[idx] = statusCode;
+
+		// the application completes the next operation in the callback
+		ApplicationCompletion::SPtr nextCompletion;
+		nextCompletion.swap(nextCompletion_);
+		if (nextCompletion.get() != nullptr) nextCompletion->complete(Success);
+	}
+
+	void timeout(uint32_t idx)
+	{
+		statusCodeVec_[idx] = BadTimeout;
+	}
+
+	void finish(void)
+	{
+		finishCount_++;
+		finishCondition_.conditionValueInc();
+	}
+
+	AsyncServiceTransaction::SPtr create(void)
+	{
+		ServiceTransaction::SPtr trx = constructSPtr<ServiceTransactionRead>();
+		AsyncServiceTransaction::SPtr asyncTrx = constructSPtr<AsyncServiceTransaction>(trx, 3);
+		asyncTrx->itemCallback() = boost::bind(&AsyncServiceTransactionTest::item, this, _1, _2, _3);
+		asyncTrx->timeoutCallback() = boost::bind(&AsyncServiceTransactionTest::timeout, this, _1);
+		asyncTrx->finishCallback() = boost::bind(&AsyncServiceTransactionTest::finish, this);
+		return asyncTrx;
+	}
+
+	std::vector<OpcUaStatusCode> statusCodeVec_;
+	uint32_t finishCount_;
+	Condition finishCondition_;
+	ApplicationCompletion::SPtr nextCompletion_;
+};
+
+BOOST_AUTO_TEST_SUITE(AsyncServiceTransaction_)
+
+BOOST_AUTO_TEST_CASE(AsyncServiceTransaction_)
+{
+	std::cout << "AsyncServiceTransaction_t" << std::endl;
+}
+
+BOOST_AUTO_TEST_CASE(AsyncServiceTransaction_complete)
+{
+	AsyncServiceTransactionTest test;
+	AsyncServiceTransaction::SPtr asyncTrx = test.create();
+
+	ApplicationCompletion::SPtr completion0 = asyncTrx->completion(0);
+	ApplicationCompletion::SPtr completion2 = asyncTrx->completion(2);
+	BOOST_REQUIRE(asyncTrx->completion(2).get() == nullptr);
+
+	// completion before start is passed to the item callback by start
+	completion0->complete(Success);
+	BOOST_REQUIRE(test.statusCodeVec_[0] == BadUnexpectedError);
+	BOOST_REQUIRE(asyncTrx->start(SlotTimer::SPtr(), 0) == false);
+	BOOST_REQUIRE(test.statusCodeVec_[0] == Success);
+	BOOST_REQUIRE(test.finishCount_ == 0);
+
+	completion2->complete(BadNotWritable);
+	BOOST_REQUIRE(test.statusCodeVec_[2] == BadNotWritable);
+	BOOST_REQUIRE(test.finishCount_ == 1);
+
+	// a second completion is ignored
+	completion2->complete(Success);
+	BOOST_REQUIRE(completion2->isCompleted() == true);
+	BOOST_REQUIRE(test.statusCodeVec_[2] == BadNotWritable);
+	BOOST_REQUIRE(test.finishCount_ == 1);
+}
+
+BOOST_AUTO_TEST_CASE(AsyncServiceTransaction_completeAll_before_start)
+{
+	AsyncServiceTransactionTest test;
+	AsyncServiceTransaction::SPtr asyncTrx = test.create();
+
+	asyncTrx->completion(1)->complete(Success);
+	BOOST_REQUIRE(asyncTrx->start(SlotTimer::SPtr(), 0) == true);
+	BOOST_REQUIRE(test.statusCodeVec_[1] == Success);
+	BOOST_REQUIRE(test.finishCount_ == 1);
+}
+
+BOOST_AUTO_TEST_CASE(AsyncServiceTransaction_complete_in_item_callback)
+{
+	AsyncServiceTransactionTest test;
+	AsyncServiceTransaction::SPtr asyncTrx = test.create();
+
+	ApplicationCompletion::SPtr completion0 = asyncTrx->completion(0);
+	test.nextCompletion_ = asyncTrx->completion(1);
+	BOOST_REQUIRE(asyncTrx->start(SlotTimer::SPtr(), 0) == false);
+
+	// the item callback is called without the lock of the transaction
+	completion0->complete(Success);
+	BOOST_REQUIRE(test.statusCodeVec_[0] == Success);
+	BOOST_REQUIRE(test.statusCodeVec_[1] == Success);
+	BOOST_REQUIRE(test.finishCount_ == 1);
+}
+
+BOOST_AUTO_TEST_CASE(AsyncServiceTransaction_dropped_token)
+{
+	AsyncServiceTransactionTest test;
+	AsyncServiceTransaction::SPtr asyncTrx = test.create();
+
+	ApplicationCompletion::SPtr completion = asyncTrx->completion(1);
+	asyncTrx->start(SlotTimer::SPtr(), 0);
+
+	// the application drops the token without completion
+	completion.reset();
+	BOOST_REQUIRE(test.statusCodeVec_[1] == BadInternalError);
+	BOOST_REQUIRE(test.finishCount_ == 1);
+}
+
+BOOST_AUTO_TEST_CASE(AsyncServiceTransaction_timeout)
+{
+	AsyncServiceTransactionTest test;
+	IOThread::SPtr ioThread = constructSPtr<IOThread>();
+	BOOST_REQUIRE(ioThread->startup() == true);
+
+	AsyncServiceTransaction::SPtr asyncTrx = test.create();
+	ApplicationCompletion::SPtr completion0 = asyncTrx->completion(0);
+	ApplicationCompletion::SPtr completion1 = asyncTrx->completion(1);
+
+	test.finishCondition_.condition(0, 1);
+	asyncTrx->start(ioThread->slotTimer(), 50);
+	completion0->complete(Success);
+	BOOST_REQUIRE(test.finishCondition_.waitForCondition(1000) == true);
+
+	BOOST_REQUIRE(test.statusCodeVec_[0] == Success);
+	BOOST_REQUIRE(test.statusCodeVec_[1] == BadTimeout);
+	BOOST_REQUIRE(test.finishCount_ == 1);
+
+	// a completion after the timeout is ignored
+	completion1->complete(Success);
+	BOOST_REQUIRE(test.statusCodeVec_[1] == BadTimeout);
+
+	BOOST_REQUIRE(ioThread->shutdown() == true);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
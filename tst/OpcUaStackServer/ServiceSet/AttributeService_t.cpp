@@ -0,0 +1,556 @@
+#include "unittest.h"
+
+#include <algorithm>
+#include "OpcUaStackCore/Base/Condition.h"
+#include "OpcUaStackCore/Component/Component.h"
+#include "OpcUaStackCore/ServiceSet/AttributeServiceTransaction.h"
+#include "OpcUaStackCore/Application/ApplicationReadBatchContext.h"
+#include "OpcUaStackCore/Application/ApplicationWriteBatchContext.h"
+#include "OpcUaStackCore/Utility/IOThread.h"
+#include "OpcUaStackServer/ServiceSet/AttributeService.h"
+#include "OpcUaStackServer/AddressSpaceModel/VariableNodeClass.h"
+
+using namespace OpcUaStackServer;
+
+class AttributeServiceTest
+: public Component
+{
+  public:
+	AttributeServiceTest(void)
+	: Component()
+	, readCount_(0)
+	, writeCount_(0)
+	, batchSizeVec_()
+	, batchErrorNode_(0)
+	, batchAsyncNode_(0)
+	, serverTimestamp_()
+	, async_(false)
+	, timeoutHint_(0)
+	, completion_()
+	, batchCompletion_()
+	, receiveCondition_()
+	, serviceTransaction_()
+	, attributeService_()
+	, node_()
+	{
+		InformationModel::SPtr informationModel = constructSPtr<InformationModel>();
+
+		OpcUaNodeId nodeId(1, 1);
+		node_ = constructSPtr<VariableNodeClass>();
+		node_->setNodeId(nodeId);
+		informationModel->insert(node_);
+
+		ForwardNodeSync::SPtr forwardNodeSync = constructSPtr<ForwardNodeSync>();
+		forwardNodeSync->readService().setCallback(boost::bind(&AttributeServiceTest::readValue, this, _1));
+		forwardNodeSync->writeService().setCallback(boost::bind(&AttributeServiceTest::writeValue, this, _1));
+		node_->forwardNodeSync(forwardNodeSync);
+
+		// the nodes 2 and 3 share a batch callback, node 4 has its own
+		Callback readBatch1;
+		Callback writeBatch1;
+		readBatch1.reset(boost::bind(&AttributeServiceTest::readBatch, this, _1));
+		writeBatch1.reset(boost::bind(&AttributeServiceTest::writeBatch, this, _1));
+		addBatchNode(informationModel, 2, readBatch1, writeBatch1);
+		addBatchNode(informationModel, 3, readBatch1, writeBatch1);
+
+		Callback readBatch2;
+		Callback writeBatch2;
+		readBatch2.reset(boost::bind(&AttributeServiceTest::readBatch, this, _1));
+		writeBatch2.reset(boost::bind(&AttributeServiceTest::writeBatch, this, _1));
+		addBatchNode(informationModel, 4, readBatch2, writeBatch2);
+
+		attributeService_.informationModel(informationModel);
+	}
+
+	void addBatchNode(InformationModel::SPtr& informationModel, OpcUaUInt32 id, Callback& readBatch, Callback& writeBatch)
+	{
+		OpcUaNodeId nodeId(id, 1);
+		BaseNodeClass::SPtr node = constructSPtr<VariableNodeClass>();
+		node->setNodeId(nodeId);
+		informationModel->insert(node);
+
+		ForwardNodeSync::SPtr forwardNodeSync = constructSPtr<ForwardNodeSync>();
+		forwardNodeSync->readBatchService().setCallback(readBatch);
+		forwardNodeSync->writeBatchService().setCallback(writeBatch);
+		node->forwardNodeSync(forwardNodeSync);
+	}
+
+	void receive(Message::SPtr message)
+	{
+		serviceTransaction_ = boost::static_pointer_cast<ServiceTransaction>(message);
+		receiveCondition_.conditionValueInc();
+	}
+
+	void readValue(ApplicationReadContext* applicationReadContext)
+	{
+		readCount_++;
+		if (async_) {
+			completion_ = applicationReadContext->asyncCompletion();
+			return;
+		}
+		applicationReadContext->dataValue_.variant()->set((OpcUaUInt32)readCount_);
+		if (!serverTimestamp_.is_not_a_date_time()) {
+			applicationReadContext->dataValue_.serverTimestamp().dateTime(serverTimestamp_);
+		}
+	}
+
+	void writeValue(ApplicationWriteContext* applicationWriteContext)
+	{
+		writeCount_++;
+		if (async_) {
+			completion_ = applicationWriteContext->asyncCompletion();
+		}
+	}
+
+	void readBatch(ApplicationReadBatchContext* applicationReadBatchContext)
+	{
+		batchSizeVec_.push_back(applicationReadBatchContext->readContextVec_.size());
+
+		ApplicationReadBatchContext::ReadContextVec::iterator it;
+		for (it = applicationReadBatchContext->readContextVec_.begin(); it != applicationReadBatchContext->readContextVec_.end(); it++) {
+			OpcUaUInt32 id = it->nodeId_.nodeId<OpcUaUInt32>();
+			if (id == batchErrorNode_) {
+				it->statusCode_ = BadDeviceFailure;
+			}
+			else if (id == batchAsyncNode_) {
+				batchCompletion_ = it->asyncCompletion();
+			}
+			else {
+				it->dataValue_.variant()->set((OpcUaUInt32)(id * 100));
+			}
+		}
+	}
+
+	void writeBatch(ApplicationWriteBatchContext* applicationWriteBatchContext)
+	{
+		batchSizeVec_.push_back(applicationWriteBatchContext->writeContextVec_.size());
+
+		ApplicationWriteBatchContext::WriteContextVec::iterator it;
+		for (it = applicationWriteBatchContext->writeContextVec_.begin(); it != applicationWriteBatchContext->writeContextVec_.end(); it++) {
+			OpcUaUInt32 id = it->nodeId_.nodeId<OpcUaUInt32>();
+			if (id == batchErrorNode_) {
+				it->statusCode_ = BadNotWritable;
+			}
+			else if (id == batchAsyncNode_) {
+				batchCompletion_ = it->asyncCompletion();
+			}
+		}
+	}
+
+	RequestHeader::SPtr requestHeader(void)
+	{
+		RequestHeader::SPtr requestHeader = constructSPtr<RequestHeader>();
+		requestHeader->timeoutHint(timeoutHint_);
+		return requestHeader;
+	}
+
+	ServiceTransactionRead::SPtr read(OpcUaDouble maxAge, OpcUaInt32 timestampsToReturn = TimestampsToReturn_Both)
+	{
+		std::vector<OpcUaUInt32> idVec(1, 1);
+		return read(idVec, maxAge, timestampsToReturn);
+	}
+
+	ServiceTransactionRead::SPtr read(std::vector<OpcUaUInt32>& idVec, OpcUaDouble maxAge = 0, OpcUaInt32 timestampsToReturn = TimestampsToReturn_Both)
+	{
+		ServiceTransactionRead::SPtr trx = constructSPtr<ServiceTransactionRead>();
+		trx->componentSession(this);
+		trx->requestHeader(requestHeader());
+		trx->request()->maxAge(maxAge);
+		trx->request()->timestampsToReturn(timestampsToReturn);
+
+		trx->request()->readValueIdArray()->resize(idVec.size());
+		std::vector<OpcUaUInt32>::iterator it;
+		for (it = idVec.begin(); it != idVec.end(); it++) {
+			ReadValueId::SPtr readValueId = constructSPtr<ReadValueId>();
+			readValueId->nodeId((OpcUaUInt16)1, *it);
+			readValueId->attributeId(AttributeId_Value);
+			trx->request()->readValueIdArray()->push_back(readValueId);
+		}
+
+		serviceTransaction_.reset();
+		attributeService_.receive(trx);
+		return trx;
+	}
+
+	ServiceTransactionWrite::SPtr write(OpcUaUInt32 value)
+	{
+		std::vector<OpcUaUInt32> idVec(1, 1);
+		return write(idVec, value);
+	}
+
+	ServiceTransactionWrite::SPtr write(std::vector<OpcUaUInt32>& idVec, OpcUaUInt32 value)
+	{
+		ServiceTransactionWrite::SPtr trx = constructSPtr<ServiceTransactionWrite>();
+		trx->componentSession(this);
+		trx->requestHeader(requestHeader());
+
+		trx->request()->writeValueArray()->resize(idVec.size());
+		std::vector<OpcUaUInt32>::iterator it;
+		for (it = idVec.begin(); it != idVec.end(); it++) {
+			WriteValue::SPtr writeValue = constructSPtr<WriteValue>();
+			writeValue->nodeId((OpcUaUInt16)1, *it);
+			writeValue->attributeId(AttributeId_Value);
+			writeValue->dataValue().variant()->set(value);
+			trx->request()->writeValueArray()->push_back(writeValue);
+		}
+
+		serviceTransaction_.reset();
+		attributeService_.receive(trx);
+		return trx;
+	}
+
+	OpcUaUInt32 nodeValue(OpcUaUInt32 id = 1)
+	{
+		OpcUaDataValue dataValue;
+		attributeService_.informationModel()->find(OpcUaNodeId(id, 1))->getValue(dataValue);
+		return dataValue.variant()->get<OpcUaUInt32>();
+	}
+
+	OpcUaUInt32 value(ServiceTransactionRead::SPtr& trx, uint32_t idx = 0)
+	{
+		OpcUaDataValue::SPtr dataValue;
+		trx->response()->dataValueArray()->get(idx, dataValue);
+		return dataValue->variant()->get<OpcUaUInt32>();
+	}
+
+	OpcUaStatusCode statusCode(ServiceTransactionRead::SPtr& trx, uint32_t idx)
+	{
+		OpcUaDataValue::SPtr dataValue;
+		trx->response()->dataValueArray()->get(idx, dataValue);
+		return dataValue->statusCode();
+	}
+
+	OpcUaStatusCode statusCode(ServiceTransactionWrite::SPtr& trx, uint32_t idx)
+	{
+		OpcUaStatusCode statusCode;
+		trx->response()->results()->get(idx, statusCode);
+		return statusCode;
+	}
+
+	uint32_t readCount_;
+	uint32_t writeCount_;
+	std::vector<uint32_t> batchSizeVec_;
+	OpcUaUInt32 batchErrorNode_;
+	OpcUaUInt32 batchAsyncNode_;
+	boost::posix_time::ptime serverTimestamp_;
+	bool async_;
+	uint32_t timeoutHint_;
+	ApplicationCompletion::SPtr completion_;
+	ApplicationCompletion::SPtr batchCompletion_;
+	Condition receiveCondition_;
+	ServiceTransaction::SPtr serviceTransaction_;
+	AttributeService attributeService_;
+	BaseNodeClass::SPtr node_;
+};
+
+BOOST_AUTO_TEST_SUITE(AttributeService_)
+
+BOOST_AUTO_TEST_CASE(AttributeService_)
+{
+	std::cout << "AttributeService_t" << std::endl;
+}
+
+BOOST_AUTO_TEST_CASE(AttributeService_read_maxAge_zero)
+{
+	AttributeServiceTest test;
+
+	ServiceTransactionRead::SPtr trx = test.read(0);
+	BOOST_REQUIRE(test.serviceTransaction_.get() != nullptr);
+	BOOST_REQUIRE(trx->statusCode() == Success);
+	BOOST_REQUIRE(test.value(trx) == 1);
+
+	trx = test.read(0);
+	BOOST_REQUIRE(test.value(trx) == 2);
+
+	// the cache is not used and no cache miss is counted
+	BOOST_REQUIRE(test.readCount_ == 2);
+	BOOST_REQUIRE(test.node_->readCacheHitCount() == 0);
+	BOOST_REQUIRE(test.node_->readCacheMissCount() == 0);
+}
+
+BOOST_AUTO_TEST_CASE(AttributeService_read_maxAge_hit)
+{
+	AttributeServiceTest test;
+
+	ServiceTransactionRead::SPtr trx = test.read(10000);
+	BOOST_REQUIRE(test.value(trx) == 1);
+
+	trx = test.read(10000);
+	BOOST_REQUIRE(trx->statusCode() == Success);
+	BOOST_REQUIRE(test.value(trx) == 1);
+
+	BOOST_REQUIRE(test.readCount_ == 1);
+	BOOST_REQUIRE(test.node_->readCacheHitCount() == 1);
+	BOOST_REQUIRE(test.node_->readCacheMissCount() == 1);
+
+	// the application returns no server timestamp. The value is stored
+	// without a server timestamp
+	OpcUaDataValue::SPtr dataValue;
+	trx->response()->dataValueArray()->get(0, dataValue);
+	BOOST_REQUIRE(dataValue->serverTimestamp().exist() == false);
+}
+
+BOOST_AUTO_TEST_CASE(AttributeService_read_maxAge_expired)
+{
+	AttributeServiceTest test;
+	test.serverTimestamp_ = boost::posix_time::microsec_clock::universal_time() - boost::posix_time::seconds(10);
+
+	ServiceTransactionRead::SPtr trx = test.read(1000);
+	BOOST_REQUIRE(test.value(trx) == 1);
+
+	trx = test.read(1000);
+	BOOST_REQUIRE(test.value(trx) == 2);
+
+	trx = test.read(60000);
+	BOOST_REQUIRE(test.value(trx) == 2);
+
+	BOOST_REQUIRE(test.readCount_ == 2);
+	BOOST_REQUIRE(test.node_->readCacheHitCount() == 1);
+	BOOST_REQUIRE(test.node_->readCacheMissCount() == 2);
+}
+
+BOOST_AUTO_TEST_CASE(AttributeService_read_maxAge_invalid)
+{
+	AttributeServiceTest test;
+
+	ServiceTransactionRead::SPtr trx = test.read(-1);
+	BOOST_REQUIRE(test.serviceTransaction_.get() != nullptr);
+	BOOST_REQUIRE(trx->statusCode() == BadMaxAgeInvalid);
+	BOOST_REQUIRE(test.readCount_ == 0);
+}
+
+BOOST_AUTO_TEST_CASE(AttributeService_read_timestampsToReturn_neither)
+{
+	AttributeServiceTest test;
+	test.serverTimestamp_ = boost::posix_time::microsec_clock::universal_time();
+
+	ServiceTransactionRead::SPtr trx = test.read(0, TimestampsToReturn_Neither);
+	BOOST_REQUIRE(trx->statusCode() == Success);
+
+	OpcUaDataValue::SPtr dataValue;
+	trx->response()->dataValueArray()->get(0, dataValue);
+	BOOST_REQUIRE(dataValue->variant()->get<OpcUaUInt32>() == 1);
+	BOOST_REQUIRE(dataValue->serverTimestamp().exist() == false);
+
+	// the timestamps are only removed from the value of the response
+	OpcUaDataValue nodeDataValue;
+	test.attributeService_.informationModel()->find(OpcUaNodeId(1, 1))->getValue(nodeDataValue);
+	BOOST_REQUIRE(nodeDataValue.serverTimestamp().exist() == true);
+}
+
+BOOST_AUTO_TEST_CASE(AttributeService_read_timestampsToReturn_invalid)
+{
+	AttributeServiceTest test;
+
+	ServiceTransactionRead::SPtr trx = test.read(0, 4);
+	BOOST_REQUIRE(trx->statusCode() == BadTimestampsToReturnInvalid);
+	BOOST_REQUIRE(test.readCount_ == 0);
+}
+
+BOOST_AUTO_TEST_CASE(AttributeService_read_async)
+{
+	AttributeServiceTest test;
+	test.async_ = true;
+
+	ServiceTransactionRead::SPtr trx = test.read(0);
+	BOOST_REQUIRE(test.completion_.get() != nullptr);
+	BOOST_REQUIRE(test.serviceTransaction_.get() == nullptr);
+
+	// the response is sent when the application completes the read
+	OpcUaDataValue dataValue;
+	dataValue.variant()->set((OpcUaUInt32)4711);
+	test.completion_->complete(Success, dataValue);
+	BOOST_REQUIRE(test.serviceTransaction_.get() != nullptr);
+	BOOST_REQUIRE(trx->statusCode() == Success);
+	BOOST_REQUIRE(test.value(trx) == 4711);
+	BOOST_REQUIRE(test.nodeValue() == 4711);
+}
+
+BOOST_AUTO_TEST_CASE(AttributeService_read_async_timeoutHint)
+{
+	AttributeServiceTest test;
+	IOThread::SPtr ioThread = constructSPtr<IOThread>();
+	BOOST_REQUIRE(ioThread->startup() == true);
+	test.attributeService_.ioThread(ioThread.get());
+	test.async_ = true;
+	test.timeoutHint_ = 50;
+
+	test.receiveCondition_.condition(0, 1);
+	ServiceTransactionRead::SPtr trx = test.read(0);
+	BOOST_REQUIRE(test.receiveCondition_.waitForCondition(1000) == true);
+
+	OpcUaDataValue::SPtr dataValue;
+	trx->response()->dataValueArray()->get(0, dataValue);
+	BOOST_REQUIRE(dataValue->statusCode() == BadTimeout);
+
+	// a completion after the timeout is ignored
+	test.completion_->complete(Success);
+	BOOST_REQUIRE(test.receiveCondition_.conditionValue() == 1);
+
+	BOOST_REQUIRE(ioThread->shutdown() == true);
+}
+
+BOOST_AUTO_TEST_CASE(AttributeService_write_async)
+{
+	AttributeServiceTest test;
+	test.async_ = true;
+
+	ServiceTransactionWrite::SPtr trx = test.write(4711);
+	BOOST_REQUIRE(test.writeCount_ == 1);
+	BOOST_REQUIRE(test.completion_.get() != nullptr);
+	BOOST_REQUIRE(test.serviceTransaction_.get() == nullptr);
+
+	// the value is written when the application completes the write
+	test.completion_->complete(Success);
+	BOOST_REQUIRE(test.serviceTransaction_.get() != nullptr);
+	BOOST_REQUIRE(trx->statusCode() == Success);
+
+	OpcUaStatusCode statusCode;
+	trx->response()->results()->get(0, statusCode);
+	BOOST_REQUIRE(statusCode == Success);
+	BOOST_REQUIRE(test.nodeValue() == 4711);
+}
+
+BOOST_AUTO_TEST_CASE(AttributeService_write_async_error)
+{
+	AttributeServiceTest test;
+	test.async_ = true;
+
+	ServiceTransactionWrite::SPtr trx = test.write(4711);
+	test.completion_->complete(BadNotWritable);
+	BOOST_REQUIRE(test.serviceTransaction_.get() != nullptr);
+
+	OpcUaStatusCode statusCode;
+	trx->response()->results()->get(0, statusCode);
+	BOOST_REQUIRE(statusCode == BadNotWritable);
+}
+
+BOOST_AUTO_TEST_CASE(AttributeService_write_async_timeoutHint)
+{
+	AttributeServiceTest test;
+	IOThread::SPtr ioThread = constructSPtr<IOThread>();
+	BOOST_REQUIRE(ioThread->startup() == true);
+	test.attributeService_.ioThread(ioThread.get());
+	test.async_ = true;
+	test.timeoutHint_ = 50;
+
+	test.receiveCondition_.condition(0, 1);
+	ServiceTransactionWrite::SPtr trx = test.write(4711);
+	BOOST_REQUIRE(test.receiveCondition_.waitForCondition(1000) == true);
+
+	OpcUaStatusCode statusCode;
+	trx->response()->results()->get(0, statusCode);
+	BOOST_REQUIRE(statusCode == BadTimeout);
+
+	BOOST_REQUIRE(ioThread->shutdown() == true);
+}
+
+BOOST_AUTO_TEST_CASE(AttributeService_read_batch)
+{
+	AttributeServiceTest test;
+
+	std::vector<OpcUaUInt32> idVec = {2, 1, 4, 3};
+	ServiceTransactionRead::SPtr trx = test.read(idVec);
+	BOOST_REQUIRE(test.serviceTransaction_.get() != nullptr);
+	BOOST_REQUIRE(trx->statusCode() == Success);
+
+	// one callback for each batch callback, the single read is not batched
+	std::sort(test.batchSizeVec_.begin(), test.batchSizeVec_.end());
+	BOOST_REQUIRE(test.batchSizeVec_.size() == 2);
+	BOOST_REQUIRE(test.batchSizeVec_[0] == 1);
+	BOOST_REQUIRE(test.batchSizeVec_[1] == 2);
+	BOOST_REQUIRE(test.readCount_ == 1);
+
+	BOOST_REQUIRE(test.value(trx, 0) == 200);
+	BOOST_REQUIRE(test.value(trx, 1) == 1);
+	BOOST_REQUIRE(test.value(trx, 2) == 400);
+	BOOST_REQUIRE(test.value(trx, 3) == 300);
+	BOOST_REQUIRE(test.nodeValue(3) == 300);
+}
+
+BOOST_AUTO_TEST_CASE(AttributeService_read_batch_status)
+{
+	AttributeServiceTest test;
+	test.batchErrorNode_ = 3;
+
+	// the value of a failed item is not stored. The node has no value yet
+	std::vector<OpcUaUInt32> idVec = {2, 3};
+	ServiceTransactionRead::SPtr trx = test.read(idVec);
+	BOOST_REQUIRE(test.batchSizeVec_.size() == 1);
+	BOOST_REQUIRE(test.statusCode(trx, 0) == Success);
+	BOOST_REQUIRE(test.value(trx, 0) == 200);
+	BOOST_REQUIRE(test.statusCode(trx, 1) == BadNotReadable);
+}
+
+BOOST_AUTO_TEST_CASE(AttributeService_read_batch_async)
+{
+	AttributeServiceTest test;
+	test.batchAsyncNode_ = 3;
+	test.async_ = true;
+
+	// a batch item and a single read are completed asynchronously
+	std::vector<OpcUaUInt32> idVec = {1, 2, 3};
+	ServiceTransactionRead::SPtr trx = test.read(idVec);
+	BOOST_REQUIRE(test.completion_.get() != nullptr);
+	BOOST_REQUIRE(test.batchCompletion_.get() != nullptr);
+	BOOST_REQUIRE(test.serviceTransaction_.get() == nullptr);
+
+	OpcUaDataValue dataValue;
+	dataValue.variant()->set((OpcUaUInt32)4711);
+	test.batchCompletion_->complete(Success, dataValue);
+	BOOST_REQUIRE(test.serviceTransaction_.get() == nullptr);
+
+	dataValue.variant()->set((OpcUaUInt32)4712);
+	test.completion_->complete(Success, dataValue);
+	BOOST_REQUIRE(test.serviceTransaction_.get() != nullptr);
+	BOOST_REQUIRE(trx->statusCode() == Success);
+	BOOST_REQUIRE(test.value(trx, 0) == 4712);
+	BOOST_REQUIRE(test.value(trx, 1) == 200);
+	BOOST_REQUIRE(test.value(trx, 2) == 4711);
+}
+
+BOOST_AUTO_TEST_CASE(AttributeService_write_batch)
+{
+	AttributeServiceTest test;
+	test.batchErrorNode_ = 4;
+
+	std::vector<OpcUaUInt32> idVec = {2, 1, 4, 3};
+	ServiceTransactionWrite::SPtr trx = test.write(idVec, 4711);
+	BOOST_REQUIRE(test.serviceTransaction_.get() != nullptr);
+	BOOST_REQUIRE(trx->statusCode() == Success);
+
+	std::sort(test.batchSizeVec_.begin(), test.batchSizeVec_.end());
+	BOOST_REQUIRE(test.batchSizeVec_.size() == 2);
+	BOOST_REQUIRE(test.batchSizeVec_[0] == 1);
+	BOOST_REQUIRE(test.batchSizeVec_[1] == 2);
+	BOOST_REQUIRE(test.writeCount_ == 1);
+
+	// the value of a failed item is not written
+	BOOST_REQUIRE(test.statusCode(trx, 0) == Success);
+	BOOST_REQUIRE(test.statusCode(trx, 1) == Success);
+	BOOST_REQUIRE(test.statusCode(trx, 2) == BadNotWritable);
+	BOOST_REQUIRE(test.statusCode(trx, 3) == Success);
+	BOOST_REQUIRE(test.nodeValue(2) == 4711);
+	BOOST_REQUIRE(test.nodeValue(3) == 4711);
+}
+
+BOOST_AUTO_TEST_CASE(AttributeService_write_batch_async)
+{
+	AttributeServiceTest test;
+	test.batchAsyncNode_ = 3;
+
+	std::vector<OpcUaUInt32> idVec = {2, 3, 4};
+	ServiceTransactionWrite::SPtr trx = test.write(idVec, 4711);
+	BOOST_REQUIRE(test.batchCompletion_.get() != nullptr);
+	BOOST_REQUIRE(test.serviceTransaction_.get() == nullptr);
+	BOOST_REQUIRE(test.nodeValue(2) == 4711);
+
+	// the response is sent when the last batch item is completed
+	test.batchCompletion_->complete(BadDeviceFailure);
+	BOOST_REQUIRE(test.serviceTransaction_.get() != nullptr);
+	BOOST_REQUIRE(test.statusCode(trx, 0) == Success);
+	BOOST_REQUIRE(test.statusCode(trx, 1) == BadDeviceFailure);
+	BOOST_REQUIRE(test.statusCode(trx, 2) == Success);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,105 @@
+#include "unittest.h"
+
+#include "OpcUaStackCore/BuildInTypes/OpcUaIdentifier.h"
+#include "OpcUaStackCore/SecureChannel/RequestHeader.h"
+#include "OpcUaStackCore/SecureChannel/ResponseHeader.h"
+#include "OpcUaStackCore/ServiceSet/GetEndpointsRequest.h"
+#include "OpcUaStackCore/ServiceSet/GetEndpointsResponse.h"
+#include "OpcUaStackServer/ServiceSet/DiscoveryService.h"
+
+using namespace OpcUaStackServer;
+
+class DiscoveryServiceTest
+{
+  public:
+	DiscoveryServiceTest(void)
+	: endpointDescriptionSet_(constructSPtr<EndpointDescriptionSet>())
+	, discoveryService_()
+	{
+		addEndpoint("opc.tcp://127.0.0.1:4841");
+	}
+
+	void addEndpoint(const std::string& endpointUrl)
+	{
+		EndpointDescription::SPtr endpointDescription = constructSPtr<EndpointDescription>();
+		endpointDescription->endpointUrl(endpointUrl);
+		endpointDescriptionSet_->addEndpoint(endpointUrl, endpointDescription);
+		discoveryService_.endpointDescriptionSet(endpointDescriptionSet_);
+	}
+
+	EndpointDescriptionArray::SPtr getEndpoints(const std::string& endpointUrl, uint32_t requestHandle)
+	{
+		SecureChannelTransaction::SPtr secureChannelTransaction = constructSPtr<SecureChannelTransaction>();
+		std::iostream is(&secureChannelTransaction->is_);
+		GetEndpointsRequest getEndpointsRequest;
+		getEndpointsRequest.endpointUrl(endpointUrl);
+		getEndpointsRequest.opcUaBinaryEncode(is);
+
+		RequestHeader::SPtr requestHeader = constructSPtr<RequestHeader>();
+		requestHeader->requestHandle(requestHandle);
+		discoveryService_.getEndpointRequest(requestHeader, secureChannelTransaction);
+		BOOST_REQUIRE(secureChannelTransaction->responseTypeNodeId_ == OpcUaNodeId(OpcUaId_GetEndpointsResponse_Encoding_DefaultBinary));
+
+		std::iostream os(&secureChannelTransaction->os_);
+		ResponseHeader responseHeader;
+		responseHeader.opcUaBinaryDecode(os);
+		BOOST_REQUIRE(responseHeader.requestHandle() == requestHandle);
+		BOOST_REQUIRE(responseHeader.serviceResult() == Success);
+
+		GetEndpointsResponse getEndpointsResponse;
+		getEndpointsResponse.opcUaBinaryDecode(os);
+		return getEndpointsResponse.endpoints();
+	}
+
+	EndpointDescriptionSet::SPtr endpointDescriptionSet_;
+	DiscoveryService discoveryService_;
+};
+
+BOOST_AUTO_TEST_SUITE(DiscoveryService_)
+
+BOOST_AUTO_TEST_CASE(DiscoveryService_)
+{
+	std::cout << "DiscoveryService_t" << std::endl;
+}
+
+BOOST_AUTO_TEST_CASE(DiscoveryService_getEndpoints_cache)
+{
+	DiscoveryServiceTest test;
+
+	EndpointDescriptionArray::SPtr endpoints = test.getEndpoints("opc.tcp://127.0.0.1:4841", 1);
+	BOOST_REQUIRE(endpoints->size() == 1);
+	BOOST_REQUIRE(test.discoveryService_.endpointCacheHits() == 0);
+	BOOST_REQUIRE(test.discoveryService_.endpointCacheMisses() == 1);
+
+	// the encoded endpoints are used for each request. The response header
+	// belongs to the request.
+	endpoints = test.getEndpoints("opc.tcp://localhost:4841", 2);
+	BOOST_REQUIRE(endpoints->size() == 1);
+	endpoints = test.getEndpoints("opc.tcp://127.0.0.1:4841", 3);
+	BOOST_REQUIRE(endpoints->size() == 1);
+
+	EndpointDescription::SPtr endpointDescription;
+	BOOST_REQUIRE(endpoints->get(0, endpointDescription) == true);
+	BOOST_REQUIRE(endpointDescription->endpointUrl() == "opc.tcp://127.0.0.1:4841");
+
+	BOOST_REQUIRE(test.discoveryService_.endpointCacheHits() == 2);
+	BOOST_REQUIRE(test.discoveryService_.endpointCacheMisses() == 1);
+}
+
+BOOST_AUTO_TEST_CASE(DiscoveryService_getEndpoints_invalidate)
+{
+	DiscoveryServiceTest test;
+
+	EndpointDescriptionArray::SPtr endpoints = test.getEndpoints("opc.tcp://127.0.0.1:4841", 1);
+	BOOST_REQUIRE(endpoints->size() == 1);
+
+	// the new endpoint is contained in the next response
+	test.addEndpoint("opc.tcp://127.0.0.1:4842");
+	endpoints = test.getEndpoints("opc.tcp://127.0.0.1:4841", 2);
+	BOOST_REQUIRE(endpoints->size() == 2);
+
+	BOOST_REQUIRE(test.discoveryService_.endpointCacheHits() == 0);
+	BOOST_REQUIRE(test.discoveryService_.endpointCacheMisses() == 2);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,34 @@
+#include "unittest.h"
+
+#include "OpcUaStackCore/ServiceSet/AttributeServiceTransaction.h"
+#include "OpcUaStackServer/ServiceSet/TransactionManager.h"
+
+using namespace OpcUaStackServer;
+
+BOOST_AUTO_TEST_SUITE(TransactionManager_)
+
+BOOST_AUTO_TEST_CASE(TransactionManager_)
+{
+	std::cout << "TransactionManager_t" << std::endl;
+}
+
+BOOST_AUTO_TEST_CASE(TransactionManager_getTransaction)
+{
+	TransactionManager transactionManager;
+	ServiceTransaction::SPtr prototype = constructSPtr<ServiceTransactionRead>();
+	BOOST_REQUIRE(transactionManager.registerTransaction(prototype) == true);
+	BOOST_REQUIRE(transactionManager.registerTransaction(prototype) == false);
+
+	OpcUaNodeId typeId(OpcUaId_ReadRequest_Encoding_DefaultBinary);
+	ServiceTransaction::SPtr trx = transactionManager.getTransaction(typeId);
+	BOOST_REQUIRE(trx.get() != nullptr);
+	BOOST_REQUIRE(trx->nodeTypeRequest() == OpcUaNodeId(OpcUaId_ReadRequest_Encoding_DefaultBinary));
+
+	OpcUaNodeId unknownTypeId(OpcUaId_HistoryReadRequest_Encoding_DefaultBinary);
+	BOOST_REQUIRE(transactionManager.getTransaction(unknownTypeId).get() == nullptr);
+
+	OpcUaNodeId stringTypeId("ReadRequest", 1);
+	BOOST_REQUIRE(transactionManager.getTransaction(stringTypeId).get() == nullptr);
+}
+
+BOOST_AUTO_TEST_SUITE_END()